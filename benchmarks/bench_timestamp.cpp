@@ -0,0 +1,94 @@
+/**
+ * @file bench_timestamp.cpp
+ * @brief Micro-benchmark of timestamp rendering for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Timestamp.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <ctime>
+#include <cstdlib>
+#include <functional>
+
+using namespace Eclipse;
+
+namespace
+{
+    volatile size_t sink = 0; ///< Keeps results alive so the work is not optimised away
+
+    /**
+     * @brief The layout produced by std::put_time, as getTimestamp() did before
+     */
+    std::string put_time_timestamp(std::chrono::system_clock::time_point time)
+    {
+        auto in_time_t = std::chrono::system_clock::to_time_t(time);
+        std::tm buf{};
+#ifdef _WIN32
+        localtime_s(&buf, &in_time_t);
+#else
+        localtime_r(&in_time_t, &buf);
+#endif
+        std::ostringstream ss;
+        ss << std::put_time(&buf, "%Y-%m-%d %H:%M:%S");
+        return ss.str();
+    }
+
+    void run(const char *name, int iterations, const std::function<size_t(int)> &body)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            sink = sink + body(i);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+        std::cout << std::left << std::setw(44) << name << std::right << std::setw(10)
+                  << std::fixed << std::setprecision(1) << ns << " ns/op" << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    if (iterations <= 0)
+    {
+        std::cerr << "Usage: bench_timestamp [iterations]" << std::endl;
+        return 1;
+    }
+
+    // Pinned time, so every variant renders the same values
+    const auto base = std::chrono::system_clock::from_time_t(1735786800);
+    Logger &logger = Logger::getInstance();
+    logger.setClockSource(EClockSource::MANUAL);
+    logger.setManualTime(base);
+
+    std::cout << "=== Eclipse Timestamp Benchmark (" << iterations << " iterations) ===" << std::endl;
+
+    // One record per microsecond: the per-second cache almost always hits
+    run("std::put_time + ostringstream", iterations, [&](int i)
+        { return put_time_timestamp(base + std::chrono::microseconds(i)).size(); });
+    // getTimestamp() returns a std::string, which allocates for every layout; records do not
+    // pay for it, they render the timestamp straight into the record text
+    run("Logger::getTimestamp(), std::string copy", iterations, [&](int)
+        { return logger.getTimestamp().size(); });
+
+    TimestampFormatter formatter;
+    char buffer[TimestampFormatter::kMaxLength];
+    run("TimestampFormatter DEFAULT", iterations, [&](int i)
+        { return formatter.format(base + std::chrono::microseconds(i), ETimestampFormat::DEFAULT, buffer); });
+    run("TimestampFormatter ISO8601", iterations, [&](int i)
+        { return formatter.format(base + std::chrono::microseconds(i), ETimestampFormat::ISO8601, buffer); });
+
+    // A new second on every call: the worst case, localtime on every record
+    run("TimestampFormatter DEFAULT, new second", iterations, [&](int i)
+        { return formatter.format(base + std::chrono::seconds(i), ETimestampFormat::DEFAULT, buffer); });
+
+    logger.setClockSource(EClockSource::REALTIME);
+    return 0;
+}
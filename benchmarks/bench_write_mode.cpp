@@ -0,0 +1,79 @@
+/**
+ * @file bench_write_mode.cpp
+ * @brief Micro-benchmark of the file write modes for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+using namespace Eclipse;
+
+namespace
+{
+    void run(const char *name, EWriteMode mode, int threads, int records)
+    {
+        Logger &logger = Logger::getInstance();
+        const std::string path = "bench_write_mode.log";
+        std::filesystem::remove(path);
+        logger.setLogFile(path);
+        logger.setWriteMode(mode);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([records]()
+                                 {
+                for (int i = 0; i < records; ++i) {
+                    ECLIPSE_INFO("BENCH", "Record", i);
+                } });
+        }
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+        logger.flush();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        logger.setWriteMode(EWriteMode::IMMEDIATE);
+        logger.closeLogFile();
+        std::filesystem::remove(path);
+
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(threads) * records);
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(3) << threads << " threads"
+                  << std::setw(10) << std::fixed << std::setprecision(1) << ns << " ns/record" << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int records = argc > 1 ? std::atoi(argv[1]) : 100000;
+    if (records <= 0)
+    {
+        std::cerr << "Usage: bench_write_mode [records-per-thread]" << std::endl;
+        return 1;
+    }
+
+    Logger &logger = Logger::getInstance();
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setOutputDestination(EOutput::FILE);
+
+    std::cout << "=== Eclipse Write Mode Benchmark (" << records << " records per thread) ===" << std::endl;
+    for (int threads : {1, 4})
+    {
+        run("IMMEDIATE", EWriteMode::IMMEDIATE, threads, records);
+        run("THREAD_BUFFERED", EWriteMode::THREAD_BUFFERED, threads, records);
+        run("DOUBLE_BUFFERED", EWriteMode::DOUBLE_BUFFERED, threads, records);
+    }
+    return 0;
+}
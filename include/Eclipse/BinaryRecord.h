@@ -0,0 +1,224 @@
+/**
+ * @file BinaryRecord.h
+ * @brief Eclipse Logging Library - Delta and dictionary encoded binary records
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "Timestamp.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Fields of one log record as kept by EFileFormat::BINARY
+     */
+    struct BinaryRecord
+    {
+        uint64_t sequence = 0;            ///< Position of the record in its logger's file output
+        int64_t timeNs = 0;               ///< Time of the record, nanoseconds since the epoch (UTC)
+        uint8_t level = 0;                ///< ELevel value
+        std::string tag;                  ///< Tag or category
+        std::string msg;                  ///< Message
+        std::string trace;                ///< Call site, empty if none
+        std::vector<std::string> details; ///< Details in order
+    };
+
+    constexpr char kBinaryBlockMarker = '\x01';   ///< First byte of every block; never starts a text record
+    constexpr uint64_t kBinaryResetBlocks = 256;  ///< Blocks between reset blocks
+
+    /**
+     * @brief Append a record in the standalone layout handed from producers to the sink
+     *
+     * Standalone records carry absolute values and whole strings, so they can
+     * be buffered and concatenated like text records. A BINARY FileSink
+     * encodes them against the previous records of its file.
+     *
+     * @param sequence Position of the record in the logger's file output
+     * @param timeNs Time of the record, nanoseconds since the epoch (UTC)
+     * @param level ELevel value
+     * @param tag Tag or category
+     * @param msg Message
+     * @param trace Call site, empty if none
+     * @param details Details in order
+     * @param out Receives the bytes, appended
+     */
+    void appendBinaryRecord(uint64_t sequence, int64_t timeNs, uint8_t level, std::string_view tag,
+                            std::string_view msg, std::string_view trace, const std::vector<std::string> &details,
+                            std::string &out);
+
+    /**
+     * @brief Check whether data starts with a standalone record
+     *
+     * Text records start with '[', so both kinds can be told apart.
+     *
+     * @param data Bytes
+     * @param size Number of bytes
+     * @return bool True for standalone records
+     */
+    bool isBinaryRecord(const char *data, size_t size);
+
+    /**
+     * @brief Parse a run of standalone records
+     *
+     * @param data Bytes written by appendBinaryRecord()
+     * @param size Number of bytes
+     * @param records Receives the records
+     * @return bool False if the bytes are not whole records
+     */
+    bool parseBinaryRecords(const char *data, size_t size, std::vector<BinaryRecord> &records);
+
+    /**
+     * @brief Render a record in the layout of TEXT log files
+     *
+     * @param record Record to render
+     * @param format Timestamp layout, in local time
+     * @param out Receives the text, appended
+     */
+    void formatBinaryRecord(const BinaryRecord &record, ETimestampFormat format, std::string &out);
+
+    /**
+     * @brief Encoder of standalone records into the blocks of a BINARY file
+     *
+     * A block is the payload of one frame:
+     *
+     * | Size    | Field                                                  |
+     * |---------|--------------------------------------------------------|
+     * | 1       | kBinaryBlockMarker                                     |
+     * | 8       | Stream id, little-endian                               |
+     * | varint  | Block number << 1, low bit set for a reset block       |
+     * | ...     | Records                                                |
+     *
+     * A record is a header byte (bits 0-2 level, bit 3 explicit sequence,
+     * bit 4 trace present, bits 5-7 detail count with 7 meaning a varint
+     * count follows), the sequence as a zigzag delta from the previous
+     * record's plus one (only with bit 3), the time as a zigzag delta from the
+     * previous record's, then tag, message, trace and details. Strings are a
+     * varint: odd values reference a dictionary entry, even ones give the
+     * length of a literal that follows. Short literals join the dictionary of
+     * the stream, so a repeated tag, message or call site costs one or two
+     * bytes and everything but a record's new strings typically six to eight.
+     *
+     * Each file is one stream per writing process. The stream id is the
+     * process id in the high 32 bits and a per-process count of streams in the
+     * low ones, so writers appending at the same time never share one. Every
+     * kBinaryResetBlocks blocks, and when the dictionary is full, a reset block
+     * starts over with an empty dictionary and absolute values, so a reader
+     * that lost a damaged block resumes at the next reset.
+     *
+     * @note Not thread-safe; FileSink owns one per file.
+     */
+    class BinaryEncoder
+    {
+    public:
+        /**
+         * @brief Start a new stream: the next block is a reset block with a new stream id
+         */
+        void reset();
+
+        /**
+         * @brief Encode leading standalone records into one block
+         *
+         * Takes records until the block holds at least limit bytes, but always
+         * at least one record.
+         *
+         * @param data Standalone records
+         * @param size Number of bytes
+         * @param limit Block size after which no further record is added
+         * @param block Receives the block
+         * @return size_t Bytes of data consumed, 0 if data does not start with a record
+         */
+        size_t encode(const char *data, size_t size, size_t limit, std::string &block);
+
+    private:
+        /**
+         * @brief Append a string as a dictionary reference or a literal
+         */
+        void appendString(std::string_view text, std::string &block);
+
+        bool started = false;                            ///< A stream id has been chosen
+        long processId = 0;                              ///< Process the stream belongs to
+        uint64_t streamId = 0;                           ///< Id written in every block
+        uint64_t blockNumber = 0;                        ///< Number of the next block
+        uint64_t blocksSinceReset = 0;                   ///< Blocks since the last reset block, 0 forces one
+        uint64_t previousSequence = 0;                   ///< Sequence of the previous record
+        int64_t previousTimeNs = 0;                      ///< Time of the previous record
+        std::deque<std::string> strings;                 ///< Dictionary entries by id; never moved
+        std::unordered_map<std::string_view, uint32_t> ids; ///< Views into strings
+        size_t dictionaryBytes = 0;                      ///< Total length of strings
+        std::vector<std::string_view> details;           ///< Scratch for the details of one record
+    };
+
+    /**
+     * @brief Decoder of the blocks of BINARY files, restoring every record exactly
+     *
+     * Keeps the state of every stream it has seen, so files that several
+     * processes appended to decode as well.
+     *
+     * @note Not thread-safe.
+     */
+    class BinaryDecoder
+    {
+    public:
+        /**
+         * @brief Check whether a frame payload is a block
+         *
+         * @param data Payload
+         * @param size Payload length
+         * @return bool True for a block
+         */
+        static bool isBlock(const char *data, size_t size);
+
+        /**
+         * @brief Read the stream id and reset flag of a block
+         *
+         * @param data Block bytes
+         * @param size Block length
+         * @param streamId Receives the stream id
+         * @param reset Receives whether the block is a reset block
+         * @return bool False if the data is not a block
+         */
+        static bool readBlockHeader(const char *data, size_t size, uint64_t &streamId, bool &reset);
+
+        /**
+         * @brief Forget every stream
+         */
+        void reset();
+
+        /**
+         * @brief Decode one block
+         *
+         * @param data Block bytes
+         * @param size Block length
+         * @param records Receives the records, replacing its contents
+         * @return bool False if the block is malformed or follows a lost block of
+         *         its stream; the stream then resumes at its next reset block
+         */
+        bool decode(const char *data, size_t size, std::vector<BinaryRecord> &records);
+
+    private:
+        /**
+         * @brief Decoding state of one stream
+         */
+        struct Stream
+        {
+            bool synced = false;              ///< A reset block was seen and no block was lost since
+            uint64_t nextBlock = 0;           ///< Expected block number
+            uint64_t previousSequence = 0;    ///< Sequence of the previous record
+            int64_t previousTimeNs = 0;       ///< Time of the previous record
+            std::vector<std::string> strings; ///< Dictionary entries by id
+            size_t dictionaryBytes = 0;       ///< Total length of strings
+        };
+
+        std::unordered_map<uint64_t, Stream> streams; ///< State by stream id
+    };
+}
@@ -0,0 +1,218 @@
+/**
+ * @file Clock.h
+ * @brief Eclipse Logging Library - Timestamp sources
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <time.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define ECLIPSE_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ECLIPSE_HAS_TSC 1
+#else
+#define ECLIPSE_HAS_TSC 0
+#endif
+
+namespace Eclipse
+{
+    /**
+     * @brief Enumeration of timestamp sources
+     *
+     * Defines how the logger reads the time of a record.
+     */
+    enum class EClockSource
+    {
+        REALTIME, ///< clock_gettime(CLOCK_REALTIME) through the vDSO
+        COARSE,   ///< clock_gettime(CLOCK_REALTIME_COARSE): cheaper, one scheduler tick of resolution
+        TSC,      ///< rdtsc on the producer, converted with a calibrated TSC-to-ns mapping
+        MANUAL    ///< Time set by the application, for deterministic tests and benchmarks
+    };
+
+    /**
+     * @brief Timestamp source shared by the regular and real-time paths
+     *
+     * The source is an enum dispatched with a switch in now(), so reading the
+     * time is an inlined branch rather than a virtual call.
+     *
+     * With the TSC source a producer only executes rdtsc. Raw ticks are turned
+     * into wall-clock time with a mapping calibrated against CLOCK_REALTIME when
+     * the source is selected and recalibrated periodically by the backend thread,
+     * so NTP adjustments are followed. The mapping is published with a seqlock:
+     * readers never block and never enter the kernel.
+     */
+    class Clock
+    {
+    public:
+        /**
+         * @brief Read the CPU timestamp counter
+         *
+         * @return uint64_t Raw TSC value, or 0 where there is no TSC
+         */
+        static uint64_t readTsc()
+        {
+#if ECLIPSE_HAS_TSC
+            return __rdtsc();
+#else
+            return 0;
+#endif
+        }
+
+        /**
+         * @brief Check whether the TSC ticks at a constant rate in every P/C-state
+         *
+         * @return bool True if the CPU reports an invariant TSC
+         */
+        static bool isTscInvariant();
+
+        /**
+         * @brief Select the timestamp source
+         *
+         * Selecting TSC calibrates the mapping first, which takes about 10 ms.
+         * If the TSC is not invariant, or COARSE is unavailable on this platform,
+         * the clock falls back to REALTIME.
+         *
+         * @param source Requested source
+         * @return bool True if the requested source is now in use
+         */
+        bool setSource(EClockSource source);
+
+        /**
+         * @brief Get the timestamp source in use
+         *
+         * @return EClockSource Current source
+         */
+        EClockSource getSource() const
+        {
+            return source.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Read the current wall-clock time from the selected source
+         *
+         * @return std::chrono::system_clock::time_point Current time
+         */
+        std::chrono::system_clock::time_point now() const
+        {
+            switch (getSource())
+            {
+            case EClockSource::COARSE:
+                return coarseNow();
+            case EClockSource::TSC:
+                return fromTsc(readTsc());
+            case EClockSource::MANUAL:
+                return fromNs(manualNs.load(std::memory_order_relaxed));
+            default:
+                return std::chrono::system_clock::now();
+            }
+        }
+
+        /**
+         * @brief Set the time returned by the MANUAL source
+         *
+         * @param time New manual time
+         */
+        void setManualTime(std::chrono::system_clock::time_point time)
+        {
+            manualNs.store(toNs(time), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Move the time returned by the MANUAL source forward
+         *
+         * @param delta Amount to advance
+         */
+        void advanceManualTime(std::chrono::nanoseconds delta)
+        {
+            manualNs.fetch_add(delta.count(), std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Convert nanoseconds since the epoch to a time point
+         *
+         * @param ns Nanoseconds since the epoch
+         * @return std::chrono::system_clock::time_point Corresponding time point
+         */
+        static std::chrono::system_clock::time_point fromNs(int64_t ns)
+        {
+            return std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns)));
+        }
+
+        /**
+         * @brief Convert a time point to nanoseconds since the epoch
+         *
+         * @param time Time point
+         * @return int64_t Nanoseconds since the epoch
+         */
+        static int64_t toNs(std::chrono::system_clock::time_point time)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        }
+
+        /**
+         * @brief Convert a raw TSC value to wall-clock time
+         *
+         * @param ticks Value returned by readTsc()
+         * @return std::chrono::system_clock::time_point Corresponding wall-clock time
+         */
+        std::chrono::system_clock::time_point fromTsc(uint64_t ticks) const;
+
+        /**
+         * @brief Re-anchor the mapping to CLOCK_REALTIME and refine the tick rate
+         *
+         * Called periodically by the backend thread while the TSC source is in use.
+         */
+        void recalibrate();
+
+    private:
+        /**
+         * @brief Read CLOCK_REALTIME_COARSE, or the regular clock where it does not exist
+         *
+         * @return std::chrono::system_clock::time_point Current time
+         */
+        static std::chrono::system_clock::time_point coarseNow()
+        {
+#ifdef CLOCK_REALTIME_COARSE
+            struct timespec ts{};
+            ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+            return fromNs(static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec);
+#else
+            return std::chrono::system_clock::now();
+#endif
+        }
+
+        /**
+         * @brief Read a TSC value and CLOCK_REALTIME as close together as possible
+         *
+         * @param ticks Receives the TSC value
+         * @param ns Receives nanoseconds since the epoch
+         */
+        static void samplePair(uint64_t &ticks, int64_t &ns);
+
+        /**
+         * @brief Publish a new mapping
+         */
+        void publish(uint64_t ticks, int64_t ns, double rate);
+
+        std::atomic<EClockSource> source{EClockSource::REALTIME}; ///< Source in use
+        std::mutex calibrationMutex;                               ///< Serialises writers of the mapping
+        std::atomic<uint32_t> sequence{0};                         ///< Seqlock counter, odd while writing
+        std::atomic<uint64_t> tscBase{0};                          ///< TSC value of the anchor
+        std::atomic<int64_t> nsBase{0};                            ///< Wall-clock time of the anchor
+        std::atomic<double> nsPerTick{0.0};                        ///< Calibrated tick length
+        std::atomic<int64_t> manualNs{0};                          ///< Time of the MANUAL source
+        uint64_t firstTicks = 0;                                   ///< TSC value of the first calibration sample
+        int64_t firstNs = 0;                                       ///< Wall-clock time of the first calibration sample
+    };
+}
@@ -0,0 +1,244 @@
+/**
+ * @file ColumnStore.h
+ * @brief Eclipse Logging Library - Columnar storage of log records for analytics
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "BinaryRecord.h"
+#include "Compression.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Columns of an exported part, one file each
+     */
+    enum class EColumn
+    {
+        TIME,    ///< Nanoseconds since the epoch (UTC), file "time.col"
+        LEVEL,   ///< ELevel value, file "level.col"
+        TAG,     ///< Tag or category, file "tag.col"
+        SITE,    ///< Call site, empty if none, file "site.col"
+        MESSAGE, ///< Message, file "message.col"
+        FIELDS   ///< Details in order, file "fields.col"
+    };
+
+    constexpr size_t kColumnCount = 6;                     ///< Number of EColumn values
+    constexpr size_t kDefaultRowsPerBlock = 64 * 1024;     ///< Rows per block unless set otherwise
+
+    /**
+     * @brief Get the name of a column, as used in file names and the index
+     *
+     * @param column Column
+     * @return const char* "time", "level", "tag", "site", "message" or "fields"
+     */
+    const char *getColumnName(EColumn column);
+
+    /**
+     * @brief Location and statistics of one block of one column
+     *
+     * TIME and LEVEL blocks keep their smallest and largest value in
+     * minValue and maxValue; the string columns keep theirs, in byte order,
+     * in minText and maxText (FIELDS over every detail of the block).
+     */
+    struct ColumnBlock
+    {
+        EColumn column = EColumn::TIME; ///< Column the block belongs to
+        uint32_t block = 0;             ///< Block number, the same in every column for the same rows
+        uint64_t firstRow = 0;          ///< Row of the block's first value
+        uint32_t rows = 0;              ///< Number of values
+        uint64_t offset = 0;            ///< Offset in the column file
+        uint32_t bytes = 0;             ///< Stored length
+        uint32_t crc = 0;               ///< CRC32C of the stored bytes
+        int64_t minValue = 0;           ///< Smallest TIME or LEVEL value
+        int64_t maxValue = 0;           ///< Largest TIME or LEVEL value
+        std::string minText;            ///< Smallest string
+        std::string maxText;            ///< Largest string
+    };
+
+    /**
+     * @brief Writer of records into a part directory, one file per column
+     *
+     * Rows are cut into blocks of a fixed number of rows, the same in every
+     * column, so a query reads only the columns it needs and skips blocks by
+     * their statistics. Within a block, times are zigzag deltas, levels are
+     * bytes and strings are a block dictionary plus an index per value. A
+     * stored block is a codec byte (0 plain, 1 zstd) and the encoded bytes;
+     * zstd is used when available and smaller.
+     *
+     * The INDEX file lists every block with its statistics and is written
+     * last, by rename, so a part without one is incomplete.
+     *
+     * @note Not thread-safe; use one writer per part.
+     */
+    class ColumnWriter
+    {
+    public:
+        /**
+         * @brief Construct a writer
+         *
+         * @param rowsPerBlock Rows per block, at least one
+         */
+        explicit ColumnWriter(size_t rowsPerBlock = kDefaultRowsPerBlock);
+
+        ColumnWriter(const ColumnWriter &) = delete;
+        ColumnWriter &operator=(const ColumnWriter &) = delete;
+
+        /**
+         * @brief Start a part, creating the directory and replacing a previous part in it
+         *
+         * @param directory Part directory
+         * @return bool True if every column file could be created
+         */
+        bool open(const std::string &directory);
+
+        /**
+         * @brief Add a row; the sequence number is not stored
+         *
+         * @param record Record to add
+         * @return bool False if the part is not open or a block could not be written
+         */
+        bool add(const BinaryRecord &record);
+
+        /**
+         * @brief Write the last block and the index
+         *
+         * @return bool True if the part is complete
+         */
+        bool close();
+
+        /**
+         * @brief Get the number of rows added
+         *
+         * @return uint64_t Rows
+         */
+        uint64_t getRowCount() const;
+
+        /**
+         * @brief Get the number of bytes stored in the column files so far
+         *
+         * @return uint64_t Bytes
+         */
+        uint64_t getStoredBytes() const;
+
+    private:
+        /**
+         * @brief Encode and store the buffered rows as one block of every column
+         */
+        bool flush();
+
+        /**
+         * @brief Store an encoded block of a column and record it in the index
+         */
+        bool store(ColumnBlock &block, const std::string &encoded);
+
+        size_t rowsPerBlock;                             ///< Rows per block
+        std::string directory;                           ///< Open part, empty when closed
+        std::ofstream files[kColumnCount];               ///< Column files
+        uint64_t offsets[kColumnCount] = {};             ///< Size of each column file
+        std::vector<ColumnBlock> blocks;                 ///< Index entries written so far
+        uint64_t rows = 0;                               ///< Rows added
+        uint32_t blockNumber = 0;                        ///< Number of the next block
+        size_t bufferedBytes = 0;                        ///< String bytes of the buffered rows
+        std::vector<int64_t> times;                      ///< Buffered TIME values
+        std::vector<uint8_t> levels;                     ///< Buffered LEVEL values
+        std::vector<std::string> strings[3];             ///< Buffered TAG, SITE and MESSAGE values
+        std::vector<std::vector<std::string>> fields;    ///< Buffered FIELDS values
+        Compressor compressor;                           ///< Compresses blocks when zstd is available
+        std::string scratch;                             ///< Encoded block
+        std::string compressed;                          ///< Compressed block
+        bool failed = false;                             ///< A write failed
+    };
+
+    /**
+     * @brief Reader of a part directory written by ColumnWriter
+     *
+     * Every read checks the block's CRC32C.
+     *
+     * @note Not thread-safe; use one reader per thread.
+     */
+    class ColumnReader
+    {
+    public:
+        /**
+         * @brief Open a part
+         *
+         * @param directory Part directory
+         * @return bool False if the index is missing or malformed
+         */
+        bool open(const std::string &directory);
+
+        /**
+         * @brief Get the blocks of a column, in row order
+         *
+         * @param column Column
+         * @return const std::vector<ColumnBlock>& Blocks with their statistics
+         */
+        const std::vector<ColumnBlock> &getBlocks(EColumn column) const;
+
+        /**
+         * @brief Get the number of rows in the part
+         *
+         * @return uint64_t Rows
+         */
+        uint64_t getRowCount() const;
+
+        /**
+         * @brief Read a TIME block
+         *
+         * @param block Block of the TIME column
+         * @param values Receives the values, replacing its contents
+         * @return bool False if the block is damaged or of another column
+         */
+        bool readTimes(const ColumnBlock &block, std::vector<int64_t> &values);
+
+        /**
+         * @brief Read a LEVEL block
+         *
+         * @param block Block of the LEVEL column
+         * @param values Receives the values, replacing its contents
+         * @return bool False if the block is damaged or of another column
+         */
+        bool readLevels(const ColumnBlock &block, std::vector<uint8_t> &values);
+
+        /**
+         * @brief Read a TAG, SITE or MESSAGE block
+         *
+         * @param block Block of a string column
+         * @param values Receives the values, replacing its contents
+         * @return bool False if the block is damaged or of another column
+         */
+        bool readStrings(const ColumnBlock &block, std::vector<std::string> &values);
+
+        /**
+         * @brief Read a FIELDS block
+         *
+         * @param block Block of the FIELDS column
+         * @param values Receives the details of every row, replacing its contents
+         * @return bool False if the block is damaged or of another column
+         */
+        bool readFields(const ColumnBlock &block, std::vector<std::vector<std::string>> &values);
+
+    private:
+        /**
+         * @brief Read, check and decompress a block into scratch
+         */
+        bool load(const ColumnBlock &block);
+
+        std::string directory;                        ///< Open part
+        std::vector<ColumnBlock> blocks[kColumnCount]; ///< Index by column
+        std::ifstream files[kColumnCount];            ///< Column files, opened on first read
+        uint64_t rows = 0;                            ///< Rows in the part
+        Compressor decompressor;                      ///< Decompresses zstd blocks
+        std::string stored;                           ///< Stored block
+        std::string scratch;                          ///< Encoded block
+    };
+}
@@ -0,0 +1,122 @@
+/**
+ * @file Compression.h
+ * @brief Eclipse Logging Library - zstd compression with trained dictionaries
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief zstd compressor and decompressor for log payloads
+     *
+     * A single record is too short for a general-purpose compressor to find
+     * much to reuse. Records of one program share most of their text with each
+     * other, though: timestamps, levels, tags, sites and message formats. A
+     * dictionary trained from a sample of the program's own logs (see
+     * trainDictionary() and the eclipse-train-dict tool) holds that shared
+     * text, so payloads of a single record or a small batch still compress
+     * several times over.
+     *
+     * zstd is optional at build time. Without it isAvailable() is false and
+     * every other function fails, so COMPRESSED files hold uncompressed payloads.
+     *
+     * @note Not thread-safe; use one instance per thread.
+     */
+    class Compressor
+    {
+    public:
+        /**
+         * @brief Create a compressor at level 3 without a dictionary
+         */
+        Compressor();
+
+        /**
+         * @brief Frees the zstd contexts
+         */
+        ~Compressor();
+
+        Compressor(const Compressor &) = delete;
+        Compressor &operator=(const Compressor &) = delete;
+
+        /**
+         * @brief Check whether the library was built with zstd
+         *
+         * @return bool True if compression is available
+         */
+        static bool isAvailable();
+
+        /**
+         * @brief Use a dictionary for compression and decompression
+         *
+         * @param dictionary Dictionary bytes, empty for none
+         * @param level zstd compression level, 1 (fastest) to 19
+         * @return bool True if zstd is available and accepted the dictionary
+         */
+        bool setDictionary(const std::string &dictionary, int level = 3);
+
+        /**
+         * @brief Get the id of the dictionary in use
+         *
+         * @return uint32_t Dictionary id, 0 without a dictionary or for raw-content dictionaries
+         */
+        uint32_t getDictionaryId() const;
+
+        /**
+         * @brief Compress data into one zstd frame
+         *
+         * @param data Bytes to compress
+         * @param size Number of bytes
+         * @param out Receives the frame
+         * @return bool True on success
+         */
+        bool compress(const char *data, size_t size, std::string &out);
+
+        /**
+         * @brief Decompress one zstd frame
+         *
+         * @param data Frame bytes
+         * @param size Frame size
+         * @param out Receives the original bytes
+         * @return bool False if the frame is damaged or needs a dictionary not in use
+         */
+        bool decompress(const char *data, size_t size, std::string &out);
+
+        /**
+         * @brief Check whether bytes start with the zstd frame magic
+         *
+         * Text records never do, so compressed and plain payloads can share a file.
+         *
+         * @param data Payload
+         * @param size Payload length
+         * @return bool True for a zstd frame
+         */
+        static bool isCompressed(const char *data, size_t size);
+
+        /**
+         * @brief Train a dictionary from sample records
+         *
+         * Samples should be single records or small batches as they will be
+         * written. A few thousand samples give a useful dictionary.
+         *
+         * @param samples Sample payloads
+         * @param capacity Largest dictionary size in bytes
+         * @param dictionary Receives the dictionary
+         * @return bool False if zstd is unavailable or the samples are too few
+         */
+        static bool trainDictionary(const std::vector<std::string> &samples, size_t capacity, std::string &dictionary);
+
+    private:
+        struct State;
+        std::unique_ptr<State> state; ///< zstd contexts and dictionaries; null without zstd
+    };
+}
@@ -0,0 +1,389 @@
+/**
+ * @file FileSink.h
+ * @brief Eclipse Logging Library - Append-only file sink with atomic record writes
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "BinaryRecord.h"
+#include "Compression.h"
+#include "Frame.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Eclipse
+{
+    /**
+     * @brief Policy for records larger than the atomic write limit
+     *
+     * Only applies once an atomic limit is set with FileSink::setAtomicLimit().
+     * A single write() of at most the limit is never interleaved with writes
+     * from other processes appending to the same file. Larger records cannot
+     * be emitted atomically and are handled according to this policy.
+     */
+    enum class EOversize
+    {
+        SPLIT_LINES, ///< Emit whole lines in several writes; a line over the limit is written in pieces
+        TRUNCATE     ///< Cut the record to the limit and mark it as truncated; the rest is lost
+    };
+
+    /**
+     * @brief Page-cache policy of a file sink
+     *
+     * High-volume logs written through the page cache evict data the rest of
+     * the system is using. The non-default modes keep log pages out of it.
+     */
+    enum class ECacheMode
+    {
+        NORMAL,   ///< Regular writes through the page cache (default)
+        DONTNEED, ///< Start write-back of every written MiB and drop it from the page cache
+        DIRECT    ///< O_DIRECT writes of aligned blocks; the file is owned by this process
+    };
+
+    /**
+     * @brief Unbuffered append-only file sink
+     *
+     * Opens the file with O_APPEND and writes every record, or batch of whole
+     * records, in full. With an atomic limit set, records up to the limit are
+     * emitted with a single write call, so several processes can append to one
+     * file without producing interleaved partial lines. Nothing is buffered in user space, so a record
+     * is in the kernel as soon as write() returns.
+     *
+     * In DIRECT mode the file is opened with O_DIRECT instead of O_APPEND.
+     * Every write stores the data together with the partial last block, padded
+     * with NUL bytes to the block size, at an aligned offset; close() truncates
+     * the padding. Only one process may write such a file, and after a crash
+     * the last block may end in NUL padding.
+     *
+     * In FRAMED format every write call, i.e. every record or batch, becomes
+     * one frame with a length and CRC32C header (see Frame.h). The atomic limit
+     * applies to the payload. COMPRESSED format compresses each payload with
+     * zstd and the dictionary set with setDictionary(); a new file starts with
+     * a header frame recording the dictionary id. BINARY format takes the
+     * standalone records of BinaryRecord.h and writes them as delta and
+     * dictionary encoded blocks of at most about the atomic limit (4096 bytes
+     * without one), one frame each; other data is framed as in FRAMED.
+     *
+     * @note Not thread-safe; the Logger serialises access with its fileMutex.
+     */
+    class FileSink
+    {
+    public:
+        FileSink() = default;
+
+        /**
+         * @brief Closes the file if it is still open
+         */
+        ~FileSink();
+
+        FileSink(const FileSink &) = delete;
+        FileSink &operator=(const FileSink &) = delete;
+
+        /**
+         * @brief Open a file for appending, creating it if necessary
+         *
+         * Closes any previously opened file first.
+         *
+         * @param filePath Path to the file
+         * @return bool True if the file was opened, false otherwise
+         */
+        bool open(const std::string &filePath);
+
+        /**
+         * @brief Close the file if it is open
+         */
+        void close();
+
+        /**
+         * @brief Check whether a file is open
+         *
+         * @return bool True if a file is open
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Get the underlying file descriptor
+         *
+         * @return int Descriptor opened with O_APPEND, or -1 when closed
+         */
+        int getDescriptor() const;
+
+        /**
+         * @brief Get the number of bytes this sink has written
+         *
+         * Counts what reached the file, frame headers and encoded BINARY or
+         * COMPRESSED payloads included, across every file the sink opened.
+         * The difference around a write() is its size on disk.
+         *
+         * @return uint64_t Bytes written since construction
+         */
+        uint64_t getBytesWritten() const;
+
+        /**
+         * @brief Get the error of the last failed write
+         *
+         * @return int errno of the last failed write since open(), e.g. ENOSPC
+         *         or EIO, or 0 if none failed
+         */
+        int getLastError() const;
+
+        /**
+         * @brief Append one record or a batch of whole records
+         *
+         * Data that fits the atomic limit is emitted with exactly one write call.
+         * Larger data is handled according to the oversize policy.
+         *
+         * @param data Bytes to append
+         * @param size Number of bytes
+         * @return bool True if every byte was written, false on error
+         */
+        bool write(const char *data, size_t size);
+
+        /**
+         * @brief Append one record or a batch of whole records
+         *
+         * @param data Bytes to append
+         * @return bool True if every byte was written, false on error
+         */
+        bool write(const std::string &data);
+
+        /**
+         * @brief Set the largest size emitted with a single write call
+         *
+         * Off by default: records are written in full with as many calls as the
+         * kernel needs. Processes sharing one O_APPEND file should set 4096
+         * (PIPE_BUF on Linux), the size POSIX guarantees to be atomic for pipes
+         * and that local file systems honour for O_APPEND; larger records then
+         * follow the oversize policy.
+         *
+         * @param bytes Atomic write limit in bytes (minimum 64), 0 for no limit
+         */
+        void setAtomicLimit(size_t bytes);
+
+        /**
+         * @brief Get the largest size emitted with a single write call
+         *
+         * @return size_t Atomic write limit in bytes, 0 if there is none
+         */
+        size_t getAtomicLimit() const;
+
+        /**
+         * @brief Set how records larger than the atomic limit are written
+         *
+         * @param policy Oversize policy
+         */
+        void setOversizePolicy(EOversize policy);
+
+        /**
+         * @brief Get the oversize policy
+         *
+         * @return EOversize Current oversize policy
+         */
+        EOversize getOversizePolicy() const;
+
+        /**
+         * @brief Set the page-cache policy used by the next open()
+         *
+         * DIRECT falls back to DONTNEED on file systems without O_DIRECT
+         * support, and both fall back to NORMAL where the platform lacks the
+         * required calls (everything but Linux).
+         *
+         * @param mode Requested cache mode
+         */
+        void setCacheMode(ECacheMode mode);
+
+        /**
+         * @brief Get the page-cache policy
+         *
+         * @return ECacheMode Mode in effect for the open file, or the requested mode when closed
+         */
+        ECacheMode getCacheMode() const;
+
+        /**
+         * @brief Reserve disk space ahead of the write position
+         *
+         * Space is reserved with fallocate(FALLOC_FL_KEEP_SIZE) in steps of this
+         * size, so the file length only grows as records are written while the
+         * blocks stay contiguous and ENOSPC surfaces early. Linux only.
+         *
+         * @param bytes Size of each reservation; 0 (default) disables preallocation
+         */
+        void setPreallocation(size_t bytes);
+
+        /**
+         * @brief Get the preallocation step
+         *
+         * @return size_t Size of each reservation in bytes, 0 if disabled
+         */
+        size_t getPreallocation() const;
+
+        /**
+         * @brief Set the on-disk layout of records
+         *
+         * An open file that is still empty gets the COMPRESSED header at once.
+         *
+         * @param format TEXT (default), FRAMED, COMPRESSED or BINARY
+         */
+        void setFormat(EFileFormat format);
+
+        /**
+         * @brief Get the on-disk layout of records
+         *
+         * @return EFileFormat Current format
+         */
+        EFileFormat getFormat() const;
+
+        /**
+         * @brief Set the zstd dictionary and level of COMPRESSED format
+         *
+         * Takes effect for the next write; files opened afterwards record the
+         * dictionary id in their header.
+         *
+         * @param dictionary Trained dictionary bytes, empty for none
+         * @param level zstd compression level
+         * @return bool False if zstd is unavailable or the dictionary is not a trained one
+         */
+        bool setDictionary(const std::string &dictionary, int level = 3);
+
+        /**
+         * @brief Get the id of the compression dictionary
+         *
+         * @return uint32_t Dictionary id, 0 without one
+         */
+        uint32_t getDictionaryId() const;
+
+        /**
+         * @brief Forget the descriptor without finishing the file
+         *
+         * Used by a forked child for a file the parent keeps writing: the file
+         * is neither truncated nor dropped from the page cache.
+         */
+        void release();
+
+        /**
+         * @brief Switch to a new file at a path without a moment of being closed
+         *
+         * Opens the path first and then moves the new file onto the existing
+         * descriptor number, so writes and signal handlers never see a closed
+         * descriptor. If the path cannot be opened, the old file stays in use.
+         *
+         * @param filePath Path to open, usually the current one after rotation
+         * @return bool True if the sink now writes to the file at filePath
+         */
+        bool reopen(const std::string &filePath);
+
+        /**
+         * @brief Check whether a path still names the open file
+         *
+         * Compares device and inode numbers, so a file renamed away by log
+         * rotation is detected. Always true on Windows.
+         *
+         * @param filePath Path the file was opened with
+         * @return bool False if the path is missing or names another file
+         */
+        bool isCurrent(const std::string &filePath) const;
+
+    private:
+        /**
+         * @brief Write all bytes, retrying on EINTR and short writes
+         *
+         * @param data Bytes to write
+         * @param size Number of bytes
+         * @return bool True if every byte was written
+         */
+        bool writeAll(const char *data, size_t size);
+
+        /**
+         * @brief Write data larger than the atomic limit per the oversize policy
+         *
+         * @param data Bytes to write
+         * @param size Number of bytes
+         * @return bool True if every emitted byte was written
+         */
+        bool writeOversize(const char *data, size_t size);
+
+        /**
+         * @brief Encode standalone records into blocks and write one frame per block
+         *
+         * @param data Standalone records
+         * @param size Number of bytes
+         * @return bool True if every frame was written
+         */
+        bool writeBinary(const char *data, size_t size);
+
+        /**
+         * @brief Write bytes as they are, retrying short writes
+         *
+         * @param data Bytes to write
+         * @param size Number of bytes
+         * @return bool True if every byte was written
+         */
+        bool writeRaw(const char *data, size_t size);
+
+        /**
+         * @brief Write data with the partial last block at an aligned offset (DIRECT)
+         *
+         * @param data Bytes to write
+         * @param size Number of bytes
+         * @return bool True if every byte was written
+         */
+        bool writeDirect(const char *data, size_t size);
+
+        /**
+         * @brief Preallocate and drop pages after the file has grown to end
+         *
+         * @param end Current end of the file
+         */
+        void afterWrite(uint64_t end);
+
+        /**
+         * @brief Write one frame around a payload
+         *
+         * @param payload Frame payload
+         * @param size Payload length, at most kMaxFramePayload
+         * @return bool True if the frame was written
+         */
+        bool writeFrame(const char *payload, size_t size);
+
+        /**
+         * @brief Start an empty COMPRESSED file with its header frame
+         */
+        void writeHeader();
+
+        /**
+         * @brief Truncate DIRECT padding or drop DONTNEED pages before the file is left
+         */
+        void finish();
+
+        /**
+         * @brief Release the DIRECT staging buffer
+         */
+        void freeStaging();
+
+        int fd = -1;                                  ///< Descriptor, -1 when closed
+        int lastError = 0;                            ///< errno of the last failed write, 0 if none
+        uint64_t bytesWritten = 0;                    ///< Bytes written to files since construction
+        size_t atomicLimit = 0;                       ///< Largest size emitted with one write call, 0 for none
+        EOversize oversizePolicy = EOversize::SPLIT_LINES; ///< Handling of records over the limit
+        EFileFormat format = EFileFormat::TEXT;       ///< On-disk layout
+        std::string frame;                            ///< FRAMED: header and payload of the current write
+        Compressor compressor;                        ///< COMPRESSED: zstd context and dictionary
+        std::string compressed;                       ///< COMPRESSED: payload of the current write
+        BinaryEncoder encoder;                        ///< BINARY: stream state of the file
+        std::string block;                            ///< BINARY: block being written
+        ECacheMode cacheMode = ECacheMode::NORMAL;    ///< Mode requested for the next open()
+        ECacheMode activeMode = ECacheMode::NORMAL;   ///< Mode of the open file
+        size_t preallocateBytes = 0;                  ///< Reservation step, 0 when disabled
+        uint64_t reservedEnd = 0;                     ///< End of the space reserved so far
+        uint64_t writebackEnd = 0;                    ///< DONTNEED: write-back started up to here
+        uint64_t droppedEnd = 0;                      ///< DONTNEED: dropped from the page cache up to here
+        char *staging = nullptr;                      ///< DIRECT: aligned buffer starting with the partial last block
+        size_t stagingCapacity = 0;                   ///< DIRECT: size of staging
+        size_t stagingFill = 0;                       ///< DIRECT: bytes of staging that hold data
+        uint64_t stagingOffset = 0;                   ///< DIRECT: file offset of staging[0], block-aligned
+    };
+}
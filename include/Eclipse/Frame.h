@@ -0,0 +1,105 @@
+/**
+ * @file Frame.h
+ * @brief Eclipse Logging Library - CRC32C-checked record frames
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Eclipse
+{
+    /**
+     * @brief On-disk layout of a log file
+     */
+    enum class EFileFormat
+    {
+        TEXT,       ///< Plain text records (default)
+        FRAMED,     ///< Every write wrapped in a frame with length and CRC32C, read back with LogReader
+        COMPRESSED, ///< FRAMED with zstd-compressed payloads, after a header frame naming the dictionary
+        BINARY      ///< FRAMED with records as delta and dictionary encoded fields, see BinaryRecord.h
+    };
+
+    /**
+     * @brief Frame layout, all fields little-endian
+     *
+     * | Offset | Size | Field                                        |
+     * |--------|------|----------------------------------------------|
+     * | 0      | 4    | kFrameMagic (bytes EC 1F 5E A1)              |
+     * | 4      | 4    | Payload length                               |
+     * | 8      | 4    | CRC32C of the length field and the payload   |
+     * | 12     | n    | Payload: one text record or a batch of them  |
+     *
+     * The magic bytes never occur in UTF-8 text, so a reader that meets a
+     * damaged frame resumes at the next occurrence of the magic.
+     */
+    constexpr uint32_t kFrameMagic = 0xA15E1FECu;
+    constexpr size_t kFrameHeaderSize = 12;              ///< Bytes before the payload
+    constexpr uint32_t kMaxFramePayload = 64u << 20;     ///< Longer lengths mark a damaged header
+
+    /**
+     * @brief Compute or extend a CRC32C (Castagnoli) checksum
+     *
+     * Uses the SSE4.2 or ARMv8 CRC32 instructions when the CPU has them and a
+     * slicing-by-8 table otherwise. Async-signal-safe.
+     *
+     * @param data Bytes to checksum
+     * @param size Number of bytes
+     * @param crc Checksum of the preceding bytes, 0 to start
+     * @return uint32_t Checksum of everything so far
+     */
+    uint32_t crc32c(const void *data, size_t size, uint32_t crc = 0);
+
+    /**
+     * @brief Check whether crc32c() uses CPU instructions
+     *
+     * @return bool True if hardware CRC32C is in use
+     */
+    bool crc32cAccelerated();
+
+    /**
+     * @brief Write the header of a frame for a payload
+     *
+     * Async-signal-safe.
+     *
+     * @param out Buffer of at least kFrameHeaderSize bytes
+     * @param payload Payload the header describes
+     * @param size Payload length, at most kMaxFramePayload
+     */
+    void encodeFrameHeader(char *out, const char *payload, uint32_t size);
+
+    /**
+     * @brief Payload of the frame that starts a COMPRESSED file, little-endian
+     *
+     * | Offset | Size | Field                                   |
+     * |--------|------|-----------------------------------------|
+     * | 0      | 8    | Tag: a NUL byte, then "ECLZSTD"         |
+     * | 8      | 4    | zstd dictionary id, 0 without one       |
+     *
+     * Readers use the id to pick the dictionary before decoding. Every
+     * compressed payload also carries the id in its own zstd frame header.
+     */
+    constexpr size_t kCompressionHeaderSize = 12;
+
+    /**
+     * @brief Write the payload of a COMPRESSED file header frame
+     *
+     * @param out Buffer of at least kCompressionHeaderSize bytes
+     * @param dictionaryId zstd dictionary id, 0 without one
+     */
+    void encodeCompressionHeader(char *out, uint32_t dictionaryId);
+
+    /**
+     * @brief Recognise the payload of a COMPRESSED file header frame
+     *
+     * @param payload Frame payload
+     * @param size Payload length
+     * @param dictionaryId Receives the dictionary id
+     * @return bool True if the payload is a header
+     */
+    bool decodeCompressionHeader(const char *payload, size_t size, uint32_t &dictionaryId);
+}
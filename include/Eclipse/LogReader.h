@@ -0,0 +1,213 @@
+/**
+ * @file LogReader.h
+ * @brief Eclipse Logging Library - Recovering reader for framed log files
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "BinaryRecord.h"
+#include "Compression.h"
+#include "Frame.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Sequential reader for log files written with EFileFormat::FRAMED, COMPRESSED or BINARY
+     *
+     * Returns the payload of every frame whose CRC matches. A damaged frame is
+     * skipped by resuming at the next frame magic, so only the damaged bytes are
+     * scanned. An incomplete frame at the end of the file, as left by a crash or
+     * a write still in progress, ends the read without being consumed: calling
+     * next() again after the file has grown picks it up.
+     *
+     * Compressed payloads are decompressed, which needs the dictionary named
+     * by the file header (see getDictionaryId()) to be set first. Payloads that
+     * cannot be decompressed are skipped and counted. BINARY blocks are decoded
+     * into their records, which getRecords() returns exactly as they were
+     * logged and next() renders as text. A block that follows a damaged one
+     * of its stream is skipped and counted until the stream's next reset block.
+     *
+     * @note Not thread-safe.
+     */
+    class LogReader
+    {
+    public:
+        /**
+         * @brief Open a framed log file
+         *
+         * @param path File to read
+         * @return bool True if the file could be opened
+         */
+        bool open(const std::string &path);
+
+        /**
+         * @brief Close the file and reset the counters
+         */
+        void close();
+
+        /**
+         * @brief Read the next valid frame
+         *
+         * @param payload Receives the payload: one record, or a batch of records
+         *                written together by a buffered write mode
+         * @return bool True if a frame was read, false at the end of the valid data
+         */
+        bool next(std::string &payload);
+
+        /**
+         * @brief Continue reading at a frame found earlier
+         *
+         * Forgets the state of BINARY streams, so a BINARY block decodes only
+         * when reading starts at its getSyncOffset(). The counters are kept.
+         *
+         * @param offset File offset of a frame
+         * @return bool False if the file is not open or the offset cannot be reached
+         */
+        bool seek(uint64_t offset);
+
+        /**
+         * @brief Set how much is read from the file at a time
+         *
+         * @param bytes Read size; small values suit reading a few frames after seek()
+         */
+        void setReadAhead(size_t bytes);
+
+        /**
+         * @brief Set the dictionary for compressed payloads
+         *
+         * @param dictionary Dictionary bytes, as written by eclipse-train-dict
+         * @return bool False if zstd is unavailable or the dictionary is not a trained one
+         */
+        bool setDictionary(const std::string &dictionary);
+
+        /**
+         * @brief Set the timestamp layout next() renders BINARY records with
+         *
+         * @param format DEFAULT (default) or ISO8601, in local time
+         */
+        void setTimestampFormat(ETimestampFormat format);
+
+        /**
+         * @brief Set whether next() renders the records of BINARY blocks as text
+         *
+         * Readers that take getRecords() turn rendering off and leave the
+         * payload of BINARY blocks empty, so records are not formatted twice.
+         *
+         * @param render True (default) to render
+         */
+        void setRenderRecords(bool render);
+
+        /**
+         * @brief Get the records of the BINARY block last returned by next()
+         *
+         * @return const std::vector<BinaryRecord>& Decoded records; empty for text payloads
+         */
+        const std::vector<BinaryRecord> &getRecords() const;
+
+        /**
+         * @brief Get the dictionary id recorded in the file header
+         *
+         * @return uint32_t Id from the last header frame read, 0 if none was read
+         */
+        uint32_t getDictionaryId() const;
+
+        /**
+         * @brief Get the number of intact frames whose payload could not be decompressed or decoded
+         *
+         * @return uint64_t Frames skipped for a missing dictionary, without zstd, or
+         *         BINARY blocks that could not be decoded
+         */
+        uint64_t getUndecodedFrames() const;
+
+        /**
+         * @brief Get the number of frames read
+         *
+         * @return uint64_t Valid frames returned by next()
+         */
+        uint64_t getFrameCount() const;
+
+        /**
+         * @brief Get the number of damaged bytes skipped between valid frames
+         *
+         * @return uint64_t Bytes skipped
+         */
+        uint64_t getCorruptBytes() const;
+
+        /**
+         * @brief Get the size of the incomplete data after the last valid frame
+         *
+         * @return uint64_t Bytes left unread when next() last returned false
+         */
+        uint64_t getTornBytes() const;
+
+        /**
+         * @brief Get the offset just past the last frame read
+         *
+         * Truncating the file here removes a torn tail.
+         *
+         * @return uint64_t File offset
+         */
+        uint64_t getValidEnd() const;
+
+        /**
+         * @brief Get the offset of the frame next() returned last
+         *
+         * @return uint64_t File offset
+         */
+        uint64_t getFrameOffset() const;
+
+        /**
+         * @brief Get where reading must start to decode the frame next() returned last
+         *
+         * That is the frame itself, or for a BINARY block the last reset block
+         * of its stream.
+         *
+         * @return uint64_t File offset to pass to seek()
+         */
+        uint64_t getSyncOffset() const;
+
+    private:
+        /**
+         * @brief Make at least needed unread bytes available in the window
+         *
+         * @param needed Bytes required after the read position
+         * @return bool False if the file ends first
+         */
+        bool fill(size_t needed);
+
+        /**
+         * @brief Move the read position to the next frame magic
+         *
+         * @return bool False if no magic follows; the position is then unchanged
+         */
+        bool resync();
+
+        std::ifstream file;        ///< File being read
+        std::string window;        ///< Bytes read from the file and not yet discarded
+        size_t position = 0;       ///< Read position within window
+        uint64_t windowOffset = 0; ///< File offset of window[0]
+        uint64_t frames = 0;       ///< Frames returned
+        uint64_t corruptBytes = 0; ///< Damaged bytes skipped
+        uint64_t tornBytes = 0;    ///< Incomplete bytes at the end
+        Compressor decoder;        ///< Decompresses COMPRESSED payloads
+        uint32_t dictionaryId = 0; ///< Dictionary id from the file header
+        uint64_t undecoded = 0;    ///< Intact frames that could not be decompressed or decoded
+        BinaryDecoder binary;      ///< Decodes BINARY blocks
+        std::vector<BinaryRecord> records; ///< Records of the last BINARY block
+        ETimestampFormat timestampFormat = ETimestampFormat::DEFAULT; ///< Layout of rendered BINARY records
+        bool renderRecords = true; ///< next() renders BINARY records into the payload
+        uint64_t frameOffset = 0;  ///< Offset of the last frame returned
+        uint64_t syncOffset = 0;   ///< Offset to seek to for decoding that frame
+        std::unordered_map<uint64_t, uint64_t> resetOffsets; ///< Last reset block of every BINARY stream
+        size_t readAhead = 1024 * 1024; ///< Bytes read from the file at a time
+    };
+}
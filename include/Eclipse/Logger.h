@@ -8,13 +8,26 @@
 
 #pragma once
 
+#include "Clock.h"
+#include "FileSink.h"
+#include "SegmentStore.h"
+#include "SharedLog.h"
+#include "Timestamp.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
-#include <fstream>
 
 namespace Eclipse
 {
+    class Backend;
+    class RealtimeRing;
+    struct ThreadBuffer;
+
     /**
      * @brief Enumeration of available logging levels
      *
@@ -44,6 +57,83 @@ namespace Eclipse
         NONE     ///< No output - suppress all log messages
     };
 
+    /**
+     * @brief Enumeration of log file handling in a child process after fork()
+     *
+     * Defines whether a forked child keeps appending to the inherited log file
+     * or switches to a file of its own.
+     */
+    enum class EForkPolicy
+    {
+        SHARE_FILE,    ///< Keep appending to the inherited file (safe with O_APPEND record writes)
+        REOPEN_PER_PID ///< Reopen as "<name>.<pid><ext>" in the child, e.g. app.log -> app.4242.log
+    };
+
+    /**
+     * @brief Enumeration of how file output reaches the sink
+     *
+     * Defines whether each record is written as it is logged or collected
+     * in memory and appended in batches.
+     */
+    enum class EWriteMode
+    {
+        IMMEDIATE,       ///< One write per record, serialised on logMutex (default)
+        THREAD_BUFFERED, ///< Format into a per-thread buffer and append whole buffers; no extra thread
+        DOUBLE_BUFFERED  ///< Append to a shared front buffer that the backend thread swaps out and writes
+    };
+
+    /**
+     * @brief Enumeration of where file output goes while the log file cannot be written
+     *
+     * Defines the sink that takes over once a write to the log file or segment
+     * directory fails, e.g. with ENOSPC or EIO, until a retry succeeds.
+     */
+    enum class EFallback
+    {
+        NONE,   ///< Drop file output; file-only records are not even formatted (default)
+        STDERR, ///< Write file output to standard error
+        FILE,   ///< Append file output to an alternate file
+        MEMORY  ///< Keep the newest 1 MiB in memory and write it to the log file once it recovers
+    };
+
+    /**
+     * @brief Write error counters of the log file
+     *
+     * Writes are records in IMMEDIATE mode and batches in the buffered write modes.
+     */
+    struct FileErrorStats
+    {
+        uint64_t failedWrites = 0;   ///< Writes the log file rejected, failed retries included
+        uint64_t fallbackWrites = 0; ///< Writes taken by the fallback sink
+        uint64_t droppedWrites = 0;  ///< Writes lost: no fallback, a failed fallback or a full memory ring
+        uint64_t skippedRecords = 0; ///< File-only records discarded unformatted while waiting for a retry
+        uint64_t recoveries = 0;     ///< Retries that found the log file writable again
+        int lastError = 0;           ///< errno of the last failed write
+        bool failed = false;         ///< Whether the log file is failed now
+    };
+
+    /**
+     * @brief Activity counters of the logger
+     *
+     * Counts since the logger was created, except queuedBytes, which is the
+     * current state.
+     */
+    struct LoggerStats
+    {
+        /// Upper bounds of the sink write latency buckets in nanoseconds; a last bucket takes the rest
+        static constexpr std::array<int64_t, 11> kSinkLatencyBoundsNs = {
+            10000, 50000, 100000, 500000, 1000000, 5000000, 10000000, 50000000, 100000000, 500000000, 1000000000};
+
+        std::array<uint64_t, 5> records{};      ///< Records logged, by level from DEBUG to FATAL
+        uint64_t bufferDrops = 0;               ///< DOUBLE_BUFFERED records dropped because the front buffer was full
+        uint64_t realtimeDrops = 0;             ///< Real-time records dropped because a ring was full
+        size_t queuedBytes = 0;                 ///< Formatted records in the front and thread buffers
+        uint64_t sinkWrites = 0;                ///< Writes to the log file or segment directory
+        std::chrono::nanoseconds sinkWriteTime{0}; ///< Time spent in those writes
+        std::array<uint64_t, kSinkLatencyBoundsNs.size() + 1> sinkLatency{}; ///< Writes per latency bucket
+        FileErrorStats fileErrors;              ///< Write errors and skipped records
+    };
+
     /**
      * @brief Singleton logger class providing thread-safe logging functionality
      *
@@ -59,10 +149,40 @@ namespace Eclipse
         /**
          * @brief Get the singleton instance of the Logger
          *
+         * The instance is created on first use and intentionally never destroyed,
+         * so static destructors can still log. Its teardown point is shutdown(),
+         * which is registered with atexit() and at_quick_exit() on creation.
+         *
          * @return Logger& Reference to the singleton Logger instance
          */
         static Logger &getInstance();
 
+        /**
+         * @brief Drain, flush and close every sink
+         *
+         * Waits for in-flight log calls, drains the embedded shared-log collector,
+         * releases the shared-memory slot and closes the log file. Draining the
+         * backend, the buffers, the collector and the MEMORY fallback shares one
+         * deadline; work not started by then is abandoned and its queued records
+         * are dropped. Runs automatically at exit; calling it again has no effect.
+         *
+         * Records logged after shutdown (e.g. from static destructors) are written
+         * synchronously: the log file, or the last segment of a log directory, is
+         * reopened for each record. Records for a shared-memory log without a local
+         * file, or for a log directory without segments, go to stderr. The segment
+         * manifest does not count records appended after shutdown.
+         *
+         * @param timeout Time allowed for draining queued records; a write in progress is not interrupted
+         */
+        void shutdown(std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+
+        /**
+         * @brief Check whether shutdown() has completed
+         *
+         * @return bool True once the logger only performs direct synchronous writes
+         */
+        bool isShutdown() const;
+
         /**
          * @brief Set the minimum logging level
          *
@@ -89,14 +209,389 @@ namespace Eclipse
          */
         void setLogFile(const std::string &filePath);
 
+        /**
+         * @brief Write file output to a directory of size-capped segments
+         *
+         * Replaces the log file. Segments are named by their first sequence number
+         * and UTC start time and listed in a manifest; the backend thread deletes
+         * the oldest ones every second once the directory exceeds the retention
+         * limits. The format, cache mode and atomic write settings of the log file
+         * apply to every segment. A forked child writes to "<directory>.<pid>".
+         *
+         * @param directory Segment directory, created if needed
+         * @param options Segment size and retention limits
+         * @return bool True if the directory could be opened
+         */
+        bool setLogDirectory(const std::string &directory, const SegmentOptions &options = {});
+
         /**
          * @brief Close the current log file
          *
-         * Closes the log file stream if it's currently open. This is automatically
-         * called when the logger is destroyed.
+         * Closes the log file or segment directory if one is open. This is
+         * automatically called when the logger is destroyed.
          */
         void closeLogFile();
 
+        /**
+         * @brief Reopen the log file at its path, e.g. after logrotate renamed it
+         *
+         * The new file is opened before the old one is let go and takes over the
+         * same descriptor, so no record is lost or written to a closed file and
+         * producers are never blocked for longer than one write. Records still
+         * buffered land in the new file. If the path cannot be opened, logging
+         * continues in the old file.
+         *
+         * @return bool True if the file was reopened; false without a log file,
+         *         for a segment directory, or if the path cannot be opened
+         */
+        bool reopenLogFile();
+
+        /**
+         * @brief Reopen the log file once its path names another file
+         *
+         * The backend thread compares the device and inode of the path with
+         * those of the open file every interval and reopens when they differ or
+         * the path is gone, which covers logrotate's default "create" mode
+         * without a postrotate script. Records are never checked one by one.
+         * "copytruncate" needs no reopen: the file is opened with O_APPEND.
+         *
+         * @param interval Time between checks, 0 to stop checking (default)
+         */
+        void setRotationCheck(std::chrono::milliseconds interval);
+
+        /**
+         * @brief Reopen the log file when a signal arrives, e.g. SIGHUP from a postrotate script
+         *
+         * The handler only sets a flag; the backend thread reopens the file
+         * within a few milliseconds. A handler installed before is still called.
+         *
+         * @param signal Signal number
+         * @return bool True if the handler was installed; always false on Windows
+         */
+        bool reopenOnSignal(int signal);
+
+        /**
+         * @brief Set where file output goes while the log file cannot be written
+         *
+         * After a failed write the log file is left alone until retryDelay has
+         * passed; the next write then retries it. Every failed retry doubles the
+         * delay, up to 64 times retryDelay. Until a retry succeeds, file output
+         * goes to the fallback. With MEMORY, the kept writes go to the log file
+         * ahead of new ones once it recovers. With NONE, file-only records are
+         * discarded before they are formatted. Signal-safe records follow the
+         * STDERR and FILE fallbacks.
+         *
+         * @param fallback NONE (default), STDERR, FILE or MEMORY
+         * @param path Alternate file for FILE, opened on the first failure
+         * @param retryDelay Time before the first retry
+         */
+        void setFallback(EFallback fallback, const std::string &path = "",
+                         std::chrono::milliseconds retryDelay = std::chrono::milliseconds(1000));
+
+        /**
+         * @brief Get the write error counters of the log file
+         *
+         * @return FileErrorStats Counters since the logger was created
+         */
+        FileErrorStats getFileErrorStats() const;
+
+        /**
+         * @brief Get the activity counters of the logger
+         *
+         * @return LoggerStats Records by level, drops, buffered bytes and sink write latency
+         */
+        LoggerStats getStats() const;
+
+        /**
+         * @brief Export the logger's counters and the metric aggregates for Prometheus
+         *
+         * Every interval the backend thread writes getStats() and
+         * Metrics::snapshot() in the Prometheus text exposition format to a
+         * temporary file next to the path and renames it over the path, so the
+         * node_exporter textfile collector never reads a partial file.
+         * shutdown() writes a last one. A forked child stops exporting; the
+         * file keeps the parent's counters.
+         *
+         * @param path File to write, e.g. "/var/lib/node_exporter/textfile/app.prom"; empty to stop
+         * @param interval Time between two writes
+         * @return bool True if the first write succeeded; exporting stops otherwise
+         */
+        bool setPrometheusExport(const std::string &path,
+                                 std::chrono::milliseconds interval = std::chrono::milliseconds(15000));
+
+        /**
+         * @brief Set the largest record size written to the log file in one call
+         *
+         * The log file is opened with O_APPEND. With a limit set, every record is
+         * emitted with a single write() while it fits the limit, so several
+         * processes can append to the same file without interleaving partial
+         * lines; 4096 suits Linux. Without one (the default) records are written
+         * in full with as many calls as needed.
+         *
+         * @param bytes Atomic write limit in bytes, 0 (default) for no limit
+         */
+        void setAtomicWriteLimit(size_t bytes);
+
+        /**
+         * @brief Set how records larger than the atomic write limit are written
+         *
+         * @param policy SPLIT_LINES (default) writes everything, splitting only lines over the
+         *               limit; TRUNCATE cuts the record to the limit and discards the rest
+         */
+        void setOversizePolicy(EOversize policy);
+
+        /**
+         * @brief Keep the log file out of the page cache and preallocate it
+         *
+         * DONTNEED starts write-back of every written MiB and drops the previous
+         * one from the page cache. DIRECT writes aligned blocks with O_DIRECT;
+         * the file then belongs to this process alone, so a forked child always
+         * reopens as "<name>.<pid><ext>" and signal-handler records go to stderr.
+         * Applies to the open log file, which is reopened, and to later files.
+         *
+         * @param mode NORMAL (default), DONTNEED or DIRECT
+         * @param preallocateBytes Reserve disk space in steps of this size, 0 to disable
+         * @return bool True if the mode is in effect; DIRECT falls back to DONTNEED
+         *         on file systems without O_DIRECT, and only NORMAL exists off Linux
+         */
+        bool setFileCacheMode(ECacheMode mode, size_t preallocateBytes = 0);
+
+        /**
+         * @brief Set the on-disk layout of the log file
+         *
+         * FRAMED wraps every record, or every batch in the buffered write modes,
+         * in a frame with its length and a CRC32C. LogReader and eclipse-read
+         * stop at a torn last record instead of returning half a line, and skip
+         * damaged frames. COMPRESSED also compresses each frame with zstd, see
+         * setCompressionDictionary(). BINARY hands the fields of file-only
+         * records to the sink without formatting them as text; the sink writes
+         * them delta and dictionary encoded (see BinaryRecord.h) and LogReader
+         * or eclipse-read turn them back into the same records. Can also be set
+         * with ECLIPSE_FILE_FORMAT in a config file.
+         *
+         * @param format TEXT (default), FRAMED, COMPRESSED or BINARY
+         */
+        void setFileFormat(EFileFormat format);
+
+        /**
+         * @brief Get the on-disk layout of the log file
+         *
+         * @return EFileFormat Current format
+         */
+        EFileFormat getFileFormat() const;
+
+        /**
+         * @brief Compress COMPRESSED log files with a trained zstd dictionary
+         *
+         * A dictionary trained from the program's own logs with eclipse-train-dict
+         * lets even single records and small, frequently flushed batches compress
+         * several times over. Files opened afterwards record the dictionary id in
+         * their header; readers need the same dictionary. Can also be set with
+         * ECLIPSE_COMPRESSION_DICTIONARY in a config file.
+         *
+         * @param dictionaryPath Dictionary file, empty to compress without one
+         * @param level zstd compression level, 1 (fastest) to 19
+         * @return bool False if the library was built without zstd or the file is
+         *         not a trained dictionary; the previous dictionary stays in use
+         */
+        bool setCompressionDictionary(const std::string &dictionaryPath, int level = 3);
+
+        /**
+         * @brief Set how a forked child handles the log file
+         *
+         * The logger registers pthread_atfork handlers: before fork() it stops its
+         * background threads and takes all of its mutexes, so the child never
+         * inherits a lock held by a thread that no longer exists. The parent
+         * resumes as before; the child gets fresh locks, claims its own slot in an
+         * attached shared-memory segment and applies this policy to the log file.
+         *
+         * @param policy SHARE_FILE (default) or REOPEN_PER_PID
+         */
+        void setForkPolicy(EForkPolicy policy);
+
+        /**
+         * @brief Set how file output reaches the sink
+         *
+         * With THREAD_BUFFERED, file-only records are formatted without taking
+         * logMutex into a buffer owned by the logging thread. The buffer is
+         * appended to the sink with one short fileMutex critical section when it
+         * fills, when its oldest record is older than maxDelay (checked when the
+         * thread logs again), when a WARN or higher record is added, on flush(),
+         * and when the thread exits. No extra thread is started. Records of
+         * different threads reach the file in batch order, not strictly in
+         * timestamp order.
+         *
+         * With DOUBLE_BUFFERED, file-only records are appended to one shared
+         * front buffer under a lock that is never held during I/O. The backend
+         * thread swaps it with the empty back buffer once it holds bufferBytes or
+         * its oldest record is maxDelay old, and writes the full one with a single
+         * large write, so producers never wait on the disk. If the disk falls so
+         * far behind that the front buffer reaches four times bufferBytes, further
+         * records are dropped and the drop is reported in the log.
+         *
+         * @param mode IMMEDIATE (default), THREAD_BUFFERED or DOUBLE_BUFFERED
+         * @param bufferBytes Buffer size that triggers a write
+         * @param maxDelay Longest time a record waits in a buffer (THREAD_BUFFERED:
+         *                 while its thread keeps logging)
+         */
+        void setWriteMode(EWriteMode mode, size_t bufferBytes = 64 * 1024,
+                          std::chrono::milliseconds maxDelay = std::chrono::milliseconds(200));
+
+        /**
+         * @brief Get how file output reaches the sink
+         *
+         * @return EWriteMode Current write mode
+         */
+        EWriteMode getWriteMode() const;
+
+        /**
+         * @brief Write every buffered record to the sink
+         *
+         * Writes each thread's buffer and the shared front buffer. Called
+         * automatically when the log file changes, before fork() and on shutdown.
+         * Has no effect in IMMEDIATE mode.
+         */
+        void flush();
+
+        /**
+         * @brief Route file output into a shared-memory log segment
+         *
+         * Once attached, records destined for the file are enqueued into this
+         * process's slot of the segment instead of being written to the local log
+         * file. A collector (embedded via startCollector() or the standalone
+         * eclipse-collectord) merges all processes into one file, so many
+         * processes can share a log without file-level locking.
+         *
+         * @param name Segment name as passed to shm_open (e.g. "/eclipse")
+         * @return bool True if the segment exists and a slot was claimed, false otherwise
+         */
+        bool attachSharedLog(const std::string &name);
+
+        /**
+         * @brief Stop routing file output into the shared-memory segment
+         *
+         * Releases this process's slot. File output reverts to the local log file.
+         */
+        void detachSharedLog();
+
+        /**
+         * @brief Run the shared-log collector inside this process
+         *
+         * Creates the segment if needed and starts a background thread that merges
+         * every producer's records into outputPath. Call attachSharedLog() as well
+         * if this process should also log into the segment.
+         *
+         * @param name Segment name as passed to shm_open (e.g. "/eclipse")
+         * @param outputPath File that receives the merged log
+         * @param options Segment geometry used when the segment is created
+         * @return bool True if the collector is running, false otherwise
+         */
+        bool startCollector(const std::string &name, const std::string &outputPath,
+                            const SharedLogOptions &options = {});
+
+        /**
+         * @brief Stop the embedded collector after a final drain
+         *
+         * @param unlinkSegment Also remove the segment name so no new producer can attach
+         */
+        void stopCollector(bool unlinkSegment = false);
+
+        /**
+         * @brief Register the calling thread as a real-time producer
+         *
+         * Allocates and prefaults a ring for this thread and starts the backend
+         * thread that drains it. Afterwards every ECLIPSE_* call on this thread
+         * does bounded work into the ring without system calls, locks or
+         * allocation; records are formatted and written on the backend thread.
+         * Details must be integers, floating-point values, characters or strings
+         * to be captured; other types are logged as "(unsupported)". When the
+         * ring is full, records are dropped and the drop is reported later.
+         *
+         * @param ringBytes Ring capacity, rounded up to a power of two
+         * @return bool True if the thread is registered, false after shutdown
+         */
+        bool registerRealtimeThread(size_t ringBytes = 1 << 20);
+
+        /**
+         * @brief Return the calling thread to the regular logging path
+         *
+         * Records already queued are still written. Threads are unregistered
+         * automatically when they exit.
+         */
+        void unregisterRealtimeThread();
+
+        /**
+         * @brief Set how often ECLIPSE_COUNTER and ECLIPSE_HISTOGRAM aggregates are logged
+         *
+         * Every interval the backend thread logs one INFO record per metric
+         * updated since the last one, tagged "Metrics" with the metric name as
+         * message and details "type=", "count=", "sum=" and, for histograms,
+         * "min=", "max=", "p50=", "p90=" and "p99=". shutdown() logs what is
+         * left. See Metrics.
+         *
+         * @param interval Time between summaries (default 10 s), 0 to stop logging them
+         */
+        void setMetricsInterval(std::chrono::milliseconds interval);
+
+        /**
+         * @brief Select how record timestamps are read
+         *
+         * With TSC, producers only execute rdtsc and ticks are converted to
+         * wall-clock time with a mapping that the backend thread recalibrates
+         * against CLOCK_REALTIME every second. Real-time threads defer the
+         * conversion to the backend entirely. Selecting TSC blocks for about
+         * 10 ms of initial calibration. COARSE trades resolution (one scheduler
+         * tick) for a cheaper read, and MANUAL stamps the time set with
+         * setManualTime() so output is reproducible.
+         *
+         * The source can also be chosen when the logger is created, through the
+         * ECLIPSE_CLOCK_SOURCE environment variable, or with the
+         * ECLIPSE_CLOCK_SOURCE key of loadConfig().
+         *
+         * @param source REALTIME (default), COARSE, TSC or MANUAL
+         * @return bool True if the source is in use; false if it is unavailable,
+         *              in which case CLOCK_REALTIME is used instead
+         */
+        bool setClockSource(EClockSource source);
+
+        /**
+         * @brief Get the timestamp source in use
+         *
+         * @return EClockSource Current source
+         */
+        EClockSource getClockSource() const;
+
+        /**
+         * @brief Set the time stamped on records while the MANUAL source is in use
+         *
+         * @param time Time to stamp
+         */
+        void setManualTime(std::chrono::system_clock::time_point time);
+
+        /**
+         * @brief Move the MANUAL source's time forward
+         *
+         * @param delta Amount to advance
+         */
+        void advanceManualTime(std::chrono::nanoseconds delta);
+
+        /**
+         * @brief Select the timestamp layout of records
+         *
+         * Can also be set with the ECLIPSE_TIMESTAMP_FORMAT key of loadConfig().
+         *
+         * @param format DEFAULT ("2025-01-02 03:04:05") or ISO8601
+         *               ("2025-01-02T03:04:05.123456+01:00")
+         */
+        void setTimestampFormat(ETimestampFormat format);
+
+        /**
+         * @brief Get the timestamp layout of records
+         *
+         * @return ETimestampFormat Current layout
+         */
+        ETimestampFormat getTimestampFormat() const;
+
         /**
          * @brief Set the output destination for log messages
          *
@@ -164,7 +659,7 @@ namespace Eclipse
         /**
          * @brief Get current timestamp as formatted string
          *
-         * @return std::string Current timestamp in a readable format
+         * @return std::string Current timestamp from the selected clock source
          */
         std::string getTimestamp() const;
 
@@ -179,11 +674,251 @@ namespace Eclipse
         /**
          * @brief Destructor (defaulted)
          *
-         * Automatically closes log files and cleans up resources.
+         * Never runs: the singleton outlives static destructors by design and
+         * releases its resources in shutdown() instead.
          */
         ~Logger() = default;
 
-        static Logger *instance; ///< Singleton instance pointer
+        friend class SignalSafeLog;
+        friend class RealtimeLog;
+        friend class Metrics;
+        friend struct ThreadBuffer;
+
+        static Logger *instance; ///< Singleton instance pointer, published before any handler can run
+
+        /**
+         * @brief Publish the log file descriptor for the signal-safe path
+         *
+         * Must be called with fileMutex held whenever the log file changes.
+         */
+        void publishSignalState();
+
+        /**
+         * @brief Stop the signal-safe path from writing to the log file
+         *
+         * Must be called with fileMutex held before the published descriptor is
+         * closed, so a handler never writes to a descriptor that was closed or
+         * reused; publishSignalState() hands out the new one afterwards.
+         */
+        void withdrawSignalFile();
+
+        /**
+         * @brief Recompute the UTC offset used by the signal-safe path
+         *
+         * Called by publishSignalState() and every minute by the backend, so
+         * signal-path timestamps follow daylight-saving changes.
+         */
+        void refreshUtcOffset();
+
+        /**
+         * @brief Format a record and write it to every configured destination
+         *
+         * @param level The severity level of the message
+         * @param tag A tag or category for the message
+         * @param msg The main log message
+         * @param details Additional details
+         * @param trace Trace information
+         * @param time Time the record was produced
+         */
+        void emitRecord(ELevel level, const std::string &tag, const std::string &msg,
+                        const std::vector<std::string> &details, const std::string &trace,
+                        std::chrono::system_clock::time_point time);
+
+        /**
+         * @brief Render a record in the text layout, appending to a string
+         *
+         * Writes the timestamp straight into the output, so a record costs no
+         * allocation beyond the growth of out.
+         *
+         * @param level The severity level of the message
+         * @param tag A tag or category for the message
+         * @param msg The main log message
+         * @param details Additional details
+         * @param trace Trace information
+         * @param time Time the record was produced
+         * @param colours Whether to include ANSI colour codes
+         * @param out Receives the text, appended
+         */
+        void appendRecordText(ELevel level, const std::string &tag, const std::string &msg,
+                              const std::vector<std::string> &details, const std::string &trace,
+                              std::chrono::system_clock::time_point time, bool colours, std::string &out) const;
+
+        /**
+         * @brief Write formatted file output to the shared log, the log file or the post-shutdown fallback
+         *
+         * @param fileOutput Records without colour codes
+         * @note Requires fileMutex
+         */
+        void writeFileOutput(const std::string &fileOutput);
+
+        /**
+         * @brief Write to the log file or segment directory, switching to the fallback on failure
+         *
+         * @param fileOutput Records without colour codes
+         * @note Requires fileMutex
+         */
+        void writeLogFile(const std::string &fileOutput);
+
+        /**
+         * @brief Write to the log file or segment directory once
+         *
+         * @param data Records without colour codes
+         * @return bool True if every byte was written
+         * @note Requires fileMutex
+         */
+        bool writeToFile(const std::string &data);
+
+        /**
+         * @brief Hand file output to the fallback sink
+         *
+         * @param fileOutput Records without colour codes
+         * @note Requires fileMutex
+         */
+        void writeFallback(const std::string &fileOutput);
+
+        /**
+         * @brief Write the writes kept by the MEMORY fallback to the log file, oldest first
+         *
+         * @param deadline Time after which the remaining writes stay kept
+         * @return bool True if none are left
+         * @note Requires fileMutex
+         */
+        bool drainFallbackMemory(std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+        /**
+         * @brief Forget a failure of the previous log file
+         *
+         * @note Requires fileMutex
+         */
+        void clearFileFailure();
+
+        /**
+         * @brief Append a record to the calling thread's buffer, writing the buffer when due
+         *
+         * @param level Severity of the record; WARN and above write the buffer at once
+         * @param fileOutput Record without colour codes
+         */
+        void bufferRecord(ELevel level, const std::string &fileOutput);
+
+        /**
+         * @brief Write a thread buffer to the sink and empty it
+         *
+         * @param buffer Buffer to write
+         * @note Requires buffer.mutex
+         */
+        void flushThreadBuffer(ThreadBuffer &buffer);
+
+        /**
+         * @brief Write every thread buffer and the front buffer until the deadline passes
+         *
+         * Buffers not written by the deadline are emptied; their records are dropped.
+         *
+         * @param deadline Time after which no further buffer is written
+         */
+        void flushUntil(std::chrono::steady_clock::time_point deadline);
+
+        /**
+         * @brief Write and unregister the buffer of an exiting thread
+         *
+         * @param buffer Buffer of the exiting thread
+         */
+        void releaseThreadBuffer(ThreadBuffer &buffer);
+
+        /**
+         * @brief Append a record to the shared front buffer
+         *
+         * @param fileOutput Record without colour codes
+         * @return bool False if the front buffer is closed and the caller must write directly
+         */
+        bool appendFront(const std::string &fileOutput);
+
+        /**
+         * @brief Swap the front buffer with the back buffer and write it
+         *
+         * Runs on the backend thread when the front buffer is full or old enough,
+         * and synchronously from flush().
+         *
+         * @param force Write even if the front buffer is neither full nor old enough
+         */
+        void writeFrontBuffer(bool force);
+
+        /**
+         * @brief Format a point in time in the selected layout, in local time
+         *
+         * @param time Time to format
+         * @param out Buffer of at least TimestampFormatter::kMaxLength bytes; not NUL-terminated
+         * @return size_t Number of bytes written
+         */
+        size_t formatTimestamp(std::chrono::system_clock::time_point time, char *out) const;
+
+        /**
+         * @brief Backend task: write every queued real-time record
+         */
+        void drainRealtime();
+
+        /**
+         * @brief Backend task: reopen the log file if a signal asked for it or its path moved on
+         */
+        void checkRotation();
+
+        /**
+         * @brief Start the backend thread that logs metric summaries; called for the first metric
+         */
+        void startMetrics();
+
+        /**
+         * @brief Backend task: log the metric summaries once the interval is over
+         *
+         * @param force Log them now, e.g. at shutdown
+         */
+        void emitMetrics(bool force);
+
+        /**
+         * @brief Backend task: write the Prometheus file once the interval is over
+         *
+         * @param force Write it now, e.g. at shutdown
+         */
+        void exportPrometheus(bool force);
+
+        /**
+         * @brief Signal handler installed by reopenOnSignal()
+         *
+         * @param signal Signal number
+         */
+        static void rotationSignalHandler(int signal);
+
+        /**
+         * @brief Create and start the backend thread if it is not running
+         *
+         * Must be called with realtimeMutex held.
+         */
+        void ensureBackend();
+
+        /**
+         * @brief atexit / at_quick_exit handler that runs shutdown()
+         */
+        static void exitHandler();
+
+        /**
+         * @brief pthread_atfork prepare handler
+         *
+         * Stops background threads and acquires every logger mutex.
+         */
+        static void forkPrepare();
+
+        /**
+         * @brief pthread_atfork parent handler
+         *
+         * Releases the mutexes and restarts the background threads.
+         */
+        static void forkParent();
+
+        /**
+         * @brief pthread_atfork child handler
+         *
+         * Releases the mutexes and rebuilds per-process state for the child.
+         */
+        static void forkChild();
 
         /**
          * @brief Get ANSI color code for a logging level
@@ -212,14 +947,86 @@ namespace Eclipse
          */
         bool parseLevel(const std::string &value, ELevel &level) const;
 
-        ELevel currentLevel = ELevel::ECLIPSE_DEBUG; ///< Current minimum logging level
+        /**
+         * @brief Parse string value to timestamp source enum
+         *
+         * @param value String representation of the source
+         * @param source Reference to store the parsed source
+         * @return bool True if parsing was successful, false otherwise
+         */
+        bool parseClockSource(const std::string &value, EClockSource &source) const;
+
+        std::atomic<ELevel> currentLevel{ELevel::ECLIPSE_DEBUG}; ///< Current minimum logging level
         mutable std::mutex logMutex;                 ///< Mutex for thread-safe logging operations
         mutable std::mutex levelMutex;               ///< Mutex for thread-safe level operations
         mutable std::mutex fileMutex;                ///< Mutex for thread-safe file operations
 
-        EOutput outputDestination = EOutput::CONSOLE; ///< Current output destination setting
+        std::atomic<EOutput> outputDestination{EOutput::CONSOLE}; ///< Current output destination setting
         std::string logFilePath;                      ///< Path to the current log file
-        std::ofstream logFileStream;                  ///< File stream for log file output
+        FileSink logFileSink;                         ///< Append-only sink for log file output
+        SegmentStore segmentStore{logFileSink};       ///< Segment directory written through logFileSink, if open
+        bool segmented = false;                       ///< File output goes to segmentStore (guarded by fileMutex)
+        SegmentOptions segmentOptions;                ///< Limits of the segment directory, reused by forked children
+        EFallback fallback = EFallback::NONE;         ///< Sink used while the log file fails (guarded by fileMutex)
+        std::string fallbackPath;                     ///< Alternate file of EFallback::FILE
+        FileSink fallbackSink;                        ///< Alternate file, opened on the first failure
+        std::deque<std::string> fallbackMemory;       ///< EFallback::MEMORY: writes kept for the log file, oldest first
+        size_t fallbackMemoryBytes = 0;               ///< Size of fallbackMemory
+        std::chrono::milliseconds retryDelay{1000};   ///< Delay before the first retry
+        std::chrono::milliseconds retryBackoff{1000}; ///< Current delay, doubled by every failed retry
+        FileErrorStats fileErrors;                    ///< Write error counters (guarded by fileMutex)
+        std::atomic<bool> fileFailed{false};          ///< The log file rejected its last write
+        std::atomic<bool> skipFileRecords{false};     ///< Failed without a fallback; file-only records are skipped
+        std::atomic<int64_t> retryDueNs{0};           ///< steady_clock time of the next retry in nanoseconds
+        std::atomic<uint64_t> skippedRecords{0};      ///< Records discarded by log() while skipFileRecords is set
+        std::unique_ptr<SharedLogWriter> sharedLog;   ///< Shared-memory segment replacing the log file when attached
+        std::unique_ptr<SharedLogCollector> collector; ///< Embedded shared-log collector, if running
+        EForkPolicy forkPolicy = EForkPolicy::SHARE_FILE; ///< Log file handling in forked children
+        bool collectorPaused = false;                 ///< Collector thread was stopped by forkPrepare()
+        std::atomic<bool> shutdownStarted{false};     ///< shutdown() has been entered
+        std::atomic<bool> shutdownComplete{false};    ///< Sinks are closed; records are written directly
+        bool directToStderr = false;                  ///< shutdown() closed a shared log or log directory without a file to reopen
+        std::string shutdownSegmentPath;              ///< Last segment of the log directory closed by shutdown()
+        std::atomic<int> signalFileFd{-1};            ///< Log file descriptor read by the signal-safe path
+        std::atomic<bool> signalFramed{false};        ///< Whether the signal-safe path writes frames to signalFileFd
+        std::atomic<long> utcOffsetSeconds{0};        ///< Local time offset used by the signal-safe path
+        Clock clock;                                  ///< Timestamp source
+        std::atomic<ETimestampFormat> timestampFormat{ETimestampFormat::DEFAULT}; ///< Layout of record timestamps
+        std::atomic<bool> binaryRecords{false};       ///< File output is standalone binary records (BINARY format)
+        std::atomic<uint64_t> recordSequence{0};      ///< Sequence number of the next binary record
+        mutable std::mutex realtimeMutex;             ///< Guards realtimeRings and backend
+        std::vector<std::shared_ptr<RealtimeRing>> realtimeRings; ///< Rings of registered real-time threads
+        std::unique_ptr<Backend> backend;             ///< Background thread draining real-time rings
+        bool backendPaused = false;                   ///< Backend thread was stopped by forkPrepare()
+        std::atomic<EWriteMode> writeMode{EWriteMode::IMMEDIATE}; ///< How file output reaches the sink
+        std::atomic<size_t> bufferLimit{64 * 1024};   ///< Per-thread buffer size that triggers a write
+        std::atomic<std::chrono::milliseconds::rep> bufferDelayMs{200}; ///< Longest wait of a buffered record
+        mutable std::mutex bufferMutex;               ///< Guards threadBuffers; taken before any buffer's mutex
+        std::vector<ThreadBuffer *> threadBuffers;    ///< Buffers of threads that logged in THREAD_BUFFERED mode
+        mutable std::mutex frontMutex;                ///< Guards the front buffer; never held during I/O
+        std::string frontBuffer;                      ///< DOUBLE_BUFFERED records not yet handed to the backend
+        std::chrono::steady_clock::time_point frontOldest; ///< When the first record in frontBuffer was added
+        uint64_t frontDropped = 0;                    ///< Records dropped because the front buffer was full
+        uint64_t bufferDrops = 0;                     ///< frontDropped summed over the logger's life (guarded by frontMutex)
+        bool frontOpen = true;                        ///< Cleared by shutdown(); producers then write directly
+        std::mutex backMutex;                         ///< Guards backBuffer; serialises writers of the front buffer
+        std::string backBuffer;                       ///< Front buffer being written to the sink
+        std::atomic<std::chrono::milliseconds::rep> rotationCheckMs{0}; ///< Interval of the inode check, 0 when off
+        std::atomic<int> rotationSignal{0};           ///< Signal that requests a reopen, 0 when none
+        std::atomic<bool> rotationRequested{false};   ///< Set by the signal handler, cleared by the backend
+        std::chrono::steady_clock::time_point nextRotationCheck; ///< Next inode check (backend thread only)
+        std::atomic<std::chrono::milliseconds::rep> metricsIntervalMs{10000}; ///< Time between metric summaries, 0 when off
+        std::atomic<bool> metricsStarted{false};      ///< A metric was defined; the backend logs summaries
+        std::chrono::steady_clock::time_point nextMetricsEmit; ///< Next metric summaries (backend thread only)
+        std::array<std::atomic<uint64_t>, 5> levelRecords{}; ///< Records logged, by level
+        std::atomic<uint64_t> realtimeDrops{0};       ///< Real-time records dropped because a ring was full
+        uint64_t sinkWrites = 0;                      ///< Writes to the log file (guarded by fileMutex)
+        int64_t sinkWriteNs = 0;                      ///< Time spent in them (guarded by fileMutex)
+        std::array<uint64_t, LoggerStats::kSinkLatencyBoundsNs.size() + 1> sinkLatency{}; ///< Writes per latency bucket (guarded by fileMutex)
+        std::mutex exportMutex;                       ///< Guards the export settings; taken before backMutex
+        std::string exportPath;                       ///< Prometheus file, empty when not exporting
+        std::chrono::milliseconds exportInterval{15000}; ///< Time between two Prometheus files
+        std::chrono::steady_clock::time_point nextExport; ///< Next Prometheus file
     };
 
     /**
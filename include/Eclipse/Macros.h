@@ -9,6 +9,10 @@
 #pragma once
 
 #include "Logger.h"
+#include "Metrics.h"
+#include "Probes.h"
+#include "Realtime.h"
+#include "SignalSafe.h"
 #include <sstream>
 #include <vector>
 #include <string>
@@ -116,6 +120,25 @@ inline void ECLIPSE_ASSERT_IMPL(bool condition, const std::string &tag, const st
     Eclipse::Logger::getInstance().assert(condition, tag, msg, details, trace);
 }
 
+/**
+ * @brief Internal dispatch shared by the level macros
+ *
+ * On a thread registered with Logger::registerRealtimeThread() the record is
+ * encoded into the thread's ring without system calls, locks or allocation.
+ * Every other thread takes the regular path, which fires the call site's
+ * log probe (see Probes.h). Only one branch evaluates its arguments.
+ *
+ * @param level The logging level
+ * @param tag Category or tag for the message
+ * @param msg The main message
+ * @param ... Optional additional details
+ */
+#define ECLIPSE_LOG_DISPATCH(level, tag, msg, ...) \
+    (Eclipse::RealtimeLog::active() \
+         ? Eclipse::RealtimeSite{level, __FILE__, __LINE__, ECLIPSE_FUNC_NAME}.bind(tag, msg)(__VA_ARGS__) \
+         : ECLIPSE_MACRO_IMPL(ECLIPSE_PROBE_CALL_SITE(level, tag), msg, eclipse_make_details_variadic(__VA_ARGS__), \
+                              ETRACE_INFO(), level))
+
 /**
  * @brief Log a debug message with automatic trace information
  *
@@ -132,7 +155,7 @@ inline void ECLIPSE_ASSERT_IMPL(bool condition, const std::string &tag, const st
  * @endcode
  */
 #define ECLIPSE_DEBUG(tag, msg, ...) \
-    ECLIPSE_MACRO_IMPL(tag, msg, eclipse_make_details_variadic(__VA_ARGS__), ETRACE_INFO(), Eclipse::ELevel::ECLIPSE_DEBUG)
+    ECLIPSE_LOG_DISPATCH(Eclipse::ELevel::ECLIPSE_DEBUG, tag, msg, __VA_ARGS__)
 
 /**
  * @brief Log an informational message with automatic trace information
@@ -150,7 +173,7 @@ inline void ECLIPSE_ASSERT_IMPL(bool condition, const std::string &tag, const st
  * @endcode
  */
 #define ECLIPSE_INFO(tag, msg, ...) \
-    ECLIPSE_MACRO_IMPL(tag, msg, eclipse_make_details_variadic(__VA_ARGS__), ETRACE_INFO(), Eclipse::ELevel::ECLIPSE_INFO)
+    ECLIPSE_LOG_DISPATCH(Eclipse::ELevel::ECLIPSE_INFO, tag, msg, __VA_ARGS__)
 
 /**
  * @brief Log a warning message with automatic trace information
@@ -168,7 +191,7 @@ inline void ECLIPSE_ASSERT_IMPL(bool condition, const std::string &tag, const st
  * @endcode
  */
 #define ECLIPSE_WARNING(tag, msg, ...) \
-    ECLIPSE_MACRO_IMPL(tag, msg, eclipse_make_details_variadic(__VA_ARGS__), ETRACE_INFO(), Eclipse::ELevel::ECLIPSE_WARN)
+    ECLIPSE_LOG_DISPATCH(Eclipse::ELevel::ECLIPSE_WARN, tag, msg, __VA_ARGS__)
 
 /**
  * @brief Log an error message with automatic trace information
@@ -186,7 +209,7 @@ inline void ECLIPSE_ASSERT_IMPL(bool condition, const std::string &tag, const st
  * @endcode
  */
 #define ECLIPSE_ERROR(tag, msg, ...) \
-    ECLIPSE_MACRO_IMPL(tag, msg, eclipse_make_details_variadic(__VA_ARGS__), ETRACE_INFO(), Eclipse::ELevel::ECLIPSE_ERROR)
+    ECLIPSE_LOG_DISPATCH(Eclipse::ELevel::ECLIPSE_ERROR, tag, msg, __VA_ARGS__)
 
 /**
  * @brief Log a fatal error message with automatic trace information
@@ -204,7 +227,7 @@ inline void ECLIPSE_ASSERT_IMPL(bool condition, const std::string &tag, const st
  * @endcode
  */
 #define ECLIPSE_FATAL(tag, msg, ...) \
-    ECLIPSE_MACRO_IMPL(tag, msg, eclipse_make_details_variadic(__VA_ARGS__), ETRACE_INFO(), Eclipse::ELevel::ECLIPSE_FATAL)
+    ECLIPSE_LOG_DISPATCH(Eclipse::ELevel::ECLIPSE_FATAL, tag, msg, __VA_ARGS__)
 
 /**
  * @brief Assert a condition and log an error if it fails
@@ -223,4 +246,29 @@ inline void ECLIPSE_ASSERT_IMPL(bool condition, const std::string &tag, const st
  * @endcode
  */
 #define ECLIPSE_ASSERT(condition, tag, msg, ...) \
-    ECLIPSE_ASSERT_IMPL(condition, tag, msg, eclipse_make_details_variadic(__VA_ARGS__), ETRACE_INFO())
\ No newline at end of file
+    (Eclipse::RealtimeLog::active() \
+         ? Eclipse::RealtimeSite{Eclipse::ELevel::ECLIPSE_FATAL, __FILE__, __LINE__, ECLIPSE_FUNC_NAME}.bindIf(!(condition), tag, msg)(__VA_ARGS__) \
+         : ECLIPSE_ASSERT_IMPL(condition, tag, msg, eclipse_make_details_variadic(__VA_ARGS__), ETRACE_INFO()))
+
+/**
+ * @brief Log from inside a signal handler
+ *
+ * Restricted, async-signal-safe variant of the logging macros. Formats the record
+ * into a stack buffer and writes it with write(2), taking no locks and performing
+ * no allocation. Only integers, bools, characters and string literals are
+ * accepted; tag and message must be string literals.
+ *
+ * @param level The logging level (e.g. Eclipse::ELevel::ECLIPSE_WARN)
+ * @param tag Category or tag for the message (string literal)
+ * @param msg The message (string literal)
+ * @param ... Optional details: integers or string literals
+ *
+ * Example usage:
+ * @code
+ * void onTerm(int sig) {
+ *     ECLIPSE_SIGNAL_SAFE_LOG(Eclipse::ELevel::ECLIPSE_WARN, "Signal", "Terminating", sig);
+ * }
+ * @endcode
+ */
+#define ECLIPSE_SIGNAL_SAFE_LOG(level, tag, msg, ...) \
+    Eclipse::SignalSafeSite{level, tag, msg, __FILE__, __LINE__}(__VA_ARGS__)
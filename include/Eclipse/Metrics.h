@@ -0,0 +1,174 @@
+/**
+ * @file Metrics.h
+ * @brief Eclipse Logging Library - Counters and histograms aggregated in process
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Enumeration of metric kinds
+     */
+    enum class EMetricType
+    {
+        COUNTER,  ///< Sum of increments
+        HISTOGRAM ///< Distribution of observed values
+    };
+
+    /**
+     * @brief Aggregate of one metric over a period
+     *
+     * min, max and the percentiles are only meaningful for histograms with a
+     * non-zero count. Percentiles are read from log-linear buckets and are
+     * within about 6% of the exact value.
+     */
+    struct MetricSummary
+    {
+        std::string name;                         ///< Name given to the macro
+        EMetricType type = EMetricType::COUNTER;  ///< Kind of metric
+        uint64_t count = 0;                       ///< Updates: increments or observations
+        double sum = 0;                           ///< Sum of increments or observed values
+        double min = 0;                           ///< Smallest observed value
+        double max = 0;                           ///< Largest observed value
+        double p50 = 0;                           ///< Median observed value
+        double p90 = 0;                           ///< 90th percentile of the observed values
+        double p99 = 0;                           ///< 99th percentile of the observed values
+    };
+
+    /**
+     * @brief Process-wide registry behind ECLIPSE_COUNTER and ECLIPSE_HISTOGRAM
+     *
+     * Every thread updates a shard of its own, so an update only takes an
+     * uncontended mutex and never formats or writes anything. collect() and
+     * snapshot() merge the shards; a thread's shard is merged when it exits.
+     * The logger's backend thread turns collect() into one summary record per
+     * metric every interval, see Logger::setMetricsInterval().
+     *
+     * @note All functions are thread-safe.
+     */
+    class Metrics
+    {
+    public:
+        static constexpr size_t kInvalidId = static_cast<size_t>(-1); ///< Id whose updates are ignored
+
+        /**
+         * @brief Get the id of a metric, creating it on first use
+         *
+         * The first metric starts the logger's backend thread, which emits the
+         * summaries. A name keeps the kind it was first defined with; defining
+         * it again with the other kind logs a warning and yields kInvalidId.
+         *
+         * @param name Metric name, e.g. "batch_size"
+         * @param type Kind of metric
+         * @return size_t Id passed to count() or observe(), kInvalidId on a kind mismatch
+         */
+        static size_t define(const std::string &name, EMetricType type);
+
+        /**
+         * @brief Add to a counter
+         *
+         * @param id Id of a COUNTER; kInvalidId is ignored
+         * @param n Increment
+         */
+        static void count(size_t id, double n);
+
+        /**
+         * @brief Record a value in a histogram
+         *
+         * @param id Id of a HISTOGRAM; kInvalidId is ignored
+         * @param value Observed value; values below 2^-16, NaN included, share the lowest bucket
+         */
+        static void observe(size_t id, double value);
+
+        /**
+         * @brief Take the aggregates since the last collect()
+         *
+         * @return std::vector<MetricSummary> Metrics updated since then, in definition order
+         */
+        static std::vector<MetricSummary> collect();
+
+        /**
+         * @brief Get the aggregates since the process started, without resetting anything
+         *
+         * @return std::vector<MetricSummary> Every defined metric, in definition order
+         */
+        static std::vector<MetricSummary> snapshot();
+
+        /**
+         * @brief Format a metric value without losing integer precision
+         *
+         * @param value Value to format
+         * @return std::string Shortest form with up to 15 significant digits, e.g. "12345678" or "0.25"
+         */
+        static std::string formatValue(double value);
+
+    private:
+        friend class Logger;
+
+        /**
+         * @brief pthread_atfork prepare handler, run by Logger::forkPrepare()
+         */
+        static void forkPrepare();
+
+        /**
+         * @brief pthread_atfork parent handler, run by Logger::forkParent()
+         */
+        static void forkParent();
+
+        /**
+         * @brief pthread_atfork child handler: the aggregates so far belong to the parent
+         */
+        static void forkChild();
+    };
+}
+
+/**
+ * @brief Add to a counter instead of logging a line per event
+ *
+ * The name is looked up once per call site. The backend logs the count and
+ * sum every metrics interval.
+ *
+ * @param name Metric name (the same at every call of this site)
+ * @param n Increment
+ *
+ * Example usage:
+ * @code
+ * ECLIPSE_COUNTER("batches_processed", 1);
+ * @endcode
+ */
+#define ECLIPSE_COUNTER(name, n) \
+    do \
+    { \
+        static const size_t eclipseMetricId = Eclipse::Metrics::define(name, Eclipse::EMetricType::COUNTER); \
+        Eclipse::Metrics::count(eclipseMetricId, static_cast<double>(n)); \
+    } while (0)
+
+/**
+ * @brief Record a value in a histogram instead of logging a line per event
+ *
+ * The name is looked up once per call site. The backend logs the count, sum,
+ * min, max and percentiles every metrics interval.
+ *
+ * @param name Metric name (the same at every call of this site)
+ * @param value Observed value
+ *
+ * Example usage:
+ * @code
+ * ECLIPSE_HISTOGRAM("batch_size", batch.size());
+ * @endcode
+ */
+#define ECLIPSE_HISTOGRAM(name, value) \
+    do \
+    { \
+        static const size_t eclipseMetricId = Eclipse::Metrics::define(name, Eclipse::EMetricType::HISTOGRAM); \
+        Eclipse::Metrics::observe(eclipseMetricId, static_cast<double>(value)); \
+    } while (0)
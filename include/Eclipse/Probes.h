@@ -0,0 +1,46 @@
+/**
+ * @file Probes.h
+ * @brief Eclipse Logging Library - USDT probe at logging macro call sites
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+/**
+ * @brief Static tracepoint for bpftrace, perf and SystemTap
+ *
+ * Built with ECLIPSE_HAVE_USDT (CMake finds sys/sdt.h), every logging macro
+ * call site carries a probe log(level, tag, file, line) of provider
+ * "eclipse": a nop instruction plus an ELF note naming it. The arguments are
+ * a constant, a pointer already at hand and two literals, so the probe has no
+ * semaphore and this header leaves sys/sdt.h's configuration to the
+ * including code. Without sys/sdt.h the probe compiles to nothing.
+ *
+ * The library's own probes (enqueue, drop, flush, sink_write) are placed in
+ * its sources and documented in the README. Strings are NUL-terminated and
+ * only valid during the probe.
+ */
+#if defined(ECLIPSE_HAVE_USDT)
+
+#include <sys/sdt.h>
+#include <string>
+
+/**
+ * @brief Fire the log probe for this call site and yield the tag
+ *
+ * The lambda is a distinct function at every expansion, so each call site
+ * gets its own probe even where nothing is inlined. The tag expression is
+ * evaluated once, whether or not a tracer is attached.
+ */
+#define ECLIPSE_PROBE_CALL_SITE(level, tag) \
+    ([](const std::string &probedTag) -> const std::string & { \
+        STAP_PROBE4(eclipse, log, static_cast<int>(level), probedTag.c_str(), __FILE__, __LINE__); \
+        return probedTag; }(tag))
+
+#else
+
+#define ECLIPSE_PROBE_CALL_SITE(level, tag) (tag)
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file Prometheus.h
+ * @brief Eclipse Logging Library - Prometheus text exposition of logger counters and metrics
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "Logger.h"
+#include "Metrics.h"
+#include <string>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Render the logger's counters and metric aggregates as Prometheus text
+     *
+     * Logger counters are prefixed "eclipse_": records_total by level,
+     * dropped_records_total by reason, failed_, fallback_ and
+     * dropped_writes_total, log_file_failed, queued_bytes and the
+     * sink_write_seconds histogram. Metrics are prefixed "eclipse_user_",
+     * and characters a metric name may not hold become '_'. Counters get a
+     * "_total" suffix and the sum as value; histograms become summaries with
+     * quantiles 0.5, 0.9 and 0.99. A metric whose name or series matches an
+     * earlier one's after this mapping (e.g. "batch.size" after "batch-size")
+     * is left out with a comment line.
+     *
+     * @param stats Logger counters, see Logger::getStats()
+     * @param metrics Metric aggregates, see Metrics::snapshot()
+     * @return std::string Text exposition format 0.0.4
+     */
+    std::string formatPrometheus(const LoggerStats &stats, const std::vector<MetricSummary> &metrics);
+
+    /**
+     * @brief Replace a file's content in one step
+     *
+     * Writes "<path>.tmp" and renames it over the path, so a reader sees
+     * either the old or the new content. The temporary name does not end in
+     * ".prom" and is skipped by the node_exporter textfile collector.
+     *
+     * @param path File to replace
+     * @param content New content
+     * @return bool False if the temporary file could not be written or renamed
+     */
+    bool writeFileAtomically(const std::string &path, const std::string &content);
+}
@@ -0,0 +1,479 @@
+/**
+ * @file Realtime.h
+ * @brief Eclipse Logging Library - Real-time producer path
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Preallocated single-producer, single-consumer byte ring of one thread
+     *
+     * The owning real-time thread pushes encoded records; the logger's backend
+     * thread pops and formats them. Pushing is a bounded copy into memory that
+     * was allocated and touched at registration time.
+     */
+    class RealtimeRing
+    {
+    public:
+        /**
+         * @brief Allocate and prefault the ring
+         *
+         * @param bytes Capacity, rounded up to a power of two (minimum 4096)
+         */
+        explicit RealtimeRing(size_t bytes);
+
+        RealtimeRing(const RealtimeRing &) = delete;
+        RealtimeRing &operator=(const RealtimeRing &) = delete;
+
+        /**
+         * @brief Append one encoded record (producer side)
+         *
+         * Never blocks: when the ring is full the record is dropped and counted.
+         *
+         * @param data Encoded record
+         * @param size Record size in bytes
+         * @return bool True if the record was queued
+         */
+        bool push(const char *data, size_t size);
+
+        /**
+         * @brief Remove the oldest record (consumer side)
+         *
+         * @param record Receives the encoded record
+         * @return bool True if a record was available
+         */
+        bool pop(std::vector<char> &record);
+
+        /**
+         * @brief Get the number of records dropped because the ring was full
+         *
+         * @return uint64_t Total drops since registration
+         */
+        uint64_t getDropped() const;
+
+        /**
+         * @brief Get drops not reported yet and mark them reported (consumer side)
+         *
+         * @return uint64_t Records dropped since the previous call
+         */
+        uint64_t takeDropped();
+
+        /**
+         * @brief Stop accepting records; the owner falls back to the regular path
+         */
+        void close();
+
+        /**
+         * @brief Check whether the ring still accepts records
+         *
+         * @return bool False once closed by its thread or by shutdown
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Check whether every pushed record has been popped
+         *
+         * @return bool True if the ring is empty
+         */
+        bool isEmpty() const;
+
+    private:
+        /**
+         * @brief Copy bytes into the ring at a monotonic position, wrapping as needed
+         */
+        void copyIn(uint64_t position, const char *data, size_t size);
+
+        /**
+         * @brief Copy bytes out of the ring at a monotonic position, wrapping as needed
+         */
+        void copyOut(uint64_t position, char *data, size_t size) const;
+
+        std::unique_ptr<char[]> buffer;                   ///< Ring storage
+        size_t capacity;                                  ///< Ring size in bytes (power of two)
+        alignas(64) std::atomic<uint64_t> head{0};        ///< Producer position (monotonic)
+        alignas(64) std::atomic<uint64_t> tail{0};        ///< Consumer position (monotonic)
+        alignas(64) std::atomic<uint64_t> dropped{0};     ///< Records dropped because the ring was full
+        uint64_t droppedReported = 0;                     ///< Drops already reported by the consumer
+        std::atomic<bool> open{true};                     ///< Whether the owner may push
+    };
+
+    /**
+     * @brief Argument type tags of the real-time record encoding
+     */
+    enum class ERealtimeArg : uint8_t
+    {
+        STRING,     ///< uint32 length followed by the bytes
+        SIGNED,     ///< int64
+        UNSIGNED,   ///< uint64
+        FLOATING,   ///< double
+        CHARACTER,  ///< char
+        UNSUPPORTED ///< Type that cannot be captured without allocating
+    };
+
+    /**
+     * @brief Fixed header of an encoded real-time record
+     */
+    struct RealtimeHeader
+    {
+        uint32_t size;        ///< Total record size including this header
+        uint8_t level;        ///< ELevel of the record
+        uint8_t argCount;     ///< Number of encoded details
+        uint16_t flags;       ///< kTscTimestamp when timestamp holds raw TSC ticks
+        int32_t line;         ///< Source line of the call site
+        const char *file;     ///< Source file of the call site (static storage)
+        const char *function; ///< Function name of the call site (static storage)
+        uint64_t timestamp;   ///< Nanoseconds since the epoch, or raw TSC ticks
+
+        static constexpr uint16_t kTscTimestamp = 1; ///< Flag: timestamp is converted by the backend
+    };
+
+    /**
+     * @brief Stack buffer that encodes one real-time record without allocating
+     *
+     * Strings that do not fit are cut; the record always remains decodable.
+     */
+    class RealtimeRecord
+    {
+    public:
+        static constexpr size_t kCapacity = 2048; ///< Maximum encoded record size
+
+        /**
+         * @brief Start a record
+         *
+         * @param level Level of the record
+         * @param file Source file of the call site
+         * @param line Source line of the call site
+         * @param function Function name of the call site
+         * @param timestamp Nanoseconds since the epoch, or raw TSC ticks
+         * @param tsc Whether the timestamp holds raw TSC ticks
+         */
+        RealtimeRecord(ELevel level, const char *file, int line, const char *function, uint64_t timestamp, bool tsc)
+        {
+            RealtimeHeader header{};
+            header.level = static_cast<uint8_t>(level);
+            header.line = line;
+            header.file = file;
+            header.function = function;
+            header.timestamp = timestamp;
+            header.flags = tsc ? RealtimeHeader::kTscTimestamp : 0;
+            std::memcpy(buffer, &header, sizeof(header));
+            length = sizeof(header);
+        }
+
+        /**
+         * @brief Append the tag or message
+         *
+         * @param text Tag or message (string literal, C string or std::string)
+         */
+        template <typename T>
+        void addText(const T &text)
+        {
+            encode(text);
+        }
+
+        /**
+         * @brief Append one detail
+         *
+         * Integers, floating-point values, characters and strings are captured as
+         * is; any other type is recorded as unsupported.
+         *
+         * @param value Detail value
+         */
+        template <typename T>
+        void addDetail(const T &value)
+        {
+            encode(value);
+            RealtimeHeader *header = reinterpret_cast<RealtimeHeader *>(buffer);
+            ++header->argCount;
+        }
+
+        /**
+         * @brief Finish the record
+         *
+         * @return const char* Start of the encoded record
+         */
+        const char *data()
+        {
+            uint32_t size = static_cast<uint32_t>(length);
+            std::memcpy(buffer + offsetof(RealtimeHeader, size), &size, sizeof(size));
+            return buffer;
+        }
+
+        /**
+         * @brief Get the encoded size
+         *
+         * @return size_t Record size in bytes
+         */
+        size_t size() const
+        {
+            return length;
+        }
+
+    private:
+        template <typename T>
+        void encode(const T &value)
+        {
+            using Type = std::decay_t<T>;
+            if constexpr (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>)
+            {
+                const void *end = std::memchr(value, '\0', std::extent_v<T>);
+                putString(value, end == nullptr ? std::extent_v<T>
+                                                : static_cast<size_t>(static_cast<const char *>(end) - value));
+            }
+            else if constexpr (std::is_same_v<Type, char> || std::is_same_v<Type, signed char> ||
+                               std::is_same_v<Type, unsigned char>)
+            {
+                putTag(ERealtimeArg::CHARACTER, static_cast<char>(value));
+            }
+            else if constexpr (std::is_same_v<Type, bool>)
+            {
+                putTag(ERealtimeArg::SIGNED, static_cast<int64_t>(value));
+            }
+            else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+            {
+                putTag(ERealtimeArg::SIGNED, static_cast<int64_t>(value));
+            }
+            else if constexpr (std::is_integral_v<Type>)
+            {
+                putTag(ERealtimeArg::UNSIGNED, static_cast<uint64_t>(value));
+            }
+            else if constexpr (std::is_enum_v<Type> && std::is_convertible_v<Type, long long>)
+            {
+                putTag(ERealtimeArg::SIGNED, static_cast<int64_t>(value));
+            }
+            else if constexpr (std::is_floating_point_v<Type>)
+            {
+                putTag(ERealtimeArg::FLOATING, static_cast<double>(value));
+            }
+            else if constexpr (std::is_same_v<Type, const char *> || std::is_same_v<Type, char *>)
+            {
+                putString(value, value == nullptr ? 0 : std::strlen(value));
+            }
+            else if constexpr (std::is_convertible_v<const Type &, std::string_view>)
+            {
+                std::string_view view = value;
+                putString(view.data(), view.size());
+            }
+            else
+            {
+                putByte(static_cast<uint8_t>(ERealtimeArg::UNSUPPORTED));
+            }
+        }
+
+        template <typename V>
+        void putTag(ERealtimeArg tag, V value)
+        {
+            if (length + 1 + sizeof(value) > kCapacity)
+            {
+                putByte(static_cast<uint8_t>(ERealtimeArg::UNSUPPORTED));
+                return;
+            }
+            buffer[length++] = static_cast<char>(tag);
+            std::memcpy(buffer + length, &value, sizeof(value));
+            length += sizeof(value);
+        }
+
+        void putString(const char *text, size_t size)
+        {
+            if (length + 1 + sizeof(uint32_t) > kCapacity)
+            {
+                putByte(static_cast<uint8_t>(ERealtimeArg::UNSUPPORTED));
+                return;
+            }
+            size = std::min(size, kCapacity - length - 1 - sizeof(uint32_t));
+            uint32_t stored = static_cast<uint32_t>(size);
+            buffer[length++] = static_cast<char>(ERealtimeArg::STRING);
+            std::memcpy(buffer + length, &stored, sizeof(stored));
+            length += sizeof(stored);
+            if (size != 0)
+            {
+                std::memcpy(buffer + length, text, size);
+                length += size;
+            }
+        }
+
+        void putByte(uint8_t byte)
+        {
+            // The header reserves room, so a single tag byte always fits
+            if (length < kCapacity)
+            {
+                buffer[length++] = static_cast<char>(byte);
+            }
+        }
+
+        alignas(8) char buffer[kCapacity]; ///< Encoded bytes
+        size_t length = 0;                 ///< Bytes used
+    };
+
+    /**
+     * @brief Decoded real-time record, ready for formatting on the backend thread
+     */
+    struct RealtimeEntry
+    {
+        ELevel level = ELevel::ECLIPSE_DEBUG;            ///< Level of the record
+        std::string tag;                                 ///< Record tag
+        std::string msg;                                 ///< Record message
+        std::vector<std::string> details;                ///< Formatted details
+        std::string trace;                               ///< "file:line [function]"
+        std::chrono::system_clock::time_point timestamp; ///< Time the record was produced
+    };
+
+    /**
+     * @brief Real-time producer entry points used by the ECLIPSE_* macros
+     *
+     * A thread registered with Logger::registerRealtimeThread() owns a
+     * preallocated ring. From then on every ECLIPSE_* call on that thread only
+     * checks the level, reads the clock (vDSO or rdtsc), encodes its arguments
+     * into a stack buffer and copies them into the ring: no system calls, no
+     * locks and no allocation. Formatting and I/O happen on the backend thread.
+     */
+    class RealtimeLog
+    {
+    public:
+        /**
+         * @brief Check whether the calling thread logs through its ring
+         *
+         * @return bool True on a registered thread whose ring is open
+         */
+        static bool active()
+        {
+            return threadRing != nullptr && threadRing->isOpen();
+        }
+
+        /**
+         * @brief Check whether a level passes the current filter
+         *
+         * @param level Level of the record
+         * @return bool True if the record should be queued
+         */
+        static bool enabled(ELevel level)
+        {
+            Logger *logger = Logger::instance;
+            return logger != nullptr && level >= logger->currentLevel.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Read the selected clock without entering the kernel
+         *
+         * With the TSC source only rdtsc runs here; the backend converts the
+         * ticks to wall-clock time when it decodes the record. The other
+         * sources are read directly and never enter the kernel either.
+         *
+         * @param tsc Receives whether the value is raw TSC ticks
+         * @return uint64_t Nanoseconds since the epoch, or raw TSC ticks
+         */
+        static uint64_t stamp(bool &tsc)
+        {
+            Logger *logger = Logger::instance;
+            tsc = logger != nullptr && logger->clock.getSource() == EClockSource::TSC;
+            if (tsc)
+            {
+                return Clock::readTsc();
+            }
+            if (logger != nullptr)
+            {
+                return static_cast<uint64_t>(Clock::toNs(logger->clock.now()));
+            }
+            return static_cast<uint64_t>(Clock::toNs(std::chrono::system_clock::now()));
+        }
+
+        /**
+         * @brief Decode a record popped from a ring
+         *
+         * @param data Encoded record
+         * @param size Record size in bytes
+         * @param clock Clock used to convert TSC timestamps
+         * @param entry Receives the decoded record
+         * @return bool True if the record was well-formed
+         */
+        static bool decode(const char *data, size_t size, const Clock &clock, RealtimeEntry &entry);
+
+        inline static thread_local RealtimeRing *threadRing = nullptr; ///< Ring of the calling thread, if registered
+    };
+
+    /**
+     * @brief Call bound to its tag and message by RealtimeSite
+     *
+     * Holds references to the macro's tag and message, which live until the end
+     * of the full expression.
+     */
+    template <typename Tag, typename Msg>
+    struct RealtimeCall
+    {
+        ELevel level;         ///< Level of the record
+        const char *file;     ///< Source file of the call site
+        int line;             ///< Source line of the call site
+        const char *function; ///< Function name of the call site
+        bool enabled;         ///< False for a passing assertion
+        const Tag &tag;       ///< Record tag
+        const Msg &msg;       ///< Record message
+
+        /**
+         * @brief Encode the record and queue it on the calling thread's ring
+         *
+         * @param args Details
+         */
+        template <typename... Args>
+        void operator()(const Args &...args) const
+        {
+            if (!enabled || !RealtimeLog::enabled(level))
+            {
+                return;
+            }
+            bool tsc = false;
+            uint64_t timestamp = RealtimeLog::stamp(tsc);
+            RealtimeRecord record(level, file, line, function, timestamp, tsc);
+            record.addText(tag);
+            record.addText(msg);
+            (record.addDetail(args), ...);
+            RealtimeLog::threadRing->push(record.data(), record.size());
+        }
+    };
+
+    /**
+     * @brief Call site captured by the ECLIPSE_* macros on a real-time thread
+     */
+    struct RealtimeSite
+    {
+        ELevel level;         ///< Level of the record
+        const char *file;     ///< Source file of the call site
+        int line;             ///< Source line of the call site
+        const char *function; ///< Function name of the call site
+
+        /**
+         * @brief Bind the tag and message of a log call
+         */
+        template <typename Tag, typename Msg>
+        RealtimeCall<Tag, Msg> bind(const Tag &tag, const Msg &msg) const
+        {
+            return {level, file, line, function, true, tag, msg};
+        }
+
+        /**
+         * @brief Bind the tag and message of an assertion, logged only if it failed
+         */
+        template <typename Tag, typename Msg>
+        RealtimeCall<Tag, Msg> bindIf(bool failed, const Tag &tag, const Msg &msg) const
+        {
+            return {level, file, line, function, failed, tag, msg};
+        }
+    };
+}
@@ -0,0 +1,222 @@
+/**
+ * @file RecordReader.h
+ * @brief Eclipse Logging Library - Reads the records of log files in any format
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "BinaryRecord.h"
+#include "LogReader.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Turns the lines of TEXT records back into their fields
+     *
+     * Understands both timestamp layouts. DEFAULT timestamps are read as
+     * local time with whole seconds; ISO8601 ones carry microseconds and
+     * their UTC offset. A record ends at the next record's first line or at
+     * finish(); lines without a marker continue its message, trace or last
+     * detail, also after the "┗" line. Lines that belong to no record are
+     * counted and skipped.
+     *
+     * @note Not thread-safe.
+     */
+    class TextRecordParser
+    {
+    public:
+        /**
+         * @brief Parse one line
+         *
+         * @param line Line without its newline
+         * @param records Receives the records the line completes
+         * @return bool True if the line starts a record
+         */
+        bool addLine(std::string_view line, std::vector<BinaryRecord> &records);
+
+        /**
+         * @brief Complete the record still open, e.g. at the end of a file
+         *
+         * @param records Receives the record, if any
+         */
+        void finish(std::vector<BinaryRecord> &records);
+
+        /**
+         * @brief Complete the open record if its "┗" line was seen
+         *
+         * For readers waiting at the end of a growing file, where no next
+         * first line may come for a while. Continuation lines the writer has
+         * not written yet are lost to such a record.
+         *
+         * @param records Receives the record, if any
+         */
+        void finishEnded(std::vector<BinaryRecord> &records);
+
+        /**
+         * @brief Get the number of lines that belonged to no record
+         *
+         * @return uint64_t Lines skipped
+         */
+        uint64_t getSkippedLines() const;
+
+    private:
+        BinaryRecord current;     ///< Record being parsed
+        bool open = false;        ///< current has its first line
+        bool ended = false;       ///< current has its "┗" line
+        uint64_t skipped = 0;     ///< Lines outside any record
+    };
+
+    /**
+     * @brief Sequential reader of the records of a log file in any Eclipse format
+     *
+     * Framed files (FRAMED, COMPRESSED and BINARY) are read with LogReader,
+     * with its damage recovery; BINARY records come back exactly, the others
+     * are parsed from their text. Anything else is read as a TEXT file. Each
+     * record's sequence number is its position in the file unless the file
+     * stores one.
+     *
+     * @note Not thread-safe.
+     */
+    class RecordReader
+    {
+    public:
+        /**
+         * @brief Open a log file
+         *
+         * @param path File to read
+         * @return bool True if the file could be opened
+         */
+        bool open(const std::string &path);
+
+        /**
+         * @brief Close the file
+         */
+        void close();
+
+        /**
+         * @brief Set the dictionary for COMPRESSED files
+         *
+         * @param dictionary Dictionary bytes, as written by eclipse-train-dict
+         * @return bool False if zstd is unavailable or the dictionary is not a trained one
+         */
+        bool setDictionary(const std::string &dictionary);
+
+        /**
+         * @brief Read the next record
+         *
+         * @param record Receives the record
+         * @return bool False at the end of the file
+         */
+        bool next(BinaryRecord &record);
+
+        /**
+         * @brief Continue reading at an offset found earlier with getOffset() or getSyncOffset()
+         *
+         * Sequence numbers of text records count from the new position.
+         *
+         * @param offset File offset
+         * @return bool False if no file is open or the offset cannot be reached
+         */
+        bool seek(uint64_t offset);
+
+        /**
+         * @brief Set whether next() waits for more of a growing file at its end
+         *
+         * When following, next() returns false at the end of what has been
+         * written so far, and a later call reads what was appended since. A
+         * partial line or frame stays unread until it is complete; a TEXT
+         * record without a closing line is returned once the next one starts.
+         *
+         * @param follow True to follow the file, false (default) to stop at its end
+         */
+        void setFollow(bool follow);
+
+        /**
+         * @brief Set how much is read from the file at a time
+         *
+         * @param bytes Read size; small values suit reading a few records after seek()
+         */
+        void setReadAhead(size_t bytes);
+
+        /**
+         * @brief Get the offset of the record next() returned last
+         *
+         * That is the offset of its frame, shared by every record of the
+         * frame, or of its first line in a TEXT file.
+         *
+         * @return uint64_t File offset
+         */
+        uint64_t getOffset() const;
+
+        /**
+         * @brief Get where reading must start to read the record next() returned last again
+         *
+         * @return uint64_t File offset to pass to seek(); see LogReader::getSyncOffset()
+         */
+        uint64_t getSyncOffset() const;
+
+        /**
+         * @brief Check whether the open file is framed
+         *
+         * @return bool True for FRAMED, COMPRESSED and BINARY files
+         */
+        bool isFramed() const;
+
+        /**
+         * @brief Get the frame reader of a framed file, for its damage counters
+         *
+         * @return const LogReader& Reader of the open file
+         */
+        const LogReader &getLogReader() const;
+
+        /**
+         * @brief Get the number of text lines that belonged to no record
+         *
+         * @return uint64_t Lines skipped
+         */
+        uint64_t getSkippedLines() const;
+
+    private:
+        /**
+         * @brief Parse text into parsed records
+         *
+         * @param text Whole lines, or the rest of the file
+         * @param offset File offset of the text, or of its frame
+         */
+        void parseText(std::string_view text, uint64_t offset);
+
+        /**
+         * @brief Move parsed records to pending, with their offsets
+         */
+        void takeParsed();
+
+        LogReader frames;                    ///< Reader of framed files
+        bool framed = false;                 ///< The open file is framed
+        std::ifstream file;                  ///< TEXT file
+        std::string buffer;                  ///< TEXT bytes read and not yet parsed
+        uint64_t bufferOffset = 0;           ///< File offset of buffer[0]
+        size_t readAhead = 1024 * 1024;      ///< Bytes read from a TEXT file at a time
+        TextRecordParser parser;             ///< Parser of text records
+        uint64_t recordStart = 0;            ///< Offset of the record the parser has open
+        std::deque<BinaryRecord> pending;    ///< Records parsed and not yet returned
+        std::deque<uint64_t> pendingOffsets; ///< Offset of every pending record
+        std::deque<uint64_t> pendingSyncs;   ///< Sync offset of every pending record
+        std::vector<BinaryRecord> parsed;    ///< Scratch for parsed records
+        std::vector<uint64_t> parsedOffsets; ///< Offset of every parsed record
+        uint64_t position = 0;               ///< Records returned, used as sequence for text
+        uint64_t offset = 0;                 ///< Offset of the last record returned
+        uint64_t syncOffset = 0;             ///< Sync offset of the last record returned
+        bool finished = false;               ///< The end of the file was reached
+        bool follow = false;                 ///< The end of the file is where it has been written to so far
+    };
+}
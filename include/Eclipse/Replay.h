@@ -0,0 +1,89 @@
+/**
+ * @file Replay.h
+ * @brief Eclipse Logging Library - Re-drives captured logs through the logger for load testing
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "BinaryRecord.h"
+#include "Logger.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief How a capture is replayed
+     */
+    struct ReplayOptions
+    {
+        double speed = 1.0; ///< Multiple of the captured pace, 0 to log as fast as possible
+        size_t threads = 1; ///< Threads logging the records; thread t logs every threads-th record from t
+    };
+
+    /**
+     * @brief Measurements of one replay
+     */
+    struct ReplayStats
+    {
+        uint64_t records = 0;                  ///< Records logged
+        std::chrono::nanoseconds callsTime{0}; ///< From the start to the return of the last log() call
+        std::chrono::nanoseconds totalTime{0}; ///< From the start to the end of the final flush()
+        std::chrono::nanoseconds latencyP50{0};  ///< Median time spent in Logger::log()
+        std::chrono::nanoseconds latencyP99{0};  ///< 99th percentile of the time spent in Logger::log()
+        std::chrono::nanoseconds latencyP999{0}; ///< 99.9th percentile of the time spent in Logger::log()
+        std::chrono::nanoseconds latencyMax{0};  ///< Longest time spent in Logger::log()
+        std::chrono::nanoseconds lagP99{0};    ///< 99th percentile of how late calls started against the capture's pace
+        std::chrono::nanoseconds lagMax{0};    ///< Latest start of a call against the capture's pace
+    };
+
+    /**
+     * @brief Replays the records of captured log files through a Logger
+     *
+     * Records are loaded up front, so reading the capture does not slow the
+     * replay. Each is logged with its level, tag, message, details and call
+     * site, at its captured offset from the first record divided by the
+     * speed; a thread that falls behind logs without waiting until it has
+     * caught up. The logger's own configuration decides the format, write
+     * mode and sink, so the same capture can benchmark each of them.
+     *
+     * @note Not thread-safe; run() starts and joins its own threads.
+     */
+    class LogReplayer
+    {
+    public:
+        /**
+         * @brief Add the records of a log file in any format
+         *
+         * @param path Log file, see RecordReader
+         * @param dictionary Dictionary for COMPRESSED files, empty if none
+         * @return bool False if the file could not be opened
+         */
+        bool load(const std::string &path, const std::string &dictionary = "");
+
+        /**
+         * @brief Get the number of records loaded
+         *
+         * @return size_t Records to replay
+         */
+        size_t getRecordCount() const;
+
+        /**
+         * @brief Log every record, then flush the logger
+         *
+         * @param logger Logger to drive, already configured
+         * @param options Pace and threads
+         * @return ReplayStats Throughput and latency of the replay
+         */
+        ReplayStats run(Logger &logger, const ReplayOptions &options) const;
+
+    private:
+        std::vector<BinaryRecord> records; ///< Records in capture order
+    };
+}
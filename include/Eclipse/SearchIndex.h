@@ -0,0 +1,184 @@
+/**
+ * @file SearchIndex.h
+ * @brief Eclipse Logging Library - Inverted index over the tags and fields of finished log files
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "BinaryRecord.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Block of a log file, as listed by a search index
+     *
+     * The records of block i are those whose offset (see
+     * RecordReader::getOffset()) is at least its offset and below the offset
+     * of block i + 1.
+     */
+    struct IndexBlock
+    {
+        uint64_t offset = 0; ///< Offset of the block's first record
+        uint64_t start = 0;  ///< Where reading must start to decode every record of the block
+    };
+
+    /**
+     * @brief Inverted index from search terms to the blocks of a log file holding them
+     *
+     * A term is "tag=VALUE" for a record's tag or a "key=value" detail, which
+     * is how structured fields are logged. Blocks are runs of whole frames,
+     * or of whole records in TEXT files, of about 64 KiB. A search reads only
+     * the blocks every indexed term of the query occurs in, and checks each
+     * of their records against every term.
+     *
+     * The index of a log file is kept next to it, see getIndexPath(). It is
+     * meant for finished files: it records the file's size, and a file that
+     * has changed size since is scanned instead.
+     *
+     * Index file layout: the magic "ECIX", a version byte, then varints for
+     * the file size, the record count, the indexed keys, every block as
+     * deltas, and every term in order, front-coded, with its block numbers
+     * as deltas; a CRC32C of everything before it ends the file.
+     *
+     * @note Not thread-safe; build different files' indexes from different instances.
+     */
+    class SearchIndex
+    {
+    public:
+        /**
+         * @brief Get the path of the index of a log file
+         *
+         * @param logPath Log file
+         * @return std::string logPath with ".idx" appended
+         */
+        static std::string getIndexPath(const std::string &logPath);
+
+        /**
+         * @brief Check whether a record holds every term
+         *
+         * @param record Record to check
+         * @param terms "tag=VALUE" or "key=value" terms
+         * @return bool True if the record's tag or one of its details equals each term
+         */
+        static bool matches(const BinaryRecord &record, const std::vector<std::string> &terms);
+
+        /**
+         * @brief Find the records holding every term by reading a whole log file, without an index
+         *
+         * @param logPath Log file in any format
+         * @param terms "tag=VALUE" or "key=value" terms
+         * @param records Receives the matching records, appended
+         * @param dictionary Dictionary for COMPRESSED files, empty for none
+         * @return bool False if the file cannot be opened
+         */
+        static bool scan(const std::string &logPath, const std::vector<std::string> &terms,
+                         std::vector<BinaryRecord> &records, const std::string &dictionary = "");
+
+        /**
+         * @brief Build the index of a log file
+         *
+         * @param logPath Log file in any format
+         * @param fields Keys of the "key=value" details to index; empty to index every one
+         * @param dictionary Dictionary for COMPRESSED files, empty for none
+         * @return bool False if the file cannot be opened
+         */
+        bool build(const std::string &logPath, const std::vector<std::string> &fields,
+                   const std::string &dictionary = "");
+
+        /**
+         * @brief Write the index, replacing the file atomically
+         *
+         * @param path Index file, usually getIndexPath() of the log file
+         * @return bool True if the index was written
+         */
+        bool save(const std::string &path) const;
+
+        /**
+         * @brief Read an index written by save()
+         *
+         * @param path Index file
+         * @return bool False if the file is missing or damaged
+         */
+        bool load(const std::string &path);
+
+        /**
+         * @brief Check whether the index still describes a log file
+         *
+         * @param logPath Log file the index was built from
+         * @return bool True if the file has the size it had when indexed
+         */
+        bool isCurrent(const std::string &logPath) const;
+
+        /**
+         * @brief Find the records holding every term, reading only the blocks the index points to
+         *
+         * Terms the index does not cover (details whose key was not indexed)
+         * narrow nothing down but are still checked.
+         *
+         * @param logPath Log file the index was built from
+         * @param terms "tag=VALUE" or "key=value" terms
+         * @param records Receives the matching records, appended
+         * @param dictionary Dictionary for COMPRESSED files, empty for none
+         * @return bool False if the file cannot be opened
+         */
+        bool search(const std::string &logPath, const std::vector<std::string> &terms,
+                    std::vector<BinaryRecord> &records, const std::string &dictionary = "");
+
+        /**
+         * @brief Get the number of blocks the last search() read
+         *
+         * @return uint64_t Blocks read
+         */
+        uint64_t getBlocksRead() const;
+
+        /**
+         * @brief Get the blocks of the indexed file
+         *
+         * @return const std::vector<IndexBlock>& Blocks in file order
+         */
+        const std::vector<IndexBlock> &getBlocks() const;
+
+        /**
+         * @brief Get the keys of the indexed details
+         *
+         * @return const std::vector<std::string>& Keys; empty when every "key=value" detail is indexed
+         */
+        const std::vector<std::string> &getFields() const;
+
+        /**
+         * @brief Get the number of distinct terms
+         *
+         * @return size_t Terms
+         */
+        size_t getTermCount() const;
+
+        /**
+         * @brief Get the number of records in the indexed file
+         *
+         * @return uint64_t Records
+         */
+        uint64_t getRecordCount() const;
+
+    private:
+        /**
+         * @brief Check whether a term is one the index lists every occurrence of
+         */
+        bool isIndexed(std::string_view term) const;
+
+        std::vector<std::string> fields;                                ///< Indexed keys, empty for all
+        uint64_t sourceBytes = 0;                                       ///< Size of the indexed file
+        uint64_t records = 0;                                           ///< Records in the indexed file
+        std::vector<IndexBlock> blocks;                                 ///< Blocks in file order
+        std::unordered_map<std::string, std::vector<uint32_t>> postings; ///< Blocks of every term, ascending
+        uint64_t blocksRead = 0;                                        ///< Blocks the last search read
+    };
+}
@@ -0,0 +1,234 @@
+/**
+ * @file SegmentStore.h
+ * @brief Eclipse Logging Library - Size-capped segment directory with manifest and retention
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "FileSink.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Segment size and retention limits of a SegmentStore
+     */
+    struct SegmentOptions
+    {
+        uint64_t segmentBytes = 64ull << 20;     ///< Start a new segment once the current one holds this much
+        uint64_t maxTotalBytes = 0;              ///< Delete the oldest segments beyond this total, 0 for no limit
+        std::chrono::seconds maxAge{0};          ///< Delete segments whose last write is older, 0 for no limit
+    };
+
+    /**
+     * @brief One segment as listed in the manifest
+     */
+    struct SegmentInfo
+    {
+        std::string name;           ///< File name within the directory
+        uint64_t firstSequence = 0; ///< Sequence number of the segment's first write
+        uint64_t writes = 0;        ///< Number of writes (records, or batches in buffered write modes)
+        uint64_t bytes = 0;         ///< Size of the segment file
+        int64_t firstTimeNs = 0;    ///< Time the segment was started, nanoseconds since the epoch (UTC)
+        int64_t lastTimeNs = 0;     ///< Time of the last write, nanoseconds since the epoch (UTC)
+        bool open = false;          ///< Whether the segment is still being written
+    };
+
+    /**
+     * @brief Directory of size-capped log segments
+     *
+     * Writes go through a caller-owned FileSink, so its format, cache mode and
+     * atomic write settings apply to every segment. When the next write would
+     * take the current segment past SegmentOptions::segmentBytes on disk, it
+     * starts a new one named "<first sequence>-<UTC start time>.log", e.g.
+     * "0000000000001234-20250102T030405Z.log". Sequence numbers count writes
+     * across the whole directory. BINARY and COMPRESSED writes shrink by a ratio
+     * known only once written, so their size is estimated from the segment so
+     * far and can rarely overshoot by a few bytes.
+     *
+     * A text manifest ("MANIFEST") lists every segment with its sequence range,
+     * size and time range, so readers can pick segments by time without opening
+     * them. It is replaced atomically (write, then rename) whenever a segment is
+     * started or finished, and by enforceRetention() when it is out of date.
+     *
+     * A directory belongs to one process. Reopening it after a crash finishes
+     * the segment that was open, adopts segment files missing from the manifest
+     * and starts a new segment.
+     *
+     * @note Thread-safe: write() and enforceRetention() may run on different threads.
+     */
+    class SegmentStore
+    {
+    public:
+        /**
+         * @brief Create a store that writes through a sink
+         *
+         * @param sink Sink used for the current segment; must outlive the store
+         */
+        explicit SegmentStore(FileSink &sink);
+
+        /**
+         * @brief Finishes the current segment
+         */
+        ~SegmentStore();
+
+        SegmentStore(const SegmentStore &) = delete;
+        SegmentStore &operator=(const SegmentStore &) = delete;
+
+        /**
+         * @brief Open a segment directory, creating it if needed, and start a segment
+         *
+         * @param directory Directory holding the segments and the manifest
+         * @param options Segment size and retention limits
+         * @return bool True if the directory and a new segment could be created
+         */
+        bool open(const std::string &directory, const SegmentOptions &options = {});
+
+        /**
+         * @brief Finish the current segment and write the manifest
+         */
+        void close();
+
+        /**
+         * @brief Forget the directory without touching its files
+         *
+         * Used by a forked child for a directory the parent keeps writing.
+         */
+        void release();
+
+        /**
+         * @brief Check whether a directory is open
+         *
+         * @return bool True between a successful open() and close()
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Get the open directory
+         *
+         * @return std::string Directory path, empty when closed
+         */
+        std::string getDirectory() const;
+
+        /**
+         * @brief Reopen the current segment, e.g. after sink settings changed
+         *
+         * @return bool True if the segment could be reopened
+         */
+        bool reopen();
+
+        /**
+         * @brief Check whether a write would start a new segment
+         *
+         * Lets the caller withdraw the current descriptor from signal handlers
+         * before write() closes it.
+         *
+         * @param size Number of bytes of the write
+         * @return bool True if write() would start a new segment first
+         */
+        bool startsSegment(size_t size) const;
+
+        /**
+         * @brief Append to the current segment, starting a new one when it is full
+         *
+         * @param data Bytes to write
+         * @param size Number of bytes
+         * @return bool True if the sink accepted the data
+         */
+        bool write(const char *data, size_t size);
+
+        /**
+         * @brief Delete finished segments beyond the size and age limits
+         *
+         * The current segment is never deleted. Also rewrites the manifest if it
+         * is out of date. Called by the logger's backend thread every second.
+         *
+         * @return size_t Number of segments deleted
+         */
+        size_t enforceRetention();
+
+        /**
+         * @brief Get the segments of the open directory, oldest first
+         *
+         * @return std::vector<SegmentInfo> Segments, the last one open
+         */
+        std::vector<SegmentInfo> getSegments() const;
+
+        /**
+         * @brief Read the manifest of a segment directory
+         *
+         * @param directory Segment directory
+         * @param segments Receives the segments, oldest first
+         * @return bool True if the manifest could be read
+         */
+        static bool readManifest(const std::string &directory, std::vector<SegmentInfo> &segments);
+
+        /**
+         * @brief Find the segments that may hold writes from a time range
+         *
+         * An open segment is taken to extend to the present.
+         *
+         * @param directory Segment directory
+         * @param from Start of the range
+         * @param to End of the range
+         * @return std::vector<SegmentInfo> Matching segments, oldest first
+         */
+        static std::vector<SegmentInfo> findSegments(const std::string &directory,
+                                                     std::chrono::system_clock::time_point from,
+                                                     std::chrono::system_clock::time_point to);
+
+    private:
+        /**
+         * @brief Check whether a write must start a new segment first (requires mutex)
+         *
+         * @param size Number of bytes of the write
+         * @return bool True if the current segment is finished or too full
+         */
+        bool needsSegment(size_t size) const;
+
+        /**
+         * @brief Finish the current segment and open a new one (requires mutex)
+         *
+         * @return bool True if the new segment could be opened
+         */
+        bool startSegment();
+
+        /**
+         * @brief Record the final size of the current segment (requires mutex)
+         */
+        void finishSegment();
+
+        /**
+         * @brief Replace the manifest with the current segment list (requires mutex)
+         *
+         * @return bool True if the manifest was written
+         */
+        bool writeManifest();
+
+        /**
+         * @brief Join the directory and a segment name
+         *
+         * @param name Segment file name
+         * @return std::string Path of the segment
+         */
+        std::string pathOf(const std::string &name) const;
+
+        FileSink &sink;                    ///< Sink of the current segment
+        mutable std::mutex mutex;          ///< Guards everything below
+        std::string directory;             ///< Open directory, empty when closed
+        SegmentOptions options;            ///< Size and retention limits
+        std::vector<SegmentInfo> segments; ///< Every segment, oldest first; the last one is open
+        uint64_t nextSequence = 0;         ///< Sequence number of the next write
+        uint64_t segmentInput = 0;         ///< Bytes handed to the sink for the current segment
+        uint64_t largestWrite = 0;         ///< Largest on-disk size of one write to the current segment
+        bool manifestDirty = false;        ///< Whether the manifest lags behind segments
+    };
+}
@@ -0,0 +1,239 @@
+/**
+ * @file SharedLog.h
+ * @brief Eclipse Logging Library - Multi-process shared-memory log
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "FileSink.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Geometry of a shared-memory log segment
+     *
+     * A segment is split into a fixed number of slots. Each producing process
+     * claims one slot and writes into its private ring, so processes never
+     * contend with each other on the hot path.
+     */
+    struct SharedLogOptions
+    {
+        uint32_t slotCount = 16;       ///< Maximum number of concurrently attached processes
+        uint32_t slotBytes = 1u << 20; ///< Ring capacity per slot in bytes (rounded down to 64)
+    };
+
+    /**
+     * @brief Producer side of a shared-memory log segment
+     *
+     * Attaches to a segment created by a SharedLogCollector, claims a free slot
+     * for the calling process and appends fully formatted records to it. Records
+     * are dropped (and counted) rather than blocking when the ring is full.
+     *
+     * @note Thread-safe. Threads of one process serialise on a process-local mutex.
+     */
+    class SharedLogWriter
+    {
+    public:
+        /**
+         * @brief Attach to an existing segment
+         *
+         * @param name Segment name as passed to shm_open (e.g. "/eclipse")
+         * @return std::unique_ptr<SharedLogWriter> New writer, or nullptr if the segment does not exist or has no free slot
+         */
+        static std::unique_ptr<SharedLogWriter> attach(const std::string &name);
+
+        /**
+         * @brief Release the slot and unmap the segment
+         */
+        ~SharedLogWriter();
+
+        SharedLogWriter(const SharedLogWriter &) = delete;
+        SharedLogWriter &operator=(const SharedLogWriter &) = delete;
+
+        /**
+         * @brief Append one record to this process's ring
+         *
+         * @param text The formatted record, including its trailing newline
+         * @return bool True if the record was enqueued, false if it was dropped
+         */
+        bool write(const std::string &text);
+
+        /**
+         * @brief Get the name of the attached segment
+         *
+         * @return const std::string& Segment name
+         */
+        const std::string &getName() const;
+
+    private:
+        SharedLogWriter() = default;
+
+        std::string name;          ///< Segment name
+        void *mapping = nullptr;   ///< Base address of the mapped segment
+        size_t mappingBytes = 0;   ///< Size of the mapping
+        uint32_t slotIndex = 0;    ///< Index of the claimed slot
+        std::mutex writeMutex;     ///< Serialises threads of this process on the slot
+    };
+
+    /**
+     * @brief Consumer side of a shared-memory log segment
+     *
+     * Creates (or re-opens) the segment, drains every slot, merges the records
+     * in global sequence order and appends them to a single output file. Can run
+     * embedded in a designated process via start()/stop(), or be driven by a
+     * standalone daemon calling poll() in a loop (see eclipse-collectord).
+     */
+    class SharedLogCollector
+    {
+    public:
+        /**
+         * @brief Construct a collector
+         *
+         * @param name Segment name as passed to shm_open (e.g. "/eclipse")
+         * @param outputPath File that receives the merged log
+         * @param options Segment geometry used when the segment is created
+         */
+        SharedLogCollector(const std::string &name, const std::string &outputPath,
+                           const SharedLogOptions &options = {});
+
+        /**
+         * @brief Stop the background thread, drain and unmap the segment
+         */
+        ~SharedLogCollector();
+
+        SharedLogCollector(const SharedLogCollector &) = delete;
+        SharedLogCollector &operator=(const SharedLogCollector &) = delete;
+
+        /**
+         * @brief Create or re-open the segment and the output file
+         *
+         * @return bool True if both the segment and the output file are usable
+         */
+        bool open();
+
+        /**
+         * @brief Drain all slots once and write the merged records
+         *
+         * @return size_t Number of records written
+         */
+        size_t poll();
+
+        /**
+         * @brief Start polling on a background thread
+         *
+         * @param interval Sleep between polls when the segment is idle
+         */
+        void start(std::chrono::milliseconds interval = std::chrono::milliseconds(5));
+
+        /**
+         * @brief Stop the background thread after a final drain
+         *
+         * Polls at least once, then keeps polling while records arrive until the
+         * drain timeout expires.
+         *
+         * @param drainTimeout Upper bound on the time spent draining
+         */
+        void stop(std::chrono::milliseconds drainTimeout = std::chrono::milliseconds(0));
+
+        /**
+         * @brief Remove the segment name so no new producer can attach
+         */
+        void unlink();
+
+    private:
+        /**
+         * @brief Background polling loop
+         *
+         * @param interval Sleep between idle polls
+         */
+        void run(std::chrono::milliseconds interval);
+
+        std::string name;                 ///< Segment name
+        std::string outputPath;           ///< Merged output file path
+        SharedLogOptions options;         ///< Geometry used on creation
+        void *mapping = nullptr;          ///< Base address of the mapped segment
+        size_t mappingBytes = 0;          ///< Size of the mapping
+        std::vector<uint64_t> dropsSeen;  ///< Per-slot drop counters already reported
+        FileSink output;                  ///< Merged output file
+        std::mutex pollMutex;             ///< Serialises poll() between the thread and callers
+        std::thread worker;               ///< Background polling thread
+        std::atomic<bool> running{false}; ///< Whether the background thread should keep polling
+    };
+
+    /**
+     * @brief One record seen by a SharedLogTail
+     */
+    struct SharedLogEntry
+    {
+        uint64_t sequence = 0;   ///< Global sequence number
+        int64_t timestampNs = 0; ///< Wall-clock time of the enqueue
+        int32_t pid = 0;         ///< Producing process
+        std::string text;        ///< The formatted record, including its trailing newline
+    };
+
+    /**
+     * @brief Read-only observer of a shared-memory log segment
+     *
+     * Follows every slot's ring without consuming from it: the collector
+     * remains the only consumer and producers never wait for the observer.
+     * The segment is mapped read-only. A record is seen if the observer reads
+     * it before the collector drains it; the bytes the collector drained
+     * first are skipped and counted, because the producer may already be
+     * reusing them.
+     *
+     * @note Not thread-safe.
+     */
+    class SharedLogTail
+    {
+    public:
+        /**
+         * @brief Map an existing segment and start at the current end of every ring
+         *
+         * @param name Segment name as passed to shm_open (e.g. "/eclipse")
+         * @return std::unique_ptr<SharedLogTail> New observer, or nullptr if the segment does not exist
+         */
+        static std::unique_ptr<SharedLogTail> attach(const std::string &name);
+
+        /**
+         * @brief Unmap the segment
+         */
+        ~SharedLogTail();
+
+        SharedLogTail(const SharedLogTail &) = delete;
+        SharedLogTail &operator=(const SharedLogTail &) = delete;
+
+        /**
+         * @brief Read the records written since the last poll
+         *
+         * @param entries Receives the records in global sequence order, appended
+         * @return size_t Number of records read
+         */
+        size_t poll(std::vector<SharedLogEntry> &entries);
+
+        /**
+         * @brief Get the number of ring bytes skipped because the collector drained them first
+         *
+         * @return uint64_t Bytes of records that were not seen
+         */
+        uint64_t getMissedBytes() const;
+
+    private:
+        SharedLogTail() = default;
+
+        void *mapping = nullptr;         ///< Base address of the read-only mapping
+        size_t mappingBytes = 0;         ///< Size of the mapping
+        std::vector<uint64_t> cursors;   ///< Read position in every slot's ring
+        uint64_t missedBytes = 0;        ///< Bytes skipped behind the collector
+    };
+}
@@ -0,0 +1,323 @@
+/**
+ * @file SignalSafe.h
+ * @brief Eclipse Logging Library - Async-signal-safe logging path
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include "Logger.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Eclipse
+{
+    /**
+     * @brief Fixed-size stack buffer for signal-safe record formatting
+     *
+     * Appends literal strings and integers without allocating. Output that does
+     * not fit is silently cut, but the record always keeps its final newline.
+     */
+    class SignalSafeBuffer
+    {
+    public:
+        static constexpr size_t kCapacity = 1024; ///< Maximum record size in bytes
+
+        /**
+         * @brief Append a NUL-terminated string
+         *
+         * @param text String to append (nullptr appends "(null)")
+         */
+        void append(const char *text)
+        {
+            if (text == nullptr)
+            {
+                text = "(null)";
+            }
+            while (*text != '\0' && length < kCapacity - 1)
+            {
+                buffer[length++] = *text++;
+            }
+        }
+
+        /**
+         * @brief Append a single character
+         *
+         * @param c Character to append
+         */
+        void append(char c)
+        {
+            if (length < kCapacity - 1)
+            {
+                buffer[length++] = c;
+            }
+        }
+
+        /**
+         * @brief Append an unsigned integer in decimal
+         *
+         * @param value Value to append
+         * @param width Minimum number of digits, zero-padded
+         */
+        void appendUnsigned(unsigned long long value, int width = 0)
+        {
+            char digits[24];
+            int count = 0;
+            do
+            {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+            while (count < width && count < static_cast<int>(sizeof(digits)))
+            {
+                digits[count++] = '0';
+            }
+            while (count > 0)
+            {
+                append(digits[--count]);
+            }
+        }
+
+        /**
+         * @brief Append a signed integer in decimal
+         *
+         * @param value Value to append
+         */
+        void appendSigned(long long value)
+        {
+            if (value < 0)
+            {
+                append('-');
+                appendUnsigned(0ULL - static_cast<unsigned long long>(value));
+            }
+            else
+            {
+                appendUnsigned(static_cast<unsigned long long>(value));
+            }
+        }
+
+        /**
+         * @brief Append an integer, bool, character or literal string
+         *
+         * Any other type is rejected at compile time because formatting it could
+         * allocate or take locks.
+         *
+         * @param value Value to append
+         */
+        template <typename T>
+        void appendValue(const T &value)
+        {
+            using Type = std::decay_t<T>;
+            if constexpr (std::is_same_v<Type, bool>)
+            {
+                append(value ? '1' : '0');
+            }
+            else if constexpr (std::is_same_v<Type, char>)
+            {
+                append(value);
+            }
+            else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+            {
+                appendSigned(static_cast<long long>(value));
+            }
+            else if constexpr (std::is_integral_v<Type>)
+            {
+                appendUnsigned(static_cast<unsigned long long>(value));
+            }
+            else if constexpr (std::is_enum_v<Type>)
+            {
+                appendSigned(static_cast<long long>(value));
+            }
+            else
+            {
+                static_assert(std::is_same_v<Type, const char *> || std::is_same_v<Type, char *>,
+                              "ECLIPSE_SIGNAL_SAFE_LOG only accepts integers and string literals");
+                append(static_cast<const char *>(value));
+            }
+        }
+
+        /**
+         * @brief Terminate the record with a newline
+         */
+        void endLine()
+        {
+            if (length < kCapacity)
+            {
+                buffer[length++] = '\n';
+            }
+        }
+
+        /**
+         * @brief Get the formatted bytes
+         *
+         * @return const char* Start of the buffer
+         */
+        const char *data() const
+        {
+            return buffer;
+        }
+
+        /**
+         * @brief Get the number of formatted bytes
+         *
+         * @return size_t Buffer length
+         */
+        size_t size() const
+        {
+            return length;
+        }
+
+    private:
+        char buffer[kCapacity]; ///< Record bytes
+        size_t length = 0;      ///< Bytes used
+    };
+
+    /**
+     * @brief Async-signal-safe logging entry points
+     *
+     * Formats records into a SignalSafeBuffer on the stack and emits them with
+     * write(2) to the console and the open log file. Takes no locks, performs
+     * no allocation and calls only async-signal-safe functions, so it can be
+     * used inside signal handlers; errno is left unchanged. Records go straight
+     * to the file even when a shared-memory log is attached, and console output
+     * is not colourised.
+     *
+     * Timestamps use the UTC offset the logger last computed: on every sink
+     * change and, while the backend thread runs, once a minute. Without the
+     * backend, records after a daylight-saving change keep the old offset until
+     * the sinks change.
+     */
+    class SignalSafeLog
+    {
+    public:
+        /**
+         * @brief Check whether a level passes the current filter
+         *
+         * @param level Level of the record
+         * @return bool True if the record should be written
+         */
+        static bool enabled(ELevel level);
+
+        /**
+         * @brief Write the timestamp, level, tag and message line
+         *
+         * @param buffer Buffer receiving the record
+         * @param level Level of the record
+         * @param tag Record tag
+         * @param msg Record message
+         */
+        static void beginRecord(SignalSafeBuffer &buffer, ELevel level, const char *tag, const char *msg);
+
+        /**
+         * @brief Write a continuation line prefix ("┃ " or "┗ ")
+         *
+         * @param buffer Buffer receiving the record
+         * @param last Whether this is the final line of the record
+         */
+        static void beginLine(SignalSafeBuffer &buffer, bool last);
+
+        /**
+         * @brief Write a finished record to every configured destination
+         *
+         * @param buffer Formatted record
+         */
+        static void emit(const SignalSafeBuffer &buffer);
+
+        /**
+         * @brief Format and write one record
+         *
+         * @param level Level of the record
+         * @param tag Record tag (string literal)
+         * @param msg Record message (string literal)
+         * @param file Source file of the call site
+         * @param line Source line of the call site
+         * @param args Details: integers, bools, characters or string literals
+         */
+        template <typename... Args>
+        static void log(ELevel level, const char *tag, const char *msg, const char *file, int line,
+                        const Args &...args)
+        {
+            if (!enabled(level))
+            {
+                return;
+            }
+            // Handlers must leave errno as the interrupted code saw it
+            const int savedErrno = errno;
+
+            SignalSafeBuffer buffer;
+            beginRecord(buffer, level, tag, msg);
+
+            const char *filename = file;
+            for (const char *p = file; *p != '\0'; ++p)
+            {
+                if (*p == '/' || *p == '\\')
+                {
+                    filename = p + 1;
+                }
+            }
+            beginLine(buffer, sizeof...(args) == 0);
+            buffer.append("at: ");
+            buffer.append(filename);
+            buffer.append(':');
+            buffer.appendSigned(line);
+            buffer.endLine();
+
+            size_t index = 0;
+            (appendDetail(buffer, ++index, sizeof...(args), args), ...);
+            (void)index;
+
+            emit(buffer);
+            errno = savedErrno;
+        }
+
+    private:
+        /**
+         * @brief Append one numbered detail line
+         *
+         * @param buffer Buffer receiving the record
+         * @param index One-based detail index
+         * @param count Total number of details
+         * @param value Detail value
+         */
+        template <typename T>
+        static void appendDetail(SignalSafeBuffer &buffer, size_t index, size_t count, const T &value)
+        {
+            beginLine(buffer, index == count);
+            buffer.append('[');
+            buffer.appendUnsigned(index);
+            buffer.append("] ");
+            buffer.appendValue(value);
+            buffer.endLine();
+        }
+    };
+
+    /**
+     * @brief Call site captured by ECLIPSE_SIGNAL_SAFE_LOG
+     *
+     * Binds the fixed record fields so the macro can forward an empty or
+     * non-empty detail list with a plain call.
+     */
+    struct SignalSafeSite
+    {
+        ELevel level;     ///< Level of the record
+        const char *tag;  ///< Record tag
+        const char *msg;  ///< Record message
+        const char *file; ///< Source file of the call site
+        int line;         ///< Source line of the call site
+
+        /**
+         * @brief Format and write the record with the given details
+         *
+         * @param args Details: integers, bools, characters or string literals
+         */
+        template <typename... Args>
+        void operator()(const Args &...args) const
+        {
+            SignalSafeLog::log(level, tag, msg, file, line, args...);
+        }
+    };
+}
@@ -0,0 +1,72 @@
+/**
+ * @file Timestamp.h
+ * @brief Eclipse Logging Library - Table-driven timestamp rendering
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Eclipse
+{
+    /**
+     * @brief Enumeration of timestamp layouts
+     */
+    enum class ETimestampFormat
+    {
+        DEFAULT, ///< Local time as "2025-01-02 03:04:05"
+        ISO8601  ///< Local time as "2025-01-02T03:04:05.123456+01:00"
+    };
+
+    /**
+     * @brief Renders timestamps without streams or strftime
+     *
+     * Digits are copied two at a time from a lookup table into a fixed-width
+     * buffer. The calendar fields and UTC offset come from localtime once per
+     * second and are cached, so most records only render the sub-second digits.
+     *
+     * @note Not thread-safe; use one instance per thread.
+     */
+    class TimestampFormatter
+    {
+    public:
+        static constexpr size_t kMaxLength = 32; ///< Length of the longest layout (ISO8601)
+
+        /**
+         * @brief Render a timestamp into a caller-provided buffer
+         *
+         * @param time Time to render
+         * @param format Layout to use
+         * @param out Buffer of at least kMaxLength bytes; not NUL-terminated
+         * @return size_t Number of bytes written
+         */
+        size_t format(std::chrono::system_clock::time_point time, ETimestampFormat format, char *out);
+
+        /**
+         * @brief Render a timestamp into a string
+         *
+         * @param time Time to render
+         * @param format Layout to use
+         * @return std::string Rendered timestamp
+         */
+        std::string format(std::chrono::system_clock::time_point time, ETimestampFormat format);
+
+    private:
+        /**
+         * @brief Recompute the cached calendar fields for a new second
+         *
+         * @param seconds Seconds since the epoch
+         */
+        void refresh(int64_t seconds);
+
+        int64_t cachedSecond = INT64_MIN; ///< Second the cached fields belong to
+        char date[19] = {};               ///< "YYYY-MM-DD HH:MM:SS" of the cached second
+        char offset[6] = {};              ///< "+hh:mm" UTC offset of the cached second
+    };
+}
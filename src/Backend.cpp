@@ -0,0 +1,89 @@
+#include "Backend.h"
+#include <algorithm>
+
+namespace Eclipse
+{
+    Backend::~Backend()
+    {
+        stop();
+    }
+
+    void Backend::addTask(Task task, std::chrono::milliseconds interval)
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        tasks.push_back({std::move(task), interval, std::chrono::steady_clock::now() + interval});
+        wake();
+    }
+
+    void Backend::start()
+    {
+        if (running.exchange(true))
+        {
+            return;
+        }
+        worker = std::thread(&Backend::run, this);
+    }
+
+    void Backend::stop(std::chrono::steady_clock::time_point deadline)
+    {
+        if (running.exchange(false))
+        {
+            wake();
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+        runDue(true, deadline);
+    }
+
+    bool Backend::isRunning() const
+    {
+        return running.load(std::memory_order_acquire);
+    }
+
+    void Backend::wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wakeRequested = true;
+        }
+        wakeup.notify_one();
+    }
+
+    void Backend::run()
+    {
+        bool woken = false;
+        while (running.load(std::memory_order_acquire))
+        {
+            auto next = runDue(woken);
+
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeup.wait_until(lock, next, [this]()
+                              { return wakeRequested || !running.load(std::memory_order_acquire); });
+            woken = wakeRequested;
+            wakeRequested = false;
+        }
+    }
+
+    std::chrono::steady_clock::time_point Backend::runDue(bool force, std::chrono::steady_clock::time_point deadline)
+    {
+        std::lock_guard<std::mutex> lock(taskMutex);
+        auto now = std::chrono::steady_clock::now();
+        auto next = now + std::chrono::milliseconds(100);
+        for (Entry &entry : tasks)
+        {
+            if (force || entry.next <= now)
+            {
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    break;
+                }
+                entry.task();
+                entry.next = std::chrono::steady_clock::now() + entry.interval;
+            }
+            next = std::min(next, entry.next);
+        }
+        return next;
+    }
+}
@@ -0,0 +1,115 @@
+/**
+ * @file Backend.h
+ * @brief Eclipse Logging Library - Background worker running periodic logger tasks
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Eclipse
+{
+    /**
+     * @brief Single background thread shared by the logger's periodic work
+     *
+     * Runs every registered task at its own interval, so draining, flushing and
+     * housekeeping never execute on a producer thread. Internal to the library.
+     */
+    class Backend
+    {
+    public:
+        using Task = std::function<void()>;
+
+        Backend() = default;
+
+        /**
+         * @brief Stops the thread after a final run of every task
+         */
+        ~Backend();
+
+        Backend(const Backend &) = delete;
+        Backend &operator=(const Backend &) = delete;
+
+        /**
+         * @brief Register a task to run periodically
+         *
+         * Tasks run in registration order on the backend thread and must not call
+         * back into the Backend.
+         *
+         * @param task Work to run
+         * @param interval Time between two runs of the task
+         */
+        void addTask(Task task, std::chrono::milliseconds interval);
+
+        /**
+         * @brief Start the background thread (no effect if already running)
+         */
+        void start();
+
+        /**
+         * @brief Join the background thread, then run every task once more
+         *
+         * The final run drains whatever producers queued before stop() was called.
+         * Tasks not yet started when the deadline passes are skipped.
+         *
+         * @param deadline Time after which the final run starts no further task
+         */
+        void stop(std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+        /**
+         * @brief Check whether the background thread is running
+         *
+         * @return bool True between start() and stop()
+         */
+        bool isRunning() const;
+
+        /**
+         * @brief Run every task now instead of waiting for its interval
+         */
+        void wake();
+
+    private:
+        /**
+         * @brief Registered task and its schedule
+         */
+        struct Entry
+        {
+            Task task;                                  ///< Work to run
+            std::chrono::milliseconds interval;         ///< Time between runs
+            std::chrono::steady_clock::time_point next; ///< Next scheduled run
+        };
+
+        /**
+         * @brief Background loop
+         */
+        void run();
+
+        /**
+         * @brief Run every task whose time has come
+         *
+         * @param force Run every task regardless of its schedule
+         * @param deadline Time after which no further task is started
+         * @return std::chrono::steady_clock::time_point Earliest next scheduled run
+         */
+        std::chrono::steady_clock::time_point runDue(bool force,
+                                                     std::chrono::steady_clock::time_point deadline =
+                                                         std::chrono::steady_clock::time_point::max());
+
+        std::vector<Entry> tasks;           ///< Registered tasks
+        std::mutex taskMutex;               ///< Guards tasks; held while tasks run
+        std::mutex wakeMutex;               ///< Guards the wake-up condition
+        std::condition_variable wakeup;     ///< Signalled by wake() and stop()
+        bool wakeRequested = false;         ///< Set by wake(), cleared by the thread
+        std::thread worker;                 ///< Background thread
+        std::atomic<bool> running{false};   ///< Whether the thread should keep running
+    };
+}
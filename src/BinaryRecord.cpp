@@ -0,0 +1,480 @@
+#include "Eclipse/BinaryRecord.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Eclipse
+{
+    namespace
+    {
+        constexpr char kRecordMarker = '\x02';          ///< First byte of a standalone record
+        constexpr uint8_t kExplicitSequence = 0x08;     ///< Header bit: the sequence is not the previous one plus one
+        constexpr uint8_t kHasTrace = 0x10;             ///< Header bit: a trace string follows the message
+        constexpr unsigned kDetailShift = 5;            ///< Header bits 5-7: detail count
+        constexpr size_t kCountEscape = 7;              ///< Detail count meaning "varint count follows"
+        constexpr size_t kMaxEntryLength = 256;         ///< Longest string kept in the dictionary
+        constexpr size_t kMaxEntries = 4096;            ///< Dictionary entries before a reset
+        constexpr size_t kMaxDictionaryBytes = 256 * 1024; ///< Dictionary bytes before a reset
+        constexpr size_t kStreamIdSize = 8;             ///< Bytes of the stream id after the block marker
+
+        const char *const kLevelNames[] = {"DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+
+        /**
+         * @brief Standalone record with views into the bytes it was parsed from
+         */
+        struct RecordView
+        {
+            uint8_t level = 0;
+            uint64_t sequence = 0;
+            int64_t timeNs = 0;
+            std::string_view tag;
+            std::string_view msg;
+            std::string_view trace;
+        };
+
+        inline uint64_t zigzag(int64_t value)
+        {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        inline int64_t unzigzag(uint64_t value)
+        {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        void appendVarint(uint64_t value, std::string &out)
+        {
+            while (value >= 0x80)
+            {
+                out += static_cast<char>(value | 0x80);
+                value >>= 7;
+            }
+            out += static_cast<char>(value);
+        }
+
+        bool readVarint(const char *&p, const char *end, uint64_t &value)
+        {
+            value = 0;
+            for (unsigned shift = 0; shift < 64 && p < end; shift += 7)
+            {
+                uint8_t byte = static_cast<uint8_t>(*p++);
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void appendText(std::string_view text, std::string &out)
+        {
+            appendVarint(text.size(), out);
+            out.append(text.data(), text.size());
+        }
+
+        bool readText(const char *&p, const char *end, std::string_view &text)
+        {
+            uint64_t size = 0;
+            if (!readVarint(p, end, size) || size > static_cast<uint64_t>(end - p))
+            {
+                return false;
+            }
+            text = std::string_view(p, static_cast<size_t>(size));
+            p += size;
+            return true;
+        }
+
+        /**
+         * @brief Parse one standalone record; details go to a separate list so it can be reused
+         */
+        bool readRecord(const char *&p, const char *end, RecordView &record, std::vector<std::string_view> &details)
+        {
+            uint64_t time = 0;
+            uint64_t count = 0;
+            if (end - p < 2 || p[0] != kRecordMarker)
+            {
+                return false;
+            }
+            record.level = static_cast<uint8_t>(p[1]);
+            p += 2;
+            if (record.level > 7 || !readVarint(p, end, record.sequence) || !readVarint(p, end, time) ||
+                !readVarint(p, end, count) || count > static_cast<uint64_t>(end - p))
+            {
+                return false;
+            }
+            record.timeNs = unzigzag(time);
+            if (!readText(p, end, record.tag) || !readText(p, end, record.msg) || !readText(p, end, record.trace))
+            {
+                return false;
+            }
+            details.resize(static_cast<size_t>(count));
+            for (std::string_view &detail : details)
+            {
+                if (!readText(p, end, detail))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Whether a literal joins the dictionary; encoder and decoder apply the same rule
+         */
+        inline bool joinsDictionary(size_t length, size_t entries, size_t bytes)
+        {
+            return length > 0 && length <= kMaxEntryLength && entries < kMaxEntries &&
+                   bytes + length <= kMaxDictionaryBytes;
+        }
+
+        long currentProcess()
+        {
+#ifdef _WIN32
+            return static_cast<long>(::_getpid());
+#else
+            return static_cast<long>(::getpid());
+#endif
+        }
+
+        uint64_t newStreamId(long process)
+        {
+            // Processes writing at the same time have distinct ids, and so do the encoders of one process
+            static std::atomic<uint32_t> counter{0};
+            return static_cast<uint64_t>(static_cast<uint32_t>(process)) << 32 |
+                   counter.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        inline uint64_t readStreamId(const char *data)
+        {
+            uint64_t id = 0;
+            for (size_t i = 0; i < kStreamIdSize; ++i)
+            {
+                id |= static_cast<uint64_t>(static_cast<uint8_t>(data[1 + i])) << (8 * i);
+            }
+            return id;
+        }
+    }
+
+    void appendBinaryRecord(uint64_t sequence, int64_t timeNs, uint8_t level, std::string_view tag,
+                            std::string_view msg, std::string_view trace, const std::vector<std::string> &details,
+                            std::string &out)
+    {
+        out += kRecordMarker;
+        out += static_cast<char>(level);
+        appendVarint(sequence, out);
+        appendVarint(zigzag(timeNs), out);
+        appendVarint(details.size(), out);
+        appendText(tag, out);
+        appendText(msg, out);
+        appendText(trace, out);
+        for (const std::string &detail : details)
+        {
+            appendText(detail, out);
+        }
+    }
+
+    bool isBinaryRecord(const char *data, size_t size)
+    {
+        return size > 0 && data[0] == kRecordMarker;
+    }
+
+    bool parseBinaryRecords(const char *data, size_t size, std::vector<BinaryRecord> &records)
+    {
+        const char *p = data;
+        const char *end = data + size;
+        RecordView view;
+        std::vector<std::string_view> details;
+        while (p < end)
+        {
+            if (!readRecord(p, end, view, details))
+            {
+                return false;
+            }
+            BinaryRecord record;
+            record.sequence = view.sequence;
+            record.timeNs = view.timeNs;
+            record.level = view.level;
+            record.tag = view.tag;
+            record.msg = view.msg;
+            record.trace = view.trace;
+            record.details.assign(details.begin(), details.end());
+            records.push_back(std::move(record));
+        }
+        return true;
+    }
+
+    void formatBinaryRecord(const BinaryRecord &record, ETimestampFormat format, std::string &out)
+    {
+        // Each thread keeps its own per-second cache
+        thread_local TimestampFormatter formatter;
+        char timestamp[TimestampFormatter::kMaxLength];
+        auto time = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(record.timeNs)));
+        size_t length = formatter.format(time, format, timestamp);
+
+        const size_t maxLevelWidth = 5;
+        std::string levelName = record.level < 5 ? kLevelNames[record.level] : "UNKNOWN";
+        levelName.resize(std::max(levelName.size(), maxLevelWidth), ' ');
+        std::string indent(length + 3 + maxLevelWidth + 2, ' ');
+
+        out += '[';
+        out.append(timestamp, length);
+        out += "] " + levelName + ": ┏ [" + record.tag + "] " + record.msg + "\n";
+        if (!record.trace.empty())
+        {
+            out += indent + (record.details.empty() ? "┗ " : "┃ ") + "at: " + record.trace + "\n";
+        }
+        for (size_t i = 0; i < record.details.size(); ++i)
+        {
+            out += indent + (i == record.details.size() - 1 ? "┗ " : "┃ ") + "[" + std::to_string(i + 1) + "] " +
+                   record.details[i] + "\n";
+        }
+    }
+
+    void BinaryEncoder::reset()
+    {
+        started = false;
+        blocksSinceReset = 0;
+    }
+
+    size_t BinaryEncoder::encode(const char *data, size_t size, size_t limit, std::string &block)
+    {
+        const char *p = data;
+        const char *end = data + size;
+        RecordView record;
+        if (!readRecord(p, end, record, details))
+        {
+            return 0;
+        }
+
+        // A forked child appending to the parent's file writes a stream of its own
+        long process = currentProcess();
+        if (!started || process != processId)
+        {
+            started = true;
+            processId = process;
+            streamId = newStreamId(process);
+            blocksSinceReset = 0;
+        }
+        bool resetBlock = blocksSinceReset == 0 || blocksSinceReset >= kBinaryResetBlocks ||
+                          ids.size() >= kMaxEntries || dictionaryBytes + kMaxEntryLength > kMaxDictionaryBytes;
+        if (resetBlock)
+        {
+            ids.clear();
+            strings.clear();
+            dictionaryBytes = 0;
+            previousSequence = 0;
+            previousTimeNs = 0;
+            blocksSinceReset = 0;
+        }
+
+        block.clear();
+        block += kBinaryBlockMarker;
+        for (size_t i = 0; i < kStreamIdSize; ++i)
+        {
+            block += static_cast<char>(streamId >> (8 * i) & 0xFF);
+        }
+        appendVarint(blockNumber << 1 | (resetBlock ? 1 : 0), block);
+
+        const char *consumed = data;
+        while (true)
+        {
+            uint64_t sequenceDelta = record.sequence - (previousSequence + 1);
+            size_t count = details.size();
+            uint8_t header = static_cast<uint8_t>(record.level | std::min(count, kCountEscape) << kDetailShift);
+            header |= sequenceDelta != 0 ? kExplicitSequence : 0;
+            header |= !record.trace.empty() ? kHasTrace : 0;
+            block += static_cast<char>(header);
+            if (sequenceDelta != 0)
+            {
+                appendVarint(zigzag(static_cast<int64_t>(sequenceDelta)), block);
+            }
+            appendVarint(zigzag(static_cast<int64_t>(static_cast<uint64_t>(record.timeNs) -
+                                                     static_cast<uint64_t>(previousTimeNs))),
+                         block);
+            if (count >= kCountEscape)
+            {
+                appendVarint(count - kCountEscape, block);
+            }
+            appendString(record.tag, block);
+            appendString(record.msg, block);
+            if (!record.trace.empty())
+            {
+                appendString(record.trace, block);
+            }
+            for (std::string_view detail : details)
+            {
+                appendString(detail, block);
+            }
+            previousSequence = record.sequence;
+            previousTimeNs = record.timeNs;
+            consumed = p;
+
+            // Stops at the limit, at the end, or before bytes that are not a record
+            if (block.size() >= limit || p == end || !readRecord(p, end, record, details))
+            {
+                break;
+            }
+        }
+        ++blockNumber;
+        ++blocksSinceReset;
+        return static_cast<size_t>(consumed - data);
+    }
+
+    void BinaryEncoder::appendString(std::string_view text, std::string &block)
+    {
+        auto found = ids.find(text);
+        if (found != ids.end())
+        {
+            appendVarint(static_cast<uint64_t>(found->second) << 1 | 1, block);
+            return;
+        }
+        appendVarint(static_cast<uint64_t>(text.size()) << 1, block);
+        block.append(text.data(), text.size());
+        if (joinsDictionary(text.size(), strings.size(), dictionaryBytes))
+        {
+            strings.emplace_back(text);
+            ids.emplace(strings.back(), static_cast<uint32_t>(strings.size() - 1));
+            dictionaryBytes += text.size();
+        }
+    }
+
+    bool BinaryDecoder::isBlock(const char *data, size_t size)
+    {
+        return size >= 2 + kStreamIdSize && data[0] == kBinaryBlockMarker;
+    }
+
+    bool BinaryDecoder::readBlockHeader(const char *data, size_t size, uint64_t &streamId, bool &reset)
+    {
+        const char *p = data + 1 + kStreamIdSize;
+        uint64_t number = 0;
+        if (!isBlock(data, size) || !readVarint(p, data + size, number))
+        {
+            return false;
+        }
+        streamId = readStreamId(data);
+        reset = (number & 1) != 0;
+        return true;
+    }
+
+    void BinaryDecoder::reset()
+    {
+        streams.clear();
+    }
+
+    bool BinaryDecoder::decode(const char *data, size_t size, std::vector<BinaryRecord> &records)
+    {
+        records.clear();
+        if (!isBlock(data, size))
+        {
+            return false;
+        }
+        uint64_t id = readStreamId(data);
+        const char *p = data + 1 + kStreamIdSize;
+        const char *end = data + size;
+        uint64_t number = 0;
+        if (!readVarint(p, end, number))
+        {
+            return false;
+        }
+
+        Stream &stream = streams[id];
+        if (number & 1)
+        {
+            stream.strings.clear();
+            stream.dictionaryBytes = 0;
+            stream.previousSequence = 0;
+            stream.previousTimeNs = 0;
+            stream.synced = true;
+        }
+        else if (!stream.synced || number >> 1 != stream.nextBlock)
+        {
+            // A block of this stream was lost; its dictionary entries are unknown until the next reset
+            stream.synced = false;
+            return false;
+        }
+        stream.nextBlock = (number >> 1) + 1;
+
+        auto readString = [&](std::string &text)
+        {
+            uint64_t value = 0;
+            if (!readVarint(p, end, value))
+            {
+                return false;
+            }
+            if (value & 1)
+            {
+                if (value >> 1 >= stream.strings.size())
+                {
+                    return false;
+                }
+                text = stream.strings[static_cast<size_t>(value >> 1)];
+                return true;
+            }
+            uint64_t length = value >> 1;
+            if (length > static_cast<uint64_t>(end - p))
+            {
+                return false;
+            }
+            text.assign(p, static_cast<size_t>(length));
+            p += length;
+            if (joinsDictionary(text.size(), stream.strings.size(), stream.dictionaryBytes))
+            {
+                stream.strings.push_back(text);
+                stream.dictionaryBytes += text.size();
+            }
+            return true;
+        };
+
+        while (p < end)
+        {
+            BinaryRecord record;
+            uint8_t header = static_cast<uint8_t>(*p++);
+            uint64_t sequenceDelta = 0;
+            uint64_t timeDelta = 0;
+            uint64_t count = header >> kDetailShift;
+            bool ok = ((header & kExplicitSequence) == 0 || readVarint(p, end, sequenceDelta)) &&
+                      readVarint(p, end, timeDelta);
+            if (ok && count == kCountEscape)
+            {
+                ok = readVarint(p, end, count) && count <= static_cast<uint64_t>(end - p);
+                count += kCountEscape;
+            }
+            ok = ok && readString(record.tag) && readString(record.msg) &&
+                 ((header & kHasTrace) == 0 || readString(record.trace));
+            if (ok)
+            {
+                record.details.resize(static_cast<size_t>(count));
+                for (std::string &detail : record.details)
+                {
+                    if (!(ok = readString(detail)))
+                    {
+                        break;
+                    }
+                }
+            }
+            if (!ok)
+            {
+                stream.synced = false;
+                records.clear();
+                return false;
+            }
+
+            record.level = header & 0x07;
+            record.sequence = stream.previousSequence + 1 + static_cast<uint64_t>(unzigzag(sequenceDelta));
+            record.timeNs = static_cast<int64_t>(static_cast<uint64_t>(stream.previousTimeNs) +
+                                                 static_cast<uint64_t>(unzigzag(timeDelta)));
+            stream.previousSequence = record.sequence;
+            stream.previousTimeNs = record.timeNs;
+            records.push_back(std::move(record));
+        }
+        return true;
+    }
+}
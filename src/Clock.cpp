@@ -0,0 +1,177 @@
+#include "Eclipse/Clock.h"
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+#if ECLIPSE_HAS_TSC && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+namespace Eclipse
+{
+    namespace
+    {
+        constexpr int kSampleAttempts = 5;
+        constexpr double kMinimumNsPerTick = 0.01; ///< 100 GHz
+        constexpr double kMaximumNsPerTick = 10.0; ///< 100 MHz
+        constexpr double kStepTolerance = 0.01;    ///< Rate change treated as a wall-clock step
+
+        int64_t realtimeNs()
+        {
+            return Clock::toNs(std::chrono::system_clock::now());
+        }
+    }
+
+    bool Clock::isTscInvariant()
+    {
+#if ECLIPSE_HAS_TSC && defined(_MSC_VER)
+        int regs[4] = {};
+        __cpuid(regs, 0x80000000);
+        if (static_cast<unsigned>(regs[0]) < 0x80000007u)
+        {
+            return false;
+        }
+        __cpuid(regs, 0x80000007);
+        return (regs[3] & (1 << 8)) != 0;
+#elif ECLIPSE_HAS_TSC
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid_max(0x80000000u, nullptr) < 0x80000007u)
+        {
+            return false;
+        }
+        __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx);
+        return (edx & (1u << 8)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    bool Clock::setSource(EClockSource requested)
+    {
+        std::lock_guard<std::mutex> lock(calibrationMutex);
+        if (requested == EClockSource::REALTIME || requested == EClockSource::MANUAL)
+        {
+            source.store(requested, std::memory_order_relaxed);
+            return true;
+        }
+
+        if (requested == EClockSource::COARSE)
+        {
+#ifdef CLOCK_REALTIME_COARSE
+            source.store(EClockSource::COARSE, std::memory_order_relaxed);
+            return true;
+#else
+            source.store(EClockSource::REALTIME, std::memory_order_relaxed);
+            return false;
+#endif
+        }
+
+        if (!isTscInvariant())
+        {
+            source.store(EClockSource::REALTIME, std::memory_order_relaxed);
+            return false;
+        }
+
+        uint64_t startTicks = 0;
+        int64_t startNs = 0;
+        samplePair(startTicks, startNs);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        uint64_t endTicks = 0;
+        int64_t endNs = 0;
+        samplePair(endTicks, endNs);
+
+        double rate = endTicks > startTicks
+                          ? static_cast<double>(endNs - startNs) / static_cast<double>(endTicks - startTicks)
+                          : 0.0;
+        if (rate < kMinimumNsPerTick || rate > kMaximumNsPerTick)
+        {
+            source.store(EClockSource::REALTIME, std::memory_order_relaxed);
+            return false;
+        }
+
+        firstTicks = startTicks;
+        firstNs = startNs;
+        publish(endTicks, endNs, rate);
+        source.store(EClockSource::TSC, std::memory_order_release);
+        return true;
+    }
+
+    std::chrono::system_clock::time_point Clock::fromTsc(uint64_t ticks) const
+    {
+        uint32_t before = 0;
+        uint64_t baseTicks = 0;
+        int64_t baseNs = 0;
+        double rate = 0.0;
+        do
+        {
+            before = sequence.load(std::memory_order_acquire);
+            baseTicks = tscBase.load(std::memory_order_relaxed);
+            baseNs = nsBase.load(std::memory_order_relaxed);
+            rate = nsPerTick.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((before & 1u) != 0 || sequence.load(std::memory_order_relaxed) != before);
+
+        // Ticks may predate the anchor when a record is converted after a recalibration
+        int64_t delta = static_cast<int64_t>(ticks - baseTicks);
+        return fromNs(baseNs + static_cast<int64_t>(std::llround(static_cast<double>(delta) * rate)));
+    }
+
+    void Clock::recalibrate()
+    {
+        std::lock_guard<std::mutex> lock(calibrationMutex);
+        if (source.load(std::memory_order_relaxed) != EClockSource::TSC)
+        {
+            return;
+        }
+
+        uint64_t ticks = 0;
+        int64_t ns = 0;
+        samplePair(ticks, ns);
+
+        // The longest baseline gives the most precise rate, unless the wall clock was stepped
+        double current = nsPerTick.load(std::memory_order_relaxed);
+        double rate = current;
+        if (ticks > firstTicks)
+        {
+            double measured = static_cast<double>(ns - firstNs) / static_cast<double>(ticks - firstTicks);
+            if (std::fabs(measured - current) <= current * kStepTolerance)
+            {
+                rate = measured;
+            }
+            else
+            {
+                firstTicks = ticks;
+                firstNs = ns;
+            }
+        }
+        publish(ticks, ns, rate);
+    }
+
+    void Clock::samplePair(uint64_t &ticks, int64_t &ns)
+    {
+        uint64_t bestWindow = UINT64_MAX;
+        for (int attempt = 0; attempt < kSampleAttempts; ++attempt)
+        {
+            uint64_t before = readTsc();
+            int64_t wall = realtimeNs();
+            uint64_t after = readTsc();
+            if (after - before < bestWindow)
+            {
+                bestWindow = after - before;
+                ticks = before + (after - before) / 2;
+                ns = wall;
+            }
+        }
+    }
+
+    void Clock::publish(uint64_t ticks, int64_t ns, double rate)
+    {
+        uint32_t current = sequence.load(std::memory_order_relaxed);
+        sequence.store(current + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        tscBase.store(ticks, std::memory_order_relaxed);
+        nsBase.store(ns, std::memory_order_relaxed);
+        nsPerTick.store(rate, std::memory_order_relaxed);
+        sequence.store(current + 2, std::memory_order_release);
+    }
+}
@@ -0,0 +1,598 @@
+#include "Eclipse/ColumnStore.h"
+#include "Eclipse/Frame.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <iterator>
+#include <sstream>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+
+namespace Eclipse
+{
+    namespace
+    {
+        const char kIndexName[] = "INDEX";
+        const char kIndexHeader[] = "# eclipse columns v1: column block first-row rows offset bytes crc min max";
+        const char *const kColumnNames[kColumnCount] = {"time", "level", "tag", "site", "message", "fields"};
+        constexpr char kPlainBlock = 0;                   ///< Codec byte: encoded bytes follow as they are
+        constexpr char kZstdBlock = 1;                    ///< Codec byte: a zstd frame follows
+        // Cut a block early past this many string bytes, well below what a block may decompress to
+        constexpr size_t kMaxBlockBytes = 16u << 20;
+
+        inline uint64_t zigzag(int64_t value)
+        {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        inline int64_t unzigzag(uint64_t value)
+        {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        void appendVarint(uint64_t value, std::string &out)
+        {
+            while (value >= 0x80)
+            {
+                out += static_cast<char>(value | 0x80);
+                value >>= 7;
+            }
+            out += static_cast<char>(value);
+        }
+
+        bool readVarint(const char *&p, const char *end, uint64_t &value)
+        {
+            value = 0;
+            for (unsigned shift = 0; shift < 64 && p < end; shift += 7)
+            {
+                uint8_t byte = static_cast<uint8_t>(*p++);
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (byte < 0x80)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::string columnPath(const std::string &directory, size_t column)
+        {
+            return (std::filesystem::path(directory) / (std::string(kColumnNames[column]) + ".col")).string();
+        }
+
+        /**
+         * @brief Append strings as a block dictionary in first-seen order, then one index per value
+         */
+        void encodeStrings(const std::vector<std::string_view> &values, std::string &out, std::string &minText,
+                           std::string &maxText)
+        {
+            std::unordered_map<std::string_view, uint64_t> ids;
+            std::vector<std::string_view> dictionary;
+            for (std::string_view value : values)
+            {
+                if (ids.emplace(value, dictionary.size()).second)
+                {
+                    dictionary.push_back(value);
+                }
+            }
+
+            appendVarint(dictionary.size(), out);
+            for (std::string_view entry : dictionary)
+            {
+                appendVarint(entry.size(), out);
+                out.append(entry.data(), entry.size());
+            }
+            for (std::string_view value : values)
+            {
+                appendVarint(ids[value], out);
+            }
+
+            if (!dictionary.empty())
+            {
+                auto range = std::minmax_element(dictionary.begin(), dictionary.end());
+                minText.assign(*range.first);
+                maxText.assign(*range.second);
+            }
+        }
+
+        bool decodeStrings(const char *&p, const char *end, uint64_t count, std::vector<std::string> &values)
+        {
+            uint64_t entries = 0;
+            if (!readVarint(p, end, entries) || entries > static_cast<uint64_t>(end - p))
+            {
+                return false;
+            }
+            std::vector<std::string_view> dictionary;
+            dictionary.reserve(static_cast<size_t>(entries));
+            for (uint64_t i = 0; i < entries; ++i)
+            {
+                uint64_t length = 0;
+                if (!readVarint(p, end, length) || length > static_cast<uint64_t>(end - p))
+                {
+                    return false;
+                }
+                dictionary.emplace_back(p, static_cast<size_t>(length));
+                p += length;
+            }
+            if (count > static_cast<uint64_t>(end - p))
+            {
+                return false;
+            }
+            values.reserve(values.size() + static_cast<size_t>(count));
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                uint64_t id = 0;
+                if (!readVarint(p, end, id) || id >= dictionary.size())
+                {
+                    return false;
+                }
+                values.emplace_back(dictionary[static_cast<size_t>(id)]);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Make a string one whitespace-free index field; "-" stands for the empty string
+         */
+        std::string escape(const std::string &text)
+        {
+            if (text.empty())
+            {
+                return "-";
+            }
+            static const char kHex[] = "0123456789ABCDEF";
+            std::string out;
+            for (char c : text)
+            {
+                unsigned char u = static_cast<unsigned char>(c);
+                if (u <= ' ' || u == 0x7F || c == '%' || (c == '-' && out.empty()))
+                {
+                    out += '%';
+                    out += kHex[u >> 4];
+                    out += kHex[u & 0x0F];
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+            return out;
+        }
+
+        bool unescape(const std::string &field, std::string &text)
+        {
+            text.clear();
+            if (field == "-")
+            {
+                return true;
+            }
+            for (size_t i = 0; i < field.size(); ++i)
+            {
+                if (field[i] != '%')
+                {
+                    text += field[i];
+                    continue;
+                }
+                if (i + 2 >= field.size() || !std::isxdigit(static_cast<unsigned char>(field[i + 1])) ||
+                    !std::isxdigit(static_cast<unsigned char>(field[i + 2])))
+                {
+                    return false;
+                }
+                text += static_cast<char>(std::strtoul(field.substr(i + 1, 2).c_str(), nullptr, 16));
+                i += 2;
+            }
+            return true;
+        }
+
+        bool isNumeric(EColumn column)
+        {
+            return column == EColumn::TIME || column == EColumn::LEVEL;
+        }
+    }
+
+    const char *getColumnName(EColumn column)
+    {
+        return kColumnNames[static_cast<size_t>(column)];
+    }
+
+    ColumnWriter::ColumnWriter(size_t rowsPerBlock) : rowsPerBlock(std::max<size_t>(rowsPerBlock, 1))
+    {
+    }
+
+    bool ColumnWriter::open(const std::string &directory)
+    {
+        if (!this->directory.empty())
+        {
+            close();
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        // A stale index would describe column files about to be replaced
+        std::filesystem::remove(std::filesystem::path(directory) / kIndexName, error);
+        for (size_t i = 0; i < kColumnCount; ++i)
+        {
+            files[i].close();
+            files[i].clear();
+            files[i].open(columnPath(directory, i), std::ios::binary | std::ios::trunc);
+            offsets[i] = 0;
+            if (!files[i].is_open())
+            {
+                for (size_t j = 0; j < i; ++j)
+                {
+                    files[j].close();
+                }
+                return false;
+            }
+        }
+
+        this->directory = directory;
+        blocks.clear();
+        rows = 0;
+        blockNumber = 0;
+        bufferedBytes = 0;
+        failed = false;
+        return true;
+    }
+
+    bool ColumnWriter::add(const BinaryRecord &record)
+    {
+        if (directory.empty() || failed)
+        {
+            return false;
+        }
+
+        times.push_back(record.timeNs);
+        levels.push_back(record.level);
+        strings[0].push_back(record.tag);
+        strings[1].push_back(record.trace);
+        strings[2].push_back(record.msg);
+        fields.push_back(record.details);
+        bufferedBytes += record.tag.size() + record.trace.size() + record.msg.size();
+        for (const std::string &detail : record.details)
+        {
+            bufferedBytes += detail.size() + 1;
+        }
+        ++rows;
+
+        if ((times.size() >= rowsPerBlock || bufferedBytes >= kMaxBlockBytes) && !flush())
+        {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool ColumnWriter::close()
+    {
+        if (directory.empty())
+        {
+            return false;
+        }
+
+        bool complete = !failed && flush();
+        for (std::ofstream &file : files)
+        {
+            file.flush();
+            complete = complete && file.good();
+            file.close();
+        }
+
+        if (complete)
+        {
+            const std::filesystem::path target = std::filesystem::path(directory) / kIndexName;
+            const std::filesystem::path temporary = target.string() + ".tmp";
+            {
+                std::ofstream index(temporary, std::ios::trunc);
+                index << kIndexHeader << '\n';
+                for (const ColumnBlock &block : blocks)
+                {
+                    index << getColumnName(block.column) << ' ' << block.block << ' ' << block.firstRow << ' '
+                          << block.rows << ' ' << block.offset << ' ' << block.bytes << ' ' << block.crc << ' ';
+                    if (isNumeric(block.column))
+                    {
+                        index << block.minValue << ' ' << block.maxValue << '\n';
+                    }
+                    else
+                    {
+                        index << escape(block.minText) << ' ' << escape(block.maxText) << '\n';
+                    }
+                }
+                index.flush();
+                complete = index.good();
+            }
+            // Readers see a part either without an index or with a complete one
+            std::error_code error;
+            std::filesystem::rename(temporary, target, error);
+            complete = complete && !error;
+        }
+
+        directory.clear();
+        blocks.clear();
+        return complete;
+    }
+
+    uint64_t ColumnWriter::getRowCount() const
+    {
+        return rows;
+    }
+
+    uint64_t ColumnWriter::getStoredBytes() const
+    {
+        uint64_t total = 0;
+        for (uint64_t offset : offsets)
+        {
+            total += offset;
+        }
+        return total;
+    }
+
+    bool ColumnWriter::flush()
+    {
+        if (times.empty())
+        {
+            return true;
+        }
+
+        ColumnBlock base;
+        base.block = blockNumber++;
+        base.firstRow = rows - times.size();
+        base.rows = static_cast<uint32_t>(times.size());
+        bool stored = true;
+
+        // Deltas wrap instead of overflowing; the reader wraps them back
+        ColumnBlock time = base;
+        time.column = EColumn::TIME;
+        time.minValue = *std::min_element(times.begin(), times.end());
+        time.maxValue = *std::max_element(times.begin(), times.end());
+        scratch.clear();
+        uint64_t previous = 0;
+        for (int64_t value : times)
+        {
+            appendVarint(zigzag(static_cast<int64_t>(static_cast<uint64_t>(value) - previous)), scratch);
+            previous = static_cast<uint64_t>(value);
+        }
+        stored = store(time, scratch) && stored;
+
+        ColumnBlock level = base;
+        level.column = EColumn::LEVEL;
+        level.minValue = *std::min_element(levels.begin(), levels.end());
+        level.maxValue = *std::max_element(levels.begin(), levels.end());
+        scratch.assign(levels.begin(), levels.end());
+        stored = store(level, scratch) && stored;
+
+        const EColumn stringColumns[] = {EColumn::TAG, EColumn::SITE, EColumn::MESSAGE};
+        std::vector<std::string_view> views;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            ColumnBlock block = base;
+            block.column = stringColumns[i];
+            views.assign(strings[i].begin(), strings[i].end());
+            scratch.clear();
+            encodeStrings(views, scratch, block.minText, block.maxText);
+            stored = store(block, scratch) && stored;
+        }
+
+        // Detail counts first, then every detail as one string sequence
+        ColumnBlock detail = base;
+        detail.column = EColumn::FIELDS;
+        scratch.clear();
+        views.clear();
+        for (const std::vector<std::string> &row : fields)
+        {
+            appendVarint(row.size(), scratch);
+            views.insert(views.end(), row.begin(), row.end());
+        }
+        encodeStrings(views, scratch, detail.minText, detail.maxText);
+        stored = store(detail, scratch) && stored;
+
+        times.clear();
+        levels.clear();
+        for (std::vector<std::string> &column : strings)
+        {
+            column.clear();
+        }
+        fields.clear();
+        bufferedBytes = 0;
+        return stored;
+    }
+
+    bool ColumnWriter::store(ColumnBlock &block, const std::string &encoded)
+    {
+        const std::string *payload = &encoded;
+        char codec = kPlainBlock;
+        if (Compressor::isAvailable() && compressor.compress(encoded.data(), encoded.size(), compressed) &&
+            compressed.size() < encoded.size())
+        {
+            payload = &compressed;
+            codec = kZstdBlock;
+        }
+
+        size_t column = static_cast<size_t>(block.column);
+        block.offset = offsets[column];
+        block.bytes = static_cast<uint32_t>(1 + payload->size());
+        block.crc = crc32c(payload->data(), payload->size(), crc32c(&codec, 1));
+        files[column].put(codec);
+        files[column].write(payload->data(), static_cast<std::streamsize>(payload->size()));
+        offsets[column] += block.bytes;
+        blocks.push_back(block);
+        return files[column].good();
+    }
+
+    bool ColumnReader::open(const std::string &directory)
+    {
+        for (size_t i = 0; i < kColumnCount; ++i)
+        {
+            blocks[i].clear();
+            files[i].close();
+            files[i].clear();
+        }
+        rows = 0;
+        this->directory = directory;
+
+        std::ifstream index((std::filesystem::path(directory) / kIndexName).string());
+        if (!index.is_open())
+        {
+            return false;
+        }
+        std::string line;
+        while (std::getline(index, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+            std::istringstream fields(line);
+            std::string name, minField, maxField;
+            ColumnBlock block;
+            if (!(fields >> name >> block.block >> block.firstRow >> block.rows >> block.offset >> block.bytes >>
+                  block.crc >> minField >> maxField) ||
+                block.bytes == 0)
+            {
+                return false;
+            }
+            auto column = std::find(std::begin(kColumnNames), std::end(kColumnNames), name);
+            if (column == std::end(kColumnNames))
+            {
+                return false;
+            }
+            block.column = static_cast<EColumn>(column - std::begin(kColumnNames));
+            if (isNumeric(block.column))
+            {
+                block.minValue = std::strtoll(minField.c_str(), nullptr, 10);
+                block.maxValue = std::strtoll(maxField.c_str(), nullptr, 10);
+            }
+            else if (!unescape(minField, block.minText) || !unescape(maxField, block.maxText))
+            {
+                return false;
+            }
+            if (block.column == EColumn::TIME)
+            {
+                rows += block.rows;
+            }
+            blocks[static_cast<size_t>(block.column)].push_back(std::move(block));
+        }
+        return true;
+    }
+
+    const std::vector<ColumnBlock> &ColumnReader::getBlocks(EColumn column) const
+    {
+        return blocks[static_cast<size_t>(column)];
+    }
+
+    uint64_t ColumnReader::getRowCount() const
+    {
+        return rows;
+    }
+
+    bool ColumnReader::readTimes(const ColumnBlock &block, std::vector<int64_t> &values)
+    {
+        values.clear();
+        if (block.column != EColumn::TIME || !load(block))
+        {
+            return false;
+        }
+        const char *p = scratch.data();
+        const char *end = p + scratch.size();
+        values.reserve(block.rows);
+        uint64_t previous = 0;
+        for (uint32_t i = 0; i < block.rows; ++i)
+        {
+            uint64_t delta = 0;
+            if (!readVarint(p, end, delta))
+            {
+                return false;
+            }
+            previous += static_cast<uint64_t>(unzigzag(delta));
+            values.push_back(static_cast<int64_t>(previous));
+        }
+        return p == end;
+    }
+
+    bool ColumnReader::readLevels(const ColumnBlock &block, std::vector<uint8_t> &values)
+    {
+        values.clear();
+        if (block.column != EColumn::LEVEL || !load(block) || scratch.size() != block.rows)
+        {
+            return false;
+        }
+        values.assign(scratch.begin(), scratch.end());
+        return true;
+    }
+
+    bool ColumnReader::readStrings(const ColumnBlock &block, std::vector<std::string> &values)
+    {
+        values.clear();
+        if (isNumeric(block.column) || block.column == EColumn::FIELDS || !load(block))
+        {
+            return false;
+        }
+        const char *p = scratch.data();
+        const char *end = p + scratch.size();
+        return decodeStrings(p, end, block.rows, values) && p == end;
+    }
+
+    bool ColumnReader::readFields(const ColumnBlock &block, std::vector<std::vector<std::string>> &values)
+    {
+        values.clear();
+        if (block.column != EColumn::FIELDS || !load(block))
+        {
+            return false;
+        }
+        const char *p = scratch.data();
+        const char *end = p + scratch.size();
+        std::vector<uint64_t> counts(block.rows);
+        uint64_t total = 0;
+        for (uint64_t &count : counts)
+        {
+            if (!readVarint(p, end, count) || count > static_cast<uint64_t>(end - p))
+            {
+                return false;
+            }
+            total += count;
+        }
+        std::vector<std::string> details;
+        if (!decodeStrings(p, end, total, details) || p != end)
+        {
+            return false;
+        }
+        values.resize(block.rows);
+        size_t next = 0;
+        for (uint32_t i = 0; i < block.rows; ++i)
+        {
+            auto first = details.begin() + static_cast<std::ptrdiff_t>(next);
+            values[i].assign(std::make_move_iterator(first),
+                             std::make_move_iterator(first + static_cast<std::ptrdiff_t>(counts[i])));
+            next += static_cast<size_t>(counts[i]);
+        }
+        return true;
+    }
+
+    bool ColumnReader::load(const ColumnBlock &block)
+    {
+        size_t column = static_cast<size_t>(block.column);
+        std::ifstream &file = files[column];
+        if (!file.is_open())
+        {
+            file.open(columnPath(directory, column), std::ios::binary);
+        }
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(block.offset));
+        stored.resize(block.bytes);
+        file.read(&stored[0], static_cast<std::streamsize>(block.bytes));
+        if (file.gcount() != static_cast<std::streamsize>(block.bytes) ||
+            crc32c(stored.data(), stored.size()) != block.crc)
+        {
+            return false;
+        }
+
+        if (stored[0] == kPlainBlock)
+        {
+            scratch.assign(stored, 1, std::string::npos);
+            return true;
+        }
+        return stored[0] == kZstdBlock && decompressor.decompress(stored.data() + 1, stored.size() - 1, scratch);
+    }
+}
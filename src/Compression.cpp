@@ -0,0 +1,204 @@
+#include "Eclipse/Compression.h"
+#include "Eclipse/Frame.h"
+
+#ifdef ECLIPSE_HAVE_ZSTD
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
+namespace Eclipse
+{
+#ifdef ECLIPSE_HAVE_ZSTD
+    struct Compressor::State
+    {
+        ~State()
+        {
+            ZSTD_freeCDict(cdict);
+            ZSTD_freeDDict(ddict);
+            ZSTD_freeCCtx(cctx);
+            ZSTD_freeDCtx(dctx);
+        }
+
+        ZSTD_CCtx *cctx = ZSTD_createCCtx(); ///< Reused by every compress()
+        ZSTD_DCtx *dctx = ZSTD_createDCtx(); ///< Reused by every decompress()
+        ZSTD_CDict *cdict = nullptr;         ///< Digested dictionary for compression, if any
+        ZSTD_DDict *ddict = nullptr;         ///< Digested dictionary for decompression, if any
+        uint32_t dictionaryId = 0;           ///< Id of the dictionary, 0 without one
+        int level = 3;                       ///< Compression level without a dictionary
+    };
+
+    Compressor::Compressor() : state(new State())
+    {
+    }
+#else
+    struct Compressor::State
+    {
+    };
+
+    Compressor::Compressor() = default;
+#endif
+
+    Compressor::~Compressor() = default;
+
+    bool Compressor::isAvailable()
+    {
+#ifdef ECLIPSE_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    bool Compressor::setDictionary(const std::string &dictionary, int level)
+    {
+#ifdef ECLIPSE_HAVE_ZSTD
+        if (!state->cctx || !state->dctx)
+        {
+            return false;
+        }
+        // Only trained dictionaries carry an id; a frame without one is decoded without a dictionary
+        uint32_t id = dictionary.empty() ? 0 : ZDICT_getDictID(dictionary.data(), dictionary.size());
+        if (!dictionary.empty() && id == 0)
+        {
+            return false;
+        }
+
+        ZSTD_CDict *cdict = nullptr;
+        ZSTD_DDict *ddict = nullptr;
+        if (!dictionary.empty())
+        {
+            cdict = ZSTD_createCDict(dictionary.data(), dictionary.size(), level);
+            ddict = ZSTD_createDDict(dictionary.data(), dictionary.size());
+            if (!cdict || !ddict)
+            {
+                ZSTD_freeCDict(cdict);
+                ZSTD_freeDDict(ddict);
+                return false;
+            }
+        }
+        ZSTD_freeCDict(state->cdict);
+        ZSTD_freeDDict(state->ddict);
+        state->cdict = cdict;
+        state->ddict = ddict;
+        state->dictionaryId = id;
+        state->level = level;
+        return true;
+#else
+        (void)dictionary;
+        (void)level;
+        return false;
+#endif
+    }
+
+    uint32_t Compressor::getDictionaryId() const
+    {
+#ifdef ECLIPSE_HAVE_ZSTD
+        return state->dictionaryId;
+#else
+        return 0;
+#endif
+    }
+
+    bool Compressor::compress(const char *data, size_t size, std::string &out)
+    {
+#ifdef ECLIPSE_HAVE_ZSTD
+        if (!state->cctx)
+        {
+            return false;
+        }
+        size_t bound = ZSTD_compressBound(size);
+        out.resize(bound);
+        size_t written = state->cdict
+                             ? ZSTD_compress_usingCDict(state->cctx, &out[0], bound, data, size, state->cdict)
+                             : ZSTD_compressCCtx(state->cctx, &out[0], bound, data, size, state->level);
+        if (ZSTD_isError(written))
+        {
+            out.clear();
+            return false;
+        }
+        out.resize(written);
+        return true;
+#else
+        (void)data;
+        (void)size;
+        (void)out;
+        return false;
+#endif
+    }
+
+    bool Compressor::decompress(const char *data, size_t size, std::string &out)
+    {
+#ifdef ECLIPSE_HAVE_ZSTD
+        if (!state->dctx)
+        {
+            return false;
+        }
+        unsigned frameDictionary = ZSTD_getDictID_fromFrame(data, size);
+        if (frameDictionary != 0 && frameDictionary != state->dictionaryId)
+        {
+            return false;
+        }
+        // Writers compress at most one frame payload at a time
+        unsigned long long content = ZSTD_getFrameContentSize(data, size);
+        if (content == ZSTD_CONTENTSIZE_UNKNOWN || content == ZSTD_CONTENTSIZE_ERROR || content > kMaxFramePayload)
+        {
+            return false;
+        }
+        out.resize(static_cast<size_t>(content));
+        size_t written = frameDictionary != 0
+                             ? ZSTD_decompress_usingDDict(state->dctx, &out[0], out.size(), data, size, state->ddict)
+                             : ZSTD_decompressDCtx(state->dctx, &out[0], out.size(), data, size);
+        if (ZSTD_isError(written) || written != out.size())
+        {
+            out.clear();
+            return false;
+        }
+        return true;
+#else
+        (void)data;
+        (void)size;
+        (void)out;
+        return false;
+#endif
+    }
+
+    bool Compressor::isCompressed(const char *data, size_t size)
+    {
+        // ZSTD_MAGICNUMBER 0xFD2FB528, little-endian
+        return size >= 4 && static_cast<unsigned char>(data[0]) == 0x28 && static_cast<unsigned char>(data[1]) == 0xB5 &&
+               static_cast<unsigned char>(data[2]) == 0x2F && static_cast<unsigned char>(data[3]) == 0xFD;
+    }
+
+    bool Compressor::trainDictionary(const std::vector<std::string> &samples, size_t capacity, std::string &dictionary)
+    {
+#ifdef ECLIPSE_HAVE_ZSTD
+        std::string buffer;
+        std::vector<size_t> sizes;
+        sizes.reserve(samples.size());
+        for (const std::string &sample : samples)
+        {
+            buffer += sample;
+            sizes.push_back(sample.size());
+        }
+        if (sizes.empty() || capacity == 0)
+        {
+            return false;
+        }
+        dictionary.resize(capacity);
+        size_t trained = ZDICT_trainFromBuffer(&dictionary[0], capacity, buffer.data(), sizes.data(),
+                                               static_cast<unsigned>(sizes.size()));
+        if (ZDICT_isError(trained))
+        {
+            dictionary.clear();
+            return false;
+        }
+        dictionary.resize(trained);
+        return true;
+#else
+        (void)samples;
+        (void)capacity;
+        (void)dictionary;
+        return false;
+#endif
+    }
+}
@@ -0,0 +1,637 @@
+#include "Eclipse/FileSink.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Eclipse
+{
+    namespace
+    {
+        constexpr size_t kMinimumAtomicLimit = 64;
+        constexpr size_t kDefaultBlockLimit = 4096;    ///< BINARY block size without an atomic limit
+        const char kTruncatedMarker[] = " [truncated]\n";
+        constexpr size_t kDirectBlock = 4096;          ///< O_DIRECT alignment; a multiple of every common sector size
+        constexpr uint64_t kDropStep = 1024 * 1024;    ///< DONTNEED: bytes written between page-cache drops
+
+        inline uint64_t roundUp(uint64_t value, uint64_t step)
+        {
+            return (value + step - 1) / step * step;
+        }
+
+#ifdef _WIN32
+        int openAppend(const char *path)
+        {
+            return ::_open(path, _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+        }
+
+        long writeFd(int fd, const char *data, size_t size)
+        {
+            return ::_write(fd, data, static_cast<unsigned int>(size));
+        }
+
+        void closeFd(int fd)
+        {
+            ::_close(fd);
+        }
+
+        bool replaceFd(int from, int to)
+        {
+            if (::_dup2(from, to) != 0)
+            {
+                return false;
+            }
+            ::_close(from);
+            return true;
+        }
+#else
+        int openAppend(const char *path)
+        {
+            return ::open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        }
+
+        long writeFd(int fd, const char *data, size_t size)
+        {
+            return static_cast<long>(::write(fd, data, size));
+        }
+
+        void closeFd(int fd)
+        {
+            ::close(fd);
+        }
+
+        /**
+         * @brief Point descriptor to at from's file and close from
+         *
+         * The descriptor number stays valid throughout, so a signal handler
+         * holding it writes to one file or the other, never to a closed slot.
+         */
+        bool replaceFd(int from, int to)
+        {
+#ifdef __linux__
+            if (::dup3(from, to, O_CLOEXEC) < 0)
+            {
+                return false;
+            }
+#else
+            if (::dup2(from, to) < 0)
+            {
+                return false;
+            }
+            ::fcntl(to, F_SETFD, FD_CLOEXEC);
+#endif
+            ::close(from);
+            return true;
+        }
+#endif
+
+#ifdef __linux__
+        int openDirect(const char *path)
+        {
+            return ::open(path, O_RDWR | O_CREAT | O_DIRECT | O_CLOEXEC, 0644);
+        }
+
+        uint64_t currentEnd(int fd)
+        {
+            off_t end = ::lseek(fd, 0, SEEK_CUR);
+            return end < 0 ? 0 : static_cast<uint64_t>(end);
+        }
+#endif
+    }
+
+    FileSink::~FileSink()
+    {
+        close();
+    }
+
+    bool FileSink::open(const std::string &filePath)
+    {
+        close();
+        activeMode = ECacheMode::NORMAL;
+        reservedEnd = writebackEnd = droppedEnd = 0;
+        lastError = 0;
+        encoder.reset();
+
+#ifdef __linux__
+        if (cacheMode == ECacheMode::DIRECT)
+        {
+            fd = openDirect(filePath.c_str());
+            if (fd >= 0)
+            {
+                struct stat info{};
+                if (::fstat(fd, &info) != 0)
+                {
+                    close();
+                    return false;
+                }
+                // Keep the partial last block, so the next write rewrites it in place
+                uint64_t size = static_cast<uint64_t>(info.st_size);
+                stagingOffset = size / kDirectBlock * kDirectBlock;
+                stagingFill = static_cast<size_t>(size - stagingOffset);
+                stagingCapacity = 16 * kDirectBlock;
+                void *buffer = nullptr;
+                if (::posix_memalign(&buffer, kDirectBlock, stagingCapacity) != 0)
+                {
+                    close();
+                    return false;
+                }
+                staging = static_cast<char *>(buffer);
+                if (stagingFill > 0 &&
+                    ::pread(fd, staging, kDirectBlock, static_cast<off_t>(stagingOffset)) < static_cast<ssize_t>(stagingFill))
+                {
+                    close();
+                    return false;
+                }
+                activeMode = ECacheMode::DIRECT;
+                afterWrite(size);
+                writeHeader();
+                return true;
+            }
+            if (errno != EINVAL)
+            {
+                return false;
+            }
+            // The file system does not support O_DIRECT
+        }
+#endif
+
+        fd = openAppend(filePath.c_str());
+        if (fd < 0)
+        {
+            return false;
+        }
+#ifdef __linux__
+        if (cacheMode != ECacheMode::NORMAL)
+        {
+            activeMode = ECacheMode::DONTNEED;
+        }
+        uint64_t end = static_cast<uint64_t>(::lseek(fd, 0, SEEK_END));
+        writebackEnd = droppedEnd = end;
+        afterWrite(end);
+#endif
+        writeHeader();
+        return true;
+    }
+
+    void FileSink::close()
+    {
+        if (fd < 0)
+        {
+            return;
+        }
+        finish();
+        release();
+    }
+
+    bool FileSink::reopen(const std::string &filePath)
+    {
+        if (fd < 0 || activeMode == ECacheMode::DIRECT)
+        {
+            // DIRECT state belongs to one file; start over
+            return open(filePath);
+        }
+
+        int replacement = openAppend(filePath.c_str());
+        if (replacement < 0)
+        {
+            // Keep appending to the old file rather than losing records
+            return false;
+        }
+        finish();
+        if (!replaceFd(replacement, fd))
+        {
+            closeFd(fd);
+            fd = replacement;
+        }
+#ifdef __linux__
+        uint64_t end = static_cast<uint64_t>(::lseek(fd, 0, SEEK_END));
+        reservedEnd = 0;
+        writebackEnd = droppedEnd = end;
+        afterWrite(end);
+#endif
+        encoder.reset();
+        writeHeader();
+        return true;
+    }
+
+    bool FileSink::isCurrent(const std::string &filePath) const
+    {
+        if (fd < 0)
+        {
+            return false;
+        }
+#ifdef _WIN32
+        (void)filePath;
+        return true;
+#else
+        struct stat opened{};
+        struct stat named{};
+        if (::fstat(fd, &opened) != 0 || ::stat(filePath.c_str(), &named) != 0)
+        {
+            return false;
+        }
+        return opened.st_dev == named.st_dev && opened.st_ino == named.st_ino;
+#endif
+    }
+
+    void FileSink::finish()
+    {
+#ifdef __linux__
+        if (activeMode == ECacheMode::DIRECT)
+        {
+            // Every write stored the tail padded to a whole block; cut the padding
+            if (::ftruncate(fd, static_cast<off_t>(stagingOffset + stagingFill)) != 0)
+            {
+                // Nothing useful to do; the file ends in NUL padding
+            }
+        }
+        else if (activeMode == ECacheMode::DONTNEED)
+        {
+            uint64_t end = currentEnd(fd);
+            ::sync_file_range(fd, static_cast<off_t>(droppedEnd), static_cast<off_t>(end - droppedEnd),
+                              SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+            ::posix_fadvise(fd, static_cast<off_t>(droppedEnd), static_cast<off_t>(end - droppedEnd), POSIX_FADV_DONTNEED);
+        }
+#endif
+    }
+
+    void FileSink::release()
+    {
+        if (fd >= 0)
+        {
+            closeFd(fd);
+            fd = -1;
+        }
+        freeStaging();
+        activeMode = ECacheMode::NORMAL;
+    }
+
+    bool FileSink::isOpen() const
+    {
+        return fd >= 0;
+    }
+
+    int FileSink::getDescriptor() const
+    {
+        return fd;
+    }
+
+    uint64_t FileSink::getBytesWritten() const
+    {
+        return bytesWritten;
+    }
+
+    int FileSink::getLastError() const
+    {
+        return lastError;
+    }
+
+    bool FileSink::write(const std::string &data)
+    {
+        return write(data.data(), data.size());
+    }
+
+    bool FileSink::write(const char *data, size_t size)
+    {
+        if (fd < 0)
+        {
+            lastError = EBADF;
+            return false;
+        }
+        if (format == EFileFormat::BINARY && isBinaryRecord(data, size))
+        {
+            return writeBinary(data, size);
+        }
+        if (atomicLimit == 0 || size <= atomicLimit)
+        {
+            return writeAll(data, size);
+        }
+        return writeOversize(data, size);
+    }
+
+    bool FileSink::writeBinary(const char *data, size_t size)
+    {
+        const size_t blockLimit = atomicLimit == 0 ? kDefaultBlockLimit : atomicLimit;
+        bool ok = true;
+        while (size > 0)
+        {
+            size_t used = encoder.encode(data, size, blockLimit, block);
+            if (used == 0)
+            {
+                // Not records, e.g. text buffered before the format changed; kept as a plain payload
+                return writeAll(data, size) && ok;
+            }
+            if (!writeFrame(block.data(), block.size()))
+            {
+                // The reader never sees this block's dictionary entries; start over
+                encoder.reset();
+                ok = false;
+            }
+            data += used;
+            size -= used;
+        }
+        return ok;
+    }
+
+    void FileSink::setAtomicLimit(size_t bytes)
+    {
+        atomicLimit = bytes == 0 ? 0 : std::max(bytes, kMinimumAtomicLimit);
+    }
+
+    size_t FileSink::getAtomicLimit() const
+    {
+        return atomicLimit;
+    }
+
+    void FileSink::setOversizePolicy(EOversize policy)
+    {
+        oversizePolicy = policy;
+    }
+
+    EOversize FileSink::getOversizePolicy() const
+    {
+        return oversizePolicy;
+    }
+
+    void FileSink::setCacheMode(ECacheMode mode)
+    {
+        cacheMode = mode;
+    }
+
+    ECacheMode FileSink::getCacheMode() const
+    {
+        return fd >= 0 ? activeMode : cacheMode;
+    }
+
+    void FileSink::setPreallocation(size_t bytes)
+    {
+        preallocateBytes = bytes;
+    }
+
+    size_t FileSink::getPreallocation() const
+    {
+        return preallocateBytes;
+    }
+
+    void FileSink::setFormat(EFileFormat value)
+    {
+        format = value;
+        encoder.reset();
+        writeHeader();
+    }
+
+    EFileFormat FileSink::getFormat() const
+    {
+        return format;
+    }
+
+    bool FileSink::setDictionary(const std::string &dictionary, int level)
+    {
+        return compressor.setDictionary(dictionary, level);
+    }
+
+    uint32_t FileSink::getDictionaryId() const
+    {
+        return compressor.getDictionaryId();
+    }
+
+    bool FileSink::writeAll(const char *data, size_t size)
+    {
+        if (format == EFileFormat::TEXT)
+        {
+            return writeRaw(data, size);
+        }
+        bool ok = true;
+        do
+        {
+            size_t part = std::min<size_t>(size, kMaxFramePayload);
+            // Without zstd, or when it does not help, the payload stays plain; readers tell by the zstd magic
+            if (format == EFileFormat::COMPRESSED && compressor.compress(data, part, compressed) &&
+                compressed.size() < part)
+            {
+                ok = writeFrame(compressed.data(), compressed.size()) && ok;
+            }
+            else
+            {
+                ok = writeFrame(data, part) && ok;
+            }
+            data += part;
+            size -= part;
+        } while (size > 0);
+        return ok;
+    }
+
+    bool FileSink::writeFrame(const char *payload, size_t size)
+    {
+        // Header and payload leave in one write, like an unframed record
+        frame.resize(kFrameHeaderSize + size);
+        encodeFrameHeader(&frame[0], payload, static_cast<uint32_t>(size));
+        std::memcpy(&frame[kFrameHeaderSize], payload, size);
+        return writeRaw(frame.data(), frame.size());
+    }
+
+    void FileSink::writeHeader()
+    {
+        if (fd < 0 || format != EFileFormat::COMPRESSED)
+        {
+            return;
+        }
+#ifdef __linux__
+        uint64_t end = activeMode == ECacheMode::DIRECT ? stagingOffset + stagingFill
+                                                        : static_cast<uint64_t>(::lseek(fd, 0, SEEK_END));
+#elif defined(_WIN32)
+        uint64_t end = static_cast<uint64_t>(::_lseeki64(fd, 0, SEEK_END));
+#else
+        uint64_t end = static_cast<uint64_t>(::lseek(fd, 0, SEEK_END));
+#endif
+        // Appending to an existing file keeps its header
+        if (end != 0)
+        {
+            return;
+        }
+        char payload[kCompressionHeaderSize];
+        encodeCompressionHeader(payload, compressor.getDictionaryId());
+        writeFrame(payload, sizeof(payload));
+    }
+
+    bool FileSink::writeRaw(const char *data, size_t size)
+    {
+#ifdef __linux__
+        if (activeMode == ECacheMode::DIRECT)
+        {
+            return writeDirect(data, size);
+        }
+        const bool track = activeMode == ECacheMode::DONTNEED || preallocateBytes > 0;
+#endif
+        while (size > 0)
+        {
+            long written = writeFd(fd, data, size);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                lastError = errno;
+                return false;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+            bytesWritten += static_cast<uint64_t>(written);
+        }
+#ifdef __linux__
+        if (track)
+        {
+            afterWrite(currentEnd(fd));
+        }
+#endif
+        return true;
+    }
+
+    bool FileSink::writeDirect(const char *data, size_t size)
+    {
+#ifdef __linux__
+        size_t needed = static_cast<size_t>(roundUp(stagingFill + size, kDirectBlock));
+        if (needed > stagingCapacity)
+        {
+            void *buffer = nullptr;
+            if (::posix_memalign(&buffer, kDirectBlock, needed) != 0)
+            {
+                lastError = ENOMEM;
+                return false;
+            }
+            std::memcpy(buffer, staging, stagingFill);
+            std::free(staging);
+            staging = static_cast<char *>(buffer);
+            stagingCapacity = needed;
+        }
+
+        std::memcpy(staging + stagingFill, data, size);
+        stagingFill += size;
+        std::memset(staging + stagingFill, 0, needed - stagingFill);
+
+        size_t done = 0;
+        while (done < needed)
+        {
+            ssize_t written = ::pwrite(fd, staging + done, needed - done, static_cast<off_t>(stagingOffset + done));
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                // Drop the data again, so the staging buffer still matches the file
+                lastError = errno;
+                stagingFill -= size;
+                return false;
+            }
+            done += static_cast<size_t>(written);
+        }
+        // Padding is rewritten by the next write; only the data counts
+        bytesWritten += size;
+        afterWrite(stagingOffset + needed);
+
+        // Whole blocks are final; keep only the partial tail for the next write
+        size_t complete = stagingFill / kDirectBlock * kDirectBlock;
+        if (complete > 0)
+        {
+            std::memmove(staging, staging + complete, stagingFill - complete);
+            stagingOffset += complete;
+            stagingFill -= complete;
+        }
+        return true;
+#else
+        (void)data;
+        (void)size;
+        return false;
+#endif
+    }
+
+    void FileSink::afterWrite(uint64_t end)
+    {
+#ifdef __linux__
+        if (preallocateBytes > 0 && reservedEnd != UINT64_MAX && end + preallocateBytes / 2 >= reservedEnd)
+        {
+            // Failure only loses the contiguity hint; the write itself already succeeded
+            if (::fallocate(fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(end), static_cast<off_t>(preallocateBytes)) == 0)
+            {
+                reservedEnd = end + preallocateBytes;
+            }
+            else
+            {
+                // Not supported here; stop trying for this file
+                reservedEnd = UINT64_MAX;
+            }
+        }
+        if (activeMode == ECacheMode::DONTNEED && end >= writebackEnd + kDropStep)
+        {
+            // Start write-back of the new range without waiting, and drop the range
+            // started last time, whose write-back has normally finished by now
+            ::sync_file_range(fd, static_cast<off_t>(writebackEnd), static_cast<off_t>(end - writebackEnd), SYNC_FILE_RANGE_WRITE);
+            ::posix_fadvise(fd, static_cast<off_t>(droppedEnd), static_cast<off_t>(writebackEnd - droppedEnd), POSIX_FADV_DONTNEED);
+            droppedEnd = writebackEnd;
+            writebackEnd = end;
+        }
+#else
+        (void)end;
+#endif
+    }
+
+    void FileSink::freeStaging()
+    {
+        std::free(staging);
+        staging = nullptr;
+        stagingCapacity = stagingFill = 0;
+        stagingOffset = 0;
+    }
+
+    bool FileSink::writeOversize(const char *data, size_t size)
+    {
+        if (oversizePolicy == EOversize::TRUNCATE)
+        {
+            const size_t markerBytes = sizeof(kTruncatedMarker) - 1;
+            std::string truncated(data, atomicLimit - markerBytes);
+            truncated.append(kTruncatedMarker, markerBytes);
+            return writeAll(truncated.data(), truncated.size());
+        }
+
+        // SPLIT_LINES: pack as many whole lines as fit into each write so no short line is torn
+        bool ok = true;
+        const char *end = data + size;
+        while (data < end)
+        {
+            const char *chunkEnd = data;
+            const char *scan = data;
+            while (scan < end)
+            {
+                const char *newline = std::find(scan, end, '\n');
+                const char *lineEnd = newline == end ? end : newline + 1;
+                if (static_cast<size_t>(lineEnd - data) > atomicLimit)
+                {
+                    break;
+                }
+                chunkEnd = lineEnd;
+                scan = lineEnd;
+            }
+
+            if (chunkEnd == data)
+            {
+                // A single line longer than the limit cannot be kept whole; write it in limit-sized pieces
+                chunkEnd = data + atomicLimit;
+            }
+
+            ok = writeAll(data, static_cast<size_t>(chunkEnd - data)) && ok;
+            data = chunkEnd;
+        }
+        return ok;
+    }
+}
@@ -0,0 +1,193 @@
+#include "Eclipse/Frame.h"
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ECLIPSE_CRC32C_SSE42 1
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define ECLIPSE_CRC32C_ARM 1
+#include <arm_acle.h>
+#endif
+
+namespace Eclipse
+{
+    namespace
+    {
+        constexpr uint32_t kPolynomial = 0x82F63B78u; // Castagnoli, reflected
+
+        using Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+        constexpr Tables makeTables()
+        {
+            Tables tables{};
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1) ? (crc >> 1) ^ kPolynomial : crc >> 1;
+                }
+                tables[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                for (size_t t = 1; t < 8; ++t)
+                {
+                    tables[t][i] = (tables[t - 1][i] >> 8) ^ tables[0][tables[t - 1][i] & 0xFF];
+                }
+            }
+            return tables;
+        }
+
+        constexpr Tables kTables = makeTables();
+
+        inline uint32_t load32(const unsigned char *p)
+        {
+            return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+                   static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+        }
+
+        uint32_t crcSoftware(const unsigned char *p, size_t size, uint32_t crc)
+        {
+            while (size >= 8)
+            {
+                uint32_t low = load32(p) ^ crc;
+                uint32_t high = load32(p + 4);
+                crc = kTables[7][low & 0xFF] ^ kTables[6][(low >> 8) & 0xFF] ^
+                      kTables[5][(low >> 16) & 0xFF] ^ kTables[4][low >> 24] ^
+                      kTables[3][high & 0xFF] ^ kTables[2][(high >> 8) & 0xFF] ^
+                      kTables[1][(high >> 16) & 0xFF] ^ kTables[0][high >> 24];
+                p += 8;
+                size -= 8;
+            }
+            while (size-- > 0)
+            {
+                crc = (crc >> 8) ^ kTables[0][(crc ^ *p++) & 0xFF];
+            }
+            return crc;
+        }
+
+#if defined(ECLIPSE_CRC32C_SSE42)
+#if defined(__GNUC__) || defined(__clang__)
+        __attribute__((target("sse4.2")))
+#endif
+        uint32_t crcHardware(const unsigned char *p, size_t size, uint32_t crc)
+        {
+            uint64_t wide = crc;
+            while (size >= 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, p, 8);
+                wide = _mm_crc32_u64(wide, word);
+                p += 8;
+                size -= 8;
+            }
+            crc = static_cast<uint32_t>(wide);
+            while (size-- > 0)
+            {
+                crc = _mm_crc32_u8(crc, *p++);
+            }
+            return crc;
+        }
+
+        bool detectHardware()
+        {
+#ifdef _MSC_VER
+            int info[4];
+            __cpuid(info, 1);
+            return (info[2] & (1 << 20)) != 0;
+#else
+            return __builtin_cpu_supports("sse4.2");
+#endif
+        }
+#elif defined(ECLIPSE_CRC32C_ARM)
+        uint32_t crcHardware(const unsigned char *p, size_t size, uint32_t crc)
+        {
+            while (size >= 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, p, 8);
+                crc = __crc32cd(crc, word);
+                p += 8;
+                size -= 8;
+            }
+            while (size-- > 0)
+            {
+                crc = __crc32cb(crc, *p++);
+            }
+            return crc;
+        }
+
+        bool detectHardware()
+        {
+            // Compiled for a target that always has the CRC32 extension
+            return true;
+        }
+#endif
+
+        using CrcFunction = uint32_t (*)(const unsigned char *, size_t, uint32_t);
+
+        CrcFunction selectImplementation()
+        {
+#if defined(ECLIPSE_CRC32C_SSE42) || defined(ECLIPSE_CRC32C_ARM)
+            if (detectHardware())
+            {
+                return crcHardware;
+            }
+#endif
+            return crcSoftware;
+        }
+
+        // Chosen during static initialisation, so crc32c() never runs lazy setup in a signal handler
+        const CrcFunction kImplementation = selectImplementation();
+
+        const char kCompressionTag[8] = {'\0', 'E', 'C', 'L', 'Z', 'S', 'T', 'D'};
+
+        inline void store32(char *out, uint32_t value)
+        {
+            out[0] = static_cast<char>(value & 0xFF);
+            out[1] = static_cast<char>((value >> 8) & 0xFF);
+            out[2] = static_cast<char>((value >> 16) & 0xFF);
+            out[3] = static_cast<char>(value >> 24);
+        }
+    }
+
+    uint32_t crc32c(const void *data, size_t size, uint32_t crc)
+    {
+        // Before static initialisation has run, fall back to the table
+        CrcFunction implementation = kImplementation != nullptr ? kImplementation : crcSoftware;
+        return ~implementation(static_cast<const unsigned char *>(data), size, ~crc);
+    }
+
+    bool crc32cAccelerated()
+    {
+        return kImplementation != crcSoftware;
+    }
+
+    void encodeFrameHeader(char *out, const char *payload, uint32_t size)
+    {
+        store32(out, kFrameMagic);
+        store32(out + 4, size);
+        store32(out + 8, crc32c(payload, size, crc32c(out + 4, 4)));
+    }
+
+    void encodeCompressionHeader(char *out, uint32_t dictionaryId)
+    {
+        std::memcpy(out, kCompressionTag, sizeof(kCompressionTag));
+        store32(out + sizeof(kCompressionTag), dictionaryId);
+    }
+
+    bool decodeCompressionHeader(const char *payload, size_t size, uint32_t &dictionaryId)
+    {
+        if (size != kCompressionHeaderSize || std::memcmp(payload, kCompressionTag, sizeof(kCompressionTag)) != 0)
+        {
+            return false;
+        }
+        dictionaryId = load32(reinterpret_cast<const unsigned char *>(payload) + sizeof(kCompressionTag));
+        return true;
+    }
+}
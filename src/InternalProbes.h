@@ -0,0 +1,76 @@
+/**
+ * @file InternalProbes.h
+ * @brief Eclipse Logging Library - USDT probes inside the library
+ * @author tomosfps
+ * @date 2025
+ * @version 2.0.1
+ */
+
+#pragma once
+
+/**
+ * @brief Static tracepoints on the library's write path
+ *
+ * Built with ECLIPSE_HAVE_USDT, the library compiles with _SDT_HAS_SEMAPHORES
+ * (a private definition), so each probe has a semaphore the tracer
+ * increments while attached. A probe's arguments are only evaluated while
+ * its semaphore is set, so an unobserved probe costs one load and a branch.
+ * Without sys/sdt.h the probes compile to nothing.
+ *
+ * Probes of provider "eclipse":
+ * - enqueue(bytes, pending): a record was appended to a write buffer holding pending bytes
+ * - drop(reason, count): records were dropped; reason is "front_full", "retry_window" or "realtime_ring"
+ * - flush(source, bytes): a write buffer went to the sink; source is "thread" or "front"
+ * - sink_write(bytes, nanoseconds, ok): one write to the log file
+ *
+ * Internal to the library; the call-site probe lives in Eclipse/Probes.h.
+ */
+#if defined(ECLIPSE_HAVE_USDT)
+
+#include <sys/sdt.h>
+
+// Defined in Logger.cpp
+extern "C"
+{
+    extern unsigned short eclipse_enqueue_semaphore __attribute__((section(".probes")));
+    extern unsigned short eclipse_drop_semaphore __attribute__((section(".probes")));
+    extern unsigned short eclipse_flush_semaphore __attribute__((section(".probes")));
+    extern unsigned short eclipse_sink_write_semaphore __attribute__((section(".probes")));
+}
+
+/**
+ * @brief True while a tracer is attached to the probe
+ */
+#define ECLIPSE_PROBE_ENABLED(name) __builtin_expect(eclipse_##name##_semaphore != 0, 0)
+
+#define ECLIPSE_PROBE2(name, a, b) \
+    do \
+    { \
+        if (ECLIPSE_PROBE_ENABLED(name)) \
+        { \
+            STAP_PROBE2(eclipse, name, a, b); \
+        } \
+    } while (0)
+
+#define ECLIPSE_PROBE3(name, a, b, c) \
+    do \
+    { \
+        if (ECLIPSE_PROBE_ENABLED(name)) \
+        { \
+            STAP_PROBE3(eclipse, name, a, b, c); \
+        } \
+    } while (0)
+
+#else
+
+#define ECLIPSE_PROBE_ENABLED(name) false
+#define ECLIPSE_PROBE2(name, a, b) \
+    do \
+    { \
+    } while (0)
+#define ECLIPSE_PROBE3(name, a, b, c) \
+    do \
+    { \
+    } while (0)
+
+#endif
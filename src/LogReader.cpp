@@ -0,0 +1,263 @@
+#include "Eclipse/LogReader.h"
+#include <algorithm>
+
+namespace Eclipse
+{
+    namespace
+    {
+        const char kMagicBytes[] = {'\xEC', '\x1F', '\x5E', '\xA1'};
+
+        inline uint32_t load32(const char *p)
+        {
+            const unsigned char *u = reinterpret_cast<const unsigned char *>(p);
+            return static_cast<uint32_t>(u[0]) | static_cast<uint32_t>(u[1]) << 8 |
+                   static_cast<uint32_t>(u[2]) << 16 | static_cast<uint32_t>(u[3]) << 24;
+        }
+    }
+
+    bool LogReader::open(const std::string &path)
+    {
+        close();
+        file.open(path, std::ios::binary);
+        return file.is_open();
+    }
+
+    void LogReader::close()
+    {
+        if (file.is_open())
+        {
+            file.close();
+        }
+        file.clear();
+        window.clear();
+        position = 0;
+        windowOffset = 0;
+        frames = corruptBytes = tornBytes = undecoded = 0;
+        dictionaryId = 0;
+        binary.reset();
+        records.clear();
+        frameOffset = syncOffset = 0;
+        resetOffsets.clear();
+    }
+
+    bool LogReader::next(std::string &payload)
+    {
+        tornBytes = 0;
+        while (true)
+        {
+            if (!fill(kFrameHeaderSize))
+            {
+                tornBytes = window.size() - position;
+                return false;
+            }
+
+            const char *header = window.data() + position;
+            uint32_t size = load32(header + 4);
+            if (load32(header) == kFrameMagic && size <= kMaxFramePayload)
+            {
+                if (!fill(kFrameHeaderSize + size))
+                {
+                    // Either a torn tail or a damaged length; only a later frame tells them apart
+                    if (resync())
+                    {
+                        continue;
+                    }
+                    tornBytes = window.size() - position;
+                    return false;
+                }
+
+                header = window.data() + position;
+                uint32_t crc = crc32c(header + kFrameHeaderSize, size, crc32c(header + 4, 4));
+                if (crc == load32(header + 8))
+                {
+                    const char *body = header + kFrameHeaderSize;
+                    uint64_t offset = windowOffset + position;
+                    position += kFrameHeaderSize + size;
+                    if (decodeCompressionHeader(body, size, dictionaryId))
+                    {
+                        continue;
+                    }
+                    records.clear();
+                    syncOffset = offset;
+                    if (BinaryDecoder::isBlock(body, size))
+                    {
+                        if (!binary.decode(body, size, records))
+                        {
+                            ++undecoded;
+                            continue;
+                        }
+                        uint64_t stream = 0;
+                        bool reset = false;
+                        BinaryDecoder::readBlockHeader(body, size, stream, reset);
+                        if (reset)
+                        {
+                            resetOffsets[stream] = offset;
+                        }
+                        syncOffset = resetOffsets[stream];
+                        payload.clear();
+                        for (size_t i = 0; renderRecords && i < records.size(); ++i)
+                        {
+                            formatBinaryRecord(records[i], timestampFormat, payload);
+                        }
+                    }
+                    else if (!Compressor::isCompressed(body, size))
+                    {
+                        payload.assign(body, size);
+                    }
+                    else if (!decoder.decompress(body, size, payload))
+                    {
+                        ++undecoded;
+                        continue;
+                    }
+                    frameOffset = offset;
+                    ++frames;
+                    return true;
+                }
+            }
+
+            if (!resync())
+            {
+                tornBytes = window.size() - position;
+                return false;
+            }
+        }
+    }
+
+    bool LogReader::seek(uint64_t offset)
+    {
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(offset));
+        window.clear();
+        position = 0;
+        windowOffset = offset;
+        tornBytes = 0;
+        binary.reset();
+        records.clear();
+        resetOffsets.clear();
+        return file.good();
+    }
+
+    void LogReader::setReadAhead(size_t bytes)
+    {
+        readAhead = std::max<size_t>(bytes, 1);
+    }
+
+    bool LogReader::setDictionary(const std::string &dictionary)
+    {
+        return decoder.setDictionary(dictionary);
+    }
+
+    void LogReader::setTimestampFormat(ETimestampFormat format)
+    {
+        timestampFormat = format;
+    }
+
+    void LogReader::setRenderRecords(bool render)
+    {
+        renderRecords = render;
+    }
+
+    const std::vector<BinaryRecord> &LogReader::getRecords() const
+    {
+        return records;
+    }
+
+    uint32_t LogReader::getDictionaryId() const
+    {
+        return dictionaryId;
+    }
+
+    uint64_t LogReader::getUndecodedFrames() const
+    {
+        return undecoded;
+    }
+
+    uint64_t LogReader::getFrameCount() const
+    {
+        return frames;
+    }
+
+    uint64_t LogReader::getCorruptBytes() const
+    {
+        return corruptBytes;
+    }
+
+    uint64_t LogReader::getTornBytes() const
+    {
+        return tornBytes;
+    }
+
+    uint64_t LogReader::getValidEnd() const
+    {
+        return windowOffset + position;
+    }
+
+    uint64_t LogReader::getFrameOffset() const
+    {
+        return frameOffset;
+    }
+
+    uint64_t LogReader::getSyncOffset() const
+    {
+        return syncOffset;
+    }
+
+    bool LogReader::fill(size_t needed)
+    {
+        while (window.size() - position < needed)
+        {
+            if (!file.is_open())
+            {
+                return false;
+            }
+            if (position > 0)
+            {
+                window.erase(0, position);
+                windowOffset += position;
+                position = 0;
+            }
+
+            size_t have = window.size();
+            size_t want = std::max(needed - have, readAhead);
+            window.resize(have + want);
+            // Clear EOF from an earlier pass so a growing file is read further
+            file.clear();
+            file.read(&window[have], static_cast<std::streamsize>(want));
+            size_t got = static_cast<size_t>(file.gcount());
+            window.resize(have + got);
+            if (got == 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool LogReader::resync()
+    {
+        // Offsets are kept relative to position, because fill() moves the window
+        size_t scanned = 1;
+        while (true)
+        {
+            size_t found = window.find(kMagicBytes, position + scanned, sizeof(kMagicBytes));
+            if (found != std::string::npos)
+            {
+                corruptBytes += found - position;
+                position = found;
+                return true;
+            }
+
+            // A magic may straddle the end of what has been read so far
+            size_t available = window.size() - position;
+            scanned = std::max(scanned, available >= sizeof(kMagicBytes) ? available - sizeof(kMagicBytes) + 1 : 1);
+            if (!fill(available + 1))
+            {
+                return false;
+            }
+        }
+    }
+}
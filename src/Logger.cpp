@@ -1,72 +1,1290 @@
 #include "Eclipse/Logger.h"
+#include "Eclipse/Metrics.h"
+#include "Eclipse/Prometheus.h"
+#include "Eclipse/Realtime.h"
+#include "Backend.h"
+#include "InternalProbes.h"
 #include <sstream>
-#include <iomanip>
 #include <chrono>
 #include <algorithm>
 #include <unordered_map>
 #include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
 
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+#if defined(ECLIPSE_HAVE_USDT)
+// Tracers increment these while attached; see InternalProbes.h
+extern "C"
+{
+    unsigned short eclipse_enqueue_semaphore __attribute__((section(".probes"))) = 0;
+    unsigned short eclipse_drop_semaphore __attribute__((section(".probes"))) = 0;
+    unsigned short eclipse_flush_semaphore __attribute__((section(".probes"))) = 0;
+    unsigned short eclipse_sink_write_semaphore __attribute__((section(".probes"))) = 0;
+}
+#endif
+
+namespace Eclipse
+{
+    namespace
+    {
+        /**
+         * @brief Keeps a real-time thread's ring alive and closes it when the thread exits
+         */
+        struct RealtimeThreadGuard
+        {
+            ~RealtimeThreadGuard()
+            {
+                if (ring)
+                {
+                    ring->close();
+                }
+                RealtimeLog::threadRing = nullptr;
+            }
+
+            std::shared_ptr<RealtimeRing> ring; ///< Ring owned by this thread
+        };
+
+        thread_local RealtimeThreadGuard realtimeThreadGuard;
+
+        constexpr size_t kFallbackMemoryBytes = 1024 * 1024; ///< Capacity of EFallback::MEMORY
+        constexpr int kMaxRetryBackoff = 64;                 ///< Longest retry delay, in multiples of the first
+
+        int64_t steadyNanoseconds()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+
+#ifndef _WIN32
+        struct sigaction previousRotationAction{}; ///< Handler replaced by reopenOnSignal(), chained to
+#endif
+
+        /**
+         * @brief Remove ANSI colour sequences for file output
+         */
+        std::string stripColours(std::string text)
+        {
+            size_t pos = 0;
+            while ((pos = text.find("\033[", pos)) != std::string::npos)
+            {
+                size_t end = text.find("m", pos);
+                if (end != std::string::npos)
+                {
+                    text.erase(pos, end - pos + 1);
+                }
+                else
+                {
+                    break;
+                }
+            }
+            return text;
+        }
+
+        /**
+         * @brief Render standalone binary records as text for sinks that do not take them
+         */
+        std::string binaryToText(const std::string &data, ETimestampFormat format)
+        {
+            std::vector<BinaryRecord> records;
+            if (!parseBinaryRecords(data.data(), data.size(), records))
+            {
+                return data;
+            }
+            std::string text;
+            for (const BinaryRecord &record : records)
+            {
+                formatBinaryRecord(record, format, text);
+            }
+            return text;
+        }
+    }
+
+    /**
+     * @brief Records of one thread waiting to be appended in THREAD_BUFFERED mode
+     */
+    struct ThreadBuffer
+    {
+        ~ThreadBuffer()
+        {
+            if (registered && Logger::instance != nullptr)
+            {
+                Logger::instance->releaseThreadBuffer(*this);
+            }
+        }
+
+        std::mutex mutex;                             ///< Taken by the owner to append and by flush() to write
+        std::string data;                             ///< Formatted records not yet written
+        std::chrono::steady_clock::time_point oldest; ///< When the first record in data was added
+        bool registered = false;                      ///< Listed in Logger::threadBuffers; only the owner sets it
+    };
+
+    namespace
+    {
+        thread_local ThreadBuffer threadBuffer;
+    }
+
+    Logger *Logger::instance = nullptr;
+
+    Logger::Logger() : currentLevel(ELevel::ECLIPSE_DEBUG)
+    {
+#ifdef _WIN32
+        HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+        if (hConsole != INVALID_HANDLE_VALUE)
+        {
+            DWORD mode;
+            GetConsoleMode(hConsole, &mode);
+            SetConsoleMode(hConsole, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+        }
+        SetConsoleOutputCP(CP_UTF8);
+        SetConsoleCP(CP_UTF8);
+#endif
+    }
+
+    Logger &Logger::getInstance()
+    {
+        static std::once_flag flag;
+        std::call_once(flag, []()
+                       {
+            instance = new Logger();
+            instance->publishSignalState();
+            std::atexit(&Logger::exitHandler);
+#if !defined(__APPLE__)
+            std::at_quick_exit(&Logger::exitHandler);
+#endif
+#ifndef _WIN32
+            pthread_atfork(&Logger::forkPrepare, &Logger::forkParent, &Logger::forkChild);
+#endif
+            // Lets a deployment pick the timestamp source without a code change
+            EClockSource source;
+            const char *requested = std::getenv("ECLIPSE_CLOCK_SOURCE");
+            if (requested != nullptr && instance->parseClockSource(requested, source))
+            {
+                instance->setClockSource(source);
+            }
+        });
+        return *instance;
+    }
+
+    void Logger::exitHandler()
+    {
+        getInstance().shutdown();
+    }
+
+    void Logger::shutdown(std::chrono::milliseconds timeout)
+    {
+        if (shutdownStarted.exchange(true))
+        {
+            return;
+        }
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        auto expired = [deadline]()
+        { return std::chrono::steady_clock::now() >= deadline; };
+
+        // Real-time threads fall back to the regular path; the final drain writes what they queued
+        Backend *stoppingBackend = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(realtimeMutex);
+            for (const std::shared_ptr<RealtimeRing> &ring : realtimeRings)
+            {
+                ring->close();
+            }
+            stoppingBackend = backend.get();
+        }
+        if (stoppingBackend)
+        {
+            stoppingBackend->stop(deadline);
+        }
+        if (!expired())
+        {
+            emitMetrics(true);
+        }
+        if (!expired())
+        {
+            exportPrometheus(true);
+        }
+
+        // Records logged from now on are written directly
+        {
+            std::lock_guard<std::mutex> lock(frontMutex);
+            frontOpen = false;
+        }
+        flushUntil(deadline);
+
+        // In-flight log() calls hold logMutex; new ones block until the sinks are closed
+        std::lock_guard<std::mutex> lock(logMutex);
+        std::unique_ptr<SharedLogCollector> stopping;
+        {
+            std::lock_guard<std::mutex> fileLock(fileMutex);
+            // Release our slot first so the embedded collector's drain sees its final records
+            directToStderr = sharedLog != nullptr && logFilePath.empty();
+            sharedLog.reset();
+            stopping = std::move(collector);
+        }
+        if (stopping)
+        {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            stopping->stop(std::max(remaining, std::chrono::milliseconds(0)));
+            stopping.reset();
+        }
+
+        std::lock_guard<std::mutex> fileLock(fileMutex);
+        // Last chance for writes kept while the log file was failing
+        if (!fallbackMemory.empty() && (segmented || logFileSink.isOpen()))
+        {
+            drainFallbackMemory(deadline);
+        }
+        if (segmented)
+        {
+            // Later records are appended to the last segment, or go to stderr if there is none
+            std::vector<SegmentInfo> segments = segmentStore.getSegments();
+            if (segments.empty())
+            {
+                directToStderr = true;
+            }
+            else
+            {
+                shutdownSegmentPath = (std::filesystem::path(segmentStore.getDirectory()) / segments.back().name).string();
+            }
+        }
+        withdrawSignalFile();
+        segmentStore.close();
+        segmented = false;
+        logFileSink.close();
+        fallbackSink.close();
+        publishSignalState();
+        std::cout.flush();
+        shutdownComplete.store(true, std::memory_order_release);
+    }
+
+    bool Logger::isShutdown() const
+    {
+        return shutdownComplete.load(std::memory_order_acquire);
+    }
+
+    void Logger::forkPrepare()
+    {
+        Logger &logger = getInstance();
+
+        // Join background threads so none of them is cloned mid-operation
+        Backend *pausing = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(logger.realtimeMutex);
+            logger.backendPaused = logger.backend && logger.backend->isRunning();
+            if (logger.backendPaused)
+            {
+                pausing = logger.backend.get();
+            }
+        }
+        if (pausing)
+        {
+            pausing->stop();
+        }
+        {
+            std::lock_guard<std::mutex> lock(logger.fileMutex);
+            logger.collectorPaused = logger.collector != nullptr;
+            if (logger.collectorPaused)
+            {
+                logger.collector->stop();
+            }
+        }
+
+        // Buffered records belong to the parent; the child must not write them again
+        logger.flush();
+
+        // Same order as log(): logMutex, then fileMutex; levelMutex and realtimeMutex are never nested.
+        // backMutex and bufferMutex come first because writers log while holding them;
+        // exportMutex before them because the exporter reads the buffers while holding it.
+        logger.exportMutex.lock();
+        logger.backMutex.lock();
+        logger.bufferMutex.lock();
+        logger.logMutex.lock();
+        logger.fileMutex.lock();
+        logger.frontMutex.lock();
+        logger.levelMutex.lock();
+        logger.realtimeMutex.lock();
+        Metrics::forkPrepare();
+    }
+
+    void Logger::forkParent()
+    {
+        Logger &logger = getInstance();
+        Metrics::forkParent();
+        logger.realtimeMutex.unlock();
+        logger.levelMutex.unlock();
+        logger.frontMutex.unlock();
+        logger.fileMutex.unlock();
+        logger.logMutex.unlock();
+        logger.bufferMutex.unlock();
+        logger.backMutex.unlock();
+        logger.exportMutex.unlock();
+
+        {
+            std::lock_guard<std::mutex> lock(logger.fileMutex);
+            if (logger.collectorPaused && logger.collector)
+            {
+                logger.collector->start();
+            }
+            logger.collectorPaused = false;
+        }
+
+        std::lock_guard<std::mutex> lock(logger.realtimeMutex);
+        if (logger.backendPaused && logger.backend)
+        {
+            logger.backend->start();
+        }
+        logger.backendPaused = false;
+    }
+
+    void Logger::forkChild()
+    {
+        Logger &logger = getInstance();
+        Metrics::forkChild();
+        logger.realtimeMutex.unlock();
+        logger.levelMutex.unlock();
+        logger.frontMutex.unlock();
+        logger.fileMutex.unlock();
+        logger.logMutex.unlock();
+        logger.bufferMutex.unlock();
+        logger.backMutex.unlock();
+        logger.exportMutex.unlock();
+
+        // The Prometheus file keeps the parent's counters
+        {
+            std::lock_guard<std::mutex> lock(logger.exportMutex);
+            logger.exportPath.clear();
+        }
+
+        // Buffers of the other threads hold records the parent writes; forget them
+        {
+            std::lock_guard<std::mutex> lock(logger.bufferMutex);
+            logger.threadBuffers.erase(std::remove_if(logger.threadBuffers.begin(), logger.threadBuffers.end(),
+                                                      [](ThreadBuffer *buffer)
+                                                      { return buffer != &threadBuffer; }),
+                                       logger.threadBuffers.end());
+        }
+        {
+            std::lock_guard<std::mutex> lock(logger.frontMutex);
+            logger.frontBuffer.clear();
+            logger.frontDropped = 0;
+        }
+
+#ifndef _WIN32
+        {
+            std::lock_guard<std::mutex> lock(logger.fileMutex);
+
+            // The collector belongs to the parent. Dropping it without stop() keeps the
+            // child from draining records the parent has not collected yet.
+            logger.collector.release();
+            logger.collectorPaused = false;
+
+            // The inherited slot is the parent's single-producer ring; claim our own
+            if (logger.sharedLog)
+            {
+                std::string name = logger.sharedLog->getName();
+                logger.sharedLog = SharedLogWriter::attach(name);
+            }
+
+            // A segment directory belongs to one process; the child starts its own
+            if (logger.segmented)
+            {
+                std::string directory = logger.segmentStore.getDirectory();
+                SegmentOptions options = logger.segmentOptions;
+                logger.withdrawSignalFile();
+                logger.segmentStore.release();
+                while (!directory.empty() && (directory.back() == '/' || directory.back() == '\\'))
+                {
+                    directory.pop_back();
+                }
+                logger.segmented = logger.segmentStore.open(directory + "." + std::to_string(::getpid()), options);
+                logger.publishSignalState();
+            }
+
+            // The parent keeps rewriting the tail block of a DIRECT file; leave it alone
+            bool direct = logger.logFileSink.getCacheMode() == ECacheMode::DIRECT && logger.logFileSink.isOpen();
+            if (direct)
+            {
+                logger.withdrawSignalFile();
+                logger.logFileSink.release();
+            }
+            if ((logger.forkPolicy == EForkPolicy::REOPEN_PER_PID || direct) && !logger.logFilePath.empty())
+            {
+                std::string path = logger.logFilePath;
+                size_t sep = path.find_last_of("\\/");
+                size_t dot = path.find_last_of('.');
+                if (dot == std::string::npos || (sep != std::string::npos && dot < sep) || dot == sep + 1)
+                {
+                    dot = path.size();
+                }
+                path.insert(dot, "." + std::to_string(::getpid()));
+                logger.logFilePath = path;
+                logger.withdrawSignalFile();
+                logger.logFileSink.open(path);
+                logger.publishSignalState();
+            }
+        }
+#endif
+
+        // Only the forking thread exists in the child. Rings of the other threads
+        // hold records the parent will write, so the child discards them.
+        std::lock_guard<std::mutex> lock(logger.realtimeMutex);
+        logger.realtimeRings.erase(
+            std::remove_if(logger.realtimeRings.begin(), logger.realtimeRings.end(),
+                           [](const std::shared_ptr<RealtimeRing> &ring)
+                           { return ring.get() != RealtimeLog::threadRing; }),
+            logger.realtimeRings.end());
+        bool doubleBuffered = logger.writeMode.load(std::memory_order_relaxed) == EWriteMode::DOUBLE_BUFFERED;
+        bool rotationWatched = logger.rotationCheckMs.load(std::memory_order_relaxed) > 0 ||
+                               logger.rotationSignal.load(std::memory_order_relaxed) != 0;
+        bool metrics = logger.metricsStarted.load(std::memory_order_relaxed);
+        if (logger.backendPaused &&
+            (!logger.realtimeRings.empty() || doubleBuffered || logger.segmented || rotationWatched || metrics))
+        {
+            logger.backend->start();
+        }
+        logger.backendPaused = false;
+    }
+
+    void Logger::publishSignalState()
+    {
+        // A handler cannot keep the block alignment of a DIRECT file
+        int fd = logFileSink.getDescriptor();
+        // Signal-safe records stay uncompressed; readers tell plain payloads by the missing zstd magic
+        bool framed = logFileSink.getFormat() != EFileFormat::TEXT;
+        if (fd >= 0 && logFileSink.getCacheMode() == ECacheMode::DIRECT)
+        {
+            fd = 2;
+            framed = false;
+        }
+        // A failed log file hands signal-safe records to the fallback as well
+        if (fd >= 0 && fileFailed.load(std::memory_order_relaxed))
+        {
+            if (fallback == EFallback::STDERR)
+            {
+                fd = 2;
+                framed = false;
+            }
+            else if (fallback == EFallback::FILE && fallbackSink.isOpen())
+            {
+                fd = fallbackSink.getDescriptor();
+                framed = fallbackSink.getFormat() != EFileFormat::TEXT;
+            }
+        }
+        signalFramed.store(framed, std::memory_order_relaxed);
+        signalFileFd.store(fd, std::memory_order_release);
+        refreshUtcOffset();
+    }
+
+    void Logger::withdrawSignalFile()
+    {
+        signalFileFd.store(-1, std::memory_order_release);
+    }
+
+    void Logger::refreshUtcOffset()
+    {
+        std::time_t now = std::time(nullptr);
+        std::tm local{};
+        std::tm utc{};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+        gmtime_s(&utc, &now);
+#else
+        localtime_r(&now, &local);
+        gmtime_r(&now, &utc);
+#endif
+        // mktime() interprets both as local time, so the difference is the UTC offset
+        utc.tm_isdst = local.tm_isdst;
+        utcOffsetSeconds.store(static_cast<long>(std::difftime(std::mktime(&local), std::mktime(&utc))),
+                               std::memory_order_relaxed);
+    }
+
+    void Logger::setForkPolicy(EForkPolicy policy)
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        forkPolicy = policy;
+    }
+
+    void Logger::setWriteMode(EWriteMode mode, size_t bufferBytes, std::chrono::milliseconds maxDelay)
+    {
+        bufferLimit.store(bufferBytes, std::memory_order_relaxed);
+        bufferDelayMs.store(maxDelay.count(), std::memory_order_relaxed);
+        if (mode == EWriteMode::DOUBLE_BUFFERED)
+        {
+            std::lock_guard<std::mutex> lock(realtimeMutex);
+            if (!shutdownStarted.load(std::memory_order_acquire))
+            {
+                ensureBackend();
+            }
+        }
+        // Release: producers that see DOUBLE_BUFFERED also see the backend
+        writeMode.store(mode, std::memory_order_release);
+
+        // Whatever the previous mode buffered is written before records of the new one
+        flush();
+    }
+
+    EWriteMode Logger::getWriteMode() const
+    {
+        return writeMode.load(std::memory_order_relaxed);
+    }
+
+    void Logger::flush()
+    {
+        flushUntil(std::chrono::steady_clock::time_point::max());
+    }
+
+    void Logger::flushUntil(std::chrono::steady_clock::time_point deadline)
+    {
+        {
+            std::lock_guard<std::mutex> lock(bufferMutex);
+            for (ThreadBuffer *buffer : threadBuffers)
+            {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                if (std::chrono::steady_clock::now() < deadline)
+                {
+                    flushThreadBuffer(*buffer);
+                }
+                else
+                {
+                    buffer->data.clear();
+                }
+            }
+        }
+        if (std::chrono::steady_clock::now() < deadline)
+        {
+            writeFrontBuffer(true);
+            return;
+        }
+        std::lock_guard<std::mutex> frontLock(frontMutex);
+        frontBuffer.clear();
+    }
+
+    void Logger::bufferRecord(ELevel level, const std::string &fileOutput)
+    {
+        ThreadBuffer &buffer = threadBuffer;
+        if (!buffer.registered)
+        {
+            std::lock_guard<std::mutex> lock(bufferMutex);
+            threadBuffers.push_back(&buffer);
+            buffer.registered = true;
+        }
+
+        size_t limit = bufferLimit.load(std::memory_order_relaxed);
+        auto maxDelay = std::chrono::milliseconds(bufferDelayMs.load(std::memory_order_relaxed));
+        auto now = std::chrono::steady_clock::now();
+
+        // Uncontended unless flush() is writing this buffer from another thread
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        if (!buffer.data.empty() && buffer.data.size() + fileOutput.size() > limit)
+        {
+            flushThreadBuffer(buffer);
+        }
+        if (buffer.data.empty())
+        {
+            buffer.data.reserve(limit);
+            buffer.oldest = now;
+        }
+        buffer.data += fileOutput;
+        ECLIPSE_PROBE2(enqueue, fileOutput.size(), buffer.data.size());
+
+        if (level >= ELevel::ECLIPSE_WARN || buffer.data.size() >= limit || now - buffer.oldest >= maxDelay)
+        {
+            flushThreadBuffer(buffer);
+        }
+    }
+
+    void Logger::flushThreadBuffer(ThreadBuffer &buffer)
+    {
+        if (buffer.data.empty())
+        {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> fileLock(fileMutex);
+            ECLIPSE_PROBE2(flush, "thread", buffer.data.size());
+            writeFileOutput(buffer.data);
+        }
+        buffer.data.clear();
+    }
+
+    void Logger::releaseThreadBuffer(ThreadBuffer &buffer)
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        threadBuffers.erase(std::remove(threadBuffers.begin(), threadBuffers.end(), &buffer), threadBuffers.end());
+        std::lock_guard<std::mutex> bufferLock(buffer.mutex);
+        flushThreadBuffer(buffer);
+        buffer.registered = false;
+    }
+
+    bool Logger::appendFront(const std::string &fileOutput)
+    {
+        size_t limit = bufferLimit.load(std::memory_order_relaxed);
+        auto now = std::chrono::steady_clock::now();
+        bool filled = false;
+        {
+            std::lock_guard<std::mutex> lock(frontMutex);
+            if (!frontOpen)
+            {
+                return false;
+            }
+            // The backend is not keeping up; drop rather than let producers wait
+            if (frontBuffer.size() + fileOutput.size() > limit * 4)
+            {
+                ++frontDropped;
+                ++bufferDrops;
+                ECLIPSE_PROBE2(drop, "front_full", 1);
+                return true;
+            }
+            if (frontBuffer.empty())
+            {
+                frontOldest = now;
+            }
+            frontBuffer += fileOutput;
+            ECLIPSE_PROBE2(enqueue, fileOutput.size(), frontBuffer.size());
+            filled = frontBuffer.size() >= limit && frontBuffer.size() - fileOutput.size() < limit;
+        }
+        if (filled)
+        {
+            backend->wake();
+        }
+        return true;
+    }
+
+    void Logger::writeFrontBuffer(bool force)
+    {
+        std::lock_guard<std::mutex> lock(backMutex);
+        uint64_t dropped = 0;
+        {
+            auto maxDelay = std::chrono::milliseconds(bufferDelayMs.load(std::memory_order_relaxed));
+            auto now = std::chrono::steady_clock::now();
+            std::lock_guard<std::mutex> frontLock(frontMutex);
+            if (!frontBuffer.empty() &&
+                (force || frontBuffer.size() >= bufferLimit.load(std::memory_order_relaxed) ||
+                 now - frontOldest >= maxDelay))
+            {
+                frontBuffer.swap(backBuffer);
+            }
+            dropped = frontDropped;
+            frontDropped = 0;
+        }
+
+        if (!backBuffer.empty())
+        {
+            {
+                std::lock_guard<std::mutex> fileLock(fileMutex);
+                ECLIPSE_PROBE2(flush, "front", backBuffer.size());
+                writeFileOutput(backBuffer);
+            }
+            // Keeps its capacity, so the next swap hands producers a preallocated buffer
+            backBuffer.clear();
+        }
+
+        if (dropped > 0)
+        {
+            emitRecord(ELevel::ECLIPSE_WARN, "Logger", "Write buffer full, records dropped",
+                       {"dropped=" + std::to_string(dropped)}, "", clock.now());
+        }
+    }
+
+    void Logger::setLevel(ELevel level)
+    {
+        std::lock_guard<std::mutex> lock(levelMutex);
+        currentLevel = level;
+    }
+
+    ELevel Logger::getLevel() const
+    {
+        std::lock_guard<std::mutex> lock(levelMutex);
+        return currentLevel;
+    }
+
+    void Logger::setLogFile(const std::string &filePath)
+    {
+        flush();
+        std::lock_guard<std::mutex> lock(fileMutex);
+        withdrawSignalFile();
+        segmentStore.close();
+        segmented = false;
+        logFilePath = filePath;
+        logFileSink.open(logFilePath);
+        clearFileFailure();
+        publishSignalState();
+    }
+
+    bool Logger::setLogDirectory(const std::string &directory, const SegmentOptions &options)
+    {
+        flush();
+        bool opened = false;
+        {
+            std::lock_guard<std::mutex> lock(fileMutex);
+            withdrawSignalFile();
+            logFileSink.close();
+            logFilePath.clear();
+            segmentOptions = options;
+            opened = segmentStore.open(directory, options);
+            segmented = opened;
+            clearFileFailure();
+            publishSignalState();
+        }
+        if (opened && !shutdownStarted.load(std::memory_order_acquire))
+        {
+            // Retention runs on the backend thread
+            std::lock_guard<std::mutex> lock(realtimeMutex);
+            ensureBackend();
+        }
+        return opened;
+    }
+
+    void Logger::closeLogFile()
+    {
+        flush();
+        std::lock_guard<std::mutex> lock(fileMutex);
+        withdrawSignalFile();
+        segmentStore.close();
+        segmented = false;
+        logFileSink.close();
+        logFilePath.clear();
+        fallbackSink.close();
+        clearFileFailure();
+        publishSignalState();
+    }
+
+    bool Logger::reopenLogFile()
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (segmented || logFilePath.empty() || !logFileSink.isOpen())
+        {
+            return false;
+        }
+        bool reopened = logFileSink.reopen(logFilePath);
+        if (reopened)
+        {
+            clearFileFailure();
+        }
+        publishSignalState();
+        return reopened;
+    }
+
+    void Logger::setRotationCheck(std::chrono::milliseconds interval)
+    {
+        rotationCheckMs.store(std::max<std::chrono::milliseconds::rep>(interval.count(), 0), std::memory_order_relaxed);
+        if (interval.count() > 0 && !shutdownStarted.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(realtimeMutex);
+            ensureBackend();
+        }
+    }
+
+    bool Logger::reopenOnSignal(int signal)
+    {
+#ifdef _WIN32
+        (void)signal;
+        return false;
+#else
+        struct sigaction action{};
+        action.sa_handler = &Logger::rotationSignalHandler;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        struct sigaction previous{};
+        if (::sigaction(signal, &action, &previous) != 0)
+        {
+            return false;
+        }
+        // Installing twice must not chain the handler to itself
+        if (previous.sa_handler != &Logger::rotationSignalHandler)
+        {
+            previousRotationAction = previous;
+        }
+        rotationSignal.store(signal, std::memory_order_relaxed);
+        if (!shutdownStarted.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(realtimeMutex);
+            ensureBackend();
+        }
+        return true;
+#endif
+    }
+
+    void Logger::rotationSignalHandler(int signal)
+    {
+        if (instance != nullptr)
+        {
+            instance->rotationRequested.store(true, std::memory_order_relaxed);
+        }
+#ifndef _WIN32
+        // Only a real handler is chained; SIG_DFL for SIGHUP would end the process
+        if (!(previousRotationAction.sa_flags & SA_SIGINFO) && previousRotationAction.sa_handler != SIG_DFL &&
+            previousRotationAction.sa_handler != SIG_IGN && previousRotationAction.sa_handler != nullptr)
+        {
+            previousRotationAction.sa_handler(signal);
+        }
+#else
+        (void)signal;
+#endif
+    }
+
+    void Logger::checkRotation()
+    {
+        bool requested = rotationRequested.exchange(false, std::memory_order_relaxed);
+        auto interval = std::chrono::milliseconds(rotationCheckMs.load(std::memory_order_relaxed));
+        auto now = std::chrono::steady_clock::now();
+        if (!requested && (interval.count() == 0 || now < nextRotationCheck))
+        {
+            return;
+        }
+        if (interval.count() > 0)
+        {
+            nextRotationCheck = now + interval;
+        }
+
+        bool moved = requested;
+        if (!moved)
+        {
+            std::lock_guard<std::mutex> lock(fileMutex);
+            moved = !segmented && !logFilePath.empty() && logFileSink.isOpen() &&
+                    !logFileSink.isCurrent(logFilePath);
+        }
+        if (moved)
+        {
+            reopenLogFile();
+        }
+    }
+
+    void Logger::setMetricsInterval(std::chrono::milliseconds interval)
+    {
+        metricsIntervalMs.store(std::max<std::chrono::milliseconds::rep>(interval.count(), 0), std::memory_order_relaxed);
+    }
+
+    void Logger::startMetrics()
+    {
+        if (metricsStarted.exchange(true) || shutdownStarted.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(realtimeMutex);
+        ensureBackend();
+    }
+
+    void Logger::emitMetrics(bool force)
+    {
+        auto interval = std::chrono::milliseconds(metricsIntervalMs.load(std::memory_order_relaxed));
+        auto now = std::chrono::steady_clock::now();
+        if (interval.count() == 0 || !metricsStarted.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        // The first interval starts with the first run, not at the epoch
+        if (nextMetricsEmit == std::chrono::steady_clock::time_point())
+        {
+            nextMetricsEmit = now + interval;
+        }
+        if (!force && now < nextMetricsEmit)
+        {
+            return;
+        }
+        nextMetricsEmit = now + interval;
+
+        for (const MetricSummary &summary : Metrics::collect())
+        {
+            std::vector<std::string> details = {
+                summary.type == EMetricType::COUNTER ? "type=counter" : "type=histogram",
+                "count=" + std::to_string(summary.count),
+                "sum=" + Metrics::formatValue(summary.sum),
+            };
+            if (summary.type == EMetricType::HISTOGRAM)
+            {
+                details.push_back("min=" + Metrics::formatValue(summary.min));
+                details.push_back("max=" + Metrics::formatValue(summary.max));
+                details.push_back("p50=" + Metrics::formatValue(summary.p50));
+                details.push_back("p90=" + Metrics::formatValue(summary.p90));
+                details.push_back("p99=" + Metrics::formatValue(summary.p99));
+            }
+            log(ELevel::ECLIPSE_INFO, "Metrics", summary.name, details, "");
+        }
+    }
+
+    bool Logger::setPrometheusExport(const std::string &path, std::chrono::milliseconds interval)
+    {
+        {
+            std::lock_guard<std::mutex> lock(exportMutex);
+            exportPath = path;
+            exportInterval = std::max(interval, std::chrono::milliseconds(1));
+            nextExport = std::chrono::steady_clock::now() + exportInterval;
+            if (path.empty())
+            {
+                return true;
+            }
+            if (!writeFileAtomically(path, formatPrometheus(getStats(), Metrics::snapshot())))
+            {
+                exportPath.clear();
+                return false;
+            }
+        }
+        if (!shutdownStarted.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(realtimeMutex);
+            ensureBackend();
+        }
+        return true;
+    }
+
+    void Logger::exportPrometheus(bool force)
+    {
+        std::lock_guard<std::mutex> lock(exportMutex);
+        auto now = std::chrono::steady_clock::now();
+        if (exportPath.empty() || (!force && now < nextExport))
+        {
+            return;
+        }
+        nextExport = now + exportInterval;
+        writeFileAtomically(exportPath, formatPrometheus(getStats(), Metrics::snapshot()));
+    }
+
+    void Logger::setFallback(EFallback newFallback, const std::string &path, std::chrono::milliseconds delay)
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        fallback = newFallback;
+        fallbackPath = path;
+        withdrawSignalFile();
+        fallbackSink.close();
+        retryDelay = std::max(delay, std::chrono::milliseconds(1));
+        retryBackoff = retryDelay;
+        skipFileRecords.store(fileFailed.load(std::memory_order_relaxed) && fallback == EFallback::NONE,
+                              std::memory_order_relaxed);
+        publishSignalState();
+    }
+
+    FileErrorStats Logger::getFileErrorStats() const
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        FileErrorStats stats = fileErrors;
+        stats.skippedRecords = skippedRecords.load(std::memory_order_relaxed);
+        stats.failed = fileFailed.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    LoggerStats Logger::getStats() const
+    {
+        LoggerStats stats;
+        for (size_t i = 0; i < stats.records.size(); ++i)
+        {
+            stats.records[i] = levelRecords[i].load(std::memory_order_relaxed);
+        }
+        stats.realtimeDrops = realtimeDrops.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(bufferMutex);
+            for (ThreadBuffer *buffer : threadBuffers)
+            {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                stats.queuedBytes += buffer->data.size();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(frontMutex);
+            stats.queuedBytes += frontBuffer.size();
+            stats.bufferDrops = bufferDrops;
+        }
+        stats.fileErrors = getFileErrorStats();
+        std::lock_guard<std::mutex> lock(fileMutex);
+        stats.sinkWrites = sinkWrites;
+        stats.sinkWriteTime = std::chrono::nanoseconds(sinkWriteNs);
+        stats.sinkLatency = sinkLatency;
+        return stats;
+    }
+
+    void Logger::clearFileFailure()
+    {
+        fileFailed.store(false, std::memory_order_relaxed);
+        skipFileRecords.store(false, std::memory_order_relaxed);
+        retryBackoff = retryDelay;
+    }
+
+    void Logger::setAtomicWriteLimit(size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        logFileSink.setAtomicLimit(bytes);
+    }
+
+    void Logger::setOversizePolicy(EOversize policy)
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        logFileSink.setOversizePolicy(policy);
+    }
+
+    bool Logger::setFileCacheMode(ECacheMode mode, size_t preallocateBytes)
+    {
+        flush();
+        std::lock_guard<std::mutex> lock(fileMutex);
+        logFileSink.setCacheMode(mode);
+        logFileSink.setPreallocation(preallocateBytes);
+        if (segmented)
+        {
+            withdrawSignalFile();
+            segmentStore.reopen();
+            publishSignalState();
+        }
+        else if (logFileSink.isOpen())
+        {
+            withdrawSignalFile();
+            logFileSink.open(logFilePath);
+            publishSignalState();
+        }
+        return logFileSink.getCacheMode() == mode;
+    }
+
+    void Logger::setFileFormat(EFileFormat format)
+    {
+        flush();
+        std::lock_guard<std::mutex> lock(fileMutex);
+        logFileSink.setFormat(format);
+        binaryRecords.store(format == EFileFormat::BINARY, std::memory_order_relaxed);
+        publishSignalState();
+    }
+
+    EFileFormat Logger::getFileFormat() const
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        return logFileSink.getFormat();
+    }
+
+    bool Logger::setCompressionDictionary(const std::string &dictionaryPath, int level)
+    {
+        std::string dictionary;
+        if (!dictionaryPath.empty())
+        {
+            std::ifstream file(dictionaryPath, std::ios::binary);
+            if (!file.is_open())
+            {
+                return false;
+            }
+            std::ostringstream content;
+            content << file.rdbuf();
+            dictionary = content.str();
+        }
+        flush();
+        std::lock_guard<std::mutex> lock(fileMutex);
+        return logFileSink.setDictionary(dictionary, level);
+    }
+
+    bool Logger::attachSharedLog(const std::string &name)
+    {
+#ifndef _WIN32
+        std::unique_ptr<SharedLogWriter> writer = SharedLogWriter::attach(name);
+        if (!writer)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(fileMutex);
+        sharedLog = std::move(writer);
+        return true;
+#else
+        (void)name;
+        return false;
 #endif
+    }
 
-namespace Eclipse
-{
-    Logger::Logger() : currentLevel(ELevel::ECLIPSE_DEBUG)
+    void Logger::detachSharedLog()
     {
-#ifdef _WIN32
-        HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-        if (hConsole != INVALID_HANDLE_VALUE)
+        std::lock_guard<std::mutex> lock(fileMutex);
+        sharedLog.reset();
+    }
+
+    bool Logger::startCollector(const std::string &name, const std::string &outputPath,
+                                const SharedLogOptions &options)
+    {
+#ifndef _WIN32
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (collector)
         {
-            DWORD mode;
-            GetConsoleMode(hConsole, &mode);
-            SetConsoleMode(hConsole, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+            return false;
         }
-        SetConsoleOutputCP(CP_UTF8);
-        SetConsoleCP(CP_UTF8);
+        std::unique_ptr<SharedLogCollector> created(new SharedLogCollector(name, outputPath, options));
+        if (!created->open())
+        {
+            return false;
+        }
+        created->start();
+        collector = std::move(created);
+        return true;
+#else
+        (void)name;
+        (void)outputPath;
+        (void)options;
+        return false;
 #endif
     }
 
-    Logger &Logger::getInstance()
+    void Logger::stopCollector(bool unlinkSegment)
     {
-        static std::once_flag flag;
-        static Logger *instance = nullptr;
-        std::call_once(flag, []()
-                       { instance = new Logger(); });
-        return *instance;
+        std::unique_ptr<SharedLogCollector> stopping;
+        {
+            std::lock_guard<std::mutex> lock(fileMutex);
+            stopping = std::move(collector);
+        }
+        if (stopping)
+        {
+            stopping->stop();
+            if (unlinkSegment)
+            {
+                stopping->unlink();
+            }
+        }
     }
 
-    void Logger::setLevel(ELevel level)
+    bool Logger::registerRealtimeThread(size_t ringBytes)
     {
-        std::lock_guard<std::mutex> lock(levelMutex);
-        currentLevel = level;
+        if (shutdownStarted.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        if (RealtimeLog::active())
+        {
+            return true;
+        }
+
+        std::shared_ptr<RealtimeRing> ring = std::make_shared<RealtimeRing>(ringBytes);
+        // Resolve the clock once so the first real-time record does not pay for it
+        bool tsc = false;
+        RealtimeLog::stamp(tsc);
+        {
+            std::lock_guard<std::mutex> lock(realtimeMutex);
+            realtimeRings.push_back(ring);
+            ensureBackend();
+        }
+        realtimeThreadGuard.ring = ring;
+        RealtimeLog::threadRing = ring.get();
+        return true;
     }
 
-    ELevel Logger::getLevel() const
+    void Logger::unregisterRealtimeThread()
     {
-        std::lock_guard<std::mutex> lock(levelMutex);
-        return currentLevel;
+        if (realtimeThreadGuard.ring)
+        {
+            realtimeThreadGuard.ring->close();
+            realtimeThreadGuard.ring.reset();
+        }
+        RealtimeLog::threadRing = nullptr;
     }
 
-    void Logger::setLogFile(const std::string &filePath)
+    void Logger::ensureBackend()
     {
-        std::lock_guard<std::mutex> lock(fileMutex);
-        logFilePath = filePath;
-        if (logFileStream.is_open())
+        if (!backend)
         {
-            logFileStream.close();
+            backend.reset(new Backend());
+            backend->addTask([this]()
+                             { drainRealtime(); },
+                             std::chrono::milliseconds(1));
+            backend->addTask([this]()
+                             { clock.recalibrate(); },
+                             std::chrono::milliseconds(1000));
+            backend->addTask([this]()
+                             { writeFrontBuffer(false); },
+                             std::chrono::milliseconds(1));
+            backend->addTask([this]()
+                             { segmentStore.enforceRetention(); },
+                             std::chrono::milliseconds(1000));
+            backend->addTask([this]()
+                             { checkRotation(); },
+                             std::chrono::milliseconds(10));
+            backend->addTask([this]()
+                             { emitMetrics(false); },
+                             std::chrono::milliseconds(100));
+            backend->addTask([this]()
+                             { exportPrometheus(false); },
+                             std::chrono::milliseconds(100));
+            backend->addTask([this]()
+                             { refreshUtcOffset(); },
+                             std::chrono::milliseconds(60000));
         }
-        logFileStream.open(logFilePath, std::ios::app);
+        backend->start();
     }
 
-    void Logger::closeLogFile()
+    void Logger::drainRealtime()
     {
-        std::lock_guard<std::mutex> lock(fileMutex);
-        if (logFileStream.is_open())
+        std::vector<std::shared_ptr<RealtimeRing>> rings;
         {
-            logFileStream.close();
+            std::lock_guard<std::mutex> lock(realtimeMutex);
+            rings = realtimeRings;
         }
-        logFilePath.clear();
+
+        std::vector<char> record;
+        RealtimeEntry entry;
+        for (const std::shared_ptr<RealtimeRing> &ring : rings)
+        {
+            while (ring->pop(record))
+            {
+                if (RealtimeLog::decode(record.data(), record.size(), clock, entry))
+                {
+                    emitRecord(entry.level, entry.tag, entry.msg, entry.details, entry.trace, entry.timestamp);
+                }
+            }
+            uint64_t dropped = ring->takeDropped();
+            if (dropped != 0)
+            {
+                ECLIPSE_PROBE2(drop, "realtime_ring", dropped);
+                realtimeDrops.fetch_add(dropped, std::memory_order_relaxed);
+                emitRecord(ELevel::ECLIPSE_WARN, "Realtime", "Ring full, records dropped",
+                           {"dropped=" + std::to_string(dropped)}, "", clock.now());
+            }
+        }
+
+        // Rings closed by their thread are released once drained
+        std::lock_guard<std::mutex> lock(realtimeMutex);
+        realtimeRings.erase(std::remove_if(realtimeRings.begin(), realtimeRings.end(),
+                                           [](const std::shared_ptr<RealtimeRing> &ring)
+                                           { return !ring->isOpen() && ring->isEmpty(); }),
+                            realtimeRings.end());
+    }
+
+    bool Logger::setClockSource(EClockSource source)
+    {
+        bool selected = clock.setSource(source);
+        if (clock.getSource() == EClockSource::TSC)
+        {
+            // The backend keeps the TSC mapping in step with CLOCK_REALTIME
+            std::lock_guard<std::mutex> lock(realtimeMutex);
+            if (!shutdownStarted.load(std::memory_order_acquire))
+            {
+                ensureBackend();
+            }
+        }
+        return selected;
+    }
+
+    EClockSource Logger::getClockSource() const
+    {
+        return clock.getSource();
+    }
+
+    void Logger::setManualTime(std::chrono::system_clock::time_point time)
+    {
+        clock.setManualTime(time);
+    }
+
+    void Logger::advanceManualTime(std::chrono::nanoseconds delta)
+    {
+        clock.advanceManualTime(delta);
+    }
+
+    void Logger::setTimestampFormat(ETimestampFormat format)
+    {
+        timestampFormat.store(format, std::memory_order_relaxed);
+    }
+
+    ETimestampFormat Logger::getTimestampFormat() const
+    {
+        return timestampFormat.load(std::memory_order_relaxed);
     }
 
     void Logger::setOutputDestination(EOutput output)
@@ -143,6 +1361,46 @@ namespace Eclipse
                         currentLevel = level;
                     }
                 }
+                else if (key == "ECLIPSE_TIMESTAMP_FORMAT")
+                {
+                    std::string format = value;
+                    format.erase(0, format.find_first_not_of(" \t\r\n\"'"));
+                    format.erase(format.find_last_not_of(" \t\r\n\"'") + 1);
+                    std::transform(format.begin(), format.end(), format.begin(), ::toupper);
+                    if (format == "DEFAULT" || format == "ISO8601")
+                    {
+                        setTimestampFormat(format == "ISO8601" ? ETimestampFormat::ISO8601 : ETimestampFormat::DEFAULT);
+                    }
+                }
+                else if (key == "ECLIPSE_FILE_FORMAT")
+                {
+                    std::string format = value;
+                    format.erase(0, format.find_first_not_of(" \t\r\n\"'"));
+                    format.erase(format.find_last_not_of(" \t\r\n\"'") + 1);
+                    std::transform(format.begin(), format.end(), format.begin(), ::toupper);
+                    if (format == "TEXT" || format == "FRAMED" || format == "COMPRESSED" || format == "BINARY")
+                    {
+                        setFileFormat(format == "FRAMED"       ? EFileFormat::FRAMED
+                                      : format == "COMPRESSED" ? EFileFormat::COMPRESSED
+                                      : format == "BINARY"     ? EFileFormat::BINARY
+                                                               : EFileFormat::TEXT);
+                    }
+                }
+                else if (key == "ECLIPSE_COMPRESSION_DICTIONARY")
+                {
+                    std::string path = value;
+                    path.erase(0, path.find_first_not_of(" \t\r\n\"'"));
+                    path.erase(path.find_last_not_of(" \t\r\n\"'") + 1);
+                    setCompressionDictionary(path);
+                }
+                else if (key == "ECLIPSE_CLOCK_SOURCE")
+                {
+                    EClockSource source;
+                    if (parseClockSource(value, source))
+                    {
+                        setClockSource(source);
+                    }
+                }
             }
         }
         return true;
@@ -184,19 +1442,39 @@ namespace Eclipse
         return false;
     }
 
+    bool Logger::parseClockSource(const std::string &value, EClockSource &outSource) const
+    {
+        std::string cleanValue = value;
+        cleanValue.erase(0, cleanValue.find_first_not_of(" \t\r\n\"'"));
+        cleanValue.erase(cleanValue.find_last_not_of(" \t\r\n\"'") + 1);
+        std::transform(cleanValue.begin(), cleanValue.end(), cleanValue.begin(), ::toupper);
+
+        static const std::unordered_map<std::string, EClockSource> sourceMap = {
+            {"REALTIME", EClockSource::REALTIME},
+            {"COARSE", EClockSource::COARSE},
+            {"TSC", EClockSource::TSC},
+            {"MANUAL", EClockSource::MANUAL}};
+
+        auto it = sourceMap.find(cleanValue);
+        if (it != sourceMap.end())
+        {
+            outSource = it->second;
+            return true;
+        }
+        return false;
+    }
+
     std::string Logger::getTimestamp() const
     {
-        auto now = std::chrono::system_clock::now();
-        auto in_time_t = std::chrono::system_clock::to_time_t(now);
-        std::tm buf{};
-#ifdef _WIN32
-        localtime_s(&buf, &in_time_t);
-#else
-        localtime_r(&in_time_t, &buf);
-#endif
-        std::ostringstream ss;
-        ss << std::put_time(&buf, "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+        char timestamp[TimestampFormatter::kMaxLength];
+        return std::string(timestamp, formatTimestamp(clock.now(), timestamp));
+    }
+
+    size_t Logger::formatTimestamp(std::chrono::system_clock::time_point time, char *out) const
+    {
+        // Each thread keeps its own per-second cache
+        thread_local TimestampFormatter formatter;
+        return formatter.format(time, timestampFormat.load(std::memory_order_relaxed), out);
     }
 
     std::string Logger::truncatePath(const std::string &path) const
@@ -229,97 +1507,320 @@ namespace Eclipse
     void Logger::log(ELevel level, const std::string &tag, const std::string &msg,
                      const std::vector<std::string> &details, const std::string &trace)
     {
-        if (level < currentLevel)
+        if (level < currentLevel.load(std::memory_order_relaxed))
             return;
 
-        std::lock_guard<std::mutex> lock(logMutex);
+        // Nothing would take a file-only record before the next retry; skip formatting it
+        if (skipFileRecords.load(std::memory_order_relaxed) &&
+            outputDestination.load(std::memory_order_relaxed) == EOutput::FILE &&
+            steadyNanoseconds() < retryDueNs.load(std::memory_order_relaxed))
+        {
+            skippedRecords.fetch_add(1, std::memory_order_relaxed);
+            ECLIPSE_PROBE2(drop, "retry_window", 1);
+            return;
+        }
 
-        std::ostringstream out;
+        emitRecord(level, tag, msg, details, trace, clock.now());
+    }
 
-        std::string grayColor = "\033[90m";
-        std::string whiteColor = "\033[37m";
-        std::string resetColor = "\033[0m";
-        std::string boldColor = "\033[1m";
-        std::string levelColor = getColour(level);
+    void Logger::emitRecord(ELevel level, const std::string &tag, const std::string &msg,
+                            const std::vector<std::string> &details, const std::string &trace,
+                            std::chrono::system_clock::time_point time)
+    {
+        if (level < ELevel::ECLIPSE_NONE)
+        {
+            levelRecords[static_cast<size_t>(level)].fetch_add(1, std::memory_order_relaxed);
+        }
 
-        std::string timestamp = getTimestamp();
-        std::string levelName = getLevelName(level);
+        EOutput destination = outputDestination.load(std::memory_order_relaxed);
+        EWriteMode mode = writeMode.load(std::memory_order_acquire);
+        bool buffered = mode != EWriteMode::IMMEDIATE && !shutdownStarted.load(std::memory_order_acquire);
 
-        const uint8_t maxLevelWidth = 5;
-        std::string paddedLevelName = levelName;
-        while (paddedLevelName.length() < maxLevelWidth)
+        // Buffered file-only records never wait for the sink
+        std::unique_lock<std::mutex> lock(logMutex, std::defer_lock);
+        if (!buffered || destination != EOutput::FILE)
         {
-            paddedLevelName += " ";
+            lock.lock();
         }
 
-        size_t prefixLength = timestamp.length() + 3 + maxLevelWidth + 2;
-        std::string indent(prefixLength, ' ');
+        // BINARY log files take the fields; text is only built for the console and other files
+        std::string fileOutput;
+        if (binaryRecords.load(std::memory_order_relaxed) &&
+            (destination == EOutput::FILE || destination == EOutput::BOTH))
+        {
+            int64_t timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+            appendBinaryRecord(recordSequence.fetch_add(1, std::memory_order_relaxed), timeNs,
+                               static_cast<uint8_t>(level), tag, msg, trace, details, fileOutput);
+        }
 
-        out << grayColor << "[" << timestamp << "] "
-            << levelColor << boldColor << paddedLevelName << resetColor << ": "
-            << whiteColor << "┏ "
-            << whiteColor << "[" << levelColor << tag << whiteColor << "] "
-            << whiteColor << msg << resetColor << "\n";
+        if (destination == EOutput::CONSOLE || destination == EOutput::BOTH)
+        {
+            // Reused, so console records allocate nothing once it has grown
+            thread_local std::string consoleText;
+            consoleText.clear();
+            appendRecordText(level, tag, msg, details, trace, time, true, consoleText);
+            std::cout.write(consoleText.data(), static_cast<std::streamsize>(consoleText.size()));
+        }
 
-        if (!details.empty())
+        if (destination == EOutput::FILE || destination == EOutput::BOTH)
         {
-            if (!trace.empty())
+            if (fileOutput.empty())
             {
-                out << indent << whiteColor << "┃ "
-                    << levelColor << "at: " << whiteColor << trace << resetColor << "\n";
+                // The record itself is the one allocation; it outlives this call in the buffers
+                size_t length = 96 + tag.size() + msg.size() + trace.size();
+                for (const std::string &detail : details)
+                {
+                    length += 48 + detail.size();
+                }
+                fileOutput.reserve(length);
+                appendRecordText(level, tag, msg, details, trace, time, false, fileOutput);
+                if (fileOutput.find("\033[") != std::string::npos)
+                {
+                    // Colour codes in the fields themselves
+                    fileOutput = stripColours(std::move(fileOutput));
+                }
             }
-
-            for (size_t i = 0; i < details.size(); ++i)
+            if (buffered)
             {
-                if (i == details.size() - 1)
+                // logMutex only orders console output; buffering takes bufferMutex and frontMutex
+                if (lock.owns_lock())
                 {
-                    out << indent << whiteColor << "┗ "
-                        << grayColor << "[" << (i + 1) << "] " << details[i] << resetColor << "\n";
+                    lock.unlock();
                 }
-                else
+                if (mode == EWriteMode::THREAD_BUFFERED)
+                {
+                    bufferRecord(level, fileOutput);
+                    return;
+                }
+                if (appendFront(fileOutput))
                 {
-                    out << indent << whiteColor << "┃ "
-                        << grayColor << "[" << (i + 1) << "] " << details[i] << resetColor << "\n";
+                    return;
                 }
             }
+
+            // Records this thread buffered before the mode changed go first
+            if (threadBuffer.registered)
+            {
+                std::lock_guard<std::mutex> bufferLock(threadBuffer.mutex);
+                flushThreadBuffer(threadBuffer);
+            }
+
+            std::lock_guard<std::mutex> fileLock(fileMutex);
+            if (sharedLog || segmented || logFileSink.isOpen() || shutdownComplete.load(std::memory_order_acquire))
+            {
+                writeFileOutput(fileOutput);
+            }
+        }
+    }
+
+    void Logger::appendRecordText(ELevel level, const std::string &tag, const std::string &msg,
+                                  const std::vector<std::string> &details, const std::string &trace,
+                                  std::chrono::system_clock::time_point time, bool colours, std::string &out) const
+    {
+        const char *grayColor = colours ? "\033[90m" : "";
+        const char *whiteColor = colours ? "\033[37m" : "";
+        const char *resetColor = colours ? "\033[0m" : "";
+        const char *boldColor = colours ? "\033[1m" : "";
+        std::string levelColor = colours ? getColour(level) : std::string();
+        std::string levelName = getLevelName(level);
+
+        char timestamp[TimestampFormatter::kMaxLength];
+        size_t timestampLength = formatTimestamp(time, timestamp);
+
+        const uint8_t maxLevelWidth = 5;
+        size_t prefixLength = timestampLength + 3 + maxLevelWidth + 2;
+
+        out.append(grayColor).append("[").append(timestamp, timestampLength).append("] ");
+        out.append(levelColor).append(boldColor).append(levelName);
+        out.append(maxLevelWidth - std::min<size_t>(levelName.size(), maxLevelWidth), ' ');
+        out.append(resetColor).append(": ").append(whiteColor).append("┏ ");
+        out.append(whiteColor).append("[").append(levelColor).append(tag).append(whiteColor).append("] ");
+        out.append(whiteColor).append(msg).append(resetColor).append("\n");
+
+        if (!details.empty())
+        {
+            if (!trace.empty())
+            {
+                out.append(prefixLength, ' ').append(whiteColor).append("┃ ");
+                out.append(levelColor).append("at: ").append(whiteColor).append(trace).append(resetColor).append("\n");
+            }
+
+            char number[24];
+            for (size_t i = 0; i < details.size(); ++i)
+            {
+                out.append(prefixLength, ' ').append(whiteColor).append(i == details.size() - 1 ? "┗ " : "┃ ");
+                int numberLength = std::snprintf(number, sizeof(number), "[%zu] ", i + 1);
+                out.append(grayColor).append(number, static_cast<size_t>(numberLength));
+                out.append(details[i]).append(resetColor).append("\n");
+            }
         }
         else if (!trace.empty())
         {
             // If we have no details but have trace, put trace on the bottom line with ┗
-            out << indent << whiteColor << "┗ "
-                << levelColor << "at: " << whiteColor << trace << resetColor << "\n";
+            out.append(prefixLength, ' ').append(whiteColor).append("┗ ");
+            out.append(levelColor).append("at: ").append(whiteColor).append(trace).append(resetColor).append("\n");
+        }
+    }
+
+    void Logger::writeFileOutput(const std::string &fileOutput)
+    {
+        // Binary records only suit a BINARY log file, e.g. not the shared log's collector
+        if (isBinaryRecord(fileOutput.data(), fileOutput.size()) &&
+            (sharedLog || logFileSink.getFormat() != EFileFormat::BINARY))
+        {
+            writeFileOutput(binaryToText(fileOutput, timestampFormat.load(std::memory_order_relaxed)));
+            return;
         }
 
-        if (outputDestination == EOutput::CONSOLE || outputDestination == EOutput::BOTH)
+        bool direct = shutdownComplete.load(std::memory_order_acquire);
+        if (sharedLog)
+        {
+            sharedLog->write(fileOutput);
+        }
+        else if (segmented || logFileSink.isOpen())
+        {
+            writeLogFile(fileOutput);
+        }
+        else if (direct && (!logFilePath.empty() || !shutdownSegmentPath.empty()))
+        {
+            // After shutdown: reopen for this record only, nothing stays buffered
+            FileSink once;
+            once.setFormat(logFileSink.getFormat());
+            if (once.open(logFilePath.empty() ? shutdownSegmentPath : logFilePath))
+            {
+                once.write(fileOutput);
+            }
+        }
+        else if (direct && directToStderr)
         {
-            std::cout << out.str();
+            std::cerr << fileOutput;
         }
+    }
 
-        if (outputDestination == EOutput::FILE || outputDestination == EOutput::BOTH)
+    void Logger::writeLogFile(const std::string &fileOutput)
+    {
+        int64_t now = steadyNanoseconds();
+        bool failed = fileFailed.load(std::memory_order_relaxed);
+        if (failed && now < retryDueNs.load(std::memory_order_relaxed))
         {
-            std::lock_guard<std::mutex> fileLock(fileMutex);
-            if (logFileStream.is_open())
+            writeFallback(fileOutput);
+            return;
+        }
+
+        // Kept writes go first, so the file stays in order
+        if ((fallbackMemory.empty() || drainFallbackMemory()) && writeToFile(fileOutput))
+        {
+            if (failed)
             {
-                std::string fileOutput = out.str();
-                size_t pos = 0;
-                while ((pos = fileOutput.find("\033[", pos)) != std::string::npos)
-                {
-                    size_t end = fileOutput.find("m", pos);
-                    if (end != std::string::npos)
-                    {
-                        fileOutput.erase(pos, end - pos + 1);
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-                logFileStream << fileOutput;
-                logFileStream.flush();
+                clearFileFailure();
+                ++fileErrors.recoveries;
+                publishSignalState();
+            }
+            return;
+        }
+
+        ++fileErrors.failedWrites;
+        fileErrors.lastError = logFileSink.getLastError();
+        if (failed)
+        {
+            retryBackoff = std::min(retryBackoff * 2, retryDelay * kMaxRetryBackoff);
+        }
+        retryDueNs.store(now + std::chrono::duration_cast<std::chrono::nanoseconds>(retryBackoff).count(),
+                         std::memory_order_relaxed);
+        fileFailed.store(true, std::memory_order_relaxed);
+        skipFileRecords.store(fallback == EFallback::NONE, std::memory_order_relaxed);
+        if (!failed)
+        {
+            publishSignalState();
+        }
+        writeFallback(fileOutput);
+    }
+
+    bool Logger::writeToFile(const std::string &data)
+    {
+        int64_t started = steadyNanoseconds();
+        bool written = false;
+        if (!segmented)
+        {
+            written = logFileSink.write(data);
+        }
+        else
+        {
+            // Signal handlers must not write to the descriptor of a segment being finished
+            bool rolling = segmentStore.startsSegment(data.size());
+            if (rolling)
+            {
+                withdrawSignalFile();
+            }
+            written = segmentStore.write(data.data(), data.size());
+            if (rolling)
+            {
+                publishSignalState();
+            }
+        }
+        int64_t elapsed = steadyNanoseconds() - started;
+        const auto &bounds = LoggerStats::kSinkLatencyBoundsNs;
+        ++sinkWrites;
+        sinkWriteNs += elapsed;
+        ++sinkLatency[static_cast<size_t>(std::lower_bound(bounds.begin(), bounds.end(), elapsed) - bounds.begin())];
+        ECLIPSE_PROBE3(sink_write, data.size(), elapsed, written ? 1 : 0);
+        return written;
+    }
+
+    void Logger::writeFallback(const std::string &fileOutput)
+    {
+        switch (fallback)
+        {
+        case EFallback::STDERR:
+            std::cerr << binaryToText(fileOutput, timestampFormat.load(std::memory_order_relaxed)) << std::flush;
+            ++fileErrors.fallbackWrites;
+            break;
+        case EFallback::FILE:
+            if (!fallbackSink.isOpen() && !fallbackPath.empty() && fallbackSink.open(fallbackPath))
+            {
+                publishSignalState();
+            }
+            if (fallbackSink.write(binaryToText(fileOutput, timestampFormat.load(std::memory_order_relaxed))))
+            {
+                ++fileErrors.fallbackWrites;
+            }
+            else
+            {
+                ++fileErrors.droppedWrites;
+            }
+            break;
+        case EFallback::MEMORY:
+            fallbackMemory.push_back(fileOutput);
+            fallbackMemoryBytes += fileOutput.size();
+            ++fileErrors.fallbackWrites;
+            // Keep the newest writes
+            while (fallbackMemoryBytes > kFallbackMemoryBytes)
+            {
+                fallbackMemoryBytes -= fallbackMemory.front().size();
+                fallbackMemory.pop_front();
+                ++fileErrors.droppedWrites;
             }
+            break;
+        case EFallback::NONE:
+            ++fileErrors.droppedWrites;
+            break;
         }
     }
 
+    bool Logger::drainFallbackMemory(std::chrono::steady_clock::time_point deadline)
+    {
+        while (!fallbackMemory.empty())
+        {
+            if (std::chrono::steady_clock::now() >= deadline || !writeToFile(fallbackMemory.front()))
+            {
+                return false;
+            }
+            fallbackMemoryBytes -= fallbackMemory.front().size();
+            fallbackMemory.pop_front();
+        }
+        return true;
+    }
+
     bool Logger::assert(bool condition, const std::string &tag, const std::string &msg,
                         const std::vector<std::string> &details, const std::string &trace)
     {
@@ -0,0 +1,369 @@
+#include "Eclipse/Metrics.h"
+#include "Eclipse/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <sstream>
+
+namespace Eclipse
+{
+    namespace
+    {
+        constexpr int kMinExponent = -15;  ///< frexp() exponent of the lowest regular bucket, values from 2^-16
+        constexpr int kMaxExponent = 48;   ///< frexp() exponent of the highest bucket; larger values share it
+        constexpr size_t kSubBuckets = 8;  ///< Linear buckets per power of two
+        constexpr size_t kBuckets = 1 + static_cast<size_t>(kMaxExponent - kMinExponent + 1) * kSubBuckets;
+
+        size_t bucketOf(double value)
+        {
+            if (!(value >= std::ldexp(0.5, kMinExponent)))
+            {
+                return 0;
+            }
+            int exponent = 0;
+            double mantissa = std::frexp(value, &exponent);
+            if (std::isinf(value) || exponent > kMaxExponent)
+            {
+                return kBuckets - 1;
+            }
+            // The mantissa lies in [0.5, 1)
+            size_t sub = std::min(static_cast<size_t>((mantissa - 0.5) * 2.0 * kSubBuckets), kSubBuckets - 1);
+            return 1 + static_cast<size_t>(exponent - kMinExponent) * kSubBuckets + sub;
+        }
+
+        double bucketMidpoint(size_t bucket)
+        {
+            if (bucket == 0)
+            {
+                return 0;
+            }
+            size_t index = bucket - 1;
+            double width = 0.5 / kSubBuckets;
+            double lower = 0.5 + width * static_cast<double>(index % kSubBuckets);
+            return std::ldexp(lower + width / 2, kMinExponent + static_cast<int>(index / kSubBuckets));
+        }
+
+        /**
+         * @brief Aggregate of one metric
+         */
+        struct Cell
+        {
+            uint64_t count = 0;                                  ///< Updates
+            double sum = 0;                                      ///< Sum of the values
+            double min = std::numeric_limits<double>::infinity();  ///< Smallest value
+            double max = -std::numeric_limits<double>::infinity(); ///< Largest value
+            std::vector<uint64_t> buckets;                       ///< Histograms only, allocated on first use
+
+            void add(double value)
+            {
+                ++count;
+                sum += value;
+                min = std::min(min, value);
+                max = std::max(max, value);
+            }
+
+            void merge(const Cell &other)
+            {
+                count += other.count;
+                sum += other.sum;
+                min = std::min(min, other.min);
+                max = std::max(max, other.max);
+                if (!other.buckets.empty())
+                {
+                    buckets.resize(kBuckets, 0);
+                    for (size_t i = 0; i < kBuckets; ++i)
+                    {
+                        buckets[i] += other.buckets[i];
+                    }
+                }
+            }
+
+            /**
+             * @brief Clear the aggregate; the buckets keep their allocation
+             */
+            void reset()
+            {
+                count = 0;
+                sum = 0;
+                min = std::numeric_limits<double>::infinity();
+                max = -std::numeric_limits<double>::infinity();
+                std::fill(buckets.begin(), buckets.end(), 0);
+            }
+
+            double percentile(double fraction) const
+            {
+                uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count))));
+                uint64_t seen = 0;
+                for (size_t i = 0; i < buckets.size(); ++i)
+                {
+                    seen += buckets[i];
+                    if (seen >= rank)
+                    {
+                        return std::min(std::max(bucketMidpoint(i), min), max);
+                    }
+                }
+                return max;
+            }
+        };
+
+        struct Definition
+        {
+            std::string name; ///< Name given to the macro
+            EMetricType type; ///< Kind of metric
+        };
+
+        /**
+         * @brief One thread's aggregates, merged into the registry by collect() and at thread exit
+         */
+        struct Shard
+        {
+            ~Shard();
+
+            std::mutex mutex;         ///< Taken by the owner to update and by the registry to merge
+            std::vector<Cell> cells;  ///< Aggregates by metric id
+            bool registered = false;  ///< Listed in Registry::shards; only the owner sets it
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;                    ///< Guards the members; taken before a shard's mutex
+            std::vector<Definition> definitions; ///< Metrics by id
+            std::vector<Shard *> shards;         ///< Shards of threads that updated a metric
+            std::vector<Cell> pending;           ///< Merged since the last collect(), by id
+            std::vector<Cell> total;             ///< Merged since the start, by id
+        };
+
+        Registry &registry()
+        {
+            // Never destroyed: threads still exit and merge their shards during static destruction
+            static Registry *instance = new Registry();
+            return *instance;
+        }
+
+        /**
+         * @brief Move a shard's aggregates into the registry; both mutexes held
+         */
+        void drainShard(Registry &reg, Shard &shard)
+        {
+            for (size_t i = 0; i < shard.cells.size(); ++i)
+            {
+                Cell &cell = shard.cells[i];
+                if (cell.count != 0)
+                {
+                    reg.pending[i].merge(cell);
+                    reg.total[i].merge(cell);
+                    cell.reset();
+                }
+            }
+        }
+
+        /**
+         * @brief Merge every live shard; registry mutex held
+         */
+        void drainShards(Registry &reg)
+        {
+            for (Shard *shard : reg.shards)
+            {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                drainShard(reg, *shard);
+            }
+        }
+
+        MetricSummary summarize(const Definition &definition, const Cell &cell)
+        {
+            MetricSummary summary;
+            summary.name = definition.name;
+            summary.type = definition.type;
+            summary.count = cell.count;
+            summary.sum = cell.sum;
+            if (cell.count != 0)
+            {
+                summary.min = cell.min;
+                summary.max = cell.max;
+                if (!cell.buckets.empty())
+                {
+                    summary.p50 = cell.percentile(0.5);
+                    summary.p90 = cell.percentile(0.9);
+                    summary.p99 = cell.percentile(0.99);
+                }
+            }
+            return summary;
+        }
+
+        Shard::~Shard()
+        {
+            if (registered)
+            {
+                Registry &reg = registry();
+                std::lock_guard<std::mutex> lock(reg.mutex);
+                reg.shards.erase(std::remove(reg.shards.begin(), reg.shards.end(), this), reg.shards.end());
+                std::lock_guard<std::mutex> shardLock(mutex);
+                drainShard(reg, *this);
+            }
+        }
+
+        thread_local Shard threadShard;
+
+        /**
+         * @brief Lock the calling thread's shard and get the cell of a metric
+         */
+        Cell &lockCell(std::unique_lock<std::mutex> &lock, size_t id)
+        {
+            Shard &shard = threadShard;
+            if (!shard.registered)
+            {
+                Registry &reg = registry();
+                std::lock_guard<std::mutex> registryLock(reg.mutex);
+                reg.shards.push_back(&shard);
+                shard.registered = true;
+            }
+            // Uncontended unless collect() is merging this shard from another thread
+            lock = std::unique_lock<std::mutex>(shard.mutex);
+            if (shard.cells.size() <= id)
+            {
+                shard.cells.resize(id + 1);
+            }
+            return shard.cells[id];
+        }
+    }
+
+    size_t Metrics::define(const std::string &name, EMetricType type)
+    {
+        size_t id = 0;
+        {
+            Registry &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            id = static_cast<size_t>(std::find_if(reg.definitions.begin(), reg.definitions.end(),
+                                                  [&name](const Definition &definition)
+                                                  { return definition.name == name; }) -
+                                     reg.definitions.begin());
+            if (id < reg.definitions.size() && reg.definitions[id].type == type)
+            {
+                return id;
+            }
+            if (id == reg.definitions.size())
+            {
+                reg.definitions.push_back({name, type});
+                reg.pending.resize(id + 1);
+                reg.total.resize(id + 1);
+            }
+            else
+            {
+                id = kInvalidId;
+            }
+        }
+        if (id == kInvalidId)
+        {
+            // Logged after releasing the registry, which ranks below the logger's mutexes
+            Logger::getInstance().log(ELevel::ECLIPSE_WARN, "Metrics", "Metric defined again with another type, updates ignored",
+                                      {"name=" + name, type == EMetricType::COUNTER ? "type=counter" : "type=histogram"}, "");
+        }
+        else if (id == 0)
+        {
+            Logger::getInstance().startMetrics();
+        }
+        return id;
+    }
+
+    void Metrics::count(size_t id, double n)
+    {
+        if (id == kInvalidId)
+        {
+            return;
+        }
+        std::unique_lock<std::mutex> lock;
+        lockCell(lock, id).add(n);
+    }
+
+    void Metrics::observe(size_t id, double value)
+    {
+        if (id == kInvalidId)
+        {
+            return;
+        }
+        std::unique_lock<std::mutex> lock;
+        Cell &cell = lockCell(lock, id);
+        if (cell.buckets.empty())
+        {
+            cell.buckets.assign(kBuckets, 0);
+        }
+        cell.add(value);
+        ++cell.buckets[bucketOf(value)];
+    }
+
+    std::vector<MetricSummary> Metrics::collect()
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        drainShards(reg);
+        std::vector<MetricSummary> summaries;
+        for (size_t i = 0; i < reg.definitions.size(); ++i)
+        {
+            if (reg.pending[i].count != 0)
+            {
+                summaries.push_back(summarize(reg.definitions[i], reg.pending[i]));
+                reg.pending[i].reset();
+            }
+        }
+        return summaries;
+    }
+
+    std::vector<MetricSummary> Metrics::snapshot()
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        drainShards(reg);
+        std::vector<MetricSummary> summaries;
+        summaries.reserve(reg.definitions.size());
+        for (size_t i = 0; i < reg.definitions.size(); ++i)
+        {
+            summaries.push_back(summarize(reg.definitions[i], reg.total[i]));
+        }
+        return summaries;
+    }
+
+    std::string Metrics::formatValue(double value)
+    {
+        std::ostringstream out;
+        out << std::setprecision(15) << value;
+        return out.str();
+    }
+
+    void Metrics::forkPrepare()
+    {
+        registry().mutex.lock();
+    }
+
+    void Metrics::forkParent()
+    {
+        registry().mutex.unlock();
+    }
+
+    void Metrics::forkChild()
+    {
+        Registry &reg = registry();
+        reg.mutex.unlock();
+
+        // Only the forking thread exists in the child, and the parent reports everything so far
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.shards.erase(std::remove_if(reg.shards.begin(), reg.shards.end(),
+                                        [](Shard *shard)
+                                        { return shard != &threadShard; }),
+                         reg.shards.end());
+        if (threadShard.registered)
+        {
+            std::lock_guard<std::mutex> shardLock(threadShard.mutex);
+            for (Cell &cell : threadShard.cells)
+            {
+                cell.reset();
+            }
+        }
+        for (size_t i = 0; i < reg.definitions.size(); ++i)
+        {
+            reg.pending[i].reset();
+            reg.total[i].reset();
+        }
+    }
+}
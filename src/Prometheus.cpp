@@ -0,0 +1,157 @@
+#include "Eclipse/Prometheus.h"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <system_error>
+
+namespace Eclipse
+{
+    namespace
+    {
+        std::string formatSample(double value)
+        {
+            if (std::isnan(value))
+            {
+                return "NaN";
+            }
+            if (std::isinf(value))
+            {
+                return value > 0 ? "+Inf" : "-Inf";
+            }
+            return Metrics::formatValue(value);
+        }
+
+        /**
+         * @brief Exported name of a user metric: "eclipse_user_" and the name with
+         *        characters outside [a-zA-Z0-9_:] replaced by '_'
+         */
+        std::string metricName(const std::string &name)
+        {
+            std::string result = "eclipse_user_" + name;
+            for (char &c : result)
+            {
+                bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                             c == '_' || c == ':';
+                if (!valid)
+                {
+                    c = '_';
+                }
+            }
+            return result;
+        }
+
+        void writeHeader(std::ostringstream &out, const std::string &name, const char *type, const char *help)
+        {
+            out << "# HELP " << name << " " << help << "\n"
+                << "# TYPE " << name << " " << type << "\n";
+        }
+    }
+
+    std::string formatPrometheus(const LoggerStats &stats, const std::vector<MetricSummary> &metrics)
+    {
+        static const char *const levels[] = {"debug", "info", "warn", "error", "fatal"};
+        std::ostringstream out;
+
+        writeHeader(out, "eclipse_records_total", "counter", "Records logged, by level.");
+        for (size_t i = 0; i < stats.records.size(); ++i)
+        {
+            out << "eclipse_records_total{level=\"" << levels[i] << "\"} " << stats.records[i] << "\n";
+        }
+
+        writeHeader(out, "eclipse_dropped_records_total", "counter",
+                    "Records dropped before reaching the log file, by reason.");
+        out << "eclipse_dropped_records_total{reason=\"front_full\"} " << stats.bufferDrops << "\n"
+            << "eclipse_dropped_records_total{reason=\"realtime_ring\"} " << stats.realtimeDrops << "\n"
+            << "eclipse_dropped_records_total{reason=\"retry_window\"} " << stats.fileErrors.skippedRecords << "\n";
+
+        writeHeader(out, "eclipse_failed_writes_total", "counter", "Writes the log file rejected.");
+        out << "eclipse_failed_writes_total " << stats.fileErrors.failedWrites << "\n";
+        writeHeader(out, "eclipse_fallback_writes_total", "counter", "Writes taken by the fallback sink.");
+        out << "eclipse_fallback_writes_total " << stats.fileErrors.fallbackWrites << "\n";
+        writeHeader(out, "eclipse_dropped_writes_total", "counter", "Writes lost while the log file failed.");
+        out << "eclipse_dropped_writes_total " << stats.fileErrors.droppedWrites << "\n";
+        writeHeader(out, "eclipse_log_file_failed", "gauge", "Whether the log file is failed now.");
+        out << "eclipse_log_file_failed " << (stats.fileErrors.failed ? 1 : 0) << "\n";
+        writeHeader(out, "eclipse_queued_bytes", "gauge", "Formatted records waiting in write buffers.");
+        out << "eclipse_queued_bytes " << stats.queuedBytes << "\n";
+
+        writeHeader(out, "eclipse_sink_write_seconds", "histogram", "Time spent in writes to the log file.");
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < stats.sinkLatency.size(); ++i)
+        {
+            cumulative += stats.sinkLatency[i];
+            std::string bound = i < LoggerStats::kSinkLatencyBoundsNs.size()
+                                    ? formatSample(static_cast<double>(LoggerStats::kSinkLatencyBoundsNs[i]) / 1e9)
+                                    : "+Inf";
+            out << "eclipse_sink_write_seconds_bucket{le=\"" << bound << "\"} " << cumulative << "\n";
+        }
+        out << "eclipse_sink_write_seconds_sum " << formatSample(static_cast<double>(stats.sinkWriteTime.count()) / 1e9)
+            << "\n"
+            << "eclipse_sink_write_seconds_count " << stats.sinkWrites << "\n";
+
+        // Names that differ only in replaced characters would merge into one series; the first one keeps it
+        std::set<std::string> taken;
+        for (const MetricSummary &metric : metrics)
+        {
+            std::string name = metricName(metric.name);
+            if (metric.type == EMetricType::COUNTER)
+            {
+                const std::string suffix = "_total";
+                if (name.size() < suffix.size() || name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0)
+                {
+                    name += suffix;
+                }
+                if (!taken.insert(name).second)
+                {
+                    out << "# Skipped a metric also exported as " << name << "\n";
+                    continue;
+                }
+                out << "# TYPE " << name << " counter\n"
+                    << name << " " << formatSample(metric.sum) << "\n";
+                continue;
+            }
+            if (taken.count(name) || taken.count(name + "_sum") || taken.count(name + "_count"))
+            {
+                out << "# Skipped a metric also exported as " << name << "\n";
+                continue;
+            }
+            taken.insert({name, name + "_sum", name + "_count"});
+            // Quantiles of a histogram without observations are undefined
+            const double none = std::numeric_limits<double>::quiet_NaN();
+            out << "# TYPE " << name << " summary\n"
+                << name << "{quantile=\"0.5\"} " << formatSample(metric.count ? metric.p50 : none) << "\n"
+                << name << "{quantile=\"0.9\"} " << formatSample(metric.count ? metric.p90 : none) << "\n"
+                << name << "{quantile=\"0.99\"} " << formatSample(metric.count ? metric.p99 : none) << "\n"
+                << name << "_sum " << formatSample(metric.sum) << "\n"
+                << name << "_count " << metric.count << "\n";
+        }
+        return out.str();
+    }
+
+    bool writeFileAtomically(const std::string &path, const std::string &content)
+    {
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file << content;
+            file.flush();
+            if (!file)
+            {
+                std::error_code ignored;
+                std::filesystem::remove(temporary, ignored);
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error)
+        {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,238 @@
+#include "Eclipse/Realtime.h"
+#include <cstring>
+#include <sstream>
+
+namespace Eclipse
+{
+    namespace
+    {
+        constexpr size_t kMinimumRingBytes = 4096;
+
+        /**
+         * @brief Bounds-checked reader over an encoded record
+         */
+        class Reader
+        {
+        public:
+            Reader(const char *data, size_t size) : data(data), size(size) {}
+
+            template <typename T>
+            bool read(T &value)
+            {
+                if (size - offset < sizeof(T))
+                {
+                    return false;
+                }
+                std::memcpy(&value, data + offset, sizeof(T));
+                offset += sizeof(T);
+                return true;
+            }
+
+            bool readValue(std::string &out)
+            {
+                uint8_t tag = 0;
+                if (!read(tag))
+                {
+                    return false;
+                }
+                switch (static_cast<ERealtimeArg>(tag))
+                {
+                case ERealtimeArg::STRING:
+                {
+                    uint32_t length = 0;
+                    if (!read(length) || size - offset < length)
+                    {
+                        return false;
+                    }
+                    out.assign(data + offset, length);
+                    offset += length;
+                    return true;
+                }
+                case ERealtimeArg::SIGNED:
+                {
+                    int64_t value = 0;
+                    if (!read(value))
+                    {
+                        return false;
+                    }
+                    out = std::to_string(value);
+                    return true;
+                }
+                case ERealtimeArg::UNSIGNED:
+                {
+                    uint64_t value = 0;
+                    if (!read(value))
+                    {
+                        return false;
+                    }
+                    out = std::to_string(value);
+                    return true;
+                }
+                case ERealtimeArg::FLOATING:
+                {
+                    double value = 0;
+                    if (!read(value))
+                    {
+                        return false;
+                    }
+                    // Same formatting as the regular path's ostringstream
+                    std::ostringstream oss;
+                    oss << value;
+                    out = oss.str();
+                    return true;
+                }
+                case ERealtimeArg::CHARACTER:
+                {
+                    char value = 0;
+                    if (!read(value))
+                    {
+                        return false;
+                    }
+                    out.assign(1, value);
+                    return true;
+                }
+                case ERealtimeArg::UNSUPPORTED:
+                    out = "(unsupported)";
+                    return true;
+                }
+                return false;
+            }
+
+        private:
+            const char *data;
+            size_t size;
+            size_t offset = 0;
+        };
+    }
+
+    RealtimeRing::RealtimeRing(size_t bytes) : capacity(kMinimumRingBytes)
+    {
+        while (capacity < bytes)
+        {
+            capacity <<= 1;
+        }
+        buffer.reset(new char[capacity]);
+        // Touch every page now so pushes never take a page fault
+        std::memset(buffer.get(), 0, capacity);
+    }
+
+    bool RealtimeRing::push(const char *data, size_t size)
+    {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        uint64_t t = tail.load(std::memory_order_acquire);
+        if (size > capacity / 2 || h + size - t > capacity)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        copyIn(h, data, size);
+        head.store(h + size, std::memory_order_release);
+        return true;
+    }
+
+    bool RealtimeRing::pop(std::vector<char> &record)
+    {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        uint64_t h = head.load(std::memory_order_acquire);
+        if (t == h)
+        {
+            return false;
+        }
+        uint32_t size = 0;
+        copyOut(t, reinterpret_cast<char *>(&size), sizeof(size));
+        record.resize(size);
+        copyOut(t, record.data(), size);
+        tail.store(t + size, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t RealtimeRing::getDropped() const
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    uint64_t RealtimeRing::takeDropped()
+    {
+        uint64_t total = dropped.load(std::memory_order_relaxed);
+        uint64_t fresh = total - droppedReported;
+        droppedReported = total;
+        return fresh;
+    }
+
+    void RealtimeRing::close()
+    {
+        open.store(false, std::memory_order_release);
+    }
+
+    bool RealtimeRing::isOpen() const
+    {
+        return open.load(std::memory_order_acquire);
+    }
+
+    bool RealtimeRing::isEmpty() const
+    {
+        return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+    }
+
+    void RealtimeRing::copyIn(uint64_t position, const char *data, size_t size)
+    {
+        size_t offset = static_cast<size_t>(position & (capacity - 1));
+        size_t first = std::min(size, capacity - offset);
+        std::memcpy(buffer.get() + offset, data, first);
+        std::memcpy(buffer.get(), data + first, size - first);
+    }
+
+    void RealtimeRing::copyOut(uint64_t position, char *data, size_t size) const
+    {
+        size_t offset = static_cast<size_t>(position & (capacity - 1));
+        size_t first = std::min(size, capacity - offset);
+        std::memcpy(data, buffer.get() + offset, first);
+        std::memcpy(data + first, buffer.get(), size - first);
+    }
+
+    bool RealtimeLog::decode(const char *data, size_t size, const Clock &clock, RealtimeEntry &entry)
+    {
+        Reader reader(data, size);
+        RealtimeHeader header{};
+        if (!reader.read(header))
+        {
+            return false;
+        }
+
+        entry.level = static_cast<ELevel>(header.level);
+        if ((header.flags & RealtimeHeader::kTscTimestamp) != 0)
+        {
+            entry.timestamp = clock.fromTsc(header.timestamp);
+        }
+        else
+        {
+            entry.timestamp = Clock::fromNs(static_cast<int64_t>(header.timestamp));
+        }
+        if (!reader.readValue(entry.tag) || !reader.readValue(entry.msg))
+        {
+            return false;
+        }
+
+        entry.details.resize(header.argCount);
+        for (std::string &detail : entry.details)
+        {
+            if (!reader.readValue(detail))
+            {
+                return false;
+            }
+        }
+
+        // Same layout as ETRACE_INFO(): "file:line [function]" without the directory
+        const char *filename = header.file != nullptr ? header.file : "";
+        for (const char *p = filename; *p != '\0'; ++p)
+        {
+            if (*p == '/' || *p == '\\')
+            {
+                filename = p + 1;
+            }
+        }
+        entry.trace = std::string(filename) + ":" + std::to_string(header.line) + " [" +
+                      (header.function != nullptr ? header.function : "") + "]";
+        return true;
+    }
+}
@@ -0,0 +1,477 @@
+#include "Eclipse/RecordReader.h"
+#include <algorithm>
+#include <ctime>
+
+namespace Eclipse
+{
+    namespace
+    {
+        const char kMagicBytes[] = {'\xEC', '\x1F', '\x5E', '\xA1'};
+        const char kFirstMarker[] = "┏ [";
+        const char kMiddleMarker[] = "┃ ";
+        const char kLastMarker[] = "┗ ";
+        const char *const kLevelNames[] = {"DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+        constexpr uint8_t kUnknownLevel = 5;
+
+        bool readDigits(std::string_view text, size_t position, size_t count, int &value)
+        {
+            if (position + count > text.size())
+            {
+                return false;
+            }
+            value = 0;
+            for (size_t i = position; i < position + count; ++i)
+            {
+                if (text[i] < '0' || text[i] > '9')
+                {
+                    return false;
+                }
+                value = value * 10 + (text[i] - '0');
+            }
+            return true;
+        }
+
+        /**
+         * @brief Days from 1970-01-01 to a date of the proleptic Gregorian calendar
+         */
+        int64_t daysFromCivil(int64_t year, unsigned month, unsigned day)
+        {
+            year -= month <= 2;
+            const int64_t era = (year >= 0 ? year : year - 399) / 400;
+            const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+            const unsigned dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+            const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+        }
+
+        /**
+         * @brief Parse either timestamp layout into nanoseconds since the epoch
+         */
+        bool parseTimestamp(std::string_view text, int64_t &timeNs)
+        {
+            int year, month, day, hour, minute, second;
+            if (text.size() < 19 || text[4] != '-' || text[7] != '-' || text[13] != ':' || text[16] != ':' ||
+                !readDigits(text, 0, 4, year) || !readDigits(text, 5, 2, month) || !readDigits(text, 8, 2, day) ||
+                !readDigits(text, 11, 2, hour) || !readDigits(text, 14, 2, minute) || !readDigits(text, 17, 2, second))
+            {
+                return false;
+            }
+
+            if (text.size() == 19 && text[10] == ' ')
+            {
+                std::tm local{};
+                local.tm_year = year - 1900;
+                local.tm_mon = month - 1;
+                local.tm_mday = day;
+                local.tm_hour = hour;
+                local.tm_min = minute;
+                local.tm_sec = second;
+                local.tm_isdst = -1;
+                std::time_t seconds = std::mktime(&local);
+                timeNs = static_cast<int64_t>(seconds) * 1000000000;
+                return true;
+            }
+            if (text[10] != 'T')
+            {
+                return false;
+            }
+
+            // Fraction of any precision, then "+hh:mm" or "-hh:mm"
+            size_t position = 19;
+            int64_t fraction = 0;
+            int64_t scale = 1000000000;
+            if (position < text.size() && text[position] == '.')
+            {
+                ++position;
+                while (position < text.size() && text[position] >= '0' && text[position] <= '9')
+                {
+                    if (scale > 1)
+                    {
+                        scale /= 10;
+                        fraction += (text[position] - '0') * scale;
+                    }
+                    ++position;
+                }
+            }
+            int offsetHours, offsetMinutes;
+            if (text.size() != position + 6 || (text[position] != '+' && text[position] != '-') ||
+                text[position + 3] != ':' || !readDigits(text, position + 1, 2, offsetHours) ||
+                !readDigits(text, position + 4, 2, offsetMinutes))
+            {
+                return false;
+            }
+            int64_t offset = (offsetHours * 60 + offsetMinutes) * 60 * (text[position] == '-' ? -1 : 1);
+            int64_t seconds = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400 +
+                              hour * 3600 + minute * 60 + second - offset;
+            timeNs = seconds * 1000000000 + fraction;
+            return true;
+        }
+
+        /**
+         * @brief Parse the first line of a record: "[ts] LEVEL: ┏ [tag] msg"
+         */
+        bool parseFirstLine(std::string_view line, BinaryRecord &record)
+        {
+            size_t close = line.find("] ");
+            if (line.empty() || line[0] != '[' || close == std::string_view::npos ||
+                !parseTimestamp(line.substr(1, close - 1), record.timeNs))
+            {
+                return false;
+            }
+            size_t colon = line.find(": ", close + 2);
+            size_t marker = line.find(kFirstMarker, close + 2);
+            if (colon == std::string_view::npos || marker != colon + 2)
+            {
+                return false;
+            }
+            std::string_view level = line.substr(close + 2, colon - close - 2);
+            while (!level.empty() && level.back() == ' ')
+            {
+                level.remove_suffix(1);
+            }
+            record.level = kUnknownLevel;
+            for (uint8_t i = 0; i < kUnknownLevel; ++i)
+            {
+                if (level == kLevelNames[i])
+                {
+                    record.level = i;
+                }
+            }
+
+            size_t tagStart = marker + sizeof(kFirstMarker) - 1;
+            size_t tagEnd = line.find("] ", tagStart);
+            if (tagEnd == std::string_view::npos)
+            {
+                // An empty message leaves no space after the tag
+                if (line.size() <= tagStart || line.back() != ']')
+                {
+                    return false;
+                }
+                tagEnd = line.size() - 1;
+            }
+            record.tag.assign(line.substr(tagStart, tagEnd - tagStart));
+            record.msg.assign(tagEnd + 2 <= line.size() ? line.substr(tagEnd + 2) : std::string_view());
+            record.trace.clear();
+            record.details.clear();
+            return true;
+        }
+
+        bool startsWith(std::string_view text, std::string_view prefix)
+        {
+            return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+        }
+    }
+
+    bool TextRecordParser::addLine(std::string_view line, std::vector<BinaryRecord> &records)
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+
+        BinaryRecord record;
+        if (parseFirstLine(line, record))
+        {
+            finish(records);
+            current = std::move(record);
+            open = true;
+            return true;
+        }
+        if (!open)
+        {
+            ++skipped;
+            return false;
+        }
+
+        std::string_view rest = line;
+        size_t indent = rest.find_first_not_of(' ');
+        rest.remove_prefix(indent == std::string_view::npos ? rest.size() : indent);
+        bool last = startsWith(rest, kLastMarker);
+        if (indent > 0 && (last || startsWith(rest, kMiddleMarker)))
+        {
+            rest.remove_prefix(sizeof(kLastMarker) - 1);
+            size_t close = rest.find("] ");
+            if (current.trace.empty() && current.details.empty() && startsWith(rest, "at: "))
+            {
+                current.trace.assign(rest.substr(4));
+            }
+            else if (startsWith(rest, "[") && close != std::string_view::npos)
+            {
+                current.details.emplace_back(rest.substr(close + 2));
+            }
+            else
+            {
+                current.details.emplace_back(rest);
+            }
+            // Kept open: a last detail or trace holding newlines continues on unmarked lines
+            ended = ended || last;
+            return false;
+        }
+
+        // A line without a marker continues a message, trace or detail that held a newline
+        std::string &continued = !current.details.empty() ? current.details.back()
+                                 : !current.trace.empty() ? current.trace
+                                                          : current.msg;
+        continued += '\n';
+        continued.append(line);
+        return false;
+    }
+
+    void TextRecordParser::finish(std::vector<BinaryRecord> &records)
+    {
+        if (open)
+        {
+            records.push_back(std::move(current));
+            current = BinaryRecord();
+            open = false;
+            ended = false;
+        }
+    }
+
+    void TextRecordParser::finishEnded(std::vector<BinaryRecord> &records)
+    {
+        if (ended)
+        {
+            finish(records);
+        }
+    }
+
+    uint64_t TextRecordParser::getSkippedLines() const
+    {
+        return skipped;
+    }
+
+    bool RecordReader::open(const std::string &path)
+    {
+        close();
+        char magic[sizeof(kMagicBytes)] = {};
+        {
+            std::ifstream probe(path, std::ios::binary);
+            if (!probe.is_open())
+            {
+                return false;
+            }
+            probe.read(magic, sizeof(magic));
+            framed = probe.gcount() == sizeof(magic) && std::equal(magic, magic + sizeof(magic), kMagicBytes);
+        }
+        if (framed)
+        {
+            // Records are taken from getRecords(), so BINARY blocks need no rendering
+            frames.setRenderRecords(false);
+            return frames.open(path);
+        }
+        file.open(path, std::ios::binary);
+        return file.is_open();
+    }
+
+    void RecordReader::close()
+    {
+        frames.close();
+        if (file.is_open())
+        {
+            file.close();
+        }
+        file.clear();
+        framed = false;
+        buffer.clear();
+        bufferOffset = 0;
+        parser = TextRecordParser();
+        recordStart = 0;
+        pending.clear();
+        pendingOffsets.clear();
+        pendingSyncs.clear();
+        position = offset = syncOffset = 0;
+        finished = false;
+    }
+
+    bool RecordReader::setDictionary(const std::string &dictionary)
+    {
+        return frames.setDictionary(dictionary);
+    }
+
+    bool RecordReader::next(BinaryRecord &record)
+    {
+        while (pending.empty())
+        {
+            if (finished)
+            {
+                return false;
+            }
+
+            if (framed)
+            {
+                std::string payload;
+                if (!frames.next(payload))
+                {
+                    if (follow)
+                    {
+                        return false;
+                    }
+                    finished = true;
+                    continue;
+                }
+                const std::vector<BinaryRecord> &decoded = frames.getRecords();
+                if (!decoded.empty())
+                {
+                    pending.insert(pending.end(), decoded.begin(), decoded.end());
+                    pendingOffsets.insert(pendingOffsets.end(), decoded.size(), frames.getFrameOffset());
+                    pendingSyncs.insert(pendingSyncs.end(), decoded.size(), frames.getSyncOffset());
+                    continue;
+                }
+                // Every frame holds whole records
+                parseText(payload, frames.getFrameOffset());
+                parser.finish(parsed);
+                takeParsed();
+            }
+            else
+            {
+                size_t kept = buffer.size();
+                buffer.resize(kept + readAhead);
+                // Clear EOF from an earlier pass so a growing file is read further
+                file.clear();
+                file.read(&buffer[kept], static_cast<std::streamsize>(readAhead));
+                buffer.resize(kept + static_cast<size_t>(file.gcount()));
+                size_t end = buffer.rfind('\n');
+                if (file.gcount() == 0 && follow)
+                {
+                    // A record whose last line arrived is complete as long as the writer is idle
+                    parser.finishEnded(parsed);
+                    takeParsed();
+                    if (pending.empty())
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                if (file.gcount() == 0)
+                {
+                    parseText(buffer, bufferOffset);
+                    parser.finish(parsed);
+                    bufferOffset += buffer.size();
+                    buffer.clear();
+                    finished = true;
+                }
+                else if (end != std::string::npos)
+                {
+                    parseText(std::string_view(buffer).substr(0, end + 1), bufferOffset);
+                    bufferOffset += end + 1;
+                    buffer.erase(0, end + 1);
+                }
+                takeParsed();
+            }
+        }
+
+        record = std::move(pending.front());
+        offset = pendingOffsets.front();
+        syncOffset = pendingSyncs.front();
+        pending.pop_front();
+        pendingOffsets.pop_front();
+        pendingSyncs.pop_front();
+        ++position;
+        return true;
+    }
+
+    bool RecordReader::seek(uint64_t offset)
+    {
+        pending.clear();
+        pendingOffsets.clear();
+        pendingSyncs.clear();
+        parsed.clear();
+        parsedOffsets.clear();
+        finished = false;
+        position = 0;
+        if (framed)
+        {
+            return frames.seek(offset);
+        }
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        // Drop the record the parser has open; it belongs to the old position
+        std::vector<BinaryRecord> discarded;
+        parser.finish(discarded);
+        buffer.clear();
+        bufferOffset = offset;
+        recordStart = offset;
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(offset));
+        return file.good();
+    }
+
+    void RecordReader::setFollow(bool follow)
+    {
+        this->follow = follow;
+    }
+
+    void RecordReader::setReadAhead(size_t bytes)
+    {
+        readAhead = std::max<size_t>(bytes, 1);
+        frames.setReadAhead(bytes);
+    }
+
+    uint64_t RecordReader::getOffset() const
+    {
+        return offset;
+    }
+
+    uint64_t RecordReader::getSyncOffset() const
+    {
+        return syncOffset;
+    }
+
+    bool RecordReader::isFramed() const
+    {
+        return framed;
+    }
+
+    const LogReader &RecordReader::getLogReader() const
+    {
+        return frames;
+    }
+
+    uint64_t RecordReader::getSkippedLines() const
+    {
+        return parser.getSkippedLines();
+    }
+
+    void RecordReader::parseText(std::string_view text, uint64_t offset)
+    {
+        size_t start = 0;
+        while (start < text.size())
+        {
+            size_t end = text.find('\n', start);
+            if (end == std::string_view::npos)
+            {
+                end = text.size();
+            }
+            size_t before = parsed.size();
+            bool first = parser.addLine(text.substr(start, end - start), parsed);
+            // Records completed by this line started at an earlier first line
+            parsedOffsets.insert(parsedOffsets.end(), parsed.size() - before, recordStart);
+            if (first)
+            {
+                // Every record of a frame shares the frame's offset
+                recordStart = framed ? offset : offset + start;
+            }
+            start = end + 1;
+        }
+    }
+
+    void RecordReader::takeParsed()
+    {
+        // finish() completes the record still open at the end of a frame or file
+        parsedOffsets.resize(parsed.size(), recordStart);
+        for (size_t i = 0; i < parsed.size(); ++i)
+        {
+            // Text carries no sequence numbers
+            parsed[i].sequence = position + pending.size();
+            pending.push_back(std::move(parsed[i]));
+            pendingOffsets.push_back(parsedOffsets[i]);
+            pendingSyncs.push_back(parsedOffsets[i]);
+        }
+        parsed.clear();
+        parsedOffsets.clear();
+    }
+}
@@ -0,0 +1,134 @@
+#include "Eclipse/Replay.h"
+#include "Eclipse/RecordReader.h"
+#include <algorithm>
+#include <thread>
+
+namespace Eclipse
+{
+    namespace
+    {
+        using SteadyClock = std::chrono::steady_clock;
+
+        /**
+         * @brief Value below which the given fraction of the values lie; reorders values
+         */
+        int64_t percentile(std::vector<int64_t> &values, double fraction)
+        {
+            if (values.empty())
+            {
+                return 0;
+            }
+            size_t rank = std::min(values.size() - 1, static_cast<size_t>(fraction * static_cast<double>(values.size())));
+            std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), values.end());
+            return values[rank];
+        }
+    }
+
+    bool LogReplayer::load(const std::string &path, const std::string &dictionary)
+    {
+        RecordReader reader;
+        if ((!dictionary.empty() && !reader.setDictionary(dictionary)) || !reader.open(path))
+        {
+            return false;
+        }
+        BinaryRecord record;
+        while (reader.next(record))
+        {
+            records.push_back(std::move(record));
+        }
+        return true;
+    }
+
+    size_t LogReplayer::getRecordCount() const
+    {
+        return records.size();
+    }
+
+    ReplayStats LogReplayer::run(Logger &logger, const ReplayOptions &options) const
+    {
+        ReplayStats stats;
+        const size_t threads = std::max<size_t>(options.threads, 1);
+        if (records.empty())
+        {
+            return stats;
+        }
+
+        // Every record is due at its offset from the first one, scaled by the speed
+        const int64_t firstNs = records.front().timeNs;
+        std::vector<std::vector<int64_t>> latencies(threads);
+        std::vector<std::vector<int64_t>> lags(threads);
+        std::vector<SteadyClock::time_point> finished(threads);
+        const SteadyClock::time_point start = SteadyClock::now() + std::chrono::milliseconds(10);
+
+        auto work = [&](size_t t)
+        {
+            latencies[t].reserve(records.size() / threads + 1);
+            if (options.speed > 0)
+            {
+                lags[t].reserve(records.size() / threads + 1);
+            }
+            std::this_thread::sleep_until(start);
+            for (size_t i = t; i < records.size(); i += threads)
+            {
+                const BinaryRecord &record = records[i];
+                if (options.speed > 0)
+                {
+                    auto offset = std::chrono::nanoseconds(static_cast<int64_t>(
+                        static_cast<double>(std::max<int64_t>(record.timeNs - firstNs, 0)) / options.speed));
+                    SteadyClock::time_point due = start + std::chrono::duration_cast<SteadyClock::duration>(offset);
+                    SteadyClock::time_point now = SteadyClock::now();
+                    if (now < due)
+                    {
+                        std::this_thread::sleep_until(due);
+                        now = SteadyClock::now();
+                    }
+                    lags[t].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(now - due).count());
+                }
+
+                // Levels the capture did not know replay as INFO
+                ELevel level = record.level < static_cast<uint8_t>(ELevel::ECLIPSE_NONE)
+                                   ? static_cast<ELevel>(record.level)
+                                   : ELevel::ECLIPSE_INFO;
+                SteadyClock::time_point before = SteadyClock::now();
+                logger.log(level, record.tag, record.msg, record.details, record.trace);
+                latencies[t].push_back(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() - before).count());
+            }
+            finished[t] = SteadyClock::now();
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back(work, t);
+        }
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+        logger.flush();
+        SteadyClock::time_point flushed = SteadyClock::now();
+
+        std::vector<int64_t> latency;
+        std::vector<int64_t> lag;
+        for (size_t t = 0; t < threads; ++t)
+        {
+            latency.insert(latency.end(), latencies[t].begin(), latencies[t].end());
+            lag.insert(lag.end(), lags[t].begin(), lags[t].end());
+        }
+        stats.records = records.size();
+        stats.callsTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            *std::max_element(finished.begin(), finished.end()) - start);
+        stats.totalTime = std::chrono::duration_cast<std::chrono::nanoseconds>(flushed - start);
+        stats.latencyMax = std::chrono::nanoseconds(*std::max_element(latency.begin(), latency.end()));
+        stats.latencyP999 = std::chrono::nanoseconds(percentile(latency, 0.999));
+        stats.latencyP99 = std::chrono::nanoseconds(percentile(latency, 0.99));
+        stats.latencyP50 = std::chrono::nanoseconds(percentile(latency, 0.5));
+        if (!lag.empty())
+        {
+            stats.lagMax = std::chrono::nanoseconds(*std::max_element(lag.begin(), lag.end()));
+            stats.lagP99 = std::chrono::nanoseconds(percentile(lag, 0.99));
+        }
+        return stats;
+    }
+}
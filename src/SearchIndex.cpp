@@ -0,0 +1,463 @@
+#include "Eclipse/SearchIndex.h"
+#include "Eclipse/Frame.h"
+#include "Eclipse/RecordReader.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <system_error>
+
+namespace Eclipse
+{
+    namespace
+    {
+        const char kIndexMagic[] = {'E', 'C', 'I', 'X'};
+        constexpr char kIndexVersion = 1;
+        const char kTagPrefix[] = "tag=";
+        constexpr uint64_t kBlockBytes = 64 * 1024;   ///< Records past this distance from a block's start begin a new one
+        constexpr size_t kMaxTermLength = 256;        ///< Longer details are not indexed
+        constexpr size_t kSearchReadAhead = 64 * 1024; ///< Read size when jumping between blocks
+
+        void appendVarint(uint64_t value, std::string &out)
+        {
+            while (value >= 0x80)
+            {
+                out += static_cast<char>(value | 0x80);
+                value >>= 7;
+            }
+            out += static_cast<char>(value);
+        }
+
+        bool readVarint(const char *&p, const char *end, uint64_t &value)
+        {
+            value = 0;
+            for (unsigned shift = 0; shift < 64 && p < end; shift += 7)
+            {
+                uint8_t byte = static_cast<uint8_t>(*p++);
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if (byte < 0x80)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void appendString(std::string_view text, std::string &out)
+        {
+            appendVarint(text.size(), out);
+            out.append(text.data(), text.size());
+        }
+
+        bool readString(const char *&p, const char *end, std::string &text)
+        {
+            uint64_t length = 0;
+            if (!readVarint(p, end, length) || length > static_cast<uint64_t>(end - p))
+            {
+                return false;
+            }
+            text.assign(p, static_cast<size_t>(length));
+            p += length;
+            return true;
+        }
+
+        bool fileSize(const std::string &path, uint64_t &bytes)
+        {
+            std::error_code error;
+            bytes = std::filesystem::file_size(path, error);
+            return !error;
+        }
+
+        bool holdsTerm(const BinaryRecord &record, std::string_view term)
+        {
+            std::string_view prefix(kTagPrefix);
+            if (term.compare(0, prefix.size(), prefix) == 0 && term.substr(prefix.size()) == record.tag)
+            {
+                return true;
+            }
+            return std::find(record.details.begin(), record.details.end(), term) != record.details.end();
+        }
+    }
+
+    std::string SearchIndex::getIndexPath(const std::string &logPath)
+    {
+        return logPath + ".idx";
+    }
+
+    bool SearchIndex::matches(const BinaryRecord &record, const std::vector<std::string> &terms)
+    {
+        return std::all_of(terms.begin(), terms.end(), [&](const std::string &term)
+                           { return holdsTerm(record, term); });
+    }
+
+    bool SearchIndex::scan(const std::string &logPath, const std::vector<std::string> &terms,
+                           std::vector<BinaryRecord> &records, const std::string &dictionary)
+    {
+        RecordReader reader;
+        if (!dictionary.empty())
+        {
+            reader.setDictionary(dictionary);
+        }
+        if (!reader.open(logPath))
+        {
+            return false;
+        }
+        BinaryRecord record;
+        while (reader.next(record))
+        {
+            if (matches(record, terms))
+            {
+                records.push_back(std::move(record));
+            }
+        }
+        return true;
+    }
+
+    bool SearchIndex::build(const std::string &logPath, const std::vector<std::string> &fields,
+                            const std::string &dictionary)
+    {
+        this->fields = fields;
+        std::sort(this->fields.begin(), this->fields.end());
+        records = 0;
+        blocks.clear();
+        postings.clear();
+
+        RecordReader reader;
+        if (!dictionary.empty())
+        {
+            reader.setDictionary(dictionary);
+        }
+        if (!fileSize(logPath, sourceBytes) || !reader.open(logPath))
+        {
+            return false;
+        }
+
+        BinaryRecord record;
+        while (reader.next(record))
+        {
+            // Blocks never split a frame: its records share its offset
+            uint64_t offset = reader.getOffset();
+            if (blocks.empty() || offset - blocks.back().offset >= kBlockBytes)
+            {
+                blocks.push_back({offset, reader.getSyncOffset()});
+            }
+            // Records of other BINARY streams in the block may need an earlier start
+            blocks.back().start = std::min(blocks.back().start, reader.getSyncOffset());
+            uint32_t block = static_cast<uint32_t>(blocks.size() - 1);
+
+            auto add = [&](const std::string &term)
+            {
+                std::vector<uint32_t> &list = postings[term];
+                if (list.empty() || list.back() != block)
+                {
+                    list.push_back(block);
+                }
+            };
+            add(kTagPrefix + record.tag);
+            for (const std::string &detail : record.details)
+            {
+                if (isIndexed(detail))
+                {
+                    add(detail);
+                }
+            }
+            ++records;
+        }
+        return true;
+    }
+
+    bool SearchIndex::save(const std::string &path) const
+    {
+        std::string out(kIndexMagic, sizeof(kIndexMagic));
+        out += kIndexVersion;
+        appendVarint(sourceBytes, out);
+        appendVarint(records, out);
+        appendVarint(fields.size(), out);
+        for (const std::string &field : fields)
+        {
+            appendString(field, out);
+        }
+
+        appendVarint(blocks.size(), out);
+        uint64_t previous = 0;
+        for (const IndexBlock &block : blocks)
+        {
+            appendVarint(block.offset - previous, out);
+            appendVarint(block.offset - block.start, out);
+            previous = block.offset;
+        }
+
+        // Sorted terms share long prefixes ("request_id=..."), so each stores only what differs
+        std::vector<const std::string *> terms;
+        terms.reserve(postings.size());
+        for (const auto &entry : postings)
+        {
+            terms.push_back(&entry.first);
+        }
+        std::sort(terms.begin(), terms.end(), [](const std::string *a, const std::string *b)
+                  { return *a < *b; });
+        appendVarint(terms.size(), out);
+        std::string_view last;
+        for (const std::string *term : terms)
+        {
+            size_t shared = 0;
+            while (shared < last.size() && shared < term->size() && last[shared] == (*term)[shared])
+            {
+                ++shared;
+            }
+            appendVarint(shared, out);
+            appendString(std::string_view(*term).substr(shared), out);
+            last = *term;
+
+            const std::vector<uint32_t> &list = postings.at(*term);
+            appendVarint(list.size(), out);
+            uint32_t previousBlock = 0;
+            for (uint32_t block : list)
+            {
+                appendVarint(block - previousBlock, out);
+                previousBlock = block;
+            }
+        }
+
+        uint32_t crc = crc32c(out.data(), out.size());
+        for (int i = 0; i < 4; ++i)
+        {
+            out += static_cast<char>(crc >> (8 * i));
+        }
+
+        const std::filesystem::path temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(out.data(), static_cast<std::streamsize>(out.size()));
+            file.flush();
+            if (!file.good())
+            {
+                return false;
+            }
+        }
+        // Readers see either the old or the new index, never a partial one
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        return !error;
+    }
+
+    bool SearchIndex::load(const std::string &path)
+    {
+        fields.clear();
+        blocks.clear();
+        postings.clear();
+        sourceBytes = records = 0;
+
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        const std::string data = content.str();
+        if (!file.is_open() || data.size() < sizeof(kIndexMagic) + 1 + 4 ||
+            !std::equal(kIndexMagic, kIndexMagic + sizeof(kIndexMagic), data.begin()) ||
+            data[sizeof(kIndexMagic)] != kIndexVersion)
+        {
+            return false;
+        }
+        const char *p = data.data() + sizeof(kIndexMagic) + 1;
+        const char *end = data.data() + data.size() - 4;
+        uint32_t crc = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            crc |= static_cast<uint32_t>(static_cast<uint8_t>(end[i])) << (8 * i);
+        }
+        if (crc32c(data.data(), data.size() - 4) != crc)
+        {
+            return false;
+        }
+
+        bool valid = true;
+        uint64_t count = 0;
+        valid = readVarint(p, end, sourceBytes) && readVarint(p, end, records) && readVarint(p, end, count) &&
+                count <= static_cast<uint64_t>(end - p);
+        for (uint64_t i = 0; valid && i < count; ++i)
+        {
+            fields.emplace_back();
+            valid = readString(p, end, fields.back());
+        }
+
+        valid = valid && readVarint(p, end, count) && count <= static_cast<uint64_t>(end - p);
+        uint64_t offset = 0;
+        for (uint64_t i = 0; valid && i < count; ++i)
+        {
+            uint64_t delta = 0, back = 0;
+            valid = readVarint(p, end, delta) && readVarint(p, end, back) && back <= offset + delta;
+            offset += delta;
+            blocks.push_back({offset, offset - back});
+        }
+
+        valid = valid && readVarint(p, end, count) && count <= static_cast<uint64_t>(end - p);
+        std::string term;
+        for (uint64_t i = 0; valid && i < count; ++i)
+        {
+            uint64_t shared = 0, entries = 0;
+            std::string suffix;
+            valid = readVarint(p, end, shared) && shared <= term.size() && readString(p, end, suffix) &&
+                    readVarint(p, end, entries) && entries <= static_cast<uint64_t>(end - p);
+            if (!valid)
+            {
+                break;
+            }
+            term.resize(static_cast<size_t>(shared));
+            term += suffix;
+            std::vector<uint32_t> &list = postings[term];
+            uint64_t block = 0;
+            for (uint64_t e = 0; valid && e < entries; ++e)
+            {
+                uint64_t delta = 0;
+                valid = readVarint(p, end, delta) && block + delta < blocks.size();
+                block += delta;
+                list.push_back(static_cast<uint32_t>(block));
+            }
+        }
+
+        if (!valid || p != end)
+        {
+            fields.clear();
+            blocks.clear();
+            postings.clear();
+            sourceBytes = records = 0;
+            return false;
+        }
+        return true;
+    }
+
+    bool SearchIndex::isCurrent(const std::string &logPath) const
+    {
+        uint64_t bytes = 0;
+        return fileSize(logPath, bytes) && bytes == sourceBytes;
+    }
+
+    bool SearchIndex::search(const std::string &logPath, const std::vector<std::string> &terms,
+                             std::vector<BinaryRecord> &records, const std::string &dictionary)
+    {
+        blocksRead = 0;
+        RecordReader reader;
+        if (!dictionary.empty())
+        {
+            reader.setDictionary(dictionary);
+        }
+        if (!reader.open(logPath))
+        {
+            return false;
+        }
+        reader.setReadAhead(kSearchReadAhead);
+
+        // Intersect the block lists of the indexed terms; with none, every block is a candidate
+        std::vector<uint32_t> candidates;
+        bool narrowed = false;
+        for (const std::string &term : terms)
+        {
+            if (!isIndexed(term))
+            {
+                continue;
+            }
+            auto found = postings.find(term);
+            if (found == postings.end())
+            {
+                return true;
+            }
+            if (!narrowed)
+            {
+                candidates = found->second;
+                narrowed = true;
+                continue;
+            }
+            std::vector<uint32_t> both;
+            std::set_intersection(candidates.begin(), candidates.end(), found->second.begin(), found->second.end(),
+                                  std::back_inserter(both));
+            candidates.swap(both);
+        }
+        if (!narrowed)
+        {
+            candidates.resize(blocks.size());
+            for (size_t i = 0; i < candidates.size(); ++i)
+            {
+                candidates[i] = static_cast<uint32_t>(i);
+            }
+        }
+
+        // Read on from the previous block when its start is already behind; seek otherwise
+        BinaryRecord record;
+        bool held = false;       // record was read but belongs to a later block
+        uint64_t heldOffset = 0; // offset of the held record
+        uint64_t readFrom = 0;   // where the current run of reading started
+        for (uint32_t id : candidates)
+        {
+            const IndexBlock &block = blocks[id];
+            uint64_t blockEnd = id + 1 < blocks.size() ? blocks[id + 1].offset : UINT64_MAX;
+            if (!held || readFrom > block.start || block.start > heldOffset || heldOffset > block.offset)
+            {
+                if (!reader.seek(block.start))
+                {
+                    return false;
+                }
+                readFrom = block.start;
+                held = false;
+            }
+
+            while (held || reader.next(record))
+            {
+                uint64_t offset = held ? heldOffset : reader.getOffset();
+                held = false;
+                if (offset >= blockEnd)
+                {
+                    held = true;
+                    heldOffset = offset;
+                    break;
+                }
+                if (offset >= block.offset && matches(record, terms))
+                {
+                    records.push_back(record);
+                }
+            }
+            ++blocksRead;
+        }
+        return true;
+    }
+
+    uint64_t SearchIndex::getBlocksRead() const
+    {
+        return blocksRead;
+    }
+
+    const std::vector<IndexBlock> &SearchIndex::getBlocks() const
+    {
+        return blocks;
+    }
+
+    const std::vector<std::string> &SearchIndex::getFields() const
+    {
+        return fields;
+    }
+
+    size_t SearchIndex::getTermCount() const
+    {
+        return postings.size();
+    }
+
+    uint64_t SearchIndex::getRecordCount() const
+    {
+        return records;
+    }
+
+    bool SearchIndex::isIndexed(std::string_view term) const
+    {
+        std::string_view prefix(kTagPrefix);
+        if (term.compare(0, prefix.size(), prefix) == 0)
+        {
+            return true;
+        }
+        size_t equals = term.find('=');
+        if (equals == 0 || equals == std::string_view::npos || term.size() > kMaxTermLength)
+        {
+            return false;
+        }
+        return fields.empty() || std::binary_search(fields.begin(), fields.end(), term.substr(0, equals));
+    }
+}
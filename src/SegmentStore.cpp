@@ -0,0 +1,455 @@
+#include "Eclipse/SegmentStore.h"
+#include "Eclipse/SearchIndex.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+#include <sys/stat.h>
+
+namespace Eclipse
+{
+    namespace
+    {
+        const char kManifestName[] = "MANIFEST";
+        const char kManifestHeader[] = "# eclipse segments v1: name first-sequence writes bytes first-ns last-ns open";
+        constexpr size_t kSequenceDigits = 16;
+        constexpr size_t kNameLength = kSequenceDigits + 1 + 16 + 4; // "<seq>-YYYYMMDDTHHMMSSZ.log"
+
+        int64_t nowNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                .count();
+        }
+
+        std::string segmentName(uint64_t sequence, int64_t timeNs)
+        {
+            std::time_t seconds = static_cast<std::time_t>(timeNs / 1000000000);
+            std::tm utc{};
+#ifdef _WIN32
+            gmtime_s(&utc, &seconds);
+#else
+            gmtime_r(&seconds, &utc);
+#endif
+            char name[64];
+            std::snprintf(name, sizeof(name), "%016llu-%04d%02d%02dT%02d%02d%02dZ.log",
+                          static_cast<unsigned long long>(sequence), utc.tm_year + 1900, utc.tm_mon + 1,
+                          utc.tm_mday, utc.tm_hour, utc.tm_min, utc.tm_sec);
+            return name;
+        }
+
+        /**
+         * @brief Recognise a segment file name and extract its first sequence number
+         */
+        bool parseSegmentName(const std::string &name, uint64_t &sequence)
+        {
+            if (name.size() != kNameLength || name[kSequenceDigits] != '-' ||
+                name.compare(kNameLength - 4, 4, ".log") != 0)
+            {
+                return false;
+            }
+            for (size_t i = 0; i < kSequenceDigits; ++i)
+            {
+                if (name[i] < '0' || name[i] > '9')
+                {
+                    return false;
+                }
+            }
+            sequence = std::strtoull(name.substr(0, kSequenceDigits).c_str(), nullptr, 10);
+            return true;
+        }
+
+        /**
+         * @brief Size and modification time of a file, false if it does not exist
+         */
+        bool statFile(const std::string &path, uint64_t &bytes, int64_t &modifiedNs)
+        {
+            struct stat info{};
+            if (::stat(path.c_str(), &info) != 0)
+            {
+                return false;
+            }
+            bytes = static_cast<uint64_t>(info.st_size);
+            modifiedNs = static_cast<int64_t>(info.st_mtime) * 1000000000;
+            return true;
+        }
+    }
+
+    SegmentStore::SegmentStore(FileSink &sink) : sink(sink)
+    {
+    }
+
+    SegmentStore::~SegmentStore()
+    {
+        close();
+    }
+
+    bool SegmentStore::open(const std::string &path, const SegmentOptions &segmentOptions)
+    {
+        close();
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::error_code error;
+        std::filesystem::create_directories(path, error);
+        if (!std::filesystem::is_directory(path, error))
+        {
+            return false;
+        }
+        directory = path;
+        options = segmentOptions;
+        segments.clear();
+        nextSequence = 0;
+
+        // Keep listed segments that still exist; one left open by a crash is finished now
+        std::vector<SegmentInfo> listed;
+        readManifest(directory, listed);
+        for (SegmentInfo &segment : listed)
+        {
+            uint64_t bytes = 0;
+            int64_t modifiedNs = 0;
+            if (!statFile(pathOf(segment.name), bytes, modifiedNs))
+            {
+                continue;
+            }
+            if (segment.open)
+            {
+                segment.open = false;
+                segment.bytes = bytes;
+                segment.lastTimeNs = std::max(segment.lastTimeNs, modifiedNs);
+            }
+            segments.push_back(segment);
+        }
+
+        // Adopt segment files created just before a crash kept them out of the manifest
+        for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+        {
+            std::string name = entry.path().filename().string();
+            uint64_t sequence = 0;
+            if (!parseSegmentName(name, sequence) ||
+                std::any_of(segments.begin(), segments.end(), [&](const SegmentInfo &s)
+                            { return s.name == name; }))
+            {
+                continue;
+            }
+            SegmentInfo adopted;
+            adopted.name = name;
+            adopted.firstSequence = sequence;
+            if (statFile(pathOf(name), adopted.bytes, adopted.lastTimeNs))
+            {
+                adopted.firstTimeNs = adopted.lastTimeNs;
+                segments.push_back(adopted);
+            }
+        }
+        std::sort(segments.begin(), segments.end(), [](const SegmentInfo &a, const SegmentInfo &b)
+                  { return a.firstSequence < b.firstSequence; });
+
+        for (const SegmentInfo &segment : segments)
+        {
+            // Adopted segments have no write count; they hold at least one write if not empty
+            uint64_t writes = std::max<uint64_t>(segment.writes, segment.bytes > 0 ? 1 : 0);
+            nextSequence = std::max(nextSequence, segment.firstSequence + writes);
+        }
+
+        if (!startSegment())
+        {
+            directory.clear();
+            segments.clear();
+            return false;
+        }
+        return true;
+    }
+
+    void SegmentStore::close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (directory.empty())
+        {
+            return;
+        }
+        finishSegment();
+        writeManifest();
+        directory.clear();
+        segments.clear();
+    }
+
+    void SegmentStore::release()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!directory.empty())
+        {
+            sink.release();
+        }
+        directory.clear();
+        segments.clear();
+    }
+
+    bool SegmentStore::isOpen() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !directory.empty();
+    }
+
+    std::string SegmentStore::getDirectory() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return directory;
+    }
+
+    bool SegmentStore::reopen()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (directory.empty() || segments.empty() || !segments.back().open)
+        {
+            return false;
+        }
+        return sink.open(pathOf(segments.back().name));
+    }
+
+    bool SegmentStore::startsSegment(size_t size) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !directory.empty() && needsSegment(size);
+    }
+
+    bool SegmentStore::write(const char *data, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (directory.empty())
+        {
+            return false;
+        }
+        if (needsSegment(size) && !startSegment())
+        {
+            return false;
+        }
+
+        uint64_t before = sink.getBytesWritten();
+        bool written = sink.write(data, size);
+        SegmentInfo &current = segments.back();
+        // What reached the file, frame headers and encoding included
+        uint64_t stored = sink.getBytesWritten() - before;
+        current.bytes += stored;
+        segmentInput += size;
+        largestWrite = std::max(largestWrite, stored);
+        if (!written)
+        {
+            return false;
+        }
+        current.lastTimeNs = nowNs();
+        ++current.writes;
+        ++nextSequence;
+        manifestDirty = true;
+        return true;
+    }
+
+    size_t SegmentStore::enforceRetention()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (directory.empty())
+        {
+            return 0;
+        }
+
+        uint64_t total = 0;
+        for (const SegmentInfo &segment : segments)
+        {
+            total += segment.bytes;
+        }
+        const int64_t ageLimitNs = std::chrono::duration_cast<std::chrono::nanoseconds>(options.maxAge).count();
+        const int64_t now = nowNs();
+
+        // Oldest first; the last segment is the one being written
+        size_t deleted = 0;
+        while (deleted + 1 < segments.size())
+        {
+            const SegmentInfo &oldest = segments[deleted];
+            bool overSize = options.maxTotalBytes > 0 && total > options.maxTotalBytes;
+            bool overAge = ageLimitNs > 0 && oldest.lastTimeNs < now - ageLimitNs;
+            if (!overSize && !overAge)
+            {
+                break;
+            }
+            std::error_code error;
+            std::filesystem::remove(pathOf(oldest.name), error);
+            std::filesystem::remove(SearchIndex::getIndexPath(pathOf(oldest.name)), error);
+            total -= oldest.bytes;
+            ++deleted;
+        }
+        segments.erase(segments.begin(), segments.begin() + static_cast<std::ptrdiff_t>(deleted));
+
+        if (deleted > 0 || manifestDirty)
+        {
+            writeManifest();
+        }
+        return deleted;
+    }
+
+    std::vector<SegmentInfo> SegmentStore::getSegments() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return segments;
+    }
+
+    bool SegmentStore::readManifest(const std::string &directory, std::vector<SegmentInfo> &segments)
+    {
+        std::ifstream manifest((std::filesystem::path(directory) / kManifestName).string());
+        if (!manifest.is_open())
+        {
+            return false;
+        }
+        segments.clear();
+        std::string line;
+        while (std::getline(manifest, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+            std::istringstream fields(line);
+            SegmentInfo segment;
+            int open = 0;
+            if (fields >> segment.name >> segment.firstSequence >> segment.writes >> segment.bytes >>
+                segment.firstTimeNs >> segment.lastTimeNs >> open)
+            {
+                segment.open = open != 0;
+                segments.push_back(segment);
+            }
+        }
+        return true;
+    }
+
+    std::vector<SegmentInfo> SegmentStore::findSegments(const std::string &directory,
+                                                        std::chrono::system_clock::time_point from,
+                                                        std::chrono::system_clock::time_point to)
+    {
+        const int64_t fromNs = std::chrono::duration_cast<std::chrono::nanoseconds>(from.time_since_epoch()).count();
+        const int64_t toNs = std::chrono::duration_cast<std::chrono::nanoseconds>(to.time_since_epoch()).count();
+
+        std::vector<SegmentInfo> listed;
+        std::vector<SegmentInfo> matches;
+        readManifest(directory, listed);
+        for (const SegmentInfo &segment : listed)
+        {
+            if (segment.firstTimeNs <= toNs && (segment.open || segment.lastTimeNs >= fromNs))
+            {
+                matches.push_back(segment);
+            }
+        }
+        return matches;
+    }
+
+    bool SegmentStore::needsSegment(size_t size) const
+    {
+        if (segments.empty() || !segments.back().open)
+        {
+            return true;
+        }
+        const SegmentInfo &last = segments.back();
+        if (last.bytes == 0)
+        {
+            return false;
+        }
+        // BINARY and COMPRESSED data shrinks on the way to disk by a ratio known only afterwards;
+        // expect this segment's ratio so far, and at least its largest write
+        double expected = segmentInput > 0 ? static_cast<double>(size) * static_cast<double>(last.bytes) /
+                                                 static_cast<double>(segmentInput)
+                                           : static_cast<double>(size);
+        double largest = std::min(static_cast<double>(largestWrite), static_cast<double>(size) * 2);
+        expected = std::max(expected, largest);
+        return static_cast<double>(last.bytes) + expected > static_cast<double>(options.segmentBytes);
+    }
+
+    bool SegmentStore::startSegment()
+    {
+        if (!segments.empty() && segments.back().open)
+        {
+            finishSegment();
+        }
+
+        segmentInput = 0;
+        largestWrite = 0;
+        SegmentInfo segment;
+        segment.firstSequence = nextSequence;
+        segment.firstTimeNs = segment.lastTimeNs = nowNs();
+        segment.name = segmentName(segment.firstSequence, segment.firstTimeNs);
+        segment.open = true;
+        if (!sink.open(pathOf(segment.name)))
+        {
+            return false;
+        }
+        // An earlier run may have left this name behind; keep counting from its end
+        uint64_t existing = 0;
+        int64_t modifiedNs = 0;
+        if (statFile(pathOf(segment.name), existing, modifiedNs))
+        {
+            segment.bytes = existing;
+        }
+        segments.erase(std::remove_if(segments.begin(), segments.end(), [&](const SegmentInfo &s)
+                                      { return !s.open && s.name == segment.name; }),
+                       segments.end());
+        segments.push_back(segment);
+        writeManifest();
+        return true;
+    }
+
+    void SegmentStore::finishSegment()
+    {
+        if (segments.empty() || !segments.back().open)
+        {
+            return;
+        }
+        sink.close();
+        SegmentInfo &segment = segments.back();
+        segment.open = false;
+        int64_t modifiedNs = 0;
+        statFile(pathOf(segment.name), segment.bytes, modifiedNs);
+        if (segment.writes == 0 && segment.bytes == 0)
+        {
+            // Nothing was written; don't leave an empty file behind
+            std::error_code error;
+            std::filesystem::remove(pathOf(segment.name), error);
+            segments.pop_back();
+        }
+        manifestDirty = true;
+    }
+
+    bool SegmentStore::writeManifest()
+    {
+        const std::filesystem::path target = std::filesystem::path(directory) / kManifestName;
+        const std::filesystem::path temporary = target.string() + ".tmp";
+        {
+            std::ofstream manifest(temporary, std::ios::trunc);
+            manifest << kManifestHeader << '\n';
+            for (const SegmentInfo &segment : segments)
+            {
+                manifest << segment.name << ' ' << segment.firstSequence << ' ' << segment.writes << ' '
+                         << segment.bytes << ' ' << segment.firstTimeNs << ' ' << segment.lastTimeNs << ' '
+                         << (segment.open ? 1 : 0) << '\n';
+            }
+            manifest.flush();
+            if (!manifest.good())
+            {
+                return false;
+            }
+        }
+        // Readers see either the old or the new manifest, never a partial one
+        std::error_code error;
+        std::filesystem::rename(temporary, target, error);
+        if (error)
+        {
+            return false;
+        }
+        manifestDirty = false;
+        return true;
+    }
+
+    std::string SegmentStore::pathOf(const std::string &name) const
+    {
+        return (std::filesystem::path(directory) / name).string();
+    }
+}
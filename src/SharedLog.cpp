@@ -0,0 +1,658 @@
+#include "Eclipse/SharedLog.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Eclipse
+{
+#ifndef _WIN32
+    namespace
+    {
+        constexpr uint32_t kSegmentMagic = 0x45434c53; // "ECLS"
+        constexpr uint32_t kSegmentVersion = 1;
+        constexpr uint32_t kRecordPadding = 1u;        ///< Record flag: skip to the start of the ring
+
+        /**
+         * @brief Segment header placed at offset 0 of the mapping
+         */
+        struct SegmentHeader
+        {
+            std::atomic<uint32_t> magic;    ///< Written last by the creator to publish the segment
+            uint32_t version;               ///< Layout version
+            uint32_t slotCount;             ///< Number of slots following the header
+            uint32_t slotBytes;             ///< Ring capacity of each slot
+            std::atomic<uint64_t> sequence; ///< Global record sequence shared by all producers
+        };
+
+        /**
+         * @brief Per-process slot header, followed by slotBytes of ring data
+         */
+        struct alignas(64) SlotHeader
+        {
+            std::atomic<int32_t> ownerPid; ///< Owning process, 0 when free
+            std::atomic<uint64_t> head;    ///< Producer position (monotonic)
+            alignas(64) std::atomic<uint64_t> tail; ///< Collector position (monotonic)
+            std::atomic<uint64_t> dropped; ///< Records dropped because the ring was full
+        };
+
+        /**
+         * @brief Header preceding every record in a ring
+         */
+        struct RecordHeader
+        {
+            uint32_t size;       ///< Payload bytes
+            uint32_t flags;      ///< kRecordPadding or 0
+            uint64_t sequence;   ///< Global sequence number
+            int64_t timestampNs; ///< Wall-clock time of the enqueue
+            int32_t pid;         ///< Producing process
+            int32_t reserved;    ///< Keeps the header 8-byte aligned
+        };
+
+        static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared rings need address-free 64-bit atomics");
+
+        constexpr size_t kHeaderBytes = 64;
+
+        size_t alignRecord(size_t bytes)
+        {
+            return (bytes + 7) & ~static_cast<size_t>(7);
+        }
+
+        size_t slotStride(uint32_t slotBytes)
+        {
+            return sizeof(SlotHeader) + slotBytes;
+        }
+
+        size_t segmentBytes(uint32_t slotCount, uint32_t slotBytes)
+        {
+            return kHeaderBytes + static_cast<size_t>(slotCount) * slotStride(slotBytes);
+        }
+
+        SegmentHeader *segmentHeader(void *mapping)
+        {
+            return static_cast<SegmentHeader *>(mapping);
+        }
+
+        SlotHeader *slotAt(void *mapping, uint32_t index)
+        {
+            SegmentHeader *header = segmentHeader(mapping);
+            char *base = static_cast<char *>(mapping) + kHeaderBytes;
+            return reinterpret_cast<SlotHeader *>(base + static_cast<size_t>(index) * slotStride(header->slotBytes));
+        }
+
+        char *slotData(SlotHeader *slot)
+        {
+            return reinterpret_cast<char *>(slot) + sizeof(SlotHeader);
+        }
+
+        bool processAlive(int32_t pid)
+        {
+            return pid > 0 && (::kill(pid, 0) == 0 || errno != ESRCH);
+        }
+
+        int64_t nowNs()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                .count();
+        }
+
+        struct CollectedRecord
+        {
+            uint64_t sequence;
+            std::string text;
+        };
+    }
+
+    std::unique_ptr<SharedLogWriter> SharedLogWriter::attach(const std::string &name)
+    {
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < kHeaderBytes)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+
+        size_t bytes = static_cast<size_t>(st.st_size);
+        void *mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        SegmentHeader *header = segmentHeader(mapping);
+        if (header->magic.load(std::memory_order_acquire) != kSegmentMagic ||
+            header->version != kSegmentVersion ||
+            segmentBytes(header->slotCount, header->slotBytes) > bytes)
+        {
+            ::munmap(mapping, bytes);
+            return nullptr;
+        }
+
+        int32_t pid = static_cast<int32_t>(::getpid());
+        for (uint32_t i = 0; i < header->slotCount; ++i)
+        {
+            SlotHeader *slot = slotAt(mapping, i);
+            int32_t owner = slot->ownerPid.load(std::memory_order_acquire);
+            if (owner != 0 && processAlive(owner))
+            {
+                continue;
+            }
+            // Free slots and slots of dead processes are reused; pending records
+            // stay in the ring and are still collected in order.
+            if (slot->ownerPid.compare_exchange_strong(owner, pid, std::memory_order_acq_rel))
+            {
+                std::unique_ptr<SharedLogWriter> writer(new SharedLogWriter());
+                writer->name = name;
+                writer->mapping = mapping;
+                writer->mappingBytes = bytes;
+                writer->slotIndex = i;
+                return writer;
+            }
+        }
+
+        ::munmap(mapping, bytes);
+        return nullptr;
+    }
+
+    SharedLogWriter::~SharedLogWriter()
+    {
+        if (mapping != nullptr)
+        {
+            int32_t pid = static_cast<int32_t>(::getpid());
+            slotAt(mapping, slotIndex)->ownerPid.compare_exchange_strong(pid, 0, std::memory_order_acq_rel);
+            ::munmap(mapping, mappingBytes);
+        }
+    }
+
+    const std::string &SharedLogWriter::getName() const
+    {
+        return name;
+    }
+
+    bool SharedLogWriter::write(const std::string &text)
+    {
+        std::lock_guard<std::mutex> lock(writeMutex);
+
+        SegmentHeader *header = segmentHeader(mapping);
+        SlotHeader *slot = slotAt(mapping, slotIndex);
+        const uint64_t capacity = header->slotBytes;
+        const size_t need = alignRecord(sizeof(RecordHeader) + text.size());
+        if (need > capacity / 2)
+        {
+            slot->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        uint64_t head = slot->head.load(std::memory_order_relaxed);
+        uint64_t tail = slot->tail.load(std::memory_order_acquire);
+        uint64_t offset = head % capacity;
+        uint64_t contiguous = capacity - offset;
+        uint64_t skip = contiguous < need ? contiguous : 0;
+
+        if (head + skip + need - tail > capacity)
+        {
+            slot->dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        char *data = slotData(slot);
+        if (skip != 0)
+        {
+            if (skip >= sizeof(RecordHeader))
+            {
+                RecordHeader padding{};
+                padding.flags = kRecordPadding;
+                std::memcpy(data + offset, &padding, sizeof(padding));
+            }
+            offset = 0;
+        }
+
+        RecordHeader record{};
+        record.size = static_cast<uint32_t>(text.size());
+        record.sequence = header->sequence.fetch_add(1, std::memory_order_relaxed);
+        record.timestampNs = nowNs();
+        record.pid = static_cast<int32_t>(::getpid());
+        std::memcpy(data + offset, &record, sizeof(record));
+        std::memcpy(data + offset + sizeof(record), text.data(), text.size());
+
+        slot->head.store(head + skip + need, std::memory_order_release);
+        return true;
+    }
+
+    SharedLogCollector::SharedLogCollector(const std::string &name, const std::string &outputPath,
+                                           const SharedLogOptions &options)
+        : name(name), outputPath(outputPath), options(options)
+    {
+        this->options.slotBytes &= ~63u;
+    }
+
+    SharedLogCollector::~SharedLogCollector()
+    {
+        stop();
+        if (mapping != nullptr)
+        {
+            ::munmap(mapping, mappingBytes);
+        }
+    }
+
+    bool SharedLogCollector::open()
+    {
+        if (mapping != nullptr)
+        {
+            return output.isOpen();
+        }
+        if (options.slotCount == 0 || options.slotBytes < 4096)
+        {
+            return false;
+        }
+
+        int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT, 0666);
+        if (fd < 0)
+        {
+            return false;
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        // Re-use a segment left by a previous collector so its pending records survive.
+        bool reuse = false;
+        size_t bytes = segmentBytes(options.slotCount, options.slotBytes);
+        if (static_cast<size_t>(st.st_size) >= kHeaderBytes)
+        {
+            void *probe = ::mmap(nullptr, kHeaderBytes, PROT_READ, MAP_SHARED, fd, 0);
+            if (probe != MAP_FAILED)
+            {
+                SegmentHeader *existing = segmentHeader(probe);
+                if (existing->magic.load(std::memory_order_acquire) == kSegmentMagic &&
+                    existing->version == kSegmentVersion &&
+                    segmentBytes(existing->slotCount, existing->slotBytes) <= static_cast<size_t>(st.st_size))
+                {
+                    reuse = true;
+                    bytes = segmentBytes(existing->slotCount, existing->slotBytes);
+                }
+                ::munmap(probe, kHeaderBytes);
+            }
+        }
+
+        if (!reuse && ::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            mapping = nullptr;
+            return false;
+        }
+        mappingBytes = bytes;
+
+        SegmentHeader *header = segmentHeader(mapping);
+        if (!reuse)
+        {
+            header->version = kSegmentVersion;
+            header->slotCount = options.slotCount;
+            header->slotBytes = options.slotBytes;
+            header->sequence.store(0, std::memory_order_relaxed);
+            for (uint32_t i = 0; i < options.slotCount; ++i)
+            {
+                SlotHeader *slot = slotAt(mapping, i);
+                slot->ownerPid.store(0, std::memory_order_relaxed);
+                slot->head.store(0, std::memory_order_relaxed);
+                slot->tail.store(0, std::memory_order_relaxed);
+                slot->dropped.store(0, std::memory_order_relaxed);
+            }
+            header->magic.store(kSegmentMagic, std::memory_order_release);
+        }
+
+        dropsSeen.assign(header->slotCount, 0);
+        for (uint32_t i = 0; i < header->slotCount; ++i)
+        {
+            dropsSeen[i] = slotAt(mapping, i)->dropped.load(std::memory_order_relaxed);
+        }
+
+        return output.open(outputPath);
+    }
+
+    size_t SharedLogCollector::poll()
+    {
+        std::lock_guard<std::mutex> lock(pollMutex);
+        if (mapping == nullptr)
+        {
+            return 0;
+        }
+
+        SegmentHeader *header = segmentHeader(mapping);
+        const uint64_t capacity = header->slotBytes;
+        std::vector<CollectedRecord> records;
+
+        for (uint32_t i = 0; i < header->slotCount; ++i)
+        {
+            SlotHeader *slot = slotAt(mapping, i);
+            char *data = slotData(slot);
+            uint64_t tail = slot->tail.load(std::memory_order_relaxed);
+            uint64_t head = slot->head.load(std::memory_order_acquire);
+
+            while (tail < head)
+            {
+                uint64_t offset = tail % capacity;
+                if (capacity - offset < sizeof(RecordHeader))
+                {
+                    tail += capacity - offset;
+                    continue;
+                }
+
+                RecordHeader record;
+                std::memcpy(&record, data + offset, sizeof(record));
+                if (record.flags & kRecordPadding)
+                {
+                    tail += capacity - offset;
+                    continue;
+                }
+
+                records.push_back({record.sequence,
+                                   std::string(data + offset + sizeof(record), record.size)});
+                tail += alignRecord(sizeof(RecordHeader) + record.size);
+            }
+            slot->tail.store(tail, std::memory_order_release);
+
+            uint64_t dropped = slot->dropped.load(std::memory_order_relaxed);
+            if (dropped != dropsSeen[i])
+            {
+                std::ostringstream note;
+                note << "[shared log] slot " << i << " dropped " << (dropped - dropsSeen[i])
+                     << " record(s): ring full\n";
+                records.push_back({header->sequence.load(std::memory_order_relaxed), note.str()});
+                dropsSeen[i] = dropped;
+            }
+        }
+
+        if (records.empty())
+        {
+            return 0;
+        }
+
+        std::stable_sort(records.begin(), records.end(),
+                         [](const CollectedRecord &a, const CollectedRecord &b)
+                         { return a.sequence < b.sequence; });
+
+        std::string batch;
+        for (const auto &record : records)
+        {
+            batch += record.text;
+        }
+        output.write(batch);
+        return records.size();
+    }
+
+    void SharedLogCollector::start(std::chrono::milliseconds interval)
+    {
+        if (running.exchange(true))
+        {
+            return;
+        }
+        worker = std::thread(&SharedLogCollector::run, this, interval);
+    }
+
+    void SharedLogCollector::stop(std::chrono::milliseconds drainTimeout)
+    {
+        if (running.exchange(false) && worker.joinable())
+        {
+            worker.join();
+        }
+        auto deadline = std::chrono::steady_clock::now() + drainTimeout;
+        while (poll() > 0 && std::chrono::steady_clock::now() < deadline)
+        {
+        }
+    }
+
+    void SharedLogCollector::unlink()
+    {
+        ::shm_unlink(name.c_str());
+    }
+
+    void SharedLogCollector::run(std::chrono::milliseconds interval)
+    {
+        while (running.load(std::memory_order_acquire))
+        {
+            if (poll() == 0)
+            {
+                std::this_thread::sleep_for(interval);
+            }
+        }
+    }
+
+    std::unique_ptr<SharedLogTail> SharedLogTail::attach(const std::string &name)
+    {
+        int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < kHeaderBytes)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+
+        size_t bytes = static_cast<size_t>(st.st_size);
+        void *mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        SegmentHeader *header = segmentHeader(mapping);
+        if (header->magic.load(std::memory_order_acquire) != kSegmentMagic ||
+            header->version != kSegmentVersion ||
+            segmentBytes(header->slotCount, header->slotBytes) > bytes)
+        {
+            ::munmap(mapping, bytes);
+            return nullptr;
+        }
+
+        std::unique_ptr<SharedLogTail> tail(new SharedLogTail());
+        tail->mapping = mapping;
+        tail->mappingBytes = bytes;
+        for (uint32_t i = 0; i < header->slotCount; ++i)
+        {
+            tail->cursors.push_back(slotAt(mapping, i)->head.load(std::memory_order_acquire));
+        }
+        return tail;
+    }
+
+    SharedLogTail::~SharedLogTail()
+    {
+        if (mapping != nullptr)
+        {
+            ::munmap(mapping, mappingBytes);
+        }
+    }
+
+    size_t SharedLogTail::poll(std::vector<SharedLogEntry> &entries)
+    {
+        SegmentHeader *header = segmentHeader(mapping);
+        const uint64_t capacity = header->slotBytes;
+        const size_t first = entries.size();
+        std::vector<uint64_t> visited;
+        std::vector<uint64_t> positions;
+
+        for (uint32_t i = 0; i < header->slotCount; ++i)
+        {
+            SlotHeader *slot = slotAt(mapping, i);
+            const char *data = slotData(slot);
+            const size_t slotFirst = entries.size();
+            uint64_t head = slot->head.load(std::memory_order_acquire);
+            uint64_t tail = slot->tail.load(std::memory_order_acquire);
+            uint64_t start = cursors[i] > head ? tail : cursors[i];
+            if (start < tail)
+            {
+                missedBytes += tail - start;
+                start = tail;
+            }
+
+            // Every position visited, so the collector's tail can be found among them below
+            visited.clear();
+            positions.clear();
+            uint64_t position = start;
+            while (position < head)
+            {
+                visited.push_back(position);
+                uint64_t offset = position % capacity;
+                if (capacity - offset < sizeof(RecordHeader))
+                {
+                    position += capacity - offset;
+                    continue;
+                }
+
+                RecordHeader record;
+                std::memcpy(&record, data + offset, sizeof(record));
+                if (record.flags & kRecordPadding)
+                {
+                    position += capacity - offset;
+                    continue;
+                }
+                size_t need = alignRecord(sizeof(RecordHeader) + record.size);
+                if (need > capacity / 2 || position + need > head)
+                {
+                    // Only bytes being reused look like this; the check below finds out
+                    break;
+                }
+                positions.push_back(position);
+                entries.push_back({record.sequence, record.timestampNs, record.pid,
+                                   std::string(data + offset + sizeof(record), record.size)});
+                position += need;
+            }
+
+            // Producers reuse only what the collector drained, and only after it
+            // published its tail, so what was read from there on is intact
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t drained = slot->tail.load(std::memory_order_relaxed);
+            if (drained > start)
+            {
+                missedBytes += drained - start;
+                if (drained != position && std::find(visited.begin(), visited.end(), drained) == visited.end())
+                {
+                    // The collector drained past the walk, or the walk went astray in reused bytes
+                    entries.resize(slotFirst);
+                    position = drained;
+                }
+                else
+                {
+                    size_t stale = static_cast<size_t>(
+                        std::lower_bound(positions.begin(), positions.end(), drained) - positions.begin());
+                    entries.erase(entries.begin() + static_cast<std::ptrdiff_t>(slotFirst),
+                                  entries.begin() + static_cast<std::ptrdiff_t>(slotFirst + stale));
+                }
+            }
+            cursors[i] = position;
+        }
+
+        std::stable_sort(entries.begin() + static_cast<std::ptrdiff_t>(first), entries.end(),
+                         [](const SharedLogEntry &a, const SharedLogEntry &b)
+                         { return a.sequence < b.sequence; });
+        return entries.size() - first;
+    }
+
+    uint64_t SharedLogTail::getMissedBytes() const
+    {
+        return missedBytes;
+    }
+#else
+    // Shared-memory logging relies on POSIX shm_open/mmap; on Windows attaching
+    // and collecting always fail so callers fall back to the local log file.
+    std::unique_ptr<SharedLogWriter> SharedLogWriter::attach(const std::string &)
+    {
+        return nullptr;
+    }
+
+    SharedLogWriter::~SharedLogWriter() = default;
+
+    const std::string &SharedLogWriter::getName() const
+    {
+        return name;
+    }
+
+    bool SharedLogWriter::write(const std::string &)
+    {
+        return false;
+    }
+
+    SharedLogCollector::SharedLogCollector(const std::string &name, const std::string &outputPath,
+                                           const SharedLogOptions &options)
+        : name(name), outputPath(outputPath), options(options)
+    {
+    }
+
+    SharedLogCollector::~SharedLogCollector() = default;
+
+    bool SharedLogCollector::open()
+    {
+        return false;
+    }
+
+    size_t SharedLogCollector::poll()
+    {
+        return 0;
+    }
+
+    void SharedLogCollector::start(std::chrono::milliseconds)
+    {
+    }
+
+    void SharedLogCollector::stop(std::chrono::milliseconds)
+    {
+    }
+
+    void SharedLogCollector::unlink()
+    {
+    }
+
+    void SharedLogCollector::run(std::chrono::milliseconds)
+    {
+    }
+
+    std::unique_ptr<SharedLogTail> SharedLogTail::attach(const std::string &)
+    {
+        return nullptr;
+    }
+
+    SharedLogTail::~SharedLogTail() = default;
+
+    size_t SharedLogTail::poll(std::vector<SharedLogEntry> &)
+    {
+        return 0;
+    }
+
+    uint64_t SharedLogTail::getMissedBytes() const
+    {
+        return missedBytes;
+    }
+#endif
+}
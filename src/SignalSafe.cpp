@@ -0,0 +1,158 @@
+#include "Eclipse/SignalSafe.h"
+#include "Eclipse/Frame.h"
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Eclipse
+{
+    namespace
+    {
+        // Same 5-wide names and 29-column continuation indent as Logger::log()
+        const char *const kLevelNames[] = {"DEBUG", "INFO ", "WARN ", "ERROR", "FATAL"};
+        const char kIndent[] = "                             ";
+
+        void writeFd(int fd, const char *data, size_t size)
+        {
+            // The interrupted code may be about to read errno
+            const int savedErrno = errno;
+            while (size > 0)
+            {
+#ifdef _WIN32
+                int written = ::_write(fd, data, static_cast<unsigned int>(size));
+#else
+                ssize_t written = ::write(fd, data, size);
+                if (written < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+#endif
+                if (written <= 0)
+                {
+                    break;
+                }
+                data += written;
+                size -= static_cast<size_t>(written);
+            }
+            errno = savedErrno;
+        }
+
+        /**
+         * @brief Convert days since 1970-01-01 to a civil date without calling into libc
+         */
+        void civilFromDays(long long days, long long &year, unsigned &month, unsigned &day)
+        {
+            days += 719468;
+            const long long era = (days >= 0 ? days : days - 146096) / 146097;
+            const unsigned doe = static_cast<unsigned>(days - era * 146097);
+            const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            const unsigned mp = (5 * doy + 2) / 153;
+            day = doy - (153 * mp + 2) / 5 + 1;
+            month = mp < 10 ? mp + 3 : mp - 9;
+            year = static_cast<long long>(yoe) + era * 400 + (month <= 2);
+        }
+    }
+
+    bool SignalSafeLog::enabled(ELevel level)
+    {
+        if (level == ELevel::ECLIPSE_NONE)
+        {
+            return false;
+        }
+        Logger *logger = Logger::instance;
+        return logger == nullptr || level >= logger->currentLevel.load(std::memory_order_relaxed);
+    }
+
+    void SignalSafeLog::beginRecord(SignalSafeBuffer &buffer, ELevel level, const char *tag, const char *msg)
+    {
+        Logger *logger = Logger::instance;
+        long long seconds = 0;
+#ifdef _WIN32
+        std::timespec ts{};
+        std::timespec_get(&ts, TIME_UTC);
+        seconds = ts.tv_sec;
+#else
+        struct timespec ts{};
+        ::clock_gettime(CLOCK_REALTIME, &ts);
+        seconds = ts.tv_sec;
+#endif
+        if (logger != nullptr)
+        {
+            seconds += logger->utcOffsetSeconds.load(std::memory_order_relaxed);
+        }
+
+        long long days = seconds / 86400;
+        long long secondOfDay = seconds % 86400;
+        if (secondOfDay < 0)
+        {
+            secondOfDay += 86400;
+            --days;
+        }
+        long long year = 0;
+        unsigned month = 0;
+        unsigned day = 0;
+        civilFromDays(days, year, month, day);
+
+        buffer.append('[');
+        buffer.appendSigned(year);
+        buffer.append('-');
+        buffer.appendUnsigned(month, 2);
+        buffer.append('-');
+        buffer.appendUnsigned(day, 2);
+        buffer.append(' ');
+        buffer.appendUnsigned(static_cast<unsigned long long>(secondOfDay / 3600), 2);
+        buffer.append(':');
+        buffer.appendUnsigned(static_cast<unsigned long long>(secondOfDay / 60 % 60), 2);
+        buffer.append(':');
+        buffer.appendUnsigned(static_cast<unsigned long long>(secondOfDay % 60), 2);
+        buffer.append("] ");
+
+        int index = static_cast<int>(level);
+        buffer.append(index >= 0 && index < 5 ? kLevelNames[index] : "UNKNOWN");
+        buffer.append(": ┏ [");
+        buffer.append(tag);
+        buffer.append("] ");
+        buffer.append(msg);
+        buffer.endLine();
+    }
+
+    void SignalSafeLog::beginLine(SignalSafeBuffer &buffer, bool last)
+    {
+        buffer.append(kIndent);
+        buffer.append(last ? "┗ " : "┃ ");
+    }
+
+    void SignalSafeLog::emit(const SignalSafeBuffer &buffer)
+    {
+        Logger *logger = Logger::instance;
+        EOutput destination = logger != nullptr ? logger->outputDestination.load(std::memory_order_relaxed)
+                                                : EOutput::CONSOLE;
+
+        if (destination == EOutput::CONSOLE || destination == EOutput::BOTH)
+        {
+            writeFd(1, buffer.data(), buffer.size());
+        }
+        if ((destination == EOutput::FILE || destination == EOutput::BOTH) && logger != nullptr)
+        {
+            int fd = logger->signalFileFd.load(std::memory_order_acquire);
+            if (fd >= 0 && logger->signalFramed.load(std::memory_order_relaxed))
+            {
+                char frame[kFrameHeaderSize + SignalSafeBuffer::kCapacity];
+                encodeFrameHeader(frame, buffer.data(), static_cast<uint32_t>(buffer.size()));
+                std::memcpy(frame + kFrameHeaderSize, buffer.data(), buffer.size());
+                writeFd(fd, frame, kFrameHeaderSize + buffer.size());
+            }
+            else if (fd >= 0)
+            {
+                writeFd(fd, buffer.data(), buffer.size());
+            }
+        }
+    }
+}
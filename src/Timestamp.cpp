@@ -0,0 +1,111 @@
+#include "Eclipse/Timestamp.h"
+#include <cstring>
+#include <ctime>
+
+namespace Eclipse
+{
+    namespace
+    {
+        constexpr char kDigitPairs[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        /**
+         * @brief Store the two digits of a value below 100
+         */
+        inline void writePair(char *out, unsigned value)
+        {
+            std::memcpy(out, kDigitPairs + value * 2, 2);
+        }
+
+        /**
+         * @brief Floor division, so times before the epoch land in the right second
+         */
+        inline int64_t floorDiv(int64_t value, int64_t divisor)
+        {
+            int64_t quotient = value / divisor;
+            return (value % divisor < 0) ? quotient - 1 : quotient;
+        }
+    }
+
+    size_t TimestampFormatter::format(std::chrono::system_clock::time_point time, ETimestampFormat layout, char *out)
+    {
+        int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+        int64_t seconds = floorDiv(ns, 1000000000);
+        if (seconds != cachedSecond)
+        {
+            refresh(seconds);
+        }
+
+        std::memcpy(out, date, sizeof(date));
+        if (layout == ETimestampFormat::DEFAULT)
+        {
+            return sizeof(date);
+        }
+
+        out[10] = 'T';
+        out[19] = '.';
+        unsigned micros = static_cast<unsigned>((ns - seconds * 1000000000) / 1000);
+        writePair(out + 20, micros / 10000);
+        writePair(out + 22, micros / 100 % 100);
+        writePair(out + 24, micros % 100);
+        std::memcpy(out + 26, offset, sizeof(offset));
+        return kMaxLength;
+    }
+
+    std::string TimestampFormatter::format(std::chrono::system_clock::time_point time, ETimestampFormat layout)
+    {
+        char buffer[kMaxLength];
+        return std::string(buffer, format(time, layout, buffer));
+    }
+
+    void TimestampFormatter::refresh(int64_t seconds)
+    {
+        std::time_t now = static_cast<std::time_t>(seconds);
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        unsigned year = static_cast<unsigned>(local.tm_year + 1900) % 10000;
+        writePair(date, year / 100);
+        writePair(date + 2, year % 100);
+        date[4] = '-';
+        writePair(date + 5, static_cast<unsigned>(local.tm_mon + 1));
+        date[7] = '-';
+        writePair(date + 8, static_cast<unsigned>(local.tm_mday));
+        date[10] = ' ';
+        writePair(date + 11, static_cast<unsigned>(local.tm_hour));
+        date[13] = ':';
+        writePair(date + 14, static_cast<unsigned>(local.tm_min));
+        date[16] = ':';
+        // tm_sec is 60 during a leap second, which the table covers
+        writePair(date + 17, static_cast<unsigned>(local.tm_sec));
+
+#ifdef _WIN32
+        // mktime() interprets both as local time, so the difference is the UTC offset
+        std::tm utc{};
+        gmtime_s(&utc, &now);
+        utc.tm_isdst = local.tm_isdst;
+        long minutes = static_cast<long>(std::difftime(std::mktime(&local), std::mktime(&utc))) / 60;
+#else
+        long minutes = static_cast<long>(local.tm_gmtoff) / 60;
+#endif
+        offset[0] = minutes < 0 ? '-' : '+';
+        minutes = minutes < 0 ? -minutes : minutes;
+        writePair(offset + 1, static_cast<unsigned>(minutes / 60 % 100));
+        offset[3] = ':';
+        writePair(offset + 4, static_cast<unsigned>(minutes % 60));
+
+        cachedSecond = seconds;
+    }
+}
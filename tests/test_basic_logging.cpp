@@ -190,6 +190,27 @@ void test_function_evaluation()
     std::cout << "✓ Function evaluation test passed" << std::endl;
 }
 
+void test_call_site_probes()
+{
+    std::cout << "Testing that call site probes evaluate the tag once..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setOutputDestination(EOutput::CONSOLE);
+
+    int tagCalls = 0;
+    auto nextTag = [&tagCalls]()
+    {
+        ++tagCalls;
+        return std::string("PROBE_TEST");
+    };
+    ECLIPSE_INFO(nextTag(), "Tag built by a call");
+    ECLIPSE_DEBUG(nextTag(), "Tag built by a call", "detail=1");
+    assert(tagCalls == 2);
+
+    std::cout << "✓ Call site probe test passed" << std::endl;
+}
+
 int main()
 {
     try
@@ -208,6 +229,7 @@ int main()
         test_assert_functionality();
         test_log_level_filtering();
         test_function_evaluation();
+        test_call_site_probes();
 
         std::cout << std::endl
                   << "🎉 All basic tests passed successfully!" << std::endl;
@@ -0,0 +1,306 @@
+/**
+ * @file test_binary_records.cpp
+ * @brief Delta and dictionary encoded binary log file tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include "Eclipse/BinaryRecord.h"
+#include "Eclipse/LogReader.h"
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <chrono>
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    /**
+     * @brief Records with repeated tags, messages and sites, and details of every count
+     */
+    std::vector<BinaryRecord> make_records(int count)
+    {
+        const char *const tags[] = {"HTTP", "DB", "CACHE"};
+        const char *const messages[] = {"Request served", "Query finished", "Entry evicted", "Retrying"};
+        std::vector<BinaryRecord> records;
+        for (int i = 0; i < count; ++i)
+        {
+            BinaryRecord record;
+            record.level = static_cast<uint8_t>(i % 5);
+            record.tag = tags[i % 3];
+            record.msg = messages[i % 4];
+            record.trace = i % 7 == 0 ? "" : "server.cpp:" + std::to_string(100 + i % 5) + " [handle]";
+            for (int d = 0; d < i % 10; ++d)
+            {
+                record.details.push_back(d == 0 ? "id=" + std::to_string(1000 + i) : "field" + std::to_string(d));
+            }
+            records.push_back(record);
+        }
+        return records;
+    }
+
+    void log_records(Logger &logger, const std::vector<BinaryRecord> &records)
+    {
+        for (const BinaryRecord &record : records)
+        {
+            logger.log(static_cast<ELevel>(record.level), record.tag, record.msg, record.details, record.trace);
+            logger.advanceManualTime(std::chrono::microseconds(1500));
+        }
+    }
+
+    bool same_fields(const BinaryRecord &a, const BinaryRecord &b)
+    {
+        return a.level == b.level && a.tag == b.tag && a.msg == b.msg && a.trace == b.trace && a.details == b.details;
+    }
+}
+
+void test_lossless_round_trip()
+{
+    std::cout << "Testing a lossless binary round trip..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string textPath = "test_binary_records.txt";
+    const std::string binaryPath = "test_binary_records.bin";
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(binaryPath);
+    std::vector<BinaryRecord> records = make_records(120);
+
+    bool manual = logger.setClockSource(EClockSource::MANUAL);
+    assert(manual);
+    auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000)) + std::chrono::nanoseconds(123456789);
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setManualTime(start);
+    logger.setLogFile(textPath);
+    log_records(logger, records);
+
+    logger.setFileFormat(EFileFormat::BINARY);
+    logger.setManualTime(start);
+    logger.setLogFile(binaryPath);
+    log_records(logger, records);
+    ECLIPSE_SIGNAL_SAFE_LOG(ELevel::ECLIPSE_WARN, "HTTP", "Signal record", 3);
+    logger.closeLogFile();
+    logger.setFileFormat(EFileFormat::TEXT);
+    logger.setClockSource(EClockSource::REALTIME);
+
+    // Every field comes back exactly, and the text matches what a TEXT file holds
+    LogReader reader;
+    bool opened = reader.open(binaryPath);
+    assert(opened);
+    std::vector<BinaryRecord> decoded;
+    std::string text;
+    std::string signalRecord;
+    std::string payload;
+    while (reader.next(payload))
+    {
+        if (reader.getRecords().empty())
+        {
+            signalRecord = payload;
+            continue;
+        }
+        decoded.insert(decoded.end(), reader.getRecords().begin(), reader.getRecords().end());
+        text += payload;
+    }
+    assert(reader.getUndecodedFrames() == 0 && reader.getCorruptBytes() == 0);
+    assert(decoded.size() == records.size());
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        assert(same_fields(decoded[i], records[i]));
+        assert(decoded[i].sequence == decoded[0].sequence + i);
+        auto expected = start + std::chrono::microseconds(1500) * i;
+        assert(decoded[i].timeNs == std::chrono::duration_cast<std::chrono::nanoseconds>(expected.time_since_epoch()).count());
+    }
+    assert(text == read_file(textPath));
+    assert(signalRecord.find("[HTTP] Signal record") != std::string::npos);
+
+    // Binary records are a fraction of the text
+    size_t textBytes = std::filesystem::file_size(textPath);
+    size_t binaryBytes = std::filesystem::file_size(binaryPath);
+    std::cout << "  " << textBytes << " text bytes, " << binaryBytes << " binary bytes" << std::endl;
+    assert(binaryBytes * 2 < textBytes);
+
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(binaryPath);
+    std::cout << "✓ Lossless round trip test passed" << std::endl;
+}
+
+void test_record_headers_shrink()
+{
+    std::cout << "Testing encoded record header sizes..." << std::endl;
+
+    // One detail that never repeats; everything else does
+    std::string standalone;
+    size_t detailBytes = 0;
+    const int count = 1000;
+    for (int i = 0; i < count; ++i)
+    {
+        std::vector<std::string> details = {"id=" + std::to_string(100000 + i)};
+        detailBytes += 1 + details[0].size();
+        appendBinaryRecord(5000 + i, 1700000000000000000LL + i * 250000LL, 1, "HTTP", "Request served",
+                           "server.cpp:42 [handle]", details, standalone);
+    }
+
+    BinaryEncoder encoder;
+    std::string block;
+    size_t used = encoder.encode(standalone.data(), standalone.size(), 1 << 20, block);
+    assert(used == standalone.size());
+    double header = double(block.size() - detailBytes) / count;
+    std::cout << "  " << standalone.size() / count << " standalone bytes per record, " << header
+              << " header bytes per encoded record" << std::endl;
+    assert(header < 8.0);
+
+    BinaryDecoder decoder;
+    std::vector<BinaryRecord> records;
+    bool decoded = decoder.decode(block.data(), block.size(), records);
+    assert(decoded);
+    assert(records.size() == static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        assert(records[i].sequence == static_cast<uint64_t>(5000 + i));
+        assert(records[i].timeNs == 1700000000000000000LL + i * 250000LL);
+        assert(records[i].details.size() == 1 && records[i].details[0] == "id=" + std::to_string(100000 + i));
+        assert(records[i].msg == "Request served" && records[i].trace == "server.cpp:42 [handle]");
+    }
+
+    // Text is not a standalone record
+    assert(encoder.encode("[2025-01-02 03:04:05] INFO ", 27, 4096, block) == 0);
+    std::cout << "✓ Record header size test passed" << std::endl;
+}
+
+void test_resumes_after_damage()
+{
+    std::cout << "Testing recovery after a damaged block..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string path = "test_binary_records_damaged.bin";
+    std::filesystem::remove(path);
+    std::vector<BinaryRecord> records = make_records(600);
+
+    // One block per record in IMMEDIATE mode; reset blocks at 0, 256 and 512
+    logger.setClockSource(EClockSource::MANUAL);
+    logger.setManualTime(std::chrono::system_clock::now());
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setFileFormat(EFileFormat::BINARY);
+    logger.setLogFile(path);
+    log_records(logger, records);
+    logger.closeLogFile();
+    logger.setFileFormat(EFileFormat::TEXT);
+    logger.setClockSource(EClockSource::REALTIME);
+
+    // Flip a byte in the payload of the eleventh frame
+    std::string content = read_file(path);
+    size_t offset = 0;
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        uint32_t size = 0;
+        for (int b = 0; b < 4; ++b)
+        {
+            size |= static_cast<uint32_t>(static_cast<unsigned char>(content[offset + 4 + b])) << (8 * b);
+        }
+        offset += kFrameHeaderSize + size;
+    }
+    content[offset + kFrameHeaderSize + 3] ^= 0x40;
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    // Blocks up to the next reset lose their dictionary; everything else decodes exactly
+    LogReader reader;
+    bool opened = reader.open(path);
+    assert(opened);
+    std::vector<BinaryRecord> decoded;
+    std::string payload;
+    while (reader.next(payload))
+    {
+        decoded.insert(decoded.end(), reader.getRecords().begin(), reader.getRecords().end());
+    }
+    assert(reader.getCorruptBytes() > 0);
+    assert(reader.getUndecodedFrames() == 256 - 11);
+    assert(decoded.size() == 10 + (600 - 256));
+    for (size_t i = 0; i < decoded.size(); ++i)
+    {
+        size_t original = i < 10 ? i : i - 10 + 256;
+        assert(same_fields(decoded[i], records[original]));
+    }
+
+    std::filesystem::remove(path);
+    std::cout << "✓ Damaged block recovery test passed" << std::endl;
+}
+
+void test_concurrent_streams()
+{
+    std::cout << "Testing streams of several encoders in one file..." << std::endl;
+
+    // Every encoder of a process writes its own stream, so interleaved blocks decode apart
+    const int writers = 100;
+    std::vector<BinaryEncoder> encoders(writers);
+    std::vector<uint64_t> ids;
+    BinaryDecoder decoder;
+    std::vector<BinaryRecord> records;
+    for (int round = 0; round < 3; ++round)
+    {
+        for (int w = 0; w < writers; ++w)
+        {
+            std::string standalone;
+            appendBinaryRecord(round, 1700000000000000000LL + round, 1, "WRITER", "Writer " + std::to_string(w),
+                               "", {"round=" + std::to_string(round)}, standalone);
+            std::string block;
+            size_t used = encoders[w].encode(standalone.data(), standalone.size(), 4096, block);
+            assert(used == standalone.size());
+
+            uint64_t id = 0;
+            bool reset = false;
+            bool read = BinaryDecoder::readBlockHeader(block.data(), block.size(), id, reset);
+            assert(read && reset == (round == 0));
+            if (round == 0)
+            {
+                ids.push_back(id);
+            }
+            assert(id == ids[w]);
+
+            bool decoded = decoder.decode(block.data(), block.size(), records);
+            assert(decoded && records.size() == 1);
+            assert(records[0].msg == "Writer " + std::to_string(w) && records[0].sequence == uint64_t(round));
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    assert(std::unique(ids.begin(), ids.end()) == ids.end());
+    std::cout << "✓ Concurrent stream test passed" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Eclipse Logger Binary Record Tests ===" << std::endl;
+
+    try
+    {
+        test_lossless_round_trip();
+        test_record_headers_shrink();
+        test_resumes_after_damage();
+        test_concurrent_streams();
+
+        std::cout << "\n🎉 All binary record tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,355 @@
+/**
+ * @file test_buffered_logging.cpp
+ * @brief Buffered write mode tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    int count_occurrences(const std::string &content, const std::string &needle)
+    {
+        int count = 0;
+        for (size_t pos = content.find(needle); pos != std::string::npos; pos = content.find(needle, pos + 1))
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    // Records written by the backend thread show up asynchronously
+    bool wait_for(const std::function<bool()> &ready)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!ready())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+
+    void start_file_logging(const std::string &path)
+    {
+        Logger &logger = Logger::getInstance();
+        std::filesystem::remove(path);
+        logger.setLevel(ELevel::ECLIPSE_DEBUG);
+        logger.setLogFile(path);
+        logger.setOutputDestination(EOutput::FILE);
+    }
+
+    void stop_file_logging(const std::string &path)
+    {
+        Logger &logger = Logger::getInstance();
+        logger.setWriteMode(EWriteMode::IMMEDIATE);
+        logger.closeLogFile();
+        logger.setOutputDestination(EOutput::CONSOLE);
+        std::filesystem::remove(path);
+    }
+}
+
+void test_records_wait_for_flush()
+{
+    std::cout << "Testing buffered records are written on flush()..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_buffered_flush.log";
+    start_file_logging(test_log_file);
+
+    logger.setWriteMode(EWriteMode::THREAD_BUFFERED, 64 * 1024, std::chrono::seconds(10));
+    assert(logger.getWriteMode() == EWriteMode::THREAD_BUFFERED);
+    for (int i = 0; i < 10; ++i)
+    {
+        ECLIPSE_INFO("BUFFERED", "Record", i);
+    }
+    assert(read_file(test_log_file).empty());
+
+    logger.flush();
+    std::string content = read_file(test_log_file);
+    assert(count_occurrences(content, "[BUFFERED] Record") == 10);
+    assert(content.find("┗ [1] 0\n") < content.find("┗ [1] 9\n"));
+
+    stop_file_logging(test_log_file);
+    std::cout << "✓ Flush test passed" << std::endl;
+}
+
+void test_flush_triggers()
+{
+    std::cout << "Testing WARN, full-buffer, delay and mode-change triggers..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_buffered_triggers.log";
+    start_file_logging(test_log_file);
+
+    // WARN and above write everything the thread buffered before them
+    logger.setWriteMode(EWriteMode::THREAD_BUFFERED, 64 * 1024, std::chrono::seconds(10));
+    ECLIPSE_INFO("TRIGGER", "Before warning");
+    ECLIPSE_WARNING("TRIGGER", "Warning");
+    std::string content = read_file(test_log_file);
+    assert(content.find("Before warning") < content.find("Warning\n"));
+
+    // A full buffer is written as a whole, never splitting a record
+    logger.setWriteMode(EWriteMode::THREAD_BUFFERED, 1024, std::chrono::seconds(10));
+    for (int i = 0; i < 50; ++i)
+    {
+        ECLIPSE_DEBUG("TRIGGER", "Filling", i);
+    }
+    content = read_file(test_log_file);
+    int written = count_occurrences(content, "[TRIGGER] Filling");
+    assert(written > 0 && written < 50);
+    assert(count_occurrences(content, "┏ [TRIGGER] Filling") == count_occurrences(content, "┗ [1] "));
+    assert(content.back() == '\n');
+
+    // Switching back to IMMEDIATE writes what is still buffered
+    logger.setWriteMode(EWriteMode::IMMEDIATE);
+    assert(count_occurrences(read_file(test_log_file), "[TRIGGER] Filling") == 50);
+
+    // A record older than the delay is written when the thread logs again
+    logger.setWriteMode(EWriteMode::THREAD_BUFFERED, 64 * 1024, std::chrono::milliseconds(20));
+    ECLIPSE_INFO("TRIGGER", "Aging");
+    assert(read_file(test_log_file).find("Aging") == std::string::npos);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ECLIPSE_INFO("TRIGGER", "Later");
+    content = read_file(test_log_file);
+    assert(content.find("Aging") != std::string::npos && content.find("Later") != std::string::npos);
+
+    stop_file_logging(test_log_file);
+    std::cout << "✓ Flush trigger test passed" << std::endl;
+}
+
+void test_threads_write_on_exit()
+{
+    std::cout << "Testing buffered threads write their records when they exit..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_buffered_threads.log";
+    start_file_logging(test_log_file);
+    logger.setWriteMode(EWriteMode::THREAD_BUFFERED, 8 * 1024, std::chrono::seconds(10));
+
+    const int num_threads = 4;
+    const int records_per_thread = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([t]()
+                             {
+            for (int i = 0; i < records_per_thread; ++i) {
+                ECLIPSE_INFO("THREAD_" + std::to_string(t), "Record", i);
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    // No flush(): every thread wrote its remainder on exit
+    std::string content = read_file(test_log_file);
+    for (int t = 0; t < num_threads; ++t)
+    {
+        std::string tag = "[THREAD_" + std::to_string(t) + "] Record";
+        assert(count_occurrences(content, tag) == records_per_thread);
+
+        // A thread's records keep their order
+        int expected = 0;
+        for (size_t pos = content.find(tag + "\n"); pos != std::string::npos; pos = content.find(tag + "\n", pos + 1))
+        {
+            assert(std::stoi(content.substr(content.find("[1] ", pos) + 4)) == expected);
+            ++expected;
+        }
+    }
+
+    stop_file_logging(test_log_file);
+    std::cout << "✓ Thread exit test passed" << std::endl;
+}
+
+void test_double_buffered_background_writes()
+{
+    std::cout << "Testing the double-buffered writer..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_double_buffered.log";
+    start_file_logging(test_log_file);
+
+    // The timer hands the front buffer to the backend thread without any flush()
+    logger.setWriteMode(EWriteMode::DOUBLE_BUFFERED, 64 * 1024, std::chrono::milliseconds(20));
+    assert(logger.getWriteMode() == EWriteMode::DOUBLE_BUFFERED);
+    for (int i = 0; i < 10; ++i)
+    {
+        ECLIPSE_INFO("DOUBLE", "Timed", i);
+    }
+    bool timed = wait_for([&]()
+                          { return count_occurrences(read_file(test_log_file), "[DOUBLE] Timed") == 10; });
+    assert(timed);
+
+    // A full front buffer wakes the backend long before the timer; 50 records
+    // cross the 4 KiB limit but stay well below the 16 KiB drop threshold
+    logger.setWriteMode(EWriteMode::DOUBLE_BUFFERED, 4096, std::chrono::seconds(10));
+    for (int i = 0; i < 50; ++i)
+    {
+        ECLIPSE_INFO("DOUBLE", "Filling", i);
+    }
+    bool woken = wait_for([&]()
+                          { return count_occurrences(read_file(test_log_file), "[DOUBLE] Filling") > 0; });
+    assert(woken);
+
+    // Producers share one front buffer, so records keep the order they were logged in.
+    // 256 KiB of headroom holds the whole burst even if the backend never ran.
+    logger.setWriteMode(EWriteMode::DOUBLE_BUFFERED, 64 * 1024, std::chrono::milliseconds(20));
+    const int num_threads = 4;
+    const int records_per_thread = 100;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([t]()
+                             {
+            for (int i = 0; i < records_per_thread; ++i) {
+                ECLIPSE_INFO("DOUBLE_" + std::to_string(t), "Record", i);
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    logger.flush();
+
+    std::string content = read_file(test_log_file);
+    assert(count_occurrences(content, "[DOUBLE] Filling") == 50);
+    for (int t = 0; t < num_threads; ++t)
+    {
+        std::string tag = "[DOUBLE_" + std::to_string(t) + "] Record\n";
+        int expected = 0;
+        for (size_t pos = content.find(tag); pos != std::string::npos; pos = content.find(tag, pos + 1))
+        {
+            assert(std::stoi(content.substr(content.find("[1] ", pos) + 4)) == expected);
+            ++expected;
+        }
+        assert(expected == records_per_thread);
+    }
+    assert(content.find("records dropped") == std::string::npos);
+
+    // Past four times the buffer size producers drop instead of waiting, and say so
+    logger.setWriteMode(EWriteMode::DOUBLE_BUFFERED, 4096, std::chrono::seconds(10));
+    const int burst = 2000;
+    for (int i = 0; i < burst; ++i)
+    {
+        ECLIPSE_INFO("DOUBLE", "Burst", i);
+    }
+    logger.setWriteMode(EWriteMode::IMMEDIATE);
+    content = read_file(test_log_file);
+    int written = count_occurrences(content, "[DOUBLE] Burst");
+    int dropped = 0;
+    for (size_t pos = content.find("dropped="); pos != std::string::npos; pos = content.find("dropped=", pos + 1))
+    {
+        dropped += std::stoi(content.substr(pos + 8));
+    }
+    std::cout << "Burst written " << written << ", dropped " << dropped << std::endl;
+    assert(written + dropped == burst);
+
+    stop_file_logging(test_log_file);
+    std::cout << "✓ Double-buffered writer test passed" << std::endl;
+}
+
+void test_fork_does_not_duplicate_buffers(EWriteMode mode)
+{
+    std::cout << "Testing buffered records are not duplicated by fork() ("
+              << (mode == EWriteMode::THREAD_BUFFERED ? "THREAD_BUFFERED" : "DOUBLE_BUFFERED") << ")..." << std::endl;
+
+#ifndef _WIN32
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_buffered_fork.log";
+    start_file_logging(test_log_file);
+    logger.setWriteMode(mode, 64 * 1024, std::chrono::seconds(10));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ECLIPSE_INFO("FORK", "Parent before fork", i);
+    }
+
+    pid_t pid = ::fork();
+    assert(pid >= 0);
+    if (pid == 0)
+    {
+        ECLIPSE_INFO("FORK", "Child record");
+        // Shutdown writes the child's buffer
+        Logger::getInstance().shutdown();
+        ::_exit(0);
+    }
+
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    ECLIPSE_INFO("FORK", "Parent after fork");
+    logger.flush();
+
+    std::string content = read_file(test_log_file);
+    std::cout << "Parent records before fork: " << count_occurrences(content, "Parent before fork") << std::endl;
+    assert(count_occurrences(content, "Parent before fork") == 3);
+    assert(count_occurrences(content, "Child record") == 1);
+    assert(count_occurrences(content, "Parent after fork") == 1);
+
+    stop_file_logging(test_log_file);
+    std::cout << "✓ Fork test passed" << std::endl;
+#else
+    std::cout << "✓ Fork test skipped (requires fork())" << std::endl;
+#endif
+}
+
+int main()
+{
+    try
+    {
+        std::cout << "=== Eclipse Logger Buffered Write Mode Tests ===" << std::endl;
+        std::cout << "Testing per-thread and double-buffered file output..." << std::endl
+                  << std::endl;
+
+        test_records_wait_for_flush();
+        test_flush_triggers();
+        test_threads_write_on_exit();
+        test_double_buffered_background_writes();
+        test_fork_does_not_duplicate_buffers(EWriteMode::THREAD_BUFFERED);
+        test_fork_does_not_duplicate_buffers(EWriteMode::DOUBLE_BUFFERED);
+
+        std::cout << std::endl
+                  << "🎉 All buffered logging tests passed successfully!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
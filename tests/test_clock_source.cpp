@@ -0,0 +1,342 @@
+/**
+ * @file test_clock_source.cpp
+ * @brief Timestamp source tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    long long offset_us(std::chrono::system_clock::time_point a, std::chrono::system_clock::time_point b)
+    {
+        return std::llabs(std::chrono::duration_cast<std::chrono::microseconds>(a - b).count());
+    }
+}
+
+void test_tsc_selection_follows_invariance()
+{
+    std::cout << "Testing TSC selection and fallback..." << std::endl;
+
+    Clock clock;
+    assert(clock.getSource() == EClockSource::REALTIME);
+
+    bool selected = clock.setSource(EClockSource::TSC);
+    std::cout << "Invariant TSC: " << Clock::isTscInvariant() << ", selected: " << selected << std::endl;
+    if (!Clock::isTscInvariant())
+    {
+        assert(!selected);
+    }
+    assert(clock.getSource() == (selected ? EClockSource::TSC : EClockSource::REALTIME));
+
+    selected = clock.setSource(EClockSource::REALTIME);
+    assert(selected);
+    assert(clock.getSource() == EClockSource::REALTIME);
+
+    std::cout << "✓ TSC selection test passed" << std::endl;
+}
+
+void test_tsc_tracks_wall_clock()
+{
+    std::cout << "Testing TSC conversion against CLOCK_REALTIME..." << std::endl;
+
+    Clock clock;
+    if (!clock.setSource(EClockSource::TSC))
+    {
+        std::cout << "✓ TSC conversion test skipped (no invariant TSC)" << std::endl;
+        return;
+    }
+
+    long long worst = 0;
+    auto previous = clock.now();
+    for (int i = 0; i < 20; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        if (i % 5 == 0)
+        {
+            clock.recalibrate();
+        }
+        auto converted = clock.now();
+        auto real = std::chrono::system_clock::now();
+        worst = std::max(worst, offset_us(converted, real));
+        assert(converted > previous);
+        previous = converted;
+    }
+
+    std::cout << "Largest offset from CLOCK_REALTIME: " << worst << " us" << std::endl;
+    assert(worst < 2000);
+
+    // Ticks read before a recalibration still convert to their original time
+    uint64_t ticks = Clock::readTsc();
+    auto before = clock.fromTsc(ticks);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    clock.recalibrate();
+    assert(offset_us(clock.fromTsc(ticks), before) < 2000);
+
+    std::cout << "✓ TSC conversion test passed" << std::endl;
+}
+
+void test_logger_records_with_tsc()
+{
+    std::cout << "Testing regular and real-time records with the TSC source..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_clock_source.log";
+    std::filesystem::remove(test_log_file);
+
+    bool selected = logger.setClockSource(EClockSource::TSC);
+    assert(selected == (logger.getClockSource() == EClockSource::TSC));
+
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setLogFile(test_log_file);
+    logger.setOutputDestination(EOutput::FILE);
+
+    std::string before = logger.getTimestamp();
+    ECLIPSE_INFO("CLOCK", "Regular record");
+    std::thread producer([&logger]()
+                         {
+        bool registered = logger.registerRealtimeThread(1 << 16);
+        assert(registered);
+        ECLIPSE_INFO("CLOCK", "Realtime record"); });
+    producer.join();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (read_file(test_log_file).find("Realtime record") == std::string::npos &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::string after = logger.getTimestamp();
+
+    logger.closeLogFile();
+    logger.setOutputDestination(EOutput::CONSOLE);
+    selected = logger.setClockSource(EClockSource::REALTIME);
+    assert(selected);
+
+    std::string content = read_file(test_log_file);
+    std::cout << content;
+    for (const char *msg : {"] INFO : ┏ [CLOCK] Regular record", "] INFO : ┏ [CLOCK] Realtime record"})
+    {
+        size_t pos = content.find(msg);
+        assert(pos != std::string::npos);
+        std::string stamp = content.substr(content.rfind('[', pos - 1) + 1, before.size());
+        assert(stamp >= before && stamp <= after);
+    }
+
+    std::filesystem::remove(test_log_file);
+    std::cout << "✓ TSC logger records test passed" << std::endl;
+}
+
+void test_coarse_source()
+{
+    std::cout << "Testing the coarse source..." << std::endl;
+
+    Clock clock;
+    if (!clock.setSource(EClockSource::COARSE))
+    {
+        assert(clock.getSource() == EClockSource::REALTIME);
+        std::cout << "✓ Coarse source test skipped (CLOCK_REALTIME_COARSE unavailable)" << std::endl;
+        return;
+    }
+    assert(clock.getSource() == EClockSource::COARSE);
+
+    // Resolution is one scheduler tick, at most 10 ms on common kernels
+    auto previous = clock.now();
+    for (int i = 0; i < 10; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        auto coarse = clock.now();
+        assert(offset_us(coarse, std::chrono::system_clock::now()) < 50000);
+        assert(coarse >= previous);
+        previous = coarse;
+    }
+
+    std::cout << "✓ Coarse source test passed" << std::endl;
+}
+
+void test_manual_source_golden_output()
+{
+    std::cout << "Testing byte-exact output with the manual source..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_clock_golden.log";
+    std::filesystem::remove(test_log_file);
+
+    bool selected = logger.setClockSource(EClockSource::MANUAL);
+    assert(selected);
+    assert(logger.getClockSource() == EClockSource::MANUAL);
+
+    // Local midnight, so the expected text does not depend on the time zone
+    std::tm date{};
+    date.tm_year = 2025 - 1900;
+    date.tm_mon = 0;
+    date.tm_mday = 2;
+    date.tm_isdst = -1;
+    logger.setManualTime(std::chrono::system_clock::from_time_t(std::mktime(&date)));
+
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setLogFile(test_log_file);
+    logger.setOutputDestination(EOutput::FILE);
+
+    logger.log(ELevel::ECLIPSE_INFO, "GOLDEN", "First", {"a=1"}, "golden.cpp:1 [main]");
+    logger.advanceManualTime(std::chrono::seconds(61));
+    logger.log(ELevel::ECLIPSE_WARN, "GOLDEN", "Second", {}, "golden.cpp:2 [main]");
+    logger.advanceManualTime(std::chrono::hours(1));
+    std::thread producer([&logger]()
+                         {
+        bool registered = logger.registerRealtimeThread(1 << 16);
+        assert(registered);
+        ECLIPSE_ERROR("GOLDEN", "Realtime", 7); });
+    producer.join();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (read_file(test_log_file).find("Realtime") == std::string::npos &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    logger.closeLogFile();
+    logger.setOutputDestination(EOutput::CONSOLE);
+    selected = logger.setClockSource(EClockSource::REALTIME);
+    assert(selected);
+
+    std::string content = read_file(test_log_file);
+    std::cout << content;
+    const std::string indent(29, ' ');
+    const std::string expected =
+        "[2025-01-02 00:00:00] INFO : ┏ [GOLDEN] First\n" +
+        indent + "┃ at: golden.cpp:1 [main]\n" +
+        indent + "┗ [1] a=1\n" +
+        "[2025-01-02 00:01:01] WARN : ┏ [GOLDEN] Second\n" +
+        indent + "┗ at: golden.cpp:2 [main]\n";
+    assert(content.compare(0, expected.size(), expected) == 0);
+    assert(content.find("[2025-01-02 01:01:01] ERROR: ┏ [GOLDEN] Realtime\n", expected.size()) == expected.size());
+
+    std::filesystem::remove(test_log_file);
+    std::cout << "✓ Manual source golden output test passed" << std::endl;
+}
+
+void test_timestamp_formatter_matches_put_time()
+{
+    std::cout << "Testing table-driven timestamps against std::put_time..." << std::endl;
+
+    TimestampFormatter formatter;
+    // One sample every 97 minutes and 13 seconds covers every field and DST changes
+    std::time_t start = 1704067200; // 2024-01-01 00:00:00 UTC
+    for (std::time_t t = start; t < start + 366 * 24 * 3600; t += 97 * 60 + 13)
+    {
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &t);
+#else
+        localtime_r(&t, &local);
+#endif
+        std::ostringstream expected;
+        expected << std::put_time(&local, "%Y-%m-%d %H:%M:%S");
+
+        auto time = std::chrono::system_clock::from_time_t(t) + std::chrono::microseconds(4567);
+        assert(formatter.format(time, ETimestampFormat::DEFAULT) == expected.str());
+
+        // "%z" gives "+hhmm"; ISO-8601 wants "+hh:mm"
+        std::ostringstream zone;
+        zone << std::put_time(&local, "%z");
+        std::string iso = formatter.format(time, ETimestampFormat::ISO8601);
+        std::string date = expected.str();
+        date[10] = 'T';
+        assert(iso == date + ".004567" + zone.str().substr(0, 3) + ":" + zone.str().substr(3));
+    }
+
+    std::cout << "✓ Timestamp formatter test passed" << std::endl;
+}
+
+void test_iso8601_records()
+{
+    std::cout << "Testing ISO-8601 record timestamps..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_clock_iso.log";
+    std::filesystem::remove(test_log_file);
+
+    bool selected = logger.setClockSource(EClockSource::MANUAL);
+    assert(selected);
+    auto time = std::chrono::system_clock::from_time_t(1735786800) + std::chrono::microseconds(123456);
+    logger.setManualTime(time);
+    logger.setTimestampFormat(ETimestampFormat::ISO8601);
+    assert(logger.getTimestampFormat() == ETimestampFormat::ISO8601);
+
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setLogFile(test_log_file);
+    logger.setOutputDestination(EOutput::FILE);
+    logger.log(ELevel::ECLIPSE_INFO, "ISO", "Record", {}, "iso.cpp:1 [main]");
+    logger.closeLogFile();
+    logger.setOutputDestination(EOutput::CONSOLE);
+    logger.setTimestampFormat(ETimestampFormat::DEFAULT);
+    selected = logger.setClockSource(EClockSource::REALTIME);
+
+    std::string stamp = TimestampFormatter().format(time, ETimestampFormat::ISO8601);
+    assert(stamp.size() == TimestampFormatter::kMaxLength);
+    assert(stamp.compare(19, 7, ".123456") == 0);
+
+    std::string content = read_file(test_log_file);
+    std::cout << content;
+    const std::string indent(stamp.size() + 10, ' ');
+    assert(content == "[" + stamp + "] INFO : ┏ [ISO] Record\n" + indent + "┗ at: iso.cpp:1 [main]\n");
+
+    std::filesystem::remove(test_log_file);
+    std::cout << "✓ ISO-8601 records test passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        std::cout << "=== Eclipse Logger Clock Source Tests ===" << std::endl;
+        std::cout << "Testing timestamp sources..." << std::endl
+                  << std::endl;
+
+        test_tsc_selection_follows_invariance();
+        test_tsc_tracks_wall_clock();
+        test_logger_records_with_tsc();
+        test_coarse_source();
+        test_manual_source_golden_output();
+        test_timestamp_formatter_matches_put_time();
+        test_iso8601_records();
+
+        std::cout << std::endl
+                  << "🎉 All clock source tests passed successfully!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
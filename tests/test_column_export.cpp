@@ -0,0 +1,424 @@
+/**
+ * @file test_column_export.cpp
+ * @brief Record reader and columnar export tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/ColumnStore.h"
+#include "Eclipse/RecordReader.h"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <chrono>
+
+using namespace Eclipse;
+
+namespace
+{
+    const char *const kTags[] = {"HTTP", "DB", "CACHE"};
+    const char *const kMessages[] = {"Request served", "Query finished", "Entry evicted", "Retrying\nwith backoff"};
+    const int64_t kStartNs = 1700000000LL * 1000000000LL + 123456789LL;
+
+    /**
+     * @brief Records with repeated strings, every detail count, and errors in some stretches only
+     */
+    std::vector<BinaryRecord> make_records(int count)
+    {
+        std::vector<BinaryRecord> records;
+        for (int i = 0; i < count; ++i)
+        {
+            BinaryRecord record;
+            record.sequence = static_cast<uint64_t>(i);
+            record.timeNs = kStartNs + i * 250000000LL;
+            record.level = static_cast<uint8_t>(i / 100 % 3 == 0 ? i % 5 : i % 3);
+            record.tag = kTags[i % 3];
+            record.msg = kMessages[i % 4];
+            record.trace = i % 7 == 0 ? "" : "server.cpp:" + std::to_string(100 + i % 5) + " [handle]";
+            for (int d = 0; d < i % 4; ++d)
+            {
+                record.details.push_back(d == 0 ? "id=" + std::to_string(1000 + i) : "[field " + std::to_string(d) + "]");
+            }
+            records.push_back(record);
+        }
+        return records;
+    }
+
+    void log_records(const std::vector<BinaryRecord> &records, EFileFormat format, ETimestampFormat timestamps,
+                     const std::string &path)
+    {
+        Logger &logger = Logger::getInstance();
+        logger.setClockSource(EClockSource::MANUAL);
+        logger.setOutputDestination(EOutput::FILE);
+        logger.setTimestampFormat(timestamps);
+        logger.setFileFormat(format);
+        logger.setLogFile(path);
+        for (const BinaryRecord &record : records)
+        {
+            logger.setManualTime(std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(record.timeNs))));
+            logger.log(static_cast<ELevel>(record.level), record.tag, record.msg, record.details, record.trace);
+        }
+        logger.closeLogFile();
+        logger.setFileFormat(EFileFormat::TEXT);
+        logger.setTimestampFormat(ETimestampFormat::DEFAULT);
+        logger.setClockSource(EClockSource::REALTIME);
+    }
+
+    std::vector<BinaryRecord> read_records(const std::string &path)
+    {
+        RecordReader reader;
+        bool opened = reader.open(path);
+        assert(opened);
+        std::vector<BinaryRecord> records;
+        BinaryRecord record;
+        while (reader.next(record))
+        {
+            records.push_back(record);
+        }
+        assert(reader.getSkippedLines() == 0);
+        return records;
+    }
+
+    bool same_fields(const BinaryRecord &a, const BinaryRecord &b)
+    {
+        return a.level == b.level && a.tag == b.tag && a.msg == b.msg && a.trace == b.trace && a.details == b.details;
+    }
+
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+}
+
+void test_reads_every_format()
+{
+    std::cout << "Testing records read back from every file format..." << std::endl;
+
+    std::vector<BinaryRecord> records = make_records(200);
+    struct Case
+    {
+        EFileFormat format;
+        ETimestampFormat timestamps;
+        int64_t resolutionNs;
+        const char *path;
+    };
+    const Case cases[] = {
+        {EFileFormat::TEXT, ETimestampFormat::DEFAULT, 1000000000, "test_column_export_default.log"},
+        {EFileFormat::TEXT, ETimestampFormat::ISO8601, 1000, "test_column_export_iso.log"},
+        {EFileFormat::FRAMED, ETimestampFormat::ISO8601, 1000, "test_column_export_framed.log"},
+        {EFileFormat::BINARY, ETimestampFormat::DEFAULT, 1, "test_column_export_binary.log"},
+    };
+
+    for (const Case &c : cases)
+    {
+        std::filesystem::remove(c.path);
+        log_records(records, c.format, c.timestamps, c.path);
+        std::vector<BinaryRecord> read = read_records(c.path);
+        assert(read.size() == records.size());
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            assert(same_fields(read[i], records[i]));
+            assert(read[i].timeNs == records[i].timeNs - records[i].timeNs % c.resolutionNs);
+            assert(c.format == EFileFormat::BINARY || read[i].sequence == i);
+        }
+        assert(c.format != EFileFormat::BINARY || read.back().sequence == read.front().sequence + records.size() - 1);
+        std::filesystem::remove(c.path);
+    }
+
+    // Lines outside any record are counted, not mistaken for records
+    TextRecordParser parser;
+    std::vector<BinaryRecord> parsed;
+    parser.addLine("garbage before the first record", parsed);
+    parser.addLine("[2025-01-02T03:04:05.250000+01:00] ERROR: ┏ [DB] Lost connection", parsed);
+    parser.addLine("                                           ┗ [1] host=db1", parsed);
+    parser.finish(parsed);
+    assert(parser.getSkippedLines() == 1);
+    assert(parsed.size() == 1 && parsed[0].level == 3 && parsed[0].tag == "DB");
+    assert(parsed[0].details == std::vector<std::string>{"host=db1"});
+    assert(parsed[0].timeNs == (1735787045LL - 3600) * 1000000000LL + 250000000LL);
+
+    std::cout << "✓ Every format test passed" << std::endl;
+}
+
+void test_multiline_text_round_trip()
+{
+    std::cout << "Testing TEXT records whose trace or details hold newlines..." << std::endl;
+
+    std::vector<BinaryRecord> records(4);
+    records[0].tag = "Multi";
+    records[0].msg = "line1\nline2";
+    records[0].details = {"d1\nd2"};
+    records[1].tag = "Multi";
+    records[1].msg = "Trace only";
+    records[1].trace = "frame1\nframe2\nframe3";
+    records[2].tag = "Multi";
+    records[2].msg = "Several details";
+    records[2].trace = "main.cpp:7";
+    records[2].details = {"first\nsecond", "id=1", "last\nline"};
+    records[3].tag = "Multi";
+    records[3].msg = "Last record";
+    records[3].details = {"tail\nend"};
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        records[i].level = static_cast<uint8_t>(ELevel::ECLIPSE_INFO);
+        records[i].timeNs = kStartNs + static_cast<int64_t>(i) * 1000000000LL;
+    }
+
+    const std::string path = "test_column_export_multiline.log";
+    std::filesystem::remove(path);
+    log_records(records, EFileFormat::TEXT, ETimestampFormat::ISO8601, path);
+
+    // Lines after the "┗" line belong to the last detail or the trace, not to nothing
+    std::vector<BinaryRecord> read = read_records(path);
+    assert(read.size() == records.size());
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        assert(same_fields(read[i], records[i]));
+    }
+
+    std::filesystem::remove(path);
+    std::cout << "✓ Multi-line TEXT round trip test passed" << std::endl;
+}
+
+void test_follow_growing_file()
+{
+    std::cout << "Testing records followed while a file grows..." << std::endl;
+
+    std::vector<BinaryRecord> records = make_records(200);
+    const std::pair<EFileFormat, const char *> cases[] = {
+        {EFileFormat::TEXT, "test_column_export_follow.log"},
+        {EFileFormat::BINARY, "test_column_export_follow.bin"},
+    };
+
+    for (const auto &c : cases)
+    {
+        const std::string full = std::string(c.second) + ".full";
+        std::filesystem::remove(full);
+        log_records(records, c.first, ETimestampFormat::ISO8601, full);
+        const std::string content = read_file(full);
+        std::filesystem::remove(full);
+
+        // The first part ends inside a line or frame, as a write in progress leaves it
+        const size_t cut = content.size() / 2 + 3;
+        {
+            std::ofstream file(c.second, std::ios::binary | std::ios::trunc);
+            file << content.substr(0, cut);
+        }
+        RecordReader reader;
+        reader.setFollow(true);
+        bool opened = reader.open(c.second);
+        assert(opened);
+        std::vector<BinaryRecord> read;
+        BinaryRecord record;
+        while (reader.next(record))
+        {
+            read.push_back(record);
+        }
+        const size_t early = read.size();
+        assert(early > 0 && early < records.size());
+
+        {
+            std::ofstream file(c.second, std::ios::binary | std::ios::app);
+            file << content.substr(cut);
+        }
+        while (reader.next(record))
+        {
+            read.push_back(record);
+        }
+        assert(read.size() == records.size());
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            assert(same_fields(read[i], records[i]));
+        }
+        std::cout << "  " << early << " record(s) before the file grew, " << read.size() - early << " after"
+                  << std::endl;
+        std::filesystem::remove(c.second);
+    }
+
+    std::cout << "✓ Follow test passed" << std::endl;
+}
+
+void test_column_round_trip()
+{
+    std::cout << "Testing a columnar part round trip..." << std::endl;
+
+    const std::string part = "test_column_export_part";
+    std::filesystem::remove_all(part);
+    std::vector<BinaryRecord> records = make_records(1050);
+
+    ColumnWriter writer(100);
+    bool opened = writer.open(part);
+    assert(opened);
+    for (const BinaryRecord &record : records)
+    {
+        bool added = writer.add(record);
+        assert(added);
+    }
+
+    // Until it is closed the part has no index
+    ColumnReader incomplete;
+    assert(!incomplete.open(part));
+    bool closed = writer.close();
+    assert(closed);
+
+    ColumnReader reader;
+    opened = reader.open(part);
+    assert(opened);
+    assert(reader.getRowCount() == records.size());
+    for (size_t c = 0; c < kColumnCount; ++c)
+    {
+        assert(reader.getBlocks(static_cast<EColumn>(c)).size() == 11);
+    }
+
+    std::vector<int64_t> times;
+    std::vector<uint8_t> levels;
+    std::vector<std::string> tags, sites, messages;
+    std::vector<std::vector<std::string>> fields;
+    for (size_t b = 0; b < 11; ++b)
+    {
+        const ColumnBlock &time = reader.getBlocks(EColumn::TIME)[b];
+        const ColumnBlock &tag = reader.getBlocks(EColumn::TAG)[b];
+        bool read = reader.readTimes(time, times) && reader.readLevels(reader.getBlocks(EColumn::LEVEL)[b], levels) &&
+                    reader.readStrings(tag, tags) && reader.readStrings(reader.getBlocks(EColumn::SITE)[b], sites) &&
+                    reader.readStrings(reader.getBlocks(EColumn::MESSAGE)[b], messages) &&
+                    reader.readFields(reader.getBlocks(EColumn::FIELDS)[b], fields);
+        assert(read);
+        assert(time.firstRow == b * 100 && time.rows == (b < 10 ? 100u : 50u));
+        assert(time.minValue == records[time.firstRow].timeNs);
+        assert(time.maxValue == records[time.firstRow + time.rows - 1].timeNs);
+        assert(tag.minText == "CACHE" && tag.maxText == "HTTP");
+        for (size_t r = 0; r < time.rows; ++r)
+        {
+            BinaryRecord row;
+            row.timeNs = times[r];
+            row.level = levels[r];
+            row.tag = tags[r];
+            row.trace = sites[r];
+            row.msg = messages[r];
+            row.details = fields[r];
+            assert(row.timeNs == records[time.firstRow + r].timeNs);
+            assert(same_fields(row, records[time.firstRow + r]));
+        }
+    }
+    // Reading a block as another column fails
+    assert(!reader.readLevels(reader.getBlocks(EColumn::TIME)[0], levels));
+
+    size_t textBytes = 0;
+    for (const BinaryRecord &record : records)
+    {
+        std::string text;
+        formatBinaryRecord(record, ETimestampFormat::DEFAULT, text);
+        textBytes += text.size();
+    }
+    std::cout << "  " << textBytes << " text bytes, " << writer.getStoredBytes() << " column bytes" << std::endl;
+    assert(writer.getStoredBytes() * 2 < textBytes);
+
+    // A damaged block fails its check without affecting the others
+    std::string content = read_file(part + "/message.col");
+    content[reader.getBlocks(EColumn::MESSAGE)[3].offset + 2] ^= 0x20;
+    {
+        std::ofstream file(part + "/message.col", std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+    assert(!reader.readStrings(reader.getBlocks(EColumn::MESSAGE)[3], messages));
+    assert(reader.readStrings(reader.getBlocks(EColumn::MESSAGE)[4], messages));
+    assert(reader.readStrings(reader.getBlocks(EColumn::TAG)[3], tags));
+
+    std::filesystem::remove_all(part);
+    std::cout << "✓ Columnar round trip test passed" << std::endl;
+}
+
+void test_errors_by_tag_per_minute()
+{
+    std::cout << "Testing an aggregate query over columns..." << std::endl;
+
+    const std::string part = "test_column_export_query";
+    std::filesystem::remove_all(part);
+    std::vector<BinaryRecord> records = make_records(3000);
+    ColumnWriter writer(100);
+    writer.open(part);
+    for (const BinaryRecord &record : records)
+    {
+        writer.add(record);
+    }
+    writer.close();
+
+    std::map<std::pair<std::string, int64_t>, int> expected;
+    for (const BinaryRecord &record : records)
+    {
+        if (record.level >= static_cast<uint8_t>(ELevel::ECLIPSE_ERROR))
+        {
+            ++expected[{record.tag, record.timeNs / 60000000000LL}];
+        }
+    }
+
+    // Only the level, time and tag columns are read, and only blocks whose levels reach ERROR
+    ColumnReader reader;
+    bool opened = reader.open(part);
+    assert(opened);
+    std::map<std::pair<std::string, int64_t>, int> counts;
+    size_t skipped = 0;
+    std::vector<uint8_t> levels;
+    std::vector<int64_t> times;
+    std::vector<std::string> tags;
+    const std::vector<ColumnBlock> &levelBlocks = reader.getBlocks(EColumn::LEVEL);
+    for (size_t b = 0; b < levelBlocks.size(); ++b)
+    {
+        if (levelBlocks[b].maxValue < static_cast<int64_t>(ELevel::ECLIPSE_ERROR))
+        {
+            ++skipped;
+            continue;
+        }
+        bool read = reader.readLevels(levelBlocks[b], levels) && reader.readTimes(reader.getBlocks(EColumn::TIME)[b], times) &&
+                    reader.readStrings(reader.getBlocks(EColumn::TAG)[b], tags);
+        assert(read);
+        for (size_t r = 0; r < levels.size(); ++r)
+        {
+            if (levels[r] >= static_cast<uint8_t>(ELevel::ECLIPSE_ERROR))
+            {
+                ++counts[{tags[r], times[r] / 60000000000LL}];
+            }
+        }
+    }
+    std::cout << "  " << counts.size() << " tag-minute groups, " << skipped << " of " << levelBlocks.size()
+              << " blocks skipped" << std::endl;
+    assert(counts == expected);
+    assert(!counts.empty());
+    assert(skipped == 20);
+
+    std::filesystem::remove_all(part);
+    std::cout << "✓ Aggregate query test passed" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Eclipse Logger Columnar Export Tests ===" << std::endl;
+
+    try
+    {
+        test_reads_every_format();
+        test_multiline_text_round_trip();
+        test_follow_growing_file();
+        test_column_round_trip();
+        test_errors_by_tag_per_minute();
+
+        std::cout << "\n🎉 All columnar export tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
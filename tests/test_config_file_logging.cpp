@@ -295,6 +295,60 @@ void test_file_append_mode()
     std::cout << "✓ File append mode test passed" << std::endl;
 }
 
+void test_oversize_record_policy()
+{
+    std::cout << "Testing records larger than the atomic write limit..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_oversize.log";
+    std::filesystem::remove(test_log_file);
+
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setLogFile(test_log_file);
+    logger.setOutputDestination(EOutput::FILE);
+
+    // Without an atomic limit every record is written in full
+    ECLIPSE_INFO("OVERSIZE_TEST", "Unlimited record", std::string(8000, 'U'));
+
+    logger.setAtomicWriteLimit(256);
+
+    // SPLIT_LINES keeps short lines whole and writes the over-long one in pieces
+    logger.setOversizePolicy(EOversize::SPLIT_LINES);
+    ECLIPSE_INFO("OVERSIZE_TEST", "Split record", "short=1", "long=" + std::string(400, 'L'));
+
+    // TRUNCATE cuts the whole record to the limit
+    logger.setOversizePolicy(EOversize::TRUNCATE);
+    ECLIPSE_INFO("OVERSIZE_TEST", "Truncated record", std::string(400, 'T'));
+
+    logger.closeLogFile();
+    logger.setOutputDestination(EOutput::CONSOLE);
+    logger.setAtomicWriteLimit(0);
+    logger.setOversizePolicy(EOversize::SPLIT_LINES);
+
+    std::ifstream log_file(test_log_file);
+    std::string content((std::istreambuf_iterator<char>(log_file)), std::istreambuf_iterator<char>());
+    log_file.close();
+
+    assert(content.find("Split record") != std::string::npos);
+    assert(content.find("short=1") != std::string::npos);
+    assert(content.find("Truncated record") != std::string::npos);
+    assert(content.find(std::string(8000, 'U')) != std::string::npos);
+    assert(content.find(std::string(400, 'L')) != std::string::npos);
+    assert(content.find(std::string(400, 'T')) == std::string::npos);
+    assert(std::count(content.begin(), content.end(), '\n') >= 4);
+
+    std::size_t marker_count = 0;
+    for (std::size_t pos = content.find("[truncated]"); pos != std::string::npos;
+         pos = content.find("[truncated]", pos + 1))
+    {
+        ++marker_count;
+    }
+    assert(marker_count == 1);
+
+    std::filesystem::remove(test_log_file);
+    std::cout << "✓ Oversize record policy test passed" << std::endl;
+}
+
 int main()
 {
     try
@@ -310,6 +364,7 @@ int main()
         test_custom_config_parsing();
         test_level_parsing_variants();
         test_file_append_mode();
+        test_oversize_record_policy();
 
         std::cout << std::endl
                   << "🎉 All configuration and file tests passed successfully!" << std::endl;
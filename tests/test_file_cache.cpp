@@ -0,0 +1,285 @@
+/**
+ * @file test_file_cache.cpp
+ * @brief Page-cache bypass and preallocation tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include "Eclipse/FileSink.h"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    std::string record(int index)
+    {
+        // Odd lengths, so records never line up with blocks
+        return "record " + std::to_string(index) + std::string(static_cast<size_t>(index % 37), 'x') + "\n";
+    }
+}
+
+void test_direct_writes_exact_content()
+{
+    std::cout << "Testing DIRECT sink content and tail padding..." << std::endl;
+
+    const std::string path = "test_cache_direct.log";
+    std::filesystem::remove(path);
+
+    FileSink sink;
+    sink.setCacheMode(ECacheMode::DIRECT);
+    bool opened = sink.open(path);
+    assert(opened);
+#ifdef __linux__
+    bool direct = sink.getCacheMode() == ECacheMode::DIRECT;
+    assert(direct || sink.getCacheMode() == ECacheMode::DONTNEED);
+#else
+    bool direct = false;
+    assert(sink.getCacheMode() == ECacheMode::NORMAL);
+#endif
+
+    std::string expected;
+    for (int i = 0; i < 500; ++i)
+    {
+        std::string line = record(i);
+        bool written = sink.write(line);
+        assert(written);
+        expected += line;
+    }
+
+    // Every record is on disk already; only the padding of the last block is extra
+    std::string padded = read_file(path);
+    assert(padded.compare(0, expected.size(), expected) == 0);
+    if (direct)
+    {
+        assert(padded.size() % 4096 == 0);
+        assert(padded.find_first_not_of('\0', expected.size()) == std::string::npos);
+    }
+
+    sink.close();
+    assert(read_file(path) == expected);
+
+    std::filesystem::remove(path);
+    std::cout << "✓ DIRECT sink content and tail padding test passed" << std::endl;
+}
+
+void test_direct_reopen_appends()
+{
+    std::cout << "Testing DIRECT sink appending to an existing file..." << std::endl;
+
+    const std::string path = "test_cache_reopen.log";
+    std::filesystem::remove(path);
+    {
+        std::ofstream seed(path, std::ios::binary);
+        seed << "existing line with an unaligned length\n";
+    }
+    std::string expected = read_file(path);
+
+    FileSink sink;
+    sink.setCacheMode(ECacheMode::DIRECT);
+    for (int round = 0; round < 3; ++round)
+    {
+        bool opened = sink.open(path);
+        assert(opened);
+        for (int i = 0; i < 50; ++i)
+        {
+            std::string line = record(round * 100 + i);
+            bool written = sink.write(line);
+            assert(written);
+            expected += line;
+        }
+        sink.close();
+        assert(read_file(path) == expected);
+    }
+
+    // A record far larger than the staging buffer grows it
+    bool opened = sink.open(path);
+    assert(opened);
+    std::string big(200000, 'b');
+    big += "\n";
+    sink.setAtomicLimit(big.size());
+    bool written = sink.write(big);
+    assert(written);
+    expected += big;
+    sink.close();
+    assert(read_file(path) == expected);
+
+    std::filesystem::remove(path);
+    std::cout << "✓ DIRECT sink append test passed" << std::endl;
+}
+
+void test_dontneed_and_preallocation()
+{
+    std::cout << "Testing DONTNEED sink with preallocation..." << std::endl;
+
+    const std::string path = "test_cache_dontneed.log";
+    std::filesystem::remove(path);
+
+    FileSink sink;
+    sink.setCacheMode(ECacheMode::DONTNEED);
+    sink.setPreallocation(4 * 1024 * 1024);
+    bool opened = sink.open(path);
+    assert(opened);
+#ifdef __linux__
+    assert(sink.getCacheMode() == ECacheMode::DONTNEED);
+#endif
+
+    bool written = sink.write("first\n");
+    assert(written);
+#ifdef __linux__
+    // Space is reserved beyond the end without changing the file length
+    struct stat info{};
+    int status = ::stat(path.c_str(), &info);
+    assert(status == 0);
+    assert(info.st_size == 6);
+    assert(static_cast<long long>(info.st_blocks) * 512 >= 4 * 1024 * 1024);
+#endif
+
+    // Enough data to cross several drop steps
+    std::string expected = "first\n";
+    std::string chunk(4095, 'd');
+    chunk += "\n";
+    for (int i = 0; i < 1024; ++i)
+    {
+        written = sink.write(chunk);
+        assert(written);
+        expected += chunk;
+    }
+    sink.close();
+    assert(read_file(path) == expected);
+
+    std::filesystem::remove(path);
+    std::cout << "✓ DONTNEED sink with preallocation test passed" << std::endl;
+}
+
+void test_logger_direct_records()
+{
+    std::cout << "Testing logger records through a DIRECT log file..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string path = "test_cache_logger.log";
+    std::filesystem::remove(path);
+
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setLogFile(path);
+    bool applied = logger.setFileCacheMode(ECacheMode::DIRECT, 1024 * 1024);
+#ifdef __linux__
+    (void)applied;
+#else
+    assert(!applied);
+#endif
+
+    for (int i = 0; i < 200; ++i)
+    {
+        ECLIPSE_INFO("CACHE", "Direct record", i);
+    }
+    logger.closeLogFile();
+
+    std::string content = read_file(path);
+    assert(content.find('\0') == std::string::npos);
+    assert(content.find("Direct record") != std::string::npos);
+    assert(content.find("199") != std::string::npos);
+    assert(content.back() == '\n');
+
+    bool restored = logger.setFileCacheMode(ECacheMode::NORMAL);
+    assert(restored);
+    std::filesystem::remove(path);
+    std::cout << "✓ Logger DIRECT records test passed" << std::endl;
+}
+
+#ifndef _WIN32
+void test_direct_fork_reopens()
+{
+    std::cout << "Testing fork with a DIRECT log file..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string path = "test_cache_fork.log";
+    std::filesystem::remove(path);
+
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setLogFile(path);
+    bool applied = logger.setFileCacheMode(ECacheMode::DIRECT);
+    ECLIPSE_INFO("CACHE", "Parent before fork");
+
+    pid_t pid = ::fork();
+    assert(pid >= 0);
+    if (pid == 0)
+    {
+        ECLIPSE_INFO("CACHE", "Child record");
+        Logger::getInstance().closeLogFile();
+        ::_exit(0);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    ECLIPSE_INFO("CACHE", "Parent after fork");
+    logger.closeLogFile();
+
+    std::string parent = read_file(path);
+    assert(parent.find("Parent before fork") != std::string::npos);
+    assert(parent.find("Parent after fork") != std::string::npos);
+    assert(parent.find('\0') == std::string::npos);
+
+    const std::string childPath = "test_cache_fork." + std::to_string(pid) + ".log";
+    if (applied)
+    {
+        assert(parent.find("Child record") == std::string::npos);
+        // A DIRECT file belongs to one process, so the child always reopens
+        std::string child = read_file(childPath);
+        assert(child.find("Child record") != std::string::npos);
+        assert(child.find("Parent before fork") == std::string::npos);
+    }
+
+    logger.setFileCacheMode(ECacheMode::NORMAL);
+    std::filesystem::remove(path);
+    std::filesystem::remove(childPath);
+    std::cout << "✓ Fork with DIRECT log file test passed" << std::endl;
+}
+#endif
+
+int main()
+{
+    std::cout << "=== Eclipse Logger File Cache Tests ===" << std::endl;
+
+    try
+    {
+        test_direct_writes_exact_content();
+        test_direct_reopen_appends();
+        test_dontneed_and_preallocation();
+        test_logger_direct_records();
+#ifndef _WIN32
+        test_direct_fork_reopens();
+#endif
+
+        std::cout << "\n🎉 All file cache tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,231 @@
+/**
+ * @file test_fork_safety.cpp
+ * @brief fork() safety tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    int wait_child(pid_t pid)
+    {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    }
+}
+
+void test_fork_while_logging()
+{
+    std::cout << "Testing fork() while other threads are logging..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_fork_busy.log";
+    std::filesystem::remove(test_log_file);
+
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setLogFile(test_log_file);
+    logger.setOutputDestination(EOutput::FILE);
+
+    std::atomic<bool> stop_flag{false};
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 3; ++t)
+    {
+        writers.emplace_back([&stop_flag, t]()
+                             {
+            int i = 0;
+            while (!stop_flag.load()) {
+                ECLIPSE_INFO("FORK_BUSY", "Background record", "thread=" + std::to_string(t), "i=" + std::to_string(i++));
+            } });
+    }
+
+    // Without atfork handling a child regularly inherits a locked logMutex and hangs
+    const int num_forks = 20;
+    for (int f = 0; f < num_forks; ++f)
+    {
+        pid_t pid = ::fork();
+        if (pid == 0)
+        {
+            ::alarm(5);
+            for (int i = 0; i < 10; ++i)
+            {
+                ECLIPSE_INFO("FORK_CHILD", "Child record", "fork=" + std::to_string(f));
+            }
+            ::_exit(0);
+        }
+        assert(pid > 0);
+        int status = wait_child(pid);
+        assert(status == 0);
+    }
+
+    stop_flag.store(true);
+    for (auto &writer : writers)
+    {
+        writer.join();
+    }
+    logger.closeLogFile();
+    logger.setOutputDestination(EOutput::CONSOLE);
+
+    std::string content = read_file(test_log_file);
+    assert(content.find("Child record") != std::string::npos);
+    assert(content.find("Background record") != std::string::npos);
+
+    std::filesystem::remove(test_log_file);
+    std::cout << "✓ Fork while logging test passed" << std::endl;
+}
+
+void test_fork_reopen_per_pid()
+{
+    std::cout << "Testing per-PID log files in forked children..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string parent_log = "test_fork_pid.log";
+    std::filesystem::remove(parent_log);
+
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setLogFile(parent_log);
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setForkPolicy(EForkPolicy::REOPEN_PER_PID);
+
+    pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        ECLIPSE_INFO("FORK_PID", "Written by the child");
+        Logger::getInstance().closeLogFile();
+        ::_exit(0);
+    }
+    assert(pid > 0);
+    int status = wait_child(pid);
+    assert(status == 0);
+
+    ECLIPSE_INFO("FORK_PID", "Written by the parent");
+    logger.closeLogFile();
+    logger.setOutputDestination(EOutput::CONSOLE);
+    logger.setForkPolicy(EForkPolicy::SHARE_FILE);
+
+    const std::string child_log = "test_fork_pid." + std::to_string(pid) + ".log";
+    std::string parent_content = read_file(parent_log);
+    std::string child_content = read_file(child_log);
+
+    assert(child_content.find("Written by the child") != std::string::npos);
+    assert(parent_content.find("Written by the child") == std::string::npos);
+    assert(parent_content.find("Written by the parent") != std::string::npos);
+
+    std::filesystem::remove(parent_log);
+    std::filesystem::remove(child_log);
+    std::cout << "✓ Per-PID log file test passed" << std::endl;
+}
+
+void test_fork_with_shared_log()
+{
+    std::cout << "Testing fork() with an attached shared-memory log..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string segment = "/eclipse_fork_" + std::to_string(::getpid());
+    const std::string merged_log = "test_fork_shared.log";
+    std::filesystem::remove(merged_log);
+
+    bool started = logger.startCollector(segment, merged_log);
+    assert(started);
+    bool attached = logger.attachSharedLog(segment);
+    assert(attached);
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setOutputDestination(EOutput::FILE);
+
+    const int num_children = 3;
+    std::vector<pid_t> children;
+    for (int c = 0; c < num_children; ++c)
+    {
+        pid_t pid = ::fork();
+        if (pid == 0)
+        {
+            // The child writes into its own slot; the parent's collector picks it up
+            for (int i = 0; i < 50; ++i)
+            {
+                ECLIPSE_INFO("FORK_SHARED", "child=" + std::to_string(c) + " i=" + std::to_string(i));
+            }
+            ::_exit(0);
+        }
+        assert(pid > 0);
+        children.push_back(pid);
+    }
+
+    for (int i = 0; i < 50; ++i)
+    {
+        ECLIPSE_INFO("FORK_SHARED", "parent i=" + std::to_string(i));
+    }
+
+    for (pid_t pid : children)
+    {
+        int status = wait_child(pid);
+        assert(status == 0);
+    }
+
+    logger.detachSharedLog();
+    logger.stopCollector(true);
+    logger.setOutputDestination(EOutput::CONSOLE);
+
+    std::string content = read_file(merged_log);
+    int records = 0;
+    for (size_t pos = content.find("[FORK_SHARED]"); pos != std::string::npos;
+         pos = content.find("[FORK_SHARED]", pos + 1))
+    {
+        ++records;
+    }
+    std::cout << "Collected " << records << " records from parent and children" << std::endl;
+    assert(records == (num_children + 1) * 50);
+
+    std::filesystem::remove(merged_log);
+    std::cout << "✓ Fork with shared log test passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        std::cout << "=== Eclipse Logger fork() Safety Tests ===" << std::endl;
+        std::cout << "Testing logging across fork()..." << std::endl
+                  << std::endl;
+
+        test_fork_while_logging();
+        test_fork_reopen_per_pid();
+        test_fork_with_shared_log();
+
+        std::cout << std::endl
+                  << "🎉 All fork() safety tests passed successfully!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
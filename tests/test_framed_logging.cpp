@@ -0,0 +1,275 @@
+/**
+ * @file test_framed_logging.cpp
+ * @brief CRC32C framed log file tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include "Eclipse/LogReader.h"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    void write_file(const std::string &path, const std::string &content)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    std::vector<std::string> read_frames(LogReader &reader)
+    {
+        std::vector<std::string> frames;
+        std::string payload;
+        while (reader.next(payload))
+        {
+            frames.push_back(payload);
+        }
+        return frames;
+    }
+
+    /**
+     * @brief Bit-at-a-time CRC32C, the definition the fast paths must match
+     */
+    uint32_t reference_crc(const std::string &data)
+    {
+        uint32_t crc = 0xFFFFFFFFu;
+        for (unsigned char c : data)
+        {
+            crc ^= c;
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+            }
+        }
+        return ~crc;
+    }
+
+    /**
+     * @brief Log count framed records to a fresh file and return its content
+     */
+    std::string write_framed_log(const std::string &path, int count)
+    {
+        Logger &logger = Logger::getInstance();
+        std::filesystem::remove(path);
+        logger.setOutputDestination(EOutput::FILE);
+        logger.setFileFormat(EFileFormat::FRAMED);
+        logger.setLogFile(path);
+        for (int i = 0; i < count; ++i)
+        {
+            // Same width for every number, so all frames have the same size
+            ECLIPSE_INFO("FRAME", "Framed record", 1000 + i);
+        }
+        logger.closeLogFile();
+        logger.setFileFormat(EFileFormat::TEXT);
+        return read_file(path);
+    }
+}
+
+void test_crc32c()
+{
+    std::cout << "Testing CRC32C checksums..." << std::endl;
+
+    // Check value from the iSCSI specification
+    assert(crc32c("123456789", 9) == 0xE3069283u);
+    assert(crc32c("", 0) == 0);
+
+    std::string data;
+    for (int i = 0; i < 1000; ++i)
+    {
+        data += static_cast<char>(i * 131 % 251);
+    }
+    // Every offset and length, so unaligned heads and tails go through both paths
+    for (size_t offset = 0; offset < 16; ++offset)
+    {
+        for (size_t length : {0u, 1u, 7u, 8u, 9u, 63u, 64u, 500u})
+        {
+            std::string slice = data.substr(offset, length);
+            assert(crc32c(slice.data(), slice.size()) == reference_crc(slice));
+        }
+    }
+
+    // Extending a checksum equals checksumming the whole
+    uint32_t split = crc32c(data.data() + 300, data.size() - 300, crc32c(data.data(), 300));
+    assert(split == crc32c(data.data(), data.size()));
+
+    std::cout << "  hardware CRC32C: " << (crc32cAccelerated() ? "yes" : "no") << std::endl;
+    std::cout << "✓ CRC32C test passed" << std::endl;
+}
+
+void test_framed_records_round_trip()
+{
+    std::cout << "Testing framed records round trip..." << std::endl;
+
+    const std::string path = "test_framed_round_trip.log";
+    std::string content = write_framed_log(path, 100);
+    assert(content.find("Framed record") != std::string::npos);
+
+    LogReader reader;
+    bool opened = reader.open(path);
+    assert(opened);
+    std::vector<std::string> frames = read_frames(reader);
+    assert(frames.size() == 100);
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        assert(frames[i].find("[FRAME] Framed record") != std::string::npos);
+        assert(frames[i].find("] " + std::to_string(1000 + i) + "\n") != std::string::npos);
+    }
+    assert(reader.getCorruptBytes() == 0);
+    assert(reader.getTornBytes() == 0);
+    assert(reader.getValidEnd() == content.size());
+
+    std::filesystem::remove(path);
+    std::cout << "✓ Framed records round trip test passed" << std::endl;
+}
+
+void test_torn_tail()
+{
+    std::cout << "Testing a torn last frame..." << std::endl;
+
+    const std::string path = "test_framed_torn.log";
+    std::string content = write_framed_log(path, 10);
+    const size_t intact = content.size();
+    const size_t frameSize = content.size() / 10;
+
+    // A crash in the middle of the next frame leaves a prefix of it
+    write_file(path, content + content.substr(0, 20));
+
+    LogReader reader;
+    bool opened = reader.open(path);
+    assert(opened);
+    assert(read_frames(reader).size() == 10);
+    assert(reader.getTornBytes() == 20);
+    assert(reader.getCorruptBytes() == 0);
+    assert(reader.getValidEnd() == intact);
+
+    // The rest of the frame arrives: the reader continues where it stopped
+    {
+        std::ofstream append(path, std::ios::binary | std::ios::app);
+        append << content.substr(20, frameSize - 20);
+    }
+    std::string payload;
+    bool resumed = reader.next(payload);
+    assert(resumed);
+    assert(payload.find("Framed record") != std::string::npos);
+    assert(reader.getFrameCount() == 11);
+    reader.close();
+
+    std::filesystem::remove(path);
+    std::cout << "✓ Torn last frame test passed" << std::endl;
+}
+
+void test_damaged_frames_skipped()
+{
+    std::cout << "Testing damaged frames are skipped..." << std::endl;
+
+    const std::string path = "test_framed_damaged.log";
+    std::string content = write_framed_log(path, 20);
+    const size_t frameSize = content.size() / 20;
+    assert(content.size() % 20 == 0);
+
+    // Flip a payload byte of frame 3, overwrite the length of frame 7 and put
+    // unframed text between frames 12 and 13
+    std::string damaged = content;
+    damaged[3 * frameSize + kFrameHeaderSize + 5] ^= 0x40;
+    damaged[7 * frameSize + 6] = '\x7F';
+    damaged.insert(13 * frameSize, "stray text line\n");
+    write_file(path, damaged);
+
+    LogReader reader;
+    bool opened = reader.open(path);
+    assert(opened);
+    std::vector<std::string> frames = read_frames(reader);
+    assert(frames.size() == 18);
+    assert(reader.getCorruptBytes() == 2 * frameSize + 16);
+    assert(reader.getTornBytes() == 0);
+    assert(frames[3].find("] 1004\n") != std::string::npos);
+    assert(frames[17].find("] 1019\n") != std::string::npos);
+
+    std::filesystem::remove(path);
+    std::cout << "✓ Damaged frames test passed" << std::endl;
+}
+
+void test_buffered_batches_and_signal_records()
+{
+    std::cout << "Testing framed batches and signal-safe records..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string path = "test_framed_batches.log";
+    std::filesystem::remove(path);
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setFileFormat(EFileFormat::FRAMED);
+    assert(logger.getFileFormat() == EFileFormat::FRAMED);
+    logger.setLogFile(path);
+
+    logger.setWriteMode(EWriteMode::THREAD_BUFFERED);
+    for (int i = 0; i < 50; ++i)
+    {
+        ECLIPSE_INFO("FRAME", "Batched record", i);
+    }
+    logger.setWriteMode(EWriteMode::IMMEDIATE);
+    ECLIPSE_SIGNAL_SAFE_LOG(ELevel::ECLIPSE_WARN, "FRAME", "Signal record", 7);
+    logger.closeLogFile();
+    logger.setFileFormat(EFileFormat::TEXT);
+
+    LogReader reader;
+    bool opened = reader.open(path);
+    assert(opened);
+    std::vector<std::string> frames = read_frames(reader);
+    assert(reader.getCorruptBytes() == 0 && reader.getTornBytes() == 0);
+
+    // One frame per batch, then the signal-safe record in a frame of its own
+    assert(frames.size() >= 2 && frames.size() < 10);
+    size_t records = 0;
+    for (size_t f = 0; f + 1 < frames.size(); ++f)
+    {
+        for (size_t at = frames[f].find("Batched record"); at != std::string::npos; at = frames[f].find("Batched record", at + 1))
+        {
+            ++records;
+        }
+    }
+    assert(records == 50);
+    assert(frames.back().find("[FRAME] Signal record") != std::string::npos);
+
+    std::filesystem::remove(path);
+    std::cout << "✓ Framed batches and signal-safe records test passed" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Eclipse Logger Framed Log Tests ===" << std::endl;
+
+    try
+    {
+        test_crc32c();
+        test_framed_records_round_trip();
+        test_torn_tail();
+        test_damaged_frames_skipped();
+        test_buffered_batches_and_signal_records();
+
+        std::cout << "\n🎉 All framed log tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
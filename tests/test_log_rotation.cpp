@@ -0,0 +1,224 @@
+/**
+ * @file test_log_rotation.cpp
+ * @brief logrotate-compatible reopen tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <csignal>
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    /**
+     * @brief Numbers of every "Rotated record" detail line in a log
+     */
+    std::vector<int> record_numbers(const std::string &content)
+    {
+        std::vector<int> numbers;
+        std::istringstream lines(content);
+        std::string line;
+        bool pending = false;
+        while (std::getline(lines, line))
+        {
+            if (line.find("Rotated record") != std::string::npos)
+            {
+                pending = true;
+            }
+            else if (pending && line.find("┗ ") != std::string::npos)
+            {
+                // Debug builds put an "at:" line between the message and its details
+                numbers.push_back(std::stoi(line.substr(line.rfind("] ") + 2)));
+                pending = false;
+            }
+        }
+        return numbers;
+    }
+
+    bool wait_for_file(const std::string &path)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!std::filesystem::exists(path) && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return std::filesystem::exists(path);
+    }
+}
+
+void test_manual_reopen()
+{
+    std::cout << "Testing reopen after the log file is renamed..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string path = "test_rotation_manual.log";
+    const std::string rotated = path + ".1";
+    std::filesystem::remove(path);
+    std::filesystem::remove(rotated);
+
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setLogFile(path);
+    ECLIPSE_INFO("ROTATE", "Before rotation");
+
+    // Renamed away, the file keeps receiving records until the reopen
+    std::filesystem::rename(path, rotated);
+    ECLIPSE_INFO("ROTATE", "Before reopen");
+    bool reopened = logger.reopenLogFile();
+    assert(reopened);
+    assert(std::filesystem::exists(path));
+    ECLIPSE_INFO("ROTATE", "After reopen");
+    ECLIPSE_SIGNAL_SAFE_LOG(ELevel::ECLIPSE_WARN, "ROTATE", "Signal record", 1);
+    logger.closeLogFile();
+
+    std::string before = read_file(rotated);
+    std::string after = read_file(path);
+    assert(before.find("Before rotation") != std::string::npos);
+    assert(before.find("Before reopen") != std::string::npos);
+    assert(before.find("After reopen") == std::string::npos);
+    assert(after.find("After reopen") != std::string::npos);
+    assert(after.find("[ROTATE] Signal record") != std::string::npos);
+    assert(after.find("Before") == std::string::npos);
+
+    // Nothing to reopen without a log file
+    assert(!logger.reopenLogFile());
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(rotated);
+    std::cout << "✓ Manual reopen test passed" << std::endl;
+}
+
+void test_inode_check_loses_nothing()
+{
+    std::cout << "Testing the inode check while a producer keeps logging..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string path = "test_rotation_watch.log";
+    const std::string rotated = path + ".1";
+    std::filesystem::remove(path);
+    std::filesystem::remove(rotated);
+
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setLogFile(path);
+    logger.setWriteMode(EWriteMode::DOUBLE_BUFFERED, 64 * 1024, std::chrono::milliseconds(5));
+    logger.setRotationCheck(std::chrono::milliseconds(20));
+
+    const int count = 4000;
+    std::atomic<int> logged{0};
+    std::thread producer([&logged]()
+                         {
+        for (int i = 0; i < count; ++i)
+        {
+            ECLIPSE_INFO("ROTATE", "Rotated record", i);
+            logged.store(i + 1, std::memory_order_relaxed);
+            if (i % 100 == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        } });
+
+    while (logged.load(std::memory_order_relaxed) < count / 4)
+    {
+        std::this_thread::yield();
+    }
+    std::filesystem::rename(path, rotated);
+    bool recreated = wait_for_file(path);
+    producer.join();
+    assert(recreated);
+
+    logger.setRotationCheck(std::chrono::milliseconds(0));
+    logger.setWriteMode(EWriteMode::IMMEDIATE);
+    logger.closeLogFile();
+
+    // Every record is in exactly one of the files, old ones first
+    std::vector<int> before = record_numbers(read_file(rotated));
+    std::vector<int> after = record_numbers(read_file(path));
+    assert(!before.empty() && !after.empty());
+    std::vector<int> all = before;
+    all.insert(all.end(), after.begin(), after.end());
+    std::sort(all.begin(), all.end());
+    assert(all.size() == static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        assert(all[i] == i);
+    }
+    assert(*std::max_element(before.begin(), before.end()) < *std::min_element(after.begin(), after.end()));
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(rotated);
+    std::cout << "✓ Inode check test passed" << std::endl;
+}
+
+void test_reopen_on_signal()
+{
+    std::cout << "Testing reopen on SIGHUP..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string path = "test_rotation_signal.log";
+    const std::string rotated = path + ".1";
+    std::filesystem::remove(path);
+    std::filesystem::remove(rotated);
+
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setLogFile(path);
+    bool installed = logger.reopenOnSignal(SIGHUP);
+    assert(installed);
+    ECLIPSE_INFO("ROTATE", "Before signal");
+
+    std::filesystem::rename(path, rotated);
+    std::raise(SIGHUP);
+    bool recreated = wait_for_file(path);
+    assert(recreated);
+    ECLIPSE_INFO("ROTATE", "After signal");
+    logger.closeLogFile();
+
+    assert(read_file(rotated).find("Before signal") != std::string::npos);
+    std::string after = read_file(path);
+    assert(after.find("After signal") != std::string::npos);
+    assert(after.find("Before signal") == std::string::npos);
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(rotated);
+    std::cout << "✓ Reopen on SIGHUP test passed" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Eclipse Logger Log Rotation Tests ===" << std::endl;
+
+    try
+    {
+        test_manual_reopen();
+        test_inode_check_loses_nothing();
+        test_reopen_on_signal();
+
+        std::cout << "\n🎉 All log rotation tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,211 @@
+/**
+ * @file test_metrics.cpp
+ * @brief Counter and histogram macro tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include "Eclipse/Metrics.h"
+#include "Eclipse/RecordReader.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include <chrono>
+
+using namespace Eclipse;
+
+namespace
+{
+    const MetricSummary *find(const std::vector<MetricSummary> &summaries, const std::string &name)
+    {
+        for (const MetricSummary &summary : summaries)
+        {
+            if (summary.name == name)
+            {
+                return &summary;
+            }
+        }
+        return nullptr;
+    }
+
+    bool near(double value, double expected)
+    {
+        return std::fabs(value - expected) <= expected * 0.065;
+    }
+
+    std::string detail(const BinaryRecord &record, const std::string &key)
+    {
+        for (const std::string &entry : record.details)
+        {
+            if (entry.compare(0, key.size() + 1, key + "=") == 0)
+            {
+                return entry.substr(key.size() + 1);
+            }
+        }
+        return "";
+    }
+}
+
+void test_sharded_aggregates()
+{
+    std::cout << "Testing counters and histograms updated from several threads..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    logger.setMetricsInterval(std::chrono::milliseconds(0));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([]()
+                             {
+            for (int i = 0; i < 10000; ++i)
+            {
+                ECLIPSE_COUNTER("test_requests", 1);
+                ECLIPSE_HISTOGRAM("test_latency_us", i % 1000 + 1);
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    // The threads have exited; their shards were merged on the way out
+    std::vector<MetricSummary> summaries = Metrics::collect();
+    const MetricSummary *requests = find(summaries, "test_requests");
+    const MetricSummary *latency = find(summaries, "test_latency_us");
+    assert(requests && requests->type == EMetricType::COUNTER);
+    assert(requests->count == 40000 && requests->sum == 40000);
+    assert(latency && latency->type == EMetricType::HISTOGRAM);
+    assert(latency->count == 40000 && latency->sum == 4 * 10 * 500500.0);
+    assert(latency->min == 1 && latency->max == 1000);
+    assert(near(latency->p50, 500) && near(latency->p90, 900) && near(latency->p99, 990));
+
+    // Another call site of the same name adds to the same metric
+    ECLIPSE_COUNTER("test_requests", 5);
+    summaries = Metrics::collect();
+    requests = find(summaries, "test_requests");
+    assert(summaries.size() == 1 && requests && requests->count == 1 && requests->sum == 5);
+    assert(Metrics::collect().empty());
+
+    // The totals are kept apart from the intervals
+    summaries = Metrics::snapshot();
+    requests = find(summaries, "test_requests");
+    latency = find(summaries, "test_latency_us");
+    assert(requests && requests->count == 40001 && requests->sum == 40005);
+    assert(latency && latency->count == 40000 && near(latency->p99, 990));
+
+    assert(Metrics::formatValue(12345678) == "12345678");
+    assert(Metrics::formatValue(0.25) == "0.25");
+
+    std::cout << "✓ Sharded aggregate test passed" << std::endl;
+}
+
+void test_periodic_summaries()
+{
+    std::cout << "Testing summary records logged every interval..." << std::endl;
+
+    const std::string path = "test_metrics_summaries.log";
+    std::filesystem::remove(path);
+    Logger &logger = Logger::getInstance();
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setLogFile(path);
+    logger.setMetricsInterval(std::chrono::milliseconds(100));
+
+    // Two bursts a few intervals apart
+    for (int burst = 0; burst < 2; ++burst)
+    {
+        for (int i = 0; i < 50000; ++i)
+        {
+            ECLIPSE_COUNTER("test_batches", 1);
+            ECLIPSE_HISTOGRAM("test_batch_size", 64);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(350));
+    }
+    logger.setMetricsInterval(std::chrono::milliseconds(0));
+    logger.closeLogFile();
+
+    RecordReader reader;
+    bool opened = reader.open(path);
+    assert(opened);
+    BinaryRecord record;
+    uint64_t batches = 0;
+    size_t summaries = 0;
+    while (reader.next(record))
+    {
+        if (record.tag != "Metrics")
+        {
+            continue;
+        }
+        if (record.msg == "test_batches")
+        {
+            assert(detail(record, "type") == "counter");
+            batches += std::stoull(detail(record, "count"));
+            ++summaries;
+        }
+        else if (record.msg == "test_batch_size")
+        {
+            assert(detail(record, "type") == "histogram");
+            assert(detail(record, "min") == "64" && detail(record, "max") == "64" && detail(record, "p99") == "64");
+        }
+    }
+
+    // A hundred thousand updates become a few lines
+    assert(batches == 100000);
+    assert(summaries >= 2 && summaries <= 8);
+
+    std::cout << "  " << summaries << " summary record(s) for " << batches << " update(s)" << std::endl;
+    std::filesystem::remove(path);
+    std::cout << "✓ Periodic summary test passed" << std::endl;
+}
+
+void test_type_mismatch()
+{
+    std::cout << "Testing a name defined again with another type..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    logger.setMetricsInterval(std::chrono::milliseconds(0));
+
+    size_t counter = Metrics::define("test_mismatch", EMetricType::COUNTER);
+    assert(counter != Metrics::kInvalidId);
+    assert(Metrics::define("test_mismatch", EMetricType::COUNTER) == counter);
+    assert(Metrics::define("test_mismatch", EMetricType::HISTOGRAM) == Metrics::kInvalidId);
+
+    // Updates through the invalid id are ignored; the counter keeps its type
+    ECLIPSE_COUNTER("test_mismatch", 2);
+    ECLIPSE_HISTOGRAM("test_mismatch", 1000);
+    Metrics::observe(Metrics::kInvalidId, 1);
+    Metrics::count(Metrics::kInvalidId, 1);
+    std::vector<MetricSummary> summaries = Metrics::snapshot();
+    const MetricSummary *mismatch = find(summaries, "test_mismatch");
+    assert(mismatch && mismatch->type == EMetricType::COUNTER);
+    assert(mismatch->count == 1 && mismatch->sum == 2);
+
+    std::cout << "✓ Type mismatch test passed" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Eclipse Logger Metrics Tests ===" << std::endl;
+
+    try
+    {
+        test_sharded_aggregates();
+        test_periodic_summaries();
+        test_type_mismatch();
+
+        std::cout << "\n🎉 All metrics tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
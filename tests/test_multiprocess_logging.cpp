@@ -0,0 +1,322 @@
+/**
+ * @file test_multiprocess_logging.cpp
+ * @brief Multi-process shared-memory logging tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Eclipse;
+
+namespace
+{
+    const std::string segment_name = "/eclipse_test_" + std::to_string(::getpid());
+
+    std::vector<std::string> read_lines(const std::string &path)
+    {
+        std::vector<std::string> lines;
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line))
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+}
+
+void test_shared_log_collects_all_processes()
+{
+    std::cout << "Testing shared-memory log with several processes..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string merged_log = "test_shared_merged.log";
+    std::filesystem::remove(merged_log);
+
+    bool started = logger.startCollector(segment_name, merged_log);
+    assert(started);
+
+    const int num_processes = 4;
+    const int logs_per_process = 200;
+
+    std::vector<pid_t> children;
+    for (int p = 0; p < num_processes; ++p)
+    {
+        pid_t pid = ::fork();
+        if (pid == 0)
+        {
+            Logger &child = Logger::getInstance();
+            child.setLevel(ELevel::ECLIPSE_DEBUG);
+            child.setOutputDestination(EOutput::FILE);
+            if (!child.attachSharedLog(segment_name))
+            {
+                ::_exit(1);
+            }
+            for (int i = 0; i < logs_per_process; ++i)
+            {
+                ECLIPSE_INFO("SHARED_TEST", "process=" + std::to_string(p) + " seq=" + std::to_string(i),
+                             "padding=" + std::string(64, 'x'));
+            }
+            child.detachSharedLog();
+            ::_exit(0);
+        }
+        assert(pid > 0);
+        children.push_back(pid);
+    }
+
+    for (pid_t pid : children)
+    {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    logger.stopCollector(true);
+
+    std::vector<std::string> lines = read_lines(merged_log);
+    int headers = 0;
+    std::vector<int> next_seq(num_processes, 0);
+    for (const auto &line : lines)
+    {
+        // Every line is either a record header or a continuation; torn writes would break this
+        assert(!line.empty() && (line[0] == '[' || line[0] == ' '));
+        size_t pos = line.find("process=");
+        if (pos == std::string::npos)
+        {
+            continue;
+        }
+        int process = std::stoi(line.substr(pos + 8));
+        int seq = std::stoi(line.substr(line.find("seq=", pos) + 4));
+        // Records of one process keep their order in the merged file
+        assert(seq == next_seq[process]);
+        next_seq[process] = seq + 1;
+        ++headers;
+    }
+
+    std::cout << "Collected " << headers << " records from " << num_processes << " processes" << std::endl;
+    assert(headers == num_processes * logs_per_process);
+
+    std::filesystem::remove(merged_log);
+    std::cout << "✓ Shared log collection test passed" << std::endl;
+}
+
+void test_attach_without_segment()
+{
+    std::cout << "Testing attach to a missing segment..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    bool attached = logger.attachSharedLog("/eclipse_missing_" + std::to_string(::getpid()));
+    assert(!attached);
+
+    std::cout << "✓ Missing segment test passed" << std::endl;
+}
+
+void test_collector_reports_drops()
+{
+    std::cout << "Testing shared ring overflow accounting..." << std::endl;
+
+    const std::string name = segment_name + "_small";
+    const std::string merged_log = "test_shared_drops.log";
+    std::filesystem::remove(merged_log);
+
+    SharedLogOptions options;
+    options.slotCount = 2;
+    options.slotBytes = 4096;
+    SharedLogCollector collector(name, merged_log, options);
+    bool opened = collector.open();
+    assert(opened);
+
+    std::unique_ptr<SharedLogWriter> writer = SharedLogWriter::attach(name);
+    assert(writer);
+
+    // Without polling the ring fills up and later writes are dropped, never blocked
+    int accepted = 0;
+    for (int i = 0; i < 200; ++i)
+    {
+        if (writer->write("record " + std::to_string(i) + "\n"))
+        {
+            ++accepted;
+        }
+    }
+    assert(accepted > 0 && accepted < 200);
+
+    size_t written = collector.poll();
+    assert(written == static_cast<size_t>(accepted) + 1);
+
+    std::ifstream file(merged_log);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    assert(content.find("dropped") != std::string::npos);
+
+    writer.reset();
+    collector.unlink();
+    std::filesystem::remove(merged_log);
+
+    std::cout << "Accepted " << accepted << " of 200 records before the ring filled" << std::endl;
+    std::cout << "✓ Shared ring overflow test passed" << std::endl;
+}
+
+void test_tail_observes_without_consuming()
+{
+    std::cout << "Testing read-only tail of a shared ring..." << std::endl;
+
+    const std::string name = segment_name + "_tail";
+    const std::string merged_log = "test_shared_tail.log";
+    std::filesystem::remove(merged_log);
+
+    SharedLogOptions options;
+    options.slotCount = 2;
+    options.slotBytes = 4096;
+    SharedLogCollector collector(name, merged_log, options);
+    bool opened = collector.open();
+    assert(opened);
+    std::unique_ptr<SharedLogWriter> writer = SharedLogWriter::attach(name);
+    assert(writer);
+    writer->write("before the tail\n");
+
+    // The tail starts at the end of every ring
+    std::unique_ptr<SharedLogTail> tail = SharedLogTail::attach(name);
+    assert(tail);
+    std::vector<SharedLogEntry> entries;
+    assert(tail->poll(entries) == 0);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        writer->write("record " + std::to_string(i) + "\n");
+    }
+    size_t seen = tail->poll(entries);
+    assert(seen == 5 && entries[0].text == "record 0\n" && entries[4].text == "record 4\n");
+    assert(entries[0].pid == static_cast<int32_t>(::getpid()) && entries[0].sequence < entries[4].sequence);
+
+    // The collector still gets everything
+    size_t written = collector.poll();
+    assert(written == 6);
+
+    // Records the collector drained first are skipped and counted, even after the ring wrapped
+    for (int round = 0; round < 20; ++round)
+    {
+        for (int i = 0; i < 20; ++i)
+        {
+            writer->write("round " + std::to_string(round) + " record " + std::to_string(i) + "\n");
+        }
+        collector.poll();
+    }
+    writer->write("after the collector\n");
+    entries.clear();
+    seen = tail->poll(entries);
+    assert(seen == 1 && entries[0].text == "after the collector\n");
+    assert(tail->getMissedBytes() > 4096);
+
+    tail.reset();
+    writer.reset();
+    collector.unlink();
+    std::filesystem::remove(merged_log);
+
+    std::cout << "✓ Shared ring tail test passed" << std::endl;
+}
+
+void test_atomic_append_without_collector()
+{
+    std::cout << "Testing O_APPEND record writes from several processes..." << std::endl;
+
+    const std::string shared_file = "test_atomic_append.log";
+    std::filesystem::remove(shared_file);
+
+    const int num_processes = 4;
+    const int logs_per_process = 200;
+
+    std::vector<pid_t> children;
+    for (int p = 0; p < num_processes; ++p)
+    {
+        pid_t pid = ::fork();
+        if (pid == 0)
+        {
+            Logger &child = Logger::getInstance();
+            child.setLevel(ELevel::ECLIPSE_DEBUG);
+            child.setLogFile(shared_file);
+            child.setOutputDestination(EOutput::FILE);
+            for (int i = 0; i < logs_per_process; ++i)
+            {
+                ECLIPSE_INFO("APPEND_TEST", "process=" + std::to_string(p) + " seq=" + std::to_string(i),
+                             "padding=" + std::string(512, 'y'), "more=" + std::string(512, 'z'));
+            }
+            child.closeLogFile();
+            ::_exit(0);
+        }
+        assert(pid > 0);
+        children.push_back(pid);
+    }
+
+    for (pid_t pid : children)
+    {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    // Each record is emitted with one write(), so records never interleave mid-way
+    std::vector<std::string> lines = read_lines(shared_file);
+    int headers = 0;
+    for (size_t i = 0; i < lines.size(); ++i)
+    {
+        size_t pos = lines[i].find("process=");
+        if (pos == std::string::npos)
+        {
+            continue;
+        }
+        assert(lines[i][0] == '[');
+        assert(i + 3 < lines.size());
+        assert(lines[i + 1].find("at: ") != std::string::npos);
+        assert(lines[i + 2].find("padding=") != std::string::npos);
+        assert(lines[i + 3].find("more=") != std::string::npos);
+        ++headers;
+    }
+
+    std::cout << "Found " << headers << " intact records in the shared file" << std::endl;
+    assert(headers == num_processes * logs_per_process);
+    assert(lines.size() == static_cast<size_t>(headers) * 4);
+
+    std::filesystem::remove(shared_file);
+    std::cout << "✓ Atomic append test passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        std::cout << "=== Eclipse Logger Multi-process Tests ===" << std::endl;
+        std::cout << "Testing shared-memory logging across processes..." << std::endl
+                  << std::endl;
+
+        test_shared_log_collects_all_processes();
+        test_attach_without_segment();
+        test_collector_reports_drops();
+        test_tail_observes_without_consuming();
+        test_atomic_append_without_collector();
+
+        std::cout << std::endl
+                  << "🎉 All multi-process tests passed successfully!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,248 @@
+/**
+ * @file test_prometheus_export.cpp
+ * @brief Logger statistics and Prometheus textfile export tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include "Eclipse/Prometheus.h"
+#include <iostream>
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <chrono>
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::ostringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    /**
+     * @brief Value of the sample with the given name and labels, or "" if absent
+     */
+    std::string sample(const std::string &text, const std::string &series)
+    {
+        std::istringstream lines(text);
+        std::string line;
+        while (std::getline(lines, line))
+        {
+            if (line.compare(0, series.size() + 1, series + " ") == 0)
+            {
+                return line.substr(series.size() + 1);
+            }
+        }
+        return "";
+    }
+}
+
+void test_logger_stats()
+{
+    std::cout << "Testing logger statistics..." << std::endl;
+
+    const std::string path = "test_prometheus_stats.log";
+    std::filesystem::remove(path);
+    Logger &logger = Logger::getInstance();
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setLogFile(path);
+
+    LoggerStats before = logger.getStats();
+    for (int i = 0; i < 10; ++i)
+    {
+        logger.log(ELevel::ECLIPSE_INFO, "Stats", "Info record", {}, "");
+    }
+    logger.log(ELevel::ECLIPSE_ERROR, "Stats", "Error record", {}, "");
+    LoggerStats after = logger.getStats();
+
+    assert(after.records[1] - before.records[1] == 10);
+    assert(after.records[3] - before.records[3] == 1);
+    assert(after.records[0] == before.records[0] && after.records[4] == before.records[4]);
+    assert(after.sinkWrites - before.sinkWrites == 11);
+    assert(after.sinkWriteTime > before.sinkWriteTime);
+    assert(std::accumulate(after.sinkLatency.begin(), after.sinkLatency.end(), uint64_t{0}) == after.sinkWrites);
+
+    // Buffered records are queued until the buffer is written
+    logger.setWriteMode(EWriteMode::THREAD_BUFFERED);
+    logger.log(ELevel::ECLIPSE_DEBUG, "Stats", "Buffered record", {}, "");
+    assert(logger.getStats().queuedBytes > 0);
+    logger.flush();
+    assert(logger.getStats().queuedBytes == 0);
+    logger.setWriteMode(EWriteMode::IMMEDIATE);
+
+    logger.closeLogFile();
+    std::filesystem::remove(path);
+    std::cout << "✓ Logger statistics test passed" << std::endl;
+}
+
+void test_prometheus_format()
+{
+    std::cout << "Testing the Prometheus text format..." << std::endl;
+
+    LoggerStats stats;
+    stats.records = {1, 2, 3, 4, 5};
+    stats.bufferDrops = 6;
+    stats.sinkWrites = 3;
+    stats.sinkWriteTime = std::chrono::microseconds(1500);
+    stats.sinkLatency[0] = 2;
+    stats.sinkLatency[4] = 1;
+
+    MetricSummary jobs;
+    jobs.name = "jobs.done-total";
+    jobs.count = 2;
+    jobs.sum = 7;
+    MetricSummary size;
+    size.name = "batch_size";
+    size.type = EMetricType::HISTOGRAM;
+    size.count = 4;
+    size.sum = 100;
+    size.p50 = 20;
+    size.p90 = 40;
+    size.p99 = 41;
+    MetricSummary idle;
+    idle.name = "9idle";
+    idle.type = EMetricType::HISTOGRAM;
+    MetricSummary requests;
+    requests.name = "requests";
+    requests.sum = 11;
+
+    // Names that only differ in replaced characters, or in a series of another metric
+    MetricSummary sizeClash = size;
+    sizeClash.name = "batch-size";
+    sizeClash.sum = 999;
+    MetricSummary countClash;
+    countClash.name = "batch_size_count";
+    countClash.type = EMetricType::HISTOGRAM;
+    countClash.count = 1;
+    countClash.sum = 999;
+    MetricSummary totalClash;
+    totalClash.name = "requests_total";
+    totalClash.sum = 999;
+
+    std::string text = formatPrometheus(stats, {jobs, size, idle, requests, sizeClash, countClash, totalClash});
+    assert(sample(text, "eclipse_records_total{level=\"warn\"}") == "3");
+    assert(sample(text, "eclipse_dropped_records_total{reason=\"front_full\"}") == "6");
+    assert(text.find("# TYPE eclipse_sink_write_seconds histogram\n") != std::string::npos);
+    assert(sample(text, "eclipse_sink_write_seconds_bucket{le=\"1e-05\"}") == "2");
+    assert(sample(text, "eclipse_sink_write_seconds_bucket{le=\"0.001\"}") == "3");
+    assert(sample(text, "eclipse_sink_write_seconds_bucket{le=\"+Inf\"}") == "3");
+    assert(sample(text, "eclipse_sink_write_seconds_sum") == "0.0015");
+    assert(sample(text, "eclipse_sink_write_seconds_count") == "3");
+
+    // Metric names are prefixed and made valid; counters end in _total, histograms become summaries
+    assert(text.find("# TYPE eclipse_user_jobs_done_total counter\n") != std::string::npos);
+    assert(sample(text, "eclipse_user_jobs_done_total") == "7");
+    assert(sample(text, "eclipse_user_requests_total") == "11");
+    assert(sample(text, "eclipse_user_batch_size{quantile=\"0.99\"}") == "41");
+    assert(sample(text, "eclipse_user_batch_size_sum") == "100");
+    assert(sample(text, "eclipse_user_batch_size_count") == "4");
+    assert(sample(text, "eclipse_user_9idle{quantile=\"0.5\"}") == "NaN");
+
+    // Colliding names are exported once, by the first metric
+    assert(text.find("999") == std::string::npos);
+    assert(text.find("# TYPE eclipse_user_batch_size_count") == std::string::npos);
+    assert(text.find("# Skipped a metric also exported as eclipse_user_batch_size\n") != std::string::npos);
+    assert(text.find("# Skipped a metric also exported as eclipse_user_requests_total\n") != std::string::npos);
+    std::istringstream families(text);
+    std::string family;
+    std::set<std::string> types;
+    while (std::getline(families, family))
+    {
+        if (family.compare(0, 7, "# TYPE ") == 0)
+        {
+            assert(types.insert(family.substr(7, family.find(' ', 7) - 7)).second);
+        }
+    }
+
+    // Every line is a comment or a sample
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        assert(!line.empty() && (line[0] == '#' || line.find(' ') != std::string::npos));
+    }
+
+    std::cout << "✓ Prometheus format test passed" << std::endl;
+}
+
+void test_textfile_export()
+{
+    std::cout << "Testing the periodic textfile export..." << std::endl;
+
+    const std::string logPath = "test_prometheus_export.log";
+    const std::string promPath = "test_prometheus_export.prom";
+    std::filesystem::remove(logPath);
+    std::filesystem::remove(promPath);
+    Logger &logger = Logger::getInstance();
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setLogFile(logPath);
+    logger.setMetricsInterval(std::chrono::milliseconds(0));
+
+    ECLIPSE_COUNTER("test_exported_jobs", 3);
+    ECLIPSE_HISTOGRAM("test_exported_size", 8);
+
+    // The first file is written before the call returns
+    bool exporting = logger.setPrometheusExport(promPath, std::chrono::milliseconds(50));
+    assert(exporting);
+    std::string text = read_file(promPath);
+    assert(sample(text, "eclipse_user_test_exported_jobs_total") == "3");
+    assert(sample(text, "eclipse_user_test_exported_size{quantile=\"0.5\"}") == "8");
+    std::string infoBefore = sample(text, "eclipse_records_total{level=\"info\"}");
+    assert(!infoBefore.empty());
+
+    // Later files follow the counters
+    ECLIPSE_COUNTER("test_exported_jobs", 4);
+    logger.log(ELevel::ECLIPSE_INFO, "Export", "Counted record", {}, "");
+    std::string jobs;
+    for (int i = 0; i < 100 && jobs != "7"; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        jobs = sample(read_file(promPath), "eclipse_user_test_exported_jobs_total");
+    }
+    assert(jobs == "7");
+    text = read_file(promPath);
+    assert(std::stoull(sample(text, "eclipse_records_total{level=\"info\"}")) > std::stoull(infoBefore));
+    assert(!std::filesystem::exists(promPath + ".tmp"));
+
+    // A file that cannot be written stops the export
+    assert(!logger.setPrometheusExport("test_prometheus_missing_dir/app.prom"));
+    assert(logger.setPrometheusExport(""));
+
+    logger.closeLogFile();
+    std::filesystem::remove(logPath);
+    std::filesystem::remove(promPath);
+    std::cout << "✓ Textfile export test passed" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Eclipse Logger Prometheus Export Tests ===" << std::endl;
+
+    try
+    {
+        test_logger_stats();
+        test_prometheus_format();
+        test_textfile_export();
+
+        std::cout << "\n🎉 All Prometheus export tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
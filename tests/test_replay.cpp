@@ -0,0 +1,173 @@
+/**
+ * @file test_replay.cpp
+ * @brief Log replay tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/RecordReader.h"
+#include "Eclipse/Replay.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <chrono>
+
+using namespace Eclipse;
+
+namespace
+{
+    const char *const kTags[] = {"HTTP", "DB", "CACHE"};
+
+    /**
+     * @brief Capture records the given interval apart
+     */
+    void capture(const std::string &path, int count, std::chrono::milliseconds interval)
+    {
+        Logger &logger = Logger::getInstance();
+        logger.setClockSource(EClockSource::MANUAL);
+        logger.setManualTime(std::chrono::system_clock::time_point(std::chrono::hours(24 * 365 * 50)));
+        logger.setOutputDestination(EOutput::FILE);
+        logger.setFileFormat(EFileFormat::BINARY);
+        logger.setLogFile(path);
+        for (int i = 0; i < count; ++i)
+        {
+            logger.log(static_cast<ELevel>(i % 5), kTags[i % 3], "Request served",
+                       {"request_id=" + std::to_string(i), "user=u" + std::to_string(i % 7)},
+                       i % 2 ? "server.cpp:42 [handle]" : "");
+            logger.advanceManualTime(interval);
+        }
+        logger.closeLogFile();
+        logger.setClockSource(EClockSource::REALTIME);
+    }
+
+    std::vector<BinaryRecord> read_records(const std::string &path)
+    {
+        RecordReader reader;
+        bool opened = reader.open(path);
+        assert(opened);
+        std::vector<BinaryRecord> records;
+        BinaryRecord record;
+        while (reader.next(record))
+        {
+            records.push_back(record);
+        }
+        // Threads interleave; the request id orders them again
+        std::sort(records.begin(), records.end(), [](const BinaryRecord &a, const BinaryRecord &b)
+                  { return std::stoi(a.details[0].substr(11)) < std::stoi(b.details[0].substr(11)); });
+        return records;
+    }
+}
+
+void test_replay_flat_out()
+{
+    std::cout << "Testing a replay as fast as possible on several threads..." << std::endl;
+
+    const std::string captured = "test_replay_capture.bin";
+    const std::string replayed = "test_replay_output.bin";
+    std::filesystem::remove(captured);
+    std::filesystem::remove(replayed);
+    capture(captured, 4000, std::chrono::milliseconds(1));
+
+    LogReplayer replayer;
+    bool loaded = replayer.load(captured);
+    assert(loaded);
+    assert(replayer.getRecordCount() == 4000);
+    assert(!replayer.load("test_replay_missing.bin"));
+
+    Logger &logger = Logger::getInstance();
+    logger.setFileFormat(EFileFormat::BINARY);
+    logger.setWriteMode(EWriteMode::THREAD_BUFFERED);
+    logger.setLogFile(replayed);
+    ReplayOptions options;
+    options.speed = 0;
+    options.threads = 4;
+    ReplayStats stats = replayer.run(logger, options);
+    logger.closeLogFile();
+    logger.setWriteMode(EWriteMode::IMMEDIATE);
+    logger.setFileFormat(EFileFormat::TEXT);
+
+    // The captured four seconds take far less without pacing
+    assert(stats.records == 4000);
+    assert(stats.totalTime >= stats.callsTime && stats.totalTime < std::chrono::seconds(4));
+    assert(stats.latencyP50 <= stats.latencyP99 && stats.latencyP99 <= stats.latencyP999 &&
+           stats.latencyP999 <= stats.latencyMax);
+    assert(stats.lagMax.count() == 0);
+
+    // Every record arrives once, with all of its fields
+    std::vector<BinaryRecord> original = read_records(captured);
+    std::vector<BinaryRecord> copy = read_records(replayed);
+    assert(copy.size() == original.size());
+    for (size_t i = 0; i < copy.size(); ++i)
+    {
+        assert(copy[i].level == original[i].level && copy[i].tag == original[i].tag &&
+               copy[i].msg == original[i].msg && copy[i].details == original[i].details &&
+               copy[i].trace == original[i].trace);
+    }
+
+    std::cout << "  " << stats.records * 1000000000ull / static_cast<uint64_t>(stats.totalTime.count())
+              << " records/s, p99 log() " << stats.latencyP99.count() << " ns" << std::endl;
+    std::filesystem::remove(captured);
+    std::filesystem::remove(replayed);
+    std::cout << "✓ Flat-out replay test passed" << std::endl;
+}
+
+void test_replay_keeps_pace()
+{
+    std::cout << "Testing a replay at a multiple of the captured pace..." << std::endl;
+
+    const std::string captured = "test_replay_paced.bin";
+    const std::string replayed = "test_replay_paced.log";
+    std::filesystem::remove(captured);
+    std::filesystem::remove(replayed);
+    // 50 records over 980 ms
+    capture(captured, 50, std::chrono::milliseconds(20));
+
+    LogReplayer replayer;
+    bool loaded = replayer.load(captured);
+    assert(loaded);
+
+    Logger &logger = Logger::getInstance();
+    logger.setLogFile(replayed);
+    ReplayOptions options;
+    options.speed = 4;
+    options.threads = 2;
+    ReplayStats stats = replayer.run(logger, options);
+    logger.closeLogFile();
+
+    // Four times as fast: the last record is due after 245 ms
+    assert(stats.records == 50);
+    assert(stats.callsTime >= std::chrono::milliseconds(245));
+    assert(stats.callsTime < std::chrono::milliseconds(900));
+    assert(stats.lagP99 <= stats.lagMax);
+    assert(read_records(replayed).size() == 50);
+
+    std::cout << "  " << std::chrono::duration_cast<std::chrono::milliseconds>(stats.callsTime).count()
+              << " ms, latest call " << std::chrono::duration_cast<std::chrono::microseconds>(stats.lagMax).count()
+              << " us behind" << std::endl;
+    std::filesystem::remove(captured);
+    std::filesystem::remove(replayed);
+    std::cout << "✓ Paced replay test passed" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Eclipse Logger Replay Tests ===" << std::endl;
+
+    try
+    {
+        test_replay_flat_out();
+        test_replay_keeps_pace();
+
+        std::cout << "\n🎉 All replay tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,195 @@
+/**
+ * @file test_search_index.cpp
+ * @brief Inverted search index tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include "Eclipse/SearchIndex.h"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace Eclipse;
+
+namespace
+{
+    const char *const kTags[] = {"HTTP", "DB", "CACHE", "AUTH"};
+
+    void log_records(EFileFormat format, const std::string &path, int count)
+    {
+        Logger &logger = Logger::getInstance();
+        logger.setOutputDestination(EOutput::FILE);
+        logger.setFileFormat(format);
+        logger.setLogFile(path);
+        for (int i = 0; i < count; ++i)
+        {
+            ECLIPSE_INFO(kTags[i % 4], "Request served", "request_id=req-" + std::to_string(i),
+                         "user=u" + std::to_string(i % 50), "latency_us=" + std::to_string(i * 37 % 5000));
+        }
+        logger.closeLogFile();
+        logger.setFileFormat(EFileFormat::TEXT);
+    }
+
+    bool same_records(const std::vector<BinaryRecord> &a, const std::vector<BinaryRecord> &b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].tag != b[i].tag || a[i].msg != b[i].msg || a[i].details != b[i].details)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+void test_search_reads_matching_blocks()
+{
+    std::cout << "Testing indexed searches in every file format..." << std::endl;
+
+    const struct
+    {
+        EFileFormat format;
+        const char *path;
+    } cases[] = {
+        {EFileFormat::TEXT, "test_search_index.log"},
+        {EFileFormat::FRAMED, "test_search_index_framed.log"},
+        {EFileFormat::BINARY, "test_search_index.bin"},
+    };
+
+    for (const auto &c : cases)
+    {
+        std::filesystem::remove(c.path);
+        log_records(c.format, c.path, 6000);
+
+        SearchIndex index;
+        bool built = index.build(c.path, {"request_id", "user"});
+        assert(built);
+        assert(index.getRecordCount() == 6000);
+        assert(index.getBlocks().size() > 4);
+        // Four tags, fifty users and a request id per record
+        assert(index.getTermCount() == 4 + 50 + 6000);
+
+        // One record, in one block
+        std::vector<BinaryRecord> found;
+        bool searched = index.search(c.path, {"request_id=req-4321"}, found);
+        assert(searched);
+        assert(found.size() == 1 && found[0].details[0] == "request_id=req-4321" && found[0].tag == "DB");
+        assert(index.getBlocksRead() == 1);
+
+        // Terms combine; the result is what a full scan finds
+        const std::vector<std::string> terms = {"tag=DB", "user=u13"};
+        std::vector<BinaryRecord> scanned;
+        found.clear();
+        SearchIndex::scan(c.path, terms, scanned);
+        index.search(c.path, terms, found);
+        assert(!found.empty() && same_records(found, scanned));
+        std::cout << "  " << index.getBlocks().size() << " block(s), " << index.getBlocksRead()
+                  << " read for " << found.size() << " record(s)" << std::endl;
+
+        // Unknown terms read nothing; unindexed keys read everything but still filter
+        found.clear();
+        index.search(c.path, {"request_id=missing"}, found);
+        assert(found.empty() && index.getBlocksRead() == 0);
+        scanned.clear();
+        SearchIndex::scan(c.path, {"latency_us=37"}, scanned);
+        index.search(c.path, {"latency_us=37"}, found);
+        assert(same_records(found, scanned) && found.size() == 6000 / 5000 + 1);
+        assert(index.getBlocksRead() == index.getBlocks().size());
+
+        std::filesystem::remove(c.path);
+    }
+    std::cout << "✓ Indexed search test passed" << std::endl;
+}
+
+void test_index_file()
+{
+    std::cout << "Testing index files..." << std::endl;
+
+    const std::string path = "test_search_index_file.bin";
+    const std::string indexPath = SearchIndex::getIndexPath(path);
+    std::filesystem::remove(path);
+    log_records(EFileFormat::BINARY, path, 3000);
+
+    SearchIndex built;
+    bool ok = built.build(path, {});
+    assert(ok);
+    // Without selected keys every key=value detail is indexed
+    assert(built.getFields().empty());
+    assert(built.getTermCount() > 3000 + 50);
+    ok = built.save(indexPath);
+    assert(ok);
+    std::cout << "  " << std::filesystem::file_size(path) << " log bytes, " << std::filesystem::file_size(indexPath)
+              << " index bytes" << std::endl;
+
+    SearchIndex loaded;
+    ok = loaded.load(indexPath);
+    assert(ok);
+    assert(loaded.isCurrent(path));
+    assert(loaded.getTermCount() == built.getTermCount() && loaded.getRecordCount() == 3000);
+    assert(loaded.getBlocks().size() == built.getBlocks().size());
+    for (size_t i = 0; i < loaded.getBlocks().size(); ++i)
+    {
+        assert(loaded.getBlocks()[i].offset == built.getBlocks()[i].offset);
+        assert(loaded.getBlocks()[i].start == built.getBlocks()[i].start);
+    }
+    std::vector<BinaryRecord> found;
+    loaded.search(path, {"user=u7", "latency_us=259"}, found);
+    assert(found.size() == 1 && found[0].details[0] == "request_id=req-7");
+
+    // A damaged index is rejected
+    std::string content;
+    {
+        std::ifstream file(indexPath, std::ios::binary);
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        content = buffer.str();
+    }
+    content[content.size() / 2] ^= 0x10;
+    {
+        std::ofstream file(indexPath, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+    assert(!loaded.load(indexPath));
+
+    // A file that grew since it was indexed is no longer described by its index
+    built.save(indexPath);
+    log_records(EFileFormat::BINARY, path, 10);
+    ok = loaded.load(indexPath);
+    assert(ok);
+    assert(!loaded.isCurrent(path));
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(indexPath);
+    std::cout << "✓ Index file test passed" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Eclipse Logger Search Index Tests ===" << std::endl;
+
+    try
+    {
+        test_search_reads_matching_blocks();
+        test_index_file();
+
+        std::cout << "\n🎉 All search index tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
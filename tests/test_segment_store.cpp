@@ -0,0 +1,418 @@
+/**
+ * @file test_segment_store.cpp
+ * @brief Segmented log directory tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include "Eclipse/SegmentStore.h"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    std::string read_segments(const std::string &directory)
+    {
+        std::vector<SegmentInfo> segments;
+        bool listed = SegmentStore::readManifest(directory, segments);
+        assert(listed);
+        std::string content;
+        for (const SegmentInfo &segment : segments)
+        {
+            content += read_file((std::filesystem::path(directory) / segment.name).string());
+        }
+        return content;
+    }
+
+    uint64_t total_bytes(const std::vector<SegmentInfo> &segments)
+    {
+        uint64_t total = 0;
+        for (const SegmentInfo &segment : segments)
+        {
+            total += segment.bytes;
+        }
+        return total;
+    }
+
+    std::string record(int index)
+    {
+        return "segment record " + std::to_string(1000 + index) + std::string(80, '.') + "\n";
+    }
+}
+
+void test_segments_roll_by_size()
+{
+    std::cout << "Testing segments roll over by size..." << std::endl;
+
+    const std::string directory = "test_segments_roll";
+    std::filesystem::remove_all(directory);
+
+    FileSink sink;
+    SegmentStore store(sink);
+    SegmentOptions options;
+    options.segmentBytes = 1000;
+    bool opened = store.open(directory, options);
+    assert(opened);
+
+    std::string expected;
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string line = record(i);
+        bool written = store.write(line.data(), line.size());
+        assert(written);
+        expected += line;
+    }
+
+    std::vector<SegmentInfo> segments = store.getSegments();
+    assert(segments.size() >= 10);
+    assert(segments.back().open);
+    for (size_t i = 0; i + 1 < segments.size(); ++i)
+    {
+        // Consecutive sequence ranges, no segment over the cap, names in order
+        assert(segments[i + 1].firstSequence == segments[i].firstSequence + segments[i].writes);
+        assert(segments[i].bytes <= options.segmentBytes);
+        assert(segments[i].name < segments[i + 1].name);
+        assert(!segments[i].open);
+    }
+    assert(segments.front().firstSequence == 0);
+    assert(segments.front().name.compare(0, 17, "0000000000000000-") == 0);
+
+    store.close();
+    assert(!store.isOpen());
+    assert(read_segments(directory) == expected);
+
+    // The manifest records the final state
+    std::vector<SegmentInfo> listed;
+    bool read = SegmentStore::readManifest(directory, listed);
+    assert(read);
+    assert(listed.size() == segments.size());
+    assert(!listed.back().open);
+    assert(total_bytes(listed) == expected.size());
+
+    std::filesystem::remove_all(directory);
+    std::cout << "✓ Segment roll-over test passed" << std::endl;
+}
+
+void test_retention_limits()
+{
+    std::cout << "Testing retention by size and age..." << std::endl;
+
+    const std::string directory = "test_segments_retention";
+    std::filesystem::remove_all(directory);
+
+    FileSink sink;
+    SegmentStore store(sink);
+    SegmentOptions options;
+    options.segmentBytes = 1000;
+    options.maxTotalBytes = 3000;
+    options.maxAge = std::chrono::seconds(1);
+    bool opened = store.open(directory, options);
+    assert(opened);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string line = record(i);
+        store.write(line.data(), line.size());
+    }
+    size_t before = store.getSegments().size();
+    size_t deleted = store.enforceRetention();
+    std::vector<SegmentInfo> kept = store.getSegments();
+    assert(deleted > 0);
+    assert(kept.size() == before - deleted);
+    assert(total_bytes(kept) <= options.maxTotalBytes);
+    // The newest records survive; deleted files are gone from disk and manifest
+    assert(kept.back().firstSequence + kept.back().writes == 100);
+    std::vector<SegmentInfo> listed;
+    SegmentStore::readManifest(directory, listed);
+    assert(listed.size() == kept.size());
+    size_t files = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(directory))
+    {
+        files += entry.path().extension() == ".log" ? 1 : 0;
+    }
+    assert(files == kept.size());
+
+    // Once every finished segment is older than maxAge only the current one is left
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    store.enforceRetention();
+    kept = store.getSegments();
+    assert(kept.size() == 1);
+    assert(kept.back().open);
+
+    store.close();
+    std::filesystem::remove_all(directory);
+    std::cout << "✓ Retention test passed" << std::endl;
+}
+
+void test_reopen_after_crash()
+{
+    std::cout << "Testing reopening a directory after a crash..." << std::endl;
+
+    const std::string directory = "test_segments_crash";
+    std::filesystem::remove_all(directory);
+
+    FileSink sink;
+    {
+        SegmentStore store(sink);
+        bool opened = store.open(directory);
+        assert(opened);
+        for (int i = 0; i < 10; ++i)
+        {
+            std::string line = record(i);
+            store.write(line.data(), line.size());
+        }
+        // Simulates a crash: the open segment is never finished
+        store.release();
+    }
+
+    // A segment file whose manifest update was lost
+    const std::string orphan = "0000000000000500-20250101T000000Z.log";
+    {
+        std::ofstream file((std::filesystem::path(directory) / orphan).string(), std::ios::binary);
+        file << record(500);
+    }
+
+    SegmentStore store(sink);
+    bool opened = store.open(directory);
+    assert(opened);
+    std::vector<SegmentInfo> segments = store.getSegments();
+    assert(segments.size() == 3);
+    assert(!segments[0].open);
+    assert(segments[0].bytes == 10 * record(0).size());
+    assert(segments[1].name == orphan);
+    assert(segments[2].open);
+    assert(segments[2].firstSequence == 501);
+
+    std::string line = record(501);
+    store.write(line.data(), line.size());
+    store.close();
+    assert(read_segments(directory) == [] {
+        std::string all;
+        for (int i = 0; i < 10; ++i)
+        {
+            all += record(i);
+        }
+        return all + record(500) + record(501);
+    }());
+
+    std::filesystem::remove_all(directory);
+    std::cout << "✓ Reopen after crash test passed" << std::endl;
+}
+
+void test_find_segments_by_time()
+{
+    std::cout << "Testing segment lookup by time range..." << std::endl;
+
+    const std::string directory = "test_segments_time";
+    std::filesystem::remove_all(directory);
+
+    FileSink sink;
+    SegmentStore store(sink);
+    SegmentOptions options;
+    options.segmentBytes = 500;
+    bool opened = store.open(directory, options);
+    assert(opened);
+
+    auto start = std::chrono::system_clock::now();
+    for (int i = 0; i < 10; ++i)
+    {
+        std::string line = record(i);
+        store.write(line.data(), line.size());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto middle = std::chrono::system_clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    for (int i = 10; i < 20; ++i)
+    {
+        std::string line = record(i);
+        store.write(line.data(), line.size());
+    }
+    store.close();
+
+    std::vector<SegmentInfo> all = SegmentStore::findSegments(directory, start - std::chrono::seconds(1),
+                                                               std::chrono::system_clock::now());
+    std::vector<SegmentInfo> later = SegmentStore::findSegments(directory, middle, std::chrono::system_clock::now());
+    std::vector<SegmentInfo> before = SegmentStore::findSegments(directory, start - std::chrono::hours(2),
+                                                                  start - std::chrono::hours(1));
+    assert(all.size() >= 4);
+    assert(!later.empty() && later.size() < all.size());
+    assert(later.front().firstSequence >= 5 && later.back().firstSequence + later.back().writes == 20);
+    assert(before.empty());
+
+    std::filesystem::remove_all(directory);
+    std::cout << "✓ Segment lookup by time test passed" << std::endl;
+}
+
+void test_logger_segment_directory()
+{
+    std::cout << "Testing logger output to a segment directory..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string directory = "test_segments_logger";
+    std::filesystem::remove_all(directory);
+
+    SegmentOptions options;
+    options.segmentBytes = 4096;
+    options.maxTotalBytes = 16384;
+    logger.setOutputDestination(EOutput::FILE);
+    bool opened = logger.setLogDirectory(directory, options);
+    assert(opened);
+
+    for (int i = 0; i < 400; ++i)
+    {
+        ECLIPSE_INFO("SEGMENT", "Segmented record", i);
+    }
+
+    // The backend enforces retention once a second
+    std::vector<SegmentInfo> segments;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    do
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        SegmentStore::readManifest(directory, segments);
+    } while (total_bytes(segments) > options.maxTotalBytes && std::chrono::steady_clock::now() < deadline);
+    assert(total_bytes(segments) <= options.maxTotalBytes);
+    assert(segments.size() >= 2);
+
+    logger.closeLogFile();
+    std::string content = read_segments(directory);
+    assert(content.find("Segmented record") != std::string::npos);
+    assert(content.find("] 399\n") != std::string::npos);
+    assert(content.find("] 0\n") == std::string::npos);
+
+    std::filesystem::remove_all(directory);
+    std::cout << "✓ Logger segment directory test passed" << std::endl;
+}
+
+void test_binary_segment_size()
+{
+    std::cout << "Testing BINARY segments fill up to their size..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string directory = "test_segments_binary";
+    std::filesystem::remove_all(directory);
+
+    SegmentOptions options;
+    options.segmentBytes = 64 * 1024;
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setFileFormat(EFileFormat::BINARY);
+    bool opened = logger.setLogDirectory(directory, options);
+    assert(opened);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        ECLIPSE_INFO("SEGMENT", "Binary segmented record", i, "user=" + std::to_string(i % 97));
+    }
+    logger.closeLogFile();
+    logger.setFileFormat(EFileFormat::TEXT);
+
+    // Encoded records are much smaller than their text; the size counts what is on disk,
+    // estimated ahead of each write, so allow a record's worth of overshoot
+    std::vector<SegmentInfo> segments;
+    bool listed = SegmentStore::readManifest(directory, segments);
+    assert(listed);
+    assert(segments.size() >= 2);
+    for (size_t i = 0; i + 1 < segments.size(); ++i)
+    {
+        uint64_t actual = std::filesystem::file_size(std::filesystem::path(directory) / segments[i].name);
+        assert(segments[i].bytes == actual);
+        assert(actual <= options.segmentBytes + 128 && actual > options.segmentBytes * 9 / 10);
+    }
+
+    std::filesystem::remove_all(directory);
+    std::cout << "✓ BINARY segment size test passed" << std::endl;
+}
+
+#ifndef _WIN32
+void test_fork_uses_own_directory()
+{
+    std::cout << "Testing fork with a segment directory..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string directory = "test_segments_fork";
+    std::filesystem::remove_all(directory);
+
+    logger.setOutputDestination(EOutput::FILE);
+    bool opened = logger.setLogDirectory(directory);
+    assert(opened);
+    ECLIPSE_INFO("SEGMENT", "Parent before fork");
+
+    pid_t pid = ::fork();
+    assert(pid >= 0);
+    if (pid == 0)
+    {
+        ECLIPSE_INFO("SEGMENT", "Child record");
+        Logger::getInstance().closeLogFile();
+        ::_exit(0);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    ECLIPSE_INFO("SEGMENT", "Parent after fork");
+    logger.closeLogFile();
+
+    const std::string childDirectory = directory + "." + std::to_string(pid);
+    std::string parent = read_segments(directory);
+    std::string child = read_segments(childDirectory);
+    assert(parent.find("Parent before fork") != std::string::npos);
+    assert(parent.find("Parent after fork") != std::string::npos);
+    assert(parent.find("Child record") == std::string::npos);
+    assert(child.find("Child record") != std::string::npos);
+    assert(child.find("Parent") == std::string::npos);
+
+    std::filesystem::remove_all(directory);
+    std::filesystem::remove_all(childDirectory);
+    std::cout << "✓ Fork with segment directory test passed" << std::endl;
+}
+#endif
+
+int main()
+{
+    std::cout << "=== Eclipse Logger Segment Directory Tests ===" << std::endl;
+
+    try
+    {
+        test_segments_roll_by_size();
+        test_retention_limits();
+        test_reopen_after_crash();
+        test_find_segments_by_time();
+        test_logger_segment_directory();
+        test_binary_segment_size();
+#ifndef _WIN32
+        test_fork_uses_own_directory();
+#endif
+
+        std::cout << "\n🎉 All segment directory tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
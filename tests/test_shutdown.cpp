@@ -0,0 +1,250 @@
+/**
+ * @file test_shutdown.cpp
+ * @brief Shutdown and static-destruction tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    int count_occurrences(const std::string &content, const std::string &needle)
+    {
+        int count = 0;
+        for (size_t pos = content.find(needle); pos != std::string::npos; pos = content.find(needle, pos + 1))
+        {
+            ++count;
+        }
+        return count;
+    }
+
+    int wait_child(pid_t pid)
+    {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    }
+
+    /**
+     * @brief Global whose destructor logs after the exit-time shutdown has run
+     *
+     * Constructed before main(), so it is destroyed after the atexit handler the
+     * logger registers on first use.
+     */
+    struct LateLogger
+    {
+        bool armed = false;
+        ~LateLogger()
+        {
+            if (armed)
+            {
+                ECLIPSE_INFO("SHUTDOWN_TEST", "Logged from a static destructor");
+            }
+        }
+    } late_logger;
+}
+
+void test_exit_drains_shared_log()
+{
+    std::cout << "Testing that exit() drains the embedded collector..." << std::endl;
+
+    const std::string segment = "/eclipse_exit_" + std::to_string(::getpid());
+    const std::string merged_log = "test_shutdown_merged.log";
+    std::filesystem::remove(merged_log);
+
+    const int num_records = 500;
+    pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        Logger &logger = Logger::getInstance();
+        logger.setLevel(ELevel::ECLIPSE_DEBUG);
+        logger.setOutputDestination(EOutput::FILE);
+        if (!logger.startCollector(segment, merged_log) || !logger.attachSharedLog(segment))
+        {
+            ::_exit(1);
+        }
+        for (int i = 0; i < num_records; ++i)
+        {
+            ECLIPSE_INFO("SHUTDOWN_TEST", "Queued record " + std::to_string(i));
+        }
+        // No explicit stop: the atexit hook has to drain the collector
+        std::exit(0);
+    }
+    assert(pid > 0);
+    int status = wait_child(pid);
+    assert(status == 0);
+
+    std::string content = read_file(merged_log);
+    int records = count_occurrences(content, "Queued record");
+    std::cout << "Found " << records << " of " << num_records << " records after exit" << std::endl;
+    assert(records == num_records);
+
+    ::shm_unlink(segment.c_str());
+    std::filesystem::remove(merged_log);
+    std::cout << "✓ Exit drain test passed" << std::endl;
+}
+
+void test_logging_from_static_destructor()
+{
+    std::cout << "Testing logging from a static destructor after shutdown..." << std::endl;
+
+    const std::string test_log_file = "test_shutdown_static.log";
+    std::filesystem::remove(test_log_file);
+
+    pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        Logger &logger = Logger::getInstance();
+        logger.setLevel(ELevel::ECLIPSE_DEBUG);
+        logger.setLogFile(test_log_file);
+        logger.setOutputDestination(EOutput::FILE);
+        ECLIPSE_INFO("SHUTDOWN_TEST", "Logged before exit");
+        late_logger.armed = true;
+        std::exit(0);
+    }
+    assert(pid > 0);
+    int status = wait_child(pid);
+    assert(status == 0);
+
+    std::string content = read_file(test_log_file);
+    assert(content.find("Logged before exit") != std::string::npos);
+    assert(content.find("Logged from a static destructor") != std::string::npos);
+
+    std::filesystem::remove(test_log_file);
+    std::cout << "✓ Static destructor logging test passed" << std::endl;
+}
+
+void test_explicit_shutdown()
+{
+    std::cout << "Testing explicit shutdown and direct writes afterwards..." << std::endl;
+
+    const std::string test_log_file = "test_shutdown_explicit.log";
+    std::filesystem::remove(test_log_file);
+
+    pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        Logger &logger = Logger::getInstance();
+        logger.setLevel(ELevel::ECLIPSE_DEBUG);
+        logger.setLogFile(test_log_file);
+        logger.setOutputDestination(EOutput::FILE);
+        ECLIPSE_INFO("SHUTDOWN_TEST", "Before shutdown");
+
+        logger.shutdown(std::chrono::milliseconds(200));
+        logger.shutdown(); // Second call is a no-op
+        if (!logger.isShutdown())
+        {
+            ::_exit(1);
+        }
+
+        ECLIPSE_WARNING("SHUTDOWN_TEST", "After shutdown");
+        ::_exit(0);
+    }
+    assert(pid > 0);
+    int status = wait_child(pid);
+    assert(status == 0);
+
+    std::string content = read_file(test_log_file);
+    assert(content.find("Before shutdown") != std::string::npos);
+    assert(content.find("After shutdown") != std::string::npos);
+
+    std::filesystem::remove(test_log_file);
+    std::cout << "✓ Explicit shutdown test passed" << std::endl;
+}
+
+void test_segmented_shutdown()
+{
+    std::cout << "Testing direct writes to a segment directory after shutdown..." << std::endl;
+
+    const std::string directory = "test_shutdown_segments";
+    std::filesystem::remove_all(directory);
+
+    pid_t pid = ::fork();
+    if (pid == 0)
+    {
+        Logger &logger = Logger::getInstance();
+        logger.setLevel(ELevel::ECLIPSE_DEBUG);
+        if (!logger.setLogDirectory(directory))
+        {
+            ::_exit(1);
+        }
+        logger.setOutputDestination(EOutput::FILE);
+        ECLIPSE_INFO("SHUTDOWN_TEST", "Segment before shutdown");
+
+        logger.shutdown();
+        ECLIPSE_WARNING("SHUTDOWN_TEST", "Segment after shutdown");
+        ::_exit(0);
+    }
+    assert(pid > 0);
+    int status = wait_child(pid);
+    assert(status == 0);
+
+    // Both records end up in the one segment, in order
+    std::string content;
+    int segments = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(directory))
+    {
+        if (entry.path().extension() == ".log")
+        {
+            content += read_file(entry.path().string());
+            ++segments;
+        }
+    }
+    assert(segments == 1);
+    size_t before = content.find("Segment before shutdown");
+    size_t after = content.find("Segment after shutdown");
+    assert(before != std::string::npos && after != std::string::npos && before < after);
+
+    std::filesystem::remove_all(directory);
+    std::cout << "✓ Segmented shutdown test passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        std::cout << "=== Eclipse Logger Shutdown Tests ===" << std::endl;
+        std::cout << "Testing draining and static-destruction safety..." << std::endl
+                  << std::endl;
+
+        test_exit_drains_shared_log();
+        test_logging_from_static_destructor();
+        test_explicit_shutdown();
+        test_segmented_shutdown();
+
+        std::cout << std::endl
+                  << "🎉 All shutdown tests passed successfully!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
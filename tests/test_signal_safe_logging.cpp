@@ -0,0 +1,224 @@
+/**
+ * @file test_signal_safe_logging.cpp
+ * @brief Async-signal-safe logging tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include <iostream>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <atomic>
+
+#include <pthread.h>
+#include <unistd.h>
+
+using namespace Eclipse;
+
+namespace
+{
+    std::atomic<int> handled{0};
+
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    void on_usr1(int sig)
+    {
+        ECLIPSE_SIGNAL_SAFE_LOG(ELevel::ECLIPSE_WARN, "SIGNAL_TEST", "Caught signal", sig, -42, ULLONG_MAX, "literal");
+        handled.fetch_add(1);
+    }
+
+    void on_usr2(int)
+    {
+        ECLIPSE_SIGNAL_SAFE_LOG(ELevel::ECLIPSE_ERROR, "SIGNAL_TEST", "Interrupted a logging thread");
+        handled.fetch_add(1);
+    }
+}
+
+void test_signal_safe_record_format()
+{
+    std::cout << "Testing signal-safe record formatting..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_signal_format.log";
+    std::filesystem::remove(test_log_file);
+
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setLogFile(test_log_file);
+    logger.setOutputDestination(EOutput::FILE);
+
+    handled.store(0);
+    std::signal(SIGUSR1, on_usr1);
+    std::raise(SIGUSR1);
+    assert(handled.load() == 1);
+
+    // The regular path writes the same layout, so both records line up in the file
+    ECLIPSE_WARNING("SIGNAL_TEST", "Regular record");
+
+    logger.closeLogFile();
+    logger.setOutputDestination(EOutput::CONSOLE);
+
+    std::string content = read_file(test_log_file);
+    std::cout << content;
+    assert(content.find("WARN : ┏ [SIGNAL_TEST] Caught signal\n") != std::string::npos);
+    assert(content.find("┃ at: test_signal_safe_logging.cpp:") != std::string::npos);
+    assert(content.find("┃ [1] " + std::to_string(SIGUSR1) + "\n") != std::string::npos);
+    assert(content.find("┃ [2] -42\n") != std::string::npos);
+    assert(content.find("┃ [3] 18446744073709551615\n") != std::string::npos);
+    assert(content.find("┗ [4] literal\n") != std::string::npos);
+
+    // Timestamp prefix has the same width as the regular path's
+    size_t signal_line = content.find("] WARN : ┏ [SIGNAL_TEST] Caught");
+    size_t regular_line = content.find("] WARN : ┏ [SIGNAL_TEST] Regular");
+    assert(signal_line != std::string::npos && regular_line != std::string::npos);
+    assert(content.rfind('\n', signal_line) == std::string::npos);
+    assert(signal_line == std::string("[YYYY-MM-DD HH:MM:SS").size());
+    assert(content[regular_line - std::string("[YYYY-MM-DD HH:MM:SS").size() - 1] == '\n');
+
+    std::filesystem::remove(test_log_file);
+    std::cout << "✓ Signal-safe record format test passed" << std::endl;
+}
+
+void test_signal_safe_respects_level()
+{
+    std::cout << "Testing signal-safe level filtering..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_signal_level.log";
+    std::filesystem::remove(test_log_file);
+
+    logger.setLogFile(test_log_file);
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setLevel(ELevel::ECLIPSE_ERROR);
+
+    handled.store(0);
+    std::signal(SIGUSR1, on_usr1);
+    std::raise(SIGUSR1);
+
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.closeLogFile();
+    logger.setOutputDestination(EOutput::CONSOLE);
+
+    std::string content = read_file(test_log_file);
+    assert(handled.load() == 1);
+    assert(content.find("Caught signal") == std::string::npos);
+
+    std::filesystem::remove(test_log_file);
+    std::cout << "✓ Signal-safe level filtering test passed" << std::endl;
+}
+
+void test_signal_during_regular_logging()
+{
+    std::cout << "Testing signals delivered while a thread is inside log()..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string test_log_file = "test_signal_busy.log";
+    std::filesystem::remove(test_log_file);
+
+    logger.setLevel(ELevel::ECLIPSE_DEBUG);
+    logger.setLogFile(test_log_file);
+    logger.setOutputDestination(EOutput::FILE);
+
+    handled.store(0);
+    std::signal(SIGUSR2, on_usr2);
+
+    // The handler interrupts a thread that may hold logMutex; taking it again would deadlock
+    std::atomic<bool> stop_flag{false};
+    std::thread busy([&stop_flag]()
+                     {
+        int i = 0;
+        while (!stop_flag.load()) {
+            ECLIPSE_INFO("SIGNAL_BUSY", "Regular record", "i=" + std::to_string(i++));
+        } });
+
+    const int num_signals = 200;
+    for (int i = 0; i < num_signals; ++i)
+    {
+        ::pthread_kill(busy.native_handle(), SIGUSR2);
+        while (handled.load() <= i)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    stop_flag.store(true);
+    busy.join();
+    logger.closeLogFile();
+    logger.setOutputDestination(EOutput::CONSOLE);
+
+    std::string content = read_file(test_log_file);
+    int records = 0;
+    for (size_t pos = content.find("Interrupted a logging thread"); pos != std::string::npos;
+         pos = content.find("Interrupted a logging thread", pos + 1))
+    {
+        ++records;
+    }
+    std::cout << "Logged " << records << " records from signal handlers" << std::endl;
+    assert(records == num_signals);
+
+    std::filesystem::remove(test_log_file);
+    std::cout << "✓ Signal during regular logging test passed" << std::endl;
+}
+
+void test_signal_safe_preserves_errno()
+{
+    std::cout << "Testing that signal-safe logging leaves errno alone..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    logger.setOutputDestination(EOutput::CONSOLE);
+
+    // A failing write to a closed stdout must not leak EBADF to the interrupted code
+    std::cout.flush();
+    int saved_stdout = ::dup(1);
+    ::close(1);
+    errno = EDOM;
+    ECLIPSE_SIGNAL_SAFE_LOG(ELevel::ECLIPSE_ERROR, "SIGNAL_TEST", "Written to a closed descriptor");
+    int observed = errno;
+    ::dup2(saved_stdout, 1);
+    ::close(saved_stdout);
+    assert(observed == EDOM);
+
+    std::cout << "✓ Signal-safe errno test passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        std::cout << "=== Eclipse Logger Signal-safe Logging Tests ===" << std::endl;
+        std::cout << "Testing logging from signal handlers..." << std::endl
+                  << std::endl;
+
+        ::alarm(30);
+        test_signal_safe_record_format();
+        test_signal_safe_respects_level();
+        test_signal_during_regular_logging();
+        test_signal_safe_preserves_errno();
+
+        std::cout << std::endl
+                  << "🎉 All signal-safe logging tests passed successfully!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "❌ Test failed with unknown exception" << std::endl;
+        return 1;
+    }
+}
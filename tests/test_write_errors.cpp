@@ -0,0 +1,222 @@
+/**
+ * @file test_write_errors.cpp
+ * @brief Disk-full and write-error fallback tests for Eclipse Logger
+ * @author tomosfps
+ * @date 2025
+ */
+
+#include "Eclipse/Logger.h"
+#include "Eclipse/Macros.h"
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace Eclipse;
+
+namespace
+{
+    std::string read_file(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    size_t count_of(const std::string &content, const std::string &needle)
+    {
+        size_t count = 0;
+        for (size_t at = content.find(needle); at != std::string::npos; at = content.find(needle, at + 1))
+        {
+            ++count;
+        }
+        return count;
+    }
+}
+
+void test_disk_full_without_fallback()
+{
+    std::cout << "Testing a full disk without a fallback..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setFallback(EFallback::NONE, "", std::chrono::seconds(10));
+    logger.setLogFile("/dev/full");
+    FileErrorStats before = logger.getFileErrorStats();
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ECLIPSE_INFO("DISK", "Lost record", i);
+    }
+
+    // The first write fails; the rest are not formatted until the retry is due
+    FileErrorStats stats = logger.getFileErrorStats();
+    assert(stats.failed);
+    assert(stats.lastError == ENOSPC);
+    assert(stats.failedWrites == before.failedWrites + 1);
+    assert(stats.droppedWrites == before.droppedWrites + 1);
+    assert(stats.skippedRecords == before.skippedRecords + 99);
+
+    // A new log file starts without the failure
+    logger.closeLogFile();
+    assert(!logger.getFileErrorStats().failed);
+    std::cout << "✓ Full disk without fallback test passed" << std::endl;
+}
+
+void test_alternate_file_fallback()
+{
+    std::cout << "Testing the alternate file fallback..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string alternate = "test_write_errors_alternate.log";
+    std::filesystem::remove(alternate);
+
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setFallback(EFallback::FILE, alternate, std::chrono::seconds(10));
+    logger.setLogFile("/dev/full");
+    FileErrorStats before = logger.getFileErrorStats();
+
+    for (int i = 0; i < 20; ++i)
+    {
+        ECLIPSE_INFO("DISK", "Diverted record", i);
+    }
+    ECLIPSE_SIGNAL_SAFE_LOG(ELevel::ECLIPSE_WARN, "DISK", "Signal record", 1);
+    FileErrorStats stats = logger.getFileErrorStats();
+    logger.closeLogFile();
+    logger.setFallback(EFallback::NONE);
+
+    std::string content = read_file(alternate);
+    assert(count_of(content, "Diverted record") == 20);
+    assert(content.find("[DISK] Signal record") != std::string::npos);
+    assert(stats.fallbackWrites == before.fallbackWrites + 20);
+    assert(stats.failedWrites == before.failedWrites + 1);
+
+    std::filesystem::remove(alternate);
+    std::cout << "✓ Alternate file fallback test passed" << std::endl;
+}
+
+void test_stderr_fallback()
+{
+    std::cout << "Testing the stderr fallback..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string captured = "test_write_errors_stderr.log";
+
+    // Capture standard error in a file for the duration of the test
+    int saved = ::dup(2);
+    int capture = ::open(captured.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    assert(saved >= 0 && capture >= 0);
+    ::dup2(capture, 2);
+    ::close(capture);
+
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setFallback(EFallback::STDERR, "", std::chrono::seconds(10));
+    logger.setLogFile("/dev/full");
+    ECLIPSE_INFO("DISK", "Record on stderr");
+    ECLIPSE_SIGNAL_SAFE_LOG(ELevel::ECLIPSE_WARN, "DISK", "Signal record on stderr", 2);
+    logger.closeLogFile();
+    logger.setFallback(EFallback::NONE);
+
+    std::cerr.flush();
+    ::dup2(saved, 2);
+    ::close(saved);
+
+    std::string content = read_file(captured);
+    assert(content.find("Record on stderr") != std::string::npos);
+    assert(content.find("Signal record on stderr") != std::string::npos);
+
+    std::filesystem::remove(captured);
+    std::cout << "✓ Stderr fallback test passed" << std::endl;
+}
+
+void test_memory_fallback_recovers()
+{
+    std::cout << "Testing the memory fallback and recovery..." << std::endl;
+
+    Logger &logger = Logger::getInstance();
+    const std::string path = "test_write_errors_memory.log";
+    std::filesystem::remove(path);
+
+    logger.setOutputDestination(EOutput::FILE);
+    logger.setFallback(EFallback::MEMORY, "", std::chrono::milliseconds(20));
+    logger.setLogFile(path);
+    ECLIPSE_INFO("DISK", "Kept record", 0);
+
+    // Cap the file at its current size: the next writes fail with EFBIG
+    std::signal(SIGXFSZ, SIG_IGN);
+    struct rlimit original{};
+    ::getrlimit(RLIMIT_FSIZE, &original);
+    struct rlimit capped = original;
+    capped.rlim_cur = static_cast<rlim_t>(std::filesystem::file_size(path));
+    ::setrlimit(RLIMIT_FSIZE, &capped);
+
+    for (int i = 1; i < 50; ++i)
+    {
+        ECLIPSE_INFO("DISK", "Kept record", i);
+    }
+    FileErrorStats failing = logger.getFileErrorStats();
+    assert(failing.failed);
+    assert(failing.lastError == EFBIG);
+
+    // Still failing at the first retry: the delay doubles
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    ECLIPSE_INFO("DISK", "Kept record", 50);
+    assert(logger.getFileErrorStats().failedWrites == failing.failedWrites + 1);
+
+    // Space comes back; the next write after the retry delay recovers
+    ::setrlimit(RLIMIT_FSIZE, &original);
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    ECLIPSE_INFO("DISK", "Kept record", 51);
+    FileErrorStats recovered = logger.getFileErrorStats();
+    logger.closeLogFile();
+    logger.setFallback(EFallback::NONE);
+    std::signal(SIGXFSZ, SIG_DFL);
+
+    assert(!recovered.failed);
+    assert(recovered.recoveries == failing.recoveries + 1);
+
+    // Every record arrived, in order
+    std::string content = read_file(path);
+    assert(count_of(content, "Kept record") == 52);
+    size_t at = 0;
+    for (int i = 0; i < 52; ++i)
+    {
+        at = content.find("] " + std::to_string(i) + "\n", at);
+        assert(at != std::string::npos);
+    }
+
+    std::filesystem::remove(path);
+    std::cout << "✓ Memory fallback recovery test passed" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Eclipse Logger Write Error Tests ===" << std::endl;
+
+    try
+    {
+        test_disk_full_without_fallback();
+        test_alternate_file_fallback();
+        test_stderr_fallback();
+        test_memory_fallback_recovers();
+
+        std::cout << "\n🎉 All write error tests passed!" << std::endl;
+        return 0;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "❌ Test failed with exception: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file eclipse-collectord.cpp
+ * @brief Standalone collector for Eclipse shared-memory logs
+ * @author tomosfps
+ * @date 2025
+ *
+ * Usage:
+ *   eclipse-collectord --name /eclipse --output app.log [--slots 16] [--slot-bytes 1048576]
+ *                      [--interval-ms 5] [--unlink]
+ *
+ * Creates the segment, merges every attached process's records into the output
+ * file and exits after a final drain on SIGINT or SIGTERM.
+ */
+
+#include "Eclipse/SharedLog.h"
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+    volatile std::sig_atomic_t stopRequested = 0;
+
+    void handleStop(int)
+    {
+        stopRequested = 1;
+    }
+
+    void printUsage(const char *program)
+    {
+        std::cerr << "Usage: " << program << " --name NAME --output PATH [--slots N] [--slot-bytes N]"
+                  << " [--interval-ms N] [--unlink]" << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string name;
+    std::string outputPath;
+    Eclipse::SharedLogOptions options;
+    int intervalMs = 5;
+    bool unlinkOnExit = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--name" && hasValue)
+        {
+            name = argv[++i];
+        }
+        else if (arg == "--output" && hasValue)
+        {
+            outputPath = argv[++i];
+        }
+        else if (arg == "--slots" && hasValue)
+        {
+            options.slotCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--slot-bytes" && hasValue)
+        {
+            options.slotBytes = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--interval-ms" && hasValue)
+        {
+            intervalMs = std::atoi(argv[++i]);
+        }
+        else if (arg == "--unlink")
+        {
+            unlinkOnExit = true;
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (name.empty() || outputPath.empty())
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    Eclipse::SharedLogCollector collector(name, outputPath, options);
+    if (!collector.open())
+    {
+        std::cerr << "eclipse-collectord: cannot open segment " << name << " or output " << outputPath << std::endl;
+        return 1;
+    }
+
+    std::signal(SIGINT, handleStop);
+    std::signal(SIGTERM, handleStop);
+
+    while (!stopRequested)
+    {
+        if (collector.poll() == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        }
+    }
+
+    collector.stop();
+    if (unlinkOnExit)
+    {
+        collector.unlink();
+    }
+    return 0;
+}
@@ -0,0 +1,244 @@
+/**
+ * @file eclipse-export.cpp
+ * @brief Converts Eclipse log files into columnar parts for analytics
+ * @author tomosfps
+ * @date 2025
+ *
+ * Usage:
+ *   eclipse-export --output DIR [--rows N] [--threads N] [--dictionary FILE] FILE|DIRECTORY...
+ *
+ * Every input file, in any format, becomes one part directory DIR/part-NNNNN
+ * holding a file per column (time, level, tag, site, message, fields) and
+ * an INDEX with per-block statistics, see ColumnStore.h. A segment
+ * directory stands for every segment its manifest lists. Files are
+ * converted in parallel, by --threads workers (one per CPU by default);
+ * --rows sets the rows per block. Parts left in DIR by an earlier export
+ * are removed first. COMPRESSED files need --dictionary.
+ *
+ * Exit status: 0 if every file was exported intact, 3 if damage was
+ * skipped, 1 if a file could not be read, decoded or written, 2 on a usage
+ * error.
+ */
+
+#include "Eclipse/ColumnStore.h"
+#include "Eclipse/RecordReader.h"
+#include "Eclipse/SegmentStore.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Outcome of exporting one file
+     */
+    struct Export
+    {
+        std::string part;          ///< Part directory
+        bool opened = false;       ///< The file could be opened
+        bool written = false;      ///< The part is complete
+        uint64_t rows = 0;         ///< Records exported
+        uint64_t inputBytes = 0;   ///< Size of the file
+        uint64_t storedBytes = 0;  ///< Size of the column files
+        uint64_t damagedBytes = 0; ///< Damaged or torn bytes skipped
+        uint64_t undecoded = 0;    ///< Frames that could not be decompressed or decoded
+    };
+
+    void printUsage(const char *program)
+    {
+        std::cerr << "Usage: " << program << " --output DIR [--rows N] [--threads N] [--dictionary FILE]"
+                  << " FILE|DIRECTORY..." << std::endl;
+    }
+
+    void exportFile(const std::string &path, const std::string &dictionary, size_t rowsPerBlock, Export &result)
+    {
+        std::error_code error;
+        result.inputBytes = std::filesystem::file_size(path, error);
+
+        Eclipse::RecordReader reader;
+        if (!dictionary.empty())
+        {
+            reader.setDictionary(dictionary);
+        }
+        result.opened = reader.open(path);
+        if (!result.opened)
+        {
+            return;
+        }
+
+        Eclipse::ColumnWriter writer(rowsPerBlock);
+        if (!writer.open(result.part))
+        {
+            return;
+        }
+        Eclipse::BinaryRecord record;
+        bool added = true;
+        while (added && reader.next(record))
+        {
+            added = writer.add(record);
+        }
+        result.written = writer.close() && added;
+        result.rows = writer.getRowCount();
+        result.storedBytes = writer.getStoredBytes();
+        result.damagedBytes = reader.getLogReader().getCorruptBytes() + reader.getLogReader().getTornBytes();
+        result.undecoded = reader.getLogReader().getUndecodedFrames();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string output;
+    size_t rowsPerBlock = Eclipse::kDefaultRowsPerBlock;
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string dictionary;
+    std::vector<std::string> arguments;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (arg == "--rows" && i + 1 < argc)
+        {
+            rowsPerBlock = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            threads = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--dictionary" && i + 1 < argc)
+        {
+            std::ifstream file(argv[++i], std::ios::binary);
+            std::ostringstream content;
+            content << file.rdbuf();
+            dictionary = content.str();
+            if (!file.is_open() || dictionary.empty())
+            {
+                std::cerr << "eclipse-export: cannot read dictionary " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            arguments.push_back(arg);
+        }
+    }
+    if (output.empty() || arguments.empty() || rowsPerBlock == 0 || threads == 0)
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (!dictionary.empty() && !Eclipse::RecordReader().setDictionary(dictionary))
+    {
+        std::cerr << "eclipse-export: not a usable zstd dictionary" << std::endl;
+        return 1;
+    }
+
+    // A segment directory stands for every segment its manifest lists
+    std::vector<std::string> paths;
+    for (const std::string &argument : arguments)
+    {
+        std::error_code error;
+        if (!std::filesystem::is_directory(argument, error))
+        {
+            paths.push_back(argument);
+            continue;
+        }
+        auto to = std::chrono::system_clock::time_point(std::chrono::hours(24 * 365 * 200));
+        for (const Eclipse::SegmentInfo &segment :
+             Eclipse::SegmentStore::findSegments(argument, std::chrono::system_clock::time_point(), to))
+        {
+            paths.push_back((std::filesystem::path(argument) / segment.name).string());
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(output, error);
+    for (const auto &entry : std::filesystem::directory_iterator(output, error))
+    {
+        if (entry.path().filename().string().rfind("part-", 0) == 0)
+        {
+            std::filesystem::remove_all(entry.path(), error);
+        }
+    }
+
+    std::vector<Export> results(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "part-%05zu", i);
+        results[i].part = (std::filesystem::path(output) / name).string();
+    }
+
+    // Files are independent, so workers take the next one until none is left
+    std::atomic<size_t> next{0};
+    auto work = [&]()
+    {
+        for (size_t i = next++; i < paths.size(); i = next++)
+        {
+            exportFile(paths[i], dictionary, rowsPerBlock, results[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < std::min(threads, paths.size()); ++t)
+    {
+        workers.emplace_back(work);
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    int status = 0;
+    uint64_t rows = 0, inputBytes = 0, storedBytes = 0;
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        const Export &result = results[i];
+        if (!result.opened)
+        {
+            std::cerr << "eclipse-export: cannot open " << paths[i] << std::endl;
+            status = 1;
+            continue;
+        }
+        std::cerr << paths[i] << " -> " << result.part << ": " << result.rows << " row(s), " << result.inputBytes
+                  << " byte(s) into " << result.storedBytes << ", " << result.damagedBytes
+                  << " damaged byte(s) skipped" << std::endl;
+        if (!result.written)
+        {
+            std::cerr << "eclipse-export: cannot write " << result.part << std::endl;
+            status = 1;
+        }
+        if (result.undecoded > 0)
+        {
+            std::cerr << paths[i] << ": " << result.undecoded << " frame(s) not decompressed or decoded" << std::endl;
+            status = 1;
+        }
+        if (result.damagedBytes > 0)
+        {
+            status = status == 0 ? 3 : status;
+        }
+        rows += result.rows;
+        inputBytes += result.inputBytes;
+        storedBytes += result.storedBytes;
+    }
+    std::cerr << paths.size() << " file(s), " << rows << " row(s), " << inputBytes << " byte(s) into "
+              << storedBytes << std::endl;
+    return status;
+}
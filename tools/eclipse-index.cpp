@@ -0,0 +1,198 @@
+/**
+ * @file eclipse-index.cpp
+ * @brief Builds search indexes over the tags and fields of finished log files
+ * @author tomosfps
+ * @date 2025
+ *
+ * Usage:
+ *   eclipse-index [--field KEY]... [--threads N] [--dictionary FILE] [--force] FILE|DIRECTORY...
+ *
+ * Writes FILE.idx next to every file, an inverted index from tags and
+ * "key=value" details to the blocks of the file holding them, see
+ * SearchIndex.h. --field limits the indexed details to the given keys;
+ * without it every "key=value" detail is indexed. A segment directory
+ * stands for its finished segments; the open one is skipped. Files whose
+ * index is current are skipped unless --force is given. Files are indexed
+ * in parallel by --threads workers (one per CPU by default). COMPRESSED
+ * files need --dictionary.
+ *
+ * eclipse-read --match TERM uses the indexes to read only matching blocks.
+ *
+ * Exit status: 0 on success, 1 if a file could not be read or its index
+ * not written, 2 on a usage error.
+ */
+
+#include "Eclipse/SearchIndex.h"
+#include "Eclipse/SegmentStore.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Outcome of indexing one file
+     */
+    struct Indexing
+    {
+        bool skipped = false;    ///< The index was current already
+        bool indexed = false;    ///< The index was built and written
+        uint64_t records = 0;    ///< Records indexed
+        size_t blocks = 0;       ///< Blocks listed
+        size_t terms = 0;        ///< Distinct terms
+        uint64_t indexBytes = 0; ///< Size of the index file
+    };
+
+    void printUsage(const char *program)
+    {
+        std::cerr << "Usage: " << program << " [--field KEY]... [--threads N] [--dictionary FILE] [--force]"
+                  << " FILE|DIRECTORY..." << std::endl;
+    }
+
+    void indexFile(const std::string &path, std::vector<std::string> fields, const std::string &dictionary,
+                   bool force, Indexing &result)
+    {
+        const std::string indexPath = Eclipse::SearchIndex::getIndexPath(path);
+        Eclipse::SearchIndex index;
+        std::sort(fields.begin(), fields.end());
+        if (!force && index.load(indexPath) && index.isCurrent(path) && index.getFields() == fields)
+        {
+            result.skipped = true;
+            return;
+        }
+
+        if (!index.build(path, fields, dictionary) || !index.save(indexPath))
+        {
+            return;
+        }
+        std::error_code error;
+        result.indexed = true;
+        result.records = index.getRecordCount();
+        result.blocks = index.getBlocks().size();
+        result.terms = index.getTermCount();
+        result.indexBytes = std::filesystem::file_size(indexPath, error);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::string> fields;
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string dictionary;
+    bool force = false;
+    std::vector<std::string> arguments;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--field" && i + 1 < argc)
+        {
+            fields.push_back(argv[++i]);
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            threads = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--force")
+        {
+            force = true;
+        }
+        else if (arg == "--dictionary" && i + 1 < argc)
+        {
+            std::ifstream file(argv[++i], std::ios::binary);
+            std::ostringstream content;
+            content << file.rdbuf();
+            dictionary = content.str();
+            if (!file.is_open() || dictionary.empty())
+            {
+                std::cerr << "eclipse-index: cannot read dictionary " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            arguments.push_back(arg);
+        }
+    }
+    if (arguments.empty() || threads == 0)
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // A segment directory stands for its finished segments; the open one still grows
+    std::vector<std::string> paths;
+    for (const std::string &argument : arguments)
+    {
+        std::error_code error;
+        if (!std::filesystem::is_directory(argument, error))
+        {
+            paths.push_back(argument);
+            continue;
+        }
+        auto to = std::chrono::system_clock::time_point(std::chrono::hours(24 * 365 * 200));
+        for (const Eclipse::SegmentInfo &segment :
+             Eclipse::SegmentStore::findSegments(argument, std::chrono::system_clock::time_point(), to))
+        {
+            if (!segment.open)
+            {
+                paths.push_back((std::filesystem::path(argument) / segment.name).string());
+            }
+        }
+    }
+
+    // Files are independent, so workers take the next one until none is left
+    std::vector<Indexing> results(paths.size());
+    std::atomic<size_t> next{0};
+    auto work = [&]()
+    {
+        for (size_t i = next++; i < paths.size(); i = next++)
+        {
+            indexFile(paths[i], fields, dictionary, force, results[i]);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < std::min(threads, paths.size()); ++t)
+    {
+        workers.emplace_back(work);
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    int status = 0;
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        const Indexing &result = results[i];
+        if (result.skipped)
+        {
+            std::cerr << paths[i] << ": index is current" << std::endl;
+        }
+        else if (!result.indexed)
+        {
+            std::cerr << "eclipse-index: cannot index " << paths[i] << std::endl;
+            status = 1;
+        }
+        else
+        {
+            std::cerr << paths[i] << ": " << result.records << " record(s), " << result.blocks << " block(s), "
+                      << result.terms << " term(s), " << result.indexBytes << " index byte(s)" << std::endl;
+        }
+    }
+    return status;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file eclipse-read.cpp
+ * @brief Reader and checker for framed Eclipse log files
+ * @author tomosfps
+ * @date 2025
+ *
+ * Usage:
+ *   eclipse-read [--check] [--truncate-torn] [--dictionary FILE] [--iso8601] [--from UNIX-SECONDS]
+ *                [--to UNIX-SECONDS] [--match TERM]... FILE|DIRECTORY...
+ *
+ * Prints the records of every valid frame, skipping damaged ones, and reports
+ * what was skipped on stderr. --check only reports. --truncate-torn cuts an
+ * incomplete last frame off the file, e.g. after a crash. For a segment
+ * directory the manifest selects the segments that overlap --from/--to.
+ * COMPRESSED files need --dictionary with the dictionary their header names.
+ * BINARY records are decoded and printed as text, with ISO 8601 timestamps
+ * under --iso8601.
+ *
+ * --match prints only the records whose tag or a detail equals every TERM,
+ * given as "tag=VALUE" or "key=value", from files of any format. Files
+ * with a current index from eclipse-index are searched by reading only the
+ * blocks it points to; others are read whole.
+ *
+ * Exit status: 0 if every file is intact, 3 if damage was found, 1 if a file
+ * could not be read, decompressed or decoded, 2 on a usage error.
+ */
+
+#include "Eclipse/LogReader.h"
+#include "Eclipse/SearchIndex.h"
+#include "Eclipse/SegmentStore.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+    void printUsage(const char *program)
+    {
+        std::cerr << "Usage: " << program << " [--check] [--truncate-torn] [--dictionary FILE] [--iso8601]"
+                  << " [--from UNIX-SECONDS] [--to UNIX-SECONDS] [--match TERM]... FILE|DIRECTORY..." << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool check = false;
+    bool truncateTorn = false;
+    auto timestampFormat = Eclipse::ETimestampFormat::DEFAULT;
+    std::string dictionary;
+    // Wide enough for any log, narrow enough to convert to nanoseconds on every clock
+    auto from = std::chrono::system_clock::time_point();
+    auto to = std::chrono::system_clock::time_point(std::chrono::hours(24 * 365 * 200));
+    std::vector<std::string> terms;
+    std::vector<std::string> arguments;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--check")
+        {
+            check = true;
+        }
+        else if (arg == "--truncate-torn")
+        {
+            truncateTorn = true;
+        }
+        else if (arg == "--iso8601")
+        {
+            timestampFormat = Eclipse::ETimestampFormat::ISO8601;
+        }
+        else if (arg == "--dictionary" && i + 1 < argc)
+        {
+            std::ifstream file(argv[++i], std::ios::binary);
+            std::ostringstream content;
+            content << file.rdbuf();
+            dictionary = content.str();
+            if (!file.is_open() || dictionary.empty())
+            {
+                std::cerr << "eclipse-read: cannot read dictionary " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if ((arg == "--from" || arg == "--to") && i + 1 < argc)
+        {
+            auto time = std::chrono::system_clock::time_point(std::chrono::seconds(std::atoll(argv[++i])));
+            (arg == "--from" ? from : to) = time;
+        }
+        else if (arg == "--match" && i + 1 < argc)
+        {
+            terms.push_back(argv[++i]);
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            arguments.push_back(arg);
+        }
+    }
+    if (arguments.empty())
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // A segment directory stands for the segments its manifest lists in the range
+    std::vector<std::string> paths;
+    for (const std::string &argument : arguments)
+    {
+        std::error_code error;
+        if (!std::filesystem::is_directory(argument, error))
+        {
+            paths.push_back(argument);
+            continue;
+        }
+        for (const Eclipse::SegmentInfo &segment : Eclipse::SegmentStore::findSegments(argument, from, to))
+        {
+            paths.push_back((std::filesystem::path(argument) / segment.name).string());
+        }
+    }
+
+    int status = 0;
+    for (const std::string &path : paths)
+    {
+        if (!terms.empty())
+        {
+            // The index narrows the search to some blocks; without a current one every block is read
+            Eclipse::SearchIndex index;
+            std::vector<Eclipse::BinaryRecord> found;
+            bool indexed = index.load(Eclipse::SearchIndex::getIndexPath(path)) && index.isCurrent(path);
+            if (!(indexed ? index.search(path, terms, found, dictionary)
+                          : Eclipse::SearchIndex::scan(path, terms, found, dictionary)))
+            {
+                std::cerr << "eclipse-read: cannot open " << path << std::endl;
+                status = 1;
+                continue;
+            }
+            std::string text;
+            for (const Eclipse::BinaryRecord &record : found)
+            {
+                Eclipse::formatBinaryRecord(record, timestampFormat, text);
+            }
+            if (!check)
+            {
+                std::cout << text;
+            }
+            std::cerr << path << ": " << found.size() << " matching record(s), ";
+            if (indexed)
+            {
+                std::cerr << index.getBlocksRead() << " of " << index.getBlocks().size() << " block(s) read";
+            }
+            else
+            {
+                std::cerr << "no current index";
+            }
+            std::cerr << std::endl;
+            continue;
+        }
+
+        Eclipse::LogReader reader;
+        reader.setTimestampFormat(timestampFormat);
+        if (!dictionary.empty() && !reader.setDictionary(dictionary))
+        {
+            std::cerr << "eclipse-read: not a usable zstd dictionary" << std::endl;
+            return 1;
+        }
+        if (!reader.open(path))
+        {
+            std::cerr << "eclipse-read: cannot open " << path << std::endl;
+            status = 1;
+            continue;
+        }
+
+        std::string payload;
+        while (reader.next(payload))
+        {
+            if (!check)
+            {
+                std::cout << payload;
+            }
+        }
+
+        std::cerr << path << ": " << reader.getFrameCount() << " frame(s), "
+                  << reader.getCorruptBytes() << " damaged byte(s) skipped, "
+                  << reader.getTornBytes() << " torn byte(s) at the end" << std::endl;
+        if (reader.getCorruptBytes() > 0 || reader.getTornBytes() > 0)
+        {
+            status = status == 0 ? 3 : status;
+        }
+        if (reader.getUndecodedFrames() > 0)
+        {
+            std::cerr << path << ": " << reader.getUndecodedFrames()
+                      << " frame(s) not decompressed or decoded; header names dictionary " << reader.getDictionaryId()
+                      << std::endl;
+            status = 1;
+        }
+
+        if (truncateTorn && reader.getTornBytes() > 0)
+        {
+            std::error_code error;
+            std::filesystem::resize_file(path, reader.getValidEnd(), error);
+            if (error)
+            {
+                std::cerr << "eclipse-read: cannot truncate " << path << ": " << error.message() << std::endl;
+                status = 1;
+            }
+        }
+    }
+    std::cout.flush();
+    return status;
+}
@@ -0,0 +1,295 @@
+/**
+ * @file eclipse-replay.cpp
+ * @brief Replays captured logs through the logger to benchmark sinks and formats
+ * @author tomosfps
+ * @date 2025
+ *
+ * Usage:
+ *   eclipse-replay (--output FILE | --directory DIR) [--speed X] [--threads N] [--config FILE]
+ *                  [--format TEXT|FRAMED|COMPRESSED|BINARY] [--write-mode IMMEDIATE|THREAD_BUFFERED|DOUBLE_BUFFERED]
+ *                  [--cache NORMAL|DONTNEED|DIRECT] [--compression-dictionary FILE] [--dictionary FILE]
+ *                  FILE|DIRECTORY...
+ *
+ * Loads the records of the captured log files (any format; a segment
+ * directory stands for all of its segments), then logs them through the
+ * full Logger pipeline into --output or a segment directory. --speed 1
+ * (the default) keeps the captured pace, 10 replays ten times as fast and
+ * 0 as fast as possible. --threads spreads the records over N threads.
+ * The logger is configured by --config first and the other options after;
+ * --dictionary is the one the capture was compressed with.
+ *
+ * Reports throughput, the time spent in each log() call and, when paced,
+ * how far the calls fell behind the captured pace.
+ *
+ * Exit status: 0 on success, 1 if a file could not be read or the logger
+ * not configured, 2 on a usage error.
+ */
+
+#include "Eclipse/Replay.h"
+#include "Eclipse/SegmentStore.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+    void printUsage(const char *program)
+    {
+        std::cerr << "Usage: " << program << " (--output FILE | --directory DIR) [--speed X] [--threads N]"
+                  << " [--config FILE] [--format TEXT|FRAMED|COMPRESSED|BINARY]"
+                  << " [--write-mode IMMEDIATE|THREAD_BUFFERED|DOUBLE_BUFFERED] [--cache NORMAL|DONTNEED|DIRECT]"
+                  << " [--compression-dictionary FILE] [--dictionary FILE] FILE|DIRECTORY..." << std::endl;
+    }
+
+    double toMicroseconds(std::chrono::nanoseconds duration)
+    {
+        return static_cast<double>(duration.count()) / 1000.0;
+    }
+
+    uint64_t outputBytes(const std::string &path)
+    {
+        std::error_code error;
+        if (!std::filesystem::is_directory(path, error))
+        {
+            uint64_t size = std::filesystem::file_size(path, error);
+            return error ? 0 : size;
+        }
+        uint64_t total = 0;
+        for (const auto &entry : std::filesystem::directory_iterator(path, error))
+        {
+            if (entry.is_regular_file(error))
+            {
+                total += entry.file_size(error);
+            }
+        }
+        return total;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string output;
+    std::string directory;
+    std::string config;
+    std::string compressionDictionary;
+    std::string dictionary;
+    std::string format;
+    std::string writeMode;
+    std::string cache;
+    Eclipse::ReplayOptions options;
+    std::vector<std::string> arguments;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--output" && hasValue)
+        {
+            output = argv[++i];
+        }
+        else if (arg == "--directory" && hasValue)
+        {
+            directory = argv[++i];
+        }
+        else if (arg == "--speed" && hasValue)
+        {
+            options.speed = std::atof(argv[++i]);
+        }
+        else if (arg == "--threads" && hasValue)
+        {
+            options.threads = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--config" && hasValue)
+        {
+            config = argv[++i];
+        }
+        else if (arg == "--format" && hasValue)
+        {
+            format = argv[++i];
+        }
+        else if (arg == "--write-mode" && hasValue)
+        {
+            writeMode = argv[++i];
+        }
+        else if (arg == "--cache" && hasValue)
+        {
+            cache = argv[++i];
+        }
+        else if (arg == "--compression-dictionary" && hasValue)
+        {
+            compressionDictionary = argv[++i];
+        }
+        else if (arg == "--dictionary" && hasValue)
+        {
+            std::ifstream file(argv[++i], std::ios::binary);
+            std::ostringstream content;
+            content << file.rdbuf();
+            dictionary = content.str();
+            if (!file.is_open() || dictionary.empty())
+            {
+                std::cerr << "eclipse-replay: cannot read dictionary " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            arguments.push_back(arg);
+        }
+    }
+    if (arguments.empty() || output.empty() == directory.empty() || options.threads == 0 || options.speed < 0)
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    Eclipse::EFileFormat fileFormat = Eclipse::EFileFormat::TEXT;
+    Eclipse::EWriteMode mode = Eclipse::EWriteMode::IMMEDIATE;
+    Eclipse::ECacheMode cacheMode = Eclipse::ECacheMode::NORMAL;
+    const std::pair<const char *, Eclipse::EFileFormat> formats[] = {
+        {"TEXT", Eclipse::EFileFormat::TEXT},
+        {"FRAMED", Eclipse::EFileFormat::FRAMED},
+        {"COMPRESSED", Eclipse::EFileFormat::COMPRESSED},
+        {"BINARY", Eclipse::EFileFormat::BINARY},
+    };
+    const std::pair<const char *, Eclipse::EWriteMode> modes[] = {
+        {"IMMEDIATE", Eclipse::EWriteMode::IMMEDIATE},
+        {"THREAD_BUFFERED", Eclipse::EWriteMode::THREAD_BUFFERED},
+        {"DOUBLE_BUFFERED", Eclipse::EWriteMode::DOUBLE_BUFFERED},
+    };
+    const std::pair<const char *, Eclipse::ECacheMode> caches[] = {
+        {"NORMAL", Eclipse::ECacheMode::NORMAL},
+        {"DONTNEED", Eclipse::ECacheMode::DONTNEED},
+        {"DIRECT", Eclipse::ECacheMode::DIRECT},
+    };
+    bool known = true;
+    auto pick = [&known](const std::string &name, const auto &choices, auto &value)
+    {
+        if (name.empty())
+        {
+            return;
+        }
+        for (const auto &choice : choices)
+        {
+            if (name == choice.first)
+            {
+                value = choice.second;
+                return;
+            }
+        }
+        known = false;
+    };
+    pick(format, formats, fileFormat);
+    pick(writeMode, modes, mode);
+    pick(cache, caches, cacheMode);
+    if (!known)
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // A segment directory stands for all of its segments
+    Eclipse::LogReplayer replayer;
+    auto loadStart = std::chrono::steady_clock::now();
+    for (const std::string &argument : arguments)
+    {
+        std::vector<std::string> paths;
+        std::error_code error;
+        if (!std::filesystem::is_directory(argument, error))
+        {
+            paths.push_back(argument);
+        }
+        else
+        {
+            auto to = std::chrono::system_clock::time_point(std::chrono::hours(24 * 365 * 200));
+            for (const Eclipse::SegmentInfo &segment :
+                 Eclipse::SegmentStore::findSegments(argument, std::chrono::system_clock::time_point(), to))
+            {
+                paths.push_back((std::filesystem::path(argument) / segment.name).string());
+            }
+        }
+        for (const std::string &path : paths)
+        {
+            if (!replayer.load(path, dictionary))
+            {
+                std::cerr << "eclipse-replay: cannot read " << path << std::endl;
+                return 1;
+            }
+        }
+    }
+    auto loadTime = std::chrono::steady_clock::now() - loadStart;
+    std::cerr << "loaded " << replayer.getRecordCount() << " record(s) in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(loadTime).count() << " ms" << std::endl;
+
+    // Configuration: the file first, then what the command line chooses
+    Eclipse::Logger &logger = Eclipse::Logger::getInstance();
+    logger.setLevel(Eclipse::ELevel::ECLIPSE_DEBUG);
+    logger.setOutputDestination(Eclipse::EOutput::FILE);
+    if (!config.empty() && !logger.loadConfig(config))
+    {
+        std::cerr << "eclipse-replay: cannot load config " << config << std::endl;
+        return 1;
+    }
+    if (!format.empty())
+    {
+        logger.setFileFormat(fileFormat);
+    }
+    if (!writeMode.empty())
+    {
+        logger.setWriteMode(mode);
+    }
+    if (!compressionDictionary.empty() && !logger.setCompressionDictionary(compressionDictionary))
+    {
+        std::cerr << "eclipse-replay: cannot use compression dictionary " << compressionDictionary << std::endl;
+        return 1;
+    }
+    if (!cache.empty() && !logger.setFileCacheMode(cacheMode))
+    {
+        std::cerr << "eclipse-replay: cache mode " << cache << " is not available" << std::endl;
+        return 1;
+    }
+    if (!directory.empty())
+    {
+        if (!logger.setLogDirectory(directory))
+        {
+            std::cerr << "eclipse-replay: cannot use directory " << directory << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        logger.setLogFile(output);
+    }
+
+    Eclipse::ReplayStats stats = replayer.run(logger, options);
+    logger.closeLogFile();
+
+    double seconds = static_cast<double>(stats.totalTime.count()) / 1e9;
+    uint64_t bytes = outputBytes(directory.empty() ? output : directory);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "replayed " << stats.records << " record(s) on " << options.threads << " thread(s) in "
+              << seconds << " s: " << (seconds > 0 ? static_cast<double>(stats.records) / seconds : 0.0)
+              << " records/s, " << (seconds > 0 ? static_cast<double>(bytes) / seconds / 1e6 : 0.0) << " MB/s, "
+              << bytes << " byte(s) written" << std::endl;
+    std::cout << "log() latency: p50 " << toMicroseconds(stats.latencyP50) << " us, p99 "
+              << toMicroseconds(stats.latencyP99) << " us, p99.9 " << toMicroseconds(stats.latencyP999)
+              << " us, max " << toMicroseconds(stats.latencyMax) << " us" << std::endl;
+    std::cout << "final flush: " << toMicroseconds(stats.totalTime - stats.callsTime) << " us" << std::endl;
+    if (options.speed > 0)
+    {
+        std::cout << "behind the captured pace: p99 " << toMicroseconds(stats.lagP99) << " us, max "
+                  << toMicroseconds(stats.lagMax) << " us" << std::endl;
+    }
+    return 0;
+}
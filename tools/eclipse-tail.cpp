@@ -0,0 +1,548 @@
+/**
+ * @file eclipse-tail.cpp
+ * @brief Follows the records of a running process's log as they are written
+ * @author tomosfps
+ * @date 2025
+ *
+ * Usage:
+ *   eclipse-tail [--level LEVEL] [--tag TAG]... [--lines N] [--iso8601] [--dictionary FILE]
+ *                [--interval-ms N] FILE|DIRECTORY
+ *   eclipse-tail --shm NAME [--level LEVEL] [--tag TAG]... [--pid PID]... [--interval-ms N]
+ *
+ * Prints the last --lines records (10 by default), then every record
+ * appended to a log file of any format. Records are read as fields, and
+ * only those at or above --level and with one of the --tag tags are
+ * formatted. A segment directory stands for its newest segment; the tail
+ * moves on when a newer one starts, and likewise follows a file that is
+ * rotated or truncated. On Linux inotify wakes the tail when the directory
+ * changes; --interval-ms bounds the wait (250 by default).
+ *
+ * With --shm, records are read from a shared-memory log segment while they
+ * wait for its collector, which still receives all of them. --pid limits
+ * them to the given processes, and --interval-ms is the sleep between polls
+ * (1 by default). Records the collector drained first are not seen; their
+ * bytes are reported on stderr.
+ *
+ * Exit status: 0 after SIGINT or SIGTERM, 1 if the log could not be opened,
+ * 2 on a usage error.
+ */
+
+#include "Eclipse/RecordReader.h"
+#include "Eclipse/SegmentStore.h"
+#include "Eclipse/SharedLog.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char *const kLevelNames[] = {"DEBUG", "INFO", "WARN", "ERROR", "FATAL"};
+    constexpr uint8_t kUnknownLevel = 5;
+    constexpr size_t kOutputBytes = 1024 * 1024;
+    const char kFirstMarker[] = "┏ [";
+    constexpr off_t kMinimumFileBytes = 4; ///< Enough to tell a framed file by its magic
+
+    volatile std::sig_atomic_t stopRequested = 0;
+
+    void handleStop(int)
+    {
+        stopRequested = 1;
+    }
+
+    void printUsage(const char *program)
+    {
+        std::cerr << "Usage: " << program << " [--level LEVEL] [--tag TAG]... [--lines N] [--iso8601]"
+                  << " [--dictionary FILE] [--interval-ms N] FILE|DIRECTORY" << std::endl
+                  << "       " << program << " --shm NAME [--level LEVEL] [--tag TAG]... [--pid PID]..."
+                  << " [--interval-ms N]" << std::endl;
+    }
+
+    /**
+     * @brief Which records are shown; checked before anything is formatted
+     */
+    struct Filter
+    {
+        uint8_t minLevel = 0;          ///< Lowest level shown
+        std::vector<std::string> tags; ///< Tags shown, all if empty
+        std::vector<int32_t> pids;     ///< Processes shown, all if empty
+
+        bool matches(uint8_t level, std::string_view tag) const
+        {
+            return level >= minLevel && (tags.empty() || std::find(tags.begin(), tags.end(), tag) != tags.end());
+        }
+
+        bool active() const
+        {
+            return minLevel > 0 || !tags.empty();
+        }
+    };
+
+    /**
+     * @brief Read the level and tag from the first line of a formatted record
+     *
+     * @return bool False if the text does not start like a record
+     */
+    bool readHeader(std::string_view text, uint8_t &level, std::string_view &tag)
+    {
+        size_t close = text.find("] ");
+        size_t colon = close == std::string_view::npos ? close : text.find(": ", close + 2);
+        if (text.empty() || text[0] != '[' || colon == std::string_view::npos ||
+            text.compare(colon + 2, sizeof(kFirstMarker) - 1, kFirstMarker) != 0)
+        {
+            return false;
+        }
+        std::string_view name = text.substr(close + 2, colon - close - 2);
+        while (!name.empty() && name.back() == ' ')
+        {
+            name.remove_suffix(1);
+        }
+        level = kUnknownLevel;
+        for (uint8_t i = 0; i < kUnknownLevel; ++i)
+        {
+            if (name == kLevelNames[i])
+            {
+                level = i;
+            }
+        }
+        size_t tagStart = colon + 2 + sizeof(kFirstMarker) - 1;
+        size_t tagEnd = text.find(']', tagStart);
+        if (tagEnd == std::string_view::npos)
+        {
+            return false;
+        }
+        tag = text.substr(tagStart, tagEnd - tagStart);
+        return true;
+    }
+
+    void writeOutput(std::string &out)
+    {
+        std::fwrite(out.data(), 1, out.size(), stdout);
+        std::fflush(stdout);
+        out.clear();
+    }
+
+    /**
+     * @brief Wait until the log may have changed or the interval has passed
+     */
+    class ChangeWaiter
+    {
+    public:
+        explicit ChangeWaiter(int intervalMs) : intervalMs(intervalMs)
+        {
+#ifdef __linux__
+            fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+        }
+
+        ~ChangeWaiter()
+        {
+#ifdef __linux__
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+#endif
+        }
+
+        ChangeWaiter(const ChangeWaiter &) = delete;
+        ChangeWaiter &operator=(const ChangeWaiter &) = delete;
+
+        /**
+         * @brief Watch the directory holding the log, which sees writes, rotation and new segments alike
+         */
+        void watch(const std::string &directory)
+        {
+#ifdef __linux__
+            if (fd >= 0 && directory != watched)
+            {
+                if (descriptor >= 0)
+                {
+                    ::inotify_rm_watch(fd, descriptor);
+                }
+                descriptor = ::inotify_add_watch(fd, directory.c_str(),
+                                                 IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM);
+                watched = directory;
+            }
+#else
+            (void)directory;
+#endif
+        }
+
+        void wait()
+        {
+#ifdef __linux__
+            if (fd >= 0 && descriptor >= 0)
+            {
+                pollfd waiting{fd, POLLIN, 0};
+                if (::poll(&waiting, 1, intervalMs) > 0)
+                {
+                    // Which file changed does not matter; the caller looks at its own
+                    char events[4096];
+                    while (::read(fd, events, sizeof(events)) > 0)
+                    {
+                    }
+                }
+                return;
+            }
+#endif
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        }
+
+    private:
+        int intervalMs;         ///< Longest wait
+        int fd = -1;            ///< inotify instance, -1 without one
+        int descriptor = -1;    ///< Watch on the directory
+        std::string watched;    ///< Directory being watched
+    };
+
+    /**
+     * @brief The file to follow: the argument itself, or the newest segment of a directory
+     */
+    std::string resolvePath(const std::string &argument)
+    {
+        std::error_code error;
+        if (!std::filesystem::is_directory(argument, error))
+        {
+            return argument;
+        }
+        auto to = std::chrono::system_clock::time_point(std::chrono::hours(24 * 365 * 200));
+        std::vector<Eclipse::SegmentInfo> segments =
+            Eclipse::SegmentStore::findSegments(argument, std::chrono::system_clock::time_point(), to);
+        return segments.empty() ? std::string() : (std::filesystem::path(argument) / segments.back().name).string();
+    }
+
+    /**
+     * @brief Identity and size of a file, to notice rotation and truncation
+     */
+    struct FileState
+    {
+        dev_t device = 0;
+        ino_t inode = 0;
+        off_t size = 0;
+    };
+
+    bool statFile(const std::string &path, FileState &state)
+    {
+        struct stat st{};
+        if (::stat(path.c_str(), &st) != 0)
+        {
+            return false;
+        }
+        state.device = st.st_dev;
+        state.inode = st.st_ino;
+        state.size = st.st_size;
+        return true;
+    }
+
+    /**
+     * @brief Format the records the reader has, which are all new, into out
+     *
+     * @return bool True if any record was read
+     */
+    bool drain(Eclipse::RecordReader &reader, const Filter &filter, Eclipse::ETimestampFormat format,
+               std::string &out)
+    {
+        bool any = false;
+        Eclipse::BinaryRecord record;
+        while (reader.next(record))
+        {
+            any = true;
+            if (filter.matches(record.level, record.tag))
+            {
+                Eclipse::formatBinaryRecord(record, format, out);
+                if (out.size() >= kOutputBytes)
+                {
+                    writeOutput(out);
+                }
+            }
+        }
+        return any;
+    }
+
+    /**
+     * @brief Open a file positioned after its last lines matching records, which are formatted into out
+     *
+     * Reads back from the end in growing steps until enough records were
+     * found. A BINARY file needs a step that holds a reset block of its
+     * stream before any record decodes, so at least one record is read.
+     */
+    bool openAtEnd(const std::string &path, size_t lines, const Filter &filter, Eclipse::ETimestampFormat format,
+                   const std::string &dictionary, Eclipse::RecordReader &reader, std::string &out)
+    {
+        std::error_code error;
+        uint64_t size = std::filesystem::file_size(path, error);
+        std::deque<Eclipse::BinaryRecord> last;
+        for (uint64_t step = 1024 * 1024;; step *= 4)
+        {
+            reader.close();
+            if ((!dictionary.empty() && !reader.setDictionary(dictionary)) || !reader.open(path))
+            {
+                return false;
+            }
+            uint64_t start = step >= size ? 0 : size - step;
+            if (start > 0)
+            {
+                reader.seek(start);
+            }
+            last.clear();
+            uint64_t decoded = 0;
+            Eclipse::BinaryRecord record;
+            while (reader.next(record))
+            {
+                ++decoded;
+                if (lines > 0 && filter.matches(record.level, record.tag))
+                {
+                    last.push_back(std::move(record));
+                    if (last.size() > lines)
+                    {
+                        last.pop_front();
+                    }
+                }
+            }
+            if (start == 0 || (last.size() >= lines && decoded > 0))
+            {
+                break;
+            }
+        }
+        for (const Eclipse::BinaryRecord &record : last)
+        {
+            Eclipse::formatBinaryRecord(record, format, out);
+        }
+        return true;
+    }
+
+    int followFile(const std::string &argument, size_t lines, const Filter &filter, Eclipse::ETimestampFormat format,
+                   const std::string &dictionary, int intervalMs)
+    {
+        std::string path = resolvePath(argument);
+        Eclipse::RecordReader reader;
+        reader.setFollow(true);
+        std::string out;
+        FileState opened;
+        if (path.empty() || !statFile(path, opened))
+        {
+            std::cerr << "eclipse-tail: cannot open " << argument << std::endl;
+            return 1;
+        }
+
+        // The format is told by the first bytes, so a file just created is opened once it has some
+        ChangeWaiter waiter(intervalMs);
+        auto directoryOf = [](const std::string &file)
+        {
+            std::filesystem::path parent = std::filesystem::path(file).parent_path();
+            return parent.empty() ? std::string(".") : parent.string();
+        };
+        while (!stopRequested && opened.size < kMinimumFileBytes)
+        {
+            waiter.watch(directoryOf(path));
+            waiter.wait();
+            statFile(path, opened);
+        }
+        if (stopRequested)
+        {
+            return 0;
+        }
+        if (!openAtEnd(path, lines, filter, format, dictionary, reader, out))
+        {
+            std::cerr << "eclipse-tail: cannot open " << argument << std::endl;
+            return 1;
+        }
+        writeOutput(out);
+
+        while (!stopRequested)
+        {
+            waiter.watch(directoryOf(path));
+            if (drain(reader, filter, format, out))
+            {
+                writeOutput(out);
+                continue;
+            }
+            writeOutput(out);
+
+            // Idle: the writer may have moved on to a new file or truncated this one
+            std::string current = resolvePath(argument);
+            FileState state;
+            if (!current.empty() && statFile(current, state) && state.size >= kMinimumFileBytes &&
+                (current != path || state.device != opened.device || state.inode != opened.inode ||
+                 state.size < opened.size))
+            {
+                // What was written to the old file before it was left is read first
+                drain(reader, filter, format, out);
+                reader.close();
+                if (!dictionary.empty())
+                {
+                    reader.setDictionary(dictionary);
+                }
+                if (!reader.open(current))
+                {
+                    std::cerr << "eclipse-tail: cannot open " << current << std::endl;
+                    return 1;
+                }
+                path = current;
+                opened = state;
+                continue;
+            }
+            if (!current.empty() && current == path)
+            {
+                opened.size = std::max(opened.size, state.size);
+            }
+            waiter.wait();
+        }
+        writeOutput(out);
+        return 0;
+    }
+
+    int followSharedLog(const std::string &name, const Filter &filter, int intervalMs)
+    {
+        std::unique_ptr<Eclipse::SharedLogTail> tail = Eclipse::SharedLogTail::attach(name);
+        if (!tail)
+        {
+            std::cerr << "eclipse-tail: cannot open segment " << name << std::endl;
+            return 1;
+        }
+
+        std::vector<Eclipse::SharedLogEntry> entries;
+        std::string out;
+        uint64_t missed = 0;
+        while (!stopRequested)
+        {
+            entries.clear();
+            if (tail->poll(entries) == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+                continue;
+            }
+            for (const Eclipse::SharedLogEntry &entry : entries)
+            {
+                if (!filter.pids.empty() && std::find(filter.pids.begin(), filter.pids.end(), entry.pid) == filter.pids.end())
+                {
+                    continue;
+                }
+                uint8_t level = 0;
+                std::string_view tag;
+                if (filter.active() && (!readHeader(entry.text, level, tag) || !filter.matches(level, tag)))
+                {
+                    continue;
+                }
+                out += entry.text;
+            }
+            writeOutput(out);
+            if (tail->getMissedBytes() != missed)
+            {
+                std::cerr << "eclipse-tail: " << (tail->getMissedBytes() - missed)
+                          << " byte(s) of records drained by the collector before they were read" << std::endl;
+                missed = tail->getMissedBytes();
+            }
+        }
+        return 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Filter filter;
+    size_t lines = 10;
+    auto timestampFormat = Eclipse::ETimestampFormat::DEFAULT;
+    std::string dictionary;
+    std::string sharedName;
+    int intervalMs = -1;
+    std::vector<std::string> arguments;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--level" && hasValue)
+        {
+            std::string name = argv[++i];
+            std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::toupper(c); });
+            auto found = std::find(std::begin(kLevelNames), std::end(kLevelNames), name);
+            if (found == std::end(kLevelNames))
+            {
+                printUsage(argv[0]);
+                return 2;
+            }
+            filter.minLevel = static_cast<uint8_t>(found - std::begin(kLevelNames));
+        }
+        else if (arg == "--tag" && hasValue)
+        {
+            filter.tags.push_back(argv[++i]);
+        }
+        else if (arg == "--pid" && hasValue)
+        {
+            filter.pids.push_back(static_cast<int32_t>(std::atol(argv[++i])));
+        }
+        else if (arg == "--lines" && hasValue)
+        {
+            lines = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--iso8601")
+        {
+            timestampFormat = Eclipse::ETimestampFormat::ISO8601;
+        }
+        else if (arg == "--dictionary" && hasValue)
+        {
+            std::ifstream file(argv[++i], std::ios::binary);
+            std::ostringstream content;
+            content << file.rdbuf();
+            dictionary = content.str();
+            if (!file.is_open() || dictionary.empty())
+            {
+                std::cerr << "eclipse-tail: cannot read dictionary " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--shm" && hasValue)
+        {
+            sharedName = argv[++i];
+        }
+        else if (arg == "--interval-ms" && hasValue)
+        {
+            intervalMs = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            arguments.push_back(arg);
+        }
+    }
+    // Records in files carry no process id
+    if (sharedName.empty() ? arguments.size() != 1 || !filter.pids.empty() : !arguments.empty())
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    std::signal(SIGINT, handleStop);
+    std::signal(SIGTERM, handleStop);
+
+    if (!sharedName.empty())
+    {
+        return followSharedLog(sharedName, filter, intervalMs < 0 ? 1 : intervalMs);
+    }
+    return followFile(arguments[0], lines, filter, timestampFormat, dictionary, intervalMs < 0 ? 250 : intervalMs);
+}
@@ -0,0 +1,216 @@
+/**
+ * @file eclipse-train-dict.cpp
+ * @brief Trains a zstd dictionary for COMPRESSED Eclipse log files
+ * @author tomosfps
+ * @date 2025
+ *
+ * Usage:
+ *   eclipse-train-dict [--output FILE] [--size BYTES] [--batch RECORDS] [--level N] LOG...
+ *
+ * Splits sample logs (text, framed or compressed without a dictionary) into
+ * records, trains a dictionary from them and writes it to FILE (default
+ * eclipse.dict). --batch joins that many consecutive records into one sample,
+ * matching the batches of the buffered write modes. Reports how much better
+ * single samples compress with the dictionary than without.
+ *
+ * Exit status: 0 on success, 1 if the logs could not be read or training
+ * failed, 2 on a usage error.
+ */
+
+#include "Eclipse/Compression.h"
+#include "Eclipse/LogReader.h"
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void printUsage(const char *program)
+    {
+        std::cerr << "Usage: " << program << " [--output FILE] [--size BYTES] [--batch RECORDS] [--level N] LOG..."
+                  << std::endl;
+    }
+
+    /**
+     * @brief Append the records of a text chunk; a record starts with a "[timestamp]" line
+     */
+    void splitRecords(const std::string &text, std::vector<std::string> &records)
+    {
+        size_t start = 0;
+        while (start < text.size())
+        {
+            size_t end = start;
+            do
+            {
+                end = text.find('\n', end);
+                end = end == std::string::npos ? text.size() : end + 1;
+            } while (end < text.size() && text[end] != '[');
+            records.push_back(text.substr(start, end - start));
+            start = end;
+        }
+    }
+
+    /**
+     * @brief Read the records of a text or framed log
+     */
+    bool readRecords(const std::string &path, std::vector<std::string> &records)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        unsigned char magic[4] = {};
+        file.read(reinterpret_cast<char *>(magic), sizeof(magic));
+        uint32_t first = static_cast<uint32_t>(magic[0]) | static_cast<uint32_t>(magic[1]) << 8 |
+                         static_cast<uint32_t>(magic[2]) << 16 | static_cast<uint32_t>(magic[3]) << 24;
+        bool framed = file.gcount() == 4 && first == Eclipse::kFrameMagic;
+        if (!framed)
+        {
+            file.seekg(0);
+            std::ostringstream content;
+            content << file.rdbuf();
+            splitRecords(content.str(), records);
+            return true;
+        }
+
+        Eclipse::LogReader reader;
+        if (!reader.open(path))
+        {
+            return false;
+        }
+        std::string payload;
+        while (reader.next(payload))
+        {
+            splitRecords(payload, records);
+        }
+        if (reader.getUndecodedFrames() > 0)
+        {
+            std::cerr << "eclipse-train-dict: " << path << ": skipped " << reader.getUndecodedFrames()
+                      << " frame(s) compressed with dictionary " << reader.getDictionaryId() << std::endl;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Total compressed size of every sample compressed on its own
+     */
+    size_t compressedSize(Eclipse::Compressor &compressor, const std::vector<std::string> &samples)
+    {
+        size_t total = 0;
+        std::string out;
+        for (const std::string &sample : samples)
+        {
+            total += compressor.compress(sample.data(), sample.size(), out) ? out.size() : sample.size();
+        }
+        return total;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string output = "eclipse.dict";
+    size_t capacity = 112640;
+    size_t batch = 1;
+    int level = 3;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc)
+        {
+            output = argv[++i];
+        }
+        else if (arg == "--size" && i + 1 < argc)
+        {
+            capacity = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--batch" && i + 1 < argc)
+        {
+            batch = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--level" && i + 1 < argc)
+        {
+            level = std::atoi(argv[++i]);
+        }
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            printUsage(argv[0]);
+            return 2;
+        }
+        else
+        {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty() || capacity == 0 || batch == 0)
+    {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (!Eclipse::Compressor::isAvailable())
+    {
+        std::cerr << "eclipse-train-dict: the Eclipse library was built without zstd" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> records;
+    for (const std::string &path : paths)
+    {
+        if (!readRecords(path, records))
+        {
+            std::cerr << "eclipse-train-dict: cannot read " << path << std::endl;
+            return 1;
+        }
+    }
+    std::vector<std::string> samples;
+    for (size_t i = 0; i < records.size(); i += batch)
+    {
+        std::string sample;
+        for (size_t j = i; j < records.size() && j < i + batch; ++j)
+        {
+            sample += records[j];
+        }
+        samples.push_back(sample);
+    }
+
+    std::string dictionary;
+    if (!Eclipse::Compressor::trainDictionary(samples, capacity, dictionary))
+    {
+        std::cerr << "eclipse-train-dict: training failed on " << samples.size()
+                  << " sample(s); more sample logs are needed" << std::endl;
+        return 1;
+    }
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    file.write(dictionary.data(), static_cast<std::streamsize>(dictionary.size()));
+    file.close();
+    if (!file)
+    {
+        std::cerr << "eclipse-train-dict: cannot write " << output << std::endl;
+        return 1;
+    }
+
+    Eclipse::Compressor plain;
+    Eclipse::Compressor trained;
+    plain.setDictionary("", level);
+    trained.setDictionary(dictionary, level);
+    size_t original = 0;
+    for (const std::string &sample : samples)
+    {
+        original += sample.size();
+    }
+    size_t without = compressedSize(plain, samples);
+    size_t with = compressedSize(trained, samples);
+
+    std::cout << output << ": " << dictionary.size() << " bytes, id " << trained.getDictionaryId() << ", trained on "
+              << samples.size() << " sample(s)" << std::endl;
+    std::cout << std::fixed << std::setprecision(1) << "single samples compress " << double(original) / with
+              << "x with the dictionary, " << double(original) / without << "x without" << std::endl;
+    return 0;
+}